@@ -0,0 +1,212 @@
+/**************************************************************************//**
+ * \file BenchCache.c
+ * \author Roman Holderried
+ *
+ * \brief GETVAR cache against the simulated slave.
+ *
+ * 4 readers (2 per variable) read 8 variables in turn every millisecond
+ * (virtual time, as in BenchScheduler) with a maximum age of 10 ms for 1 s, every 100th
+ * read is preceded by a SETVAR of the variable through the cache. Reported are
+ * the hits, the reads merged into a GETVAR in flight, the GETVARs on the link
+ * and the reads rejected while the link was busy.
+ * Every delivered value is checked against the slave, a read following a
+ * SETVAR must not be served from the cache.
+ * Afterwards (without SETVARs) every 10th response is dropped, the cache
+ * must give those GETVARs up after its timeout (merged reads are cancelled)
+ * and go on reading.
+ *
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchCache.c -o BenchCache
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "SCIMaster.h"
+#include "SCICache.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_BAUDRATE          460800
+#define BENCH_TURNAROUND_US     200
+#define BENCH_IDLE_STEP_US      20
+#define BENCH_DURATION_US       1000000u
+#define BENCH_NUM_READERS       4
+#define BENCH_NUM_VARIABLES     8
+#define BENCH_READ_PERIOD_US    1000
+#define BENCH_MAX_AGE_US        10000
+#define BENCH_WRITE_INTERVAL    100
+#define BENCH_LOSS_INTERVAL     10
+#define BENCH_TIMEOUT_US        2000
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint64_t ui64IdleUs = 0;
+static uint32_t ui32Pending = 0;
+static uint32_t ui32Delivered = 0;
+static uint32_t ui32Cancelled = 0;
+static uint32_t ui32Busy = 0;
+static uint32_t ui32Failed = 0;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t BenchTimeUs (void)
+{
+    tsSIM_SLAVE_STATS sStats = SimSlaveGetStats();
+    uint64_t ui64WireUs = (uint64_t)(sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10u * 1000000u / BENCH_BAUDRATE;
+
+    return (uint32_t)(ui64IdleUs + ui64WireUs + (uint64_t)sStats.ui32ResponseCnt * BENCH_TURNAROUND_US);
+}
+
+//=============================================================================
+static void BenchReadCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    ui32Pending--;
+
+    if (eAck == eREQUEST_ACK_STATUS_CANCELLED)
+        ui32Cancelled++;
+    else if (eAck != eREQUEST_ACK_STATUS_SUCCESS || ui32Data != SimSlaveGetVariable(i16Num))
+    {
+        printf("variable %d: ack %d, value %u instead of %u\n", i16Num, eAck, ui32Data, SimSlaveGetVariable(i16Num));
+        ui32Failed++;
+    }
+    else
+        ui32Delivered++;
+}
+
+//=============================================================================
+static void Read (int16_t i16Num)
+{
+    uint32_t ui32Data;
+
+    switch (SCICacheRead(i16Num, BENCH_MAX_AGE_US, &ui32Data, BenchReadCB))
+    {
+        case eSCI_CACHE_HIT:
+            if (ui32Data != SimSlaveGetVariable(i16Num))
+            {
+                printf("variable %d: cached value %u instead of %u\n", i16Num, ui32Data, SimSlaveGetVariable(i16Num));
+                ui32Failed++;
+            }
+            break;
+
+        case eSCI_CACHE_PENDING:
+            ui32Pending++;
+            break;
+
+        default:
+            ui32Busy++;
+            break;
+    }
+}
+
+//=============================================================================
+static void Bench (bool bLossy)
+{
+    tsSCI_CACHE_STATS sStats;
+    const uint8_t *pui8Rsp;
+    uint16_t ui16RspLen;
+    uint32_t ui32NextReadUs = 0;
+    uint32_t ui32Reads = 0;
+    uint32_t ui32Dropped = 0;
+    uint32_t ui32Written = 0;
+    bool bLost = false;
+
+    SimSlaveInit(TX_PACKET_LENGTH, 1);
+    SimSlaveResetStats();
+    ui64IdleUs = 0;
+    ui32Pending = ui32Delivered = ui32Cancelled = ui32Busy = 0;
+
+    for (int16_t i = 0; i < BENCH_NUM_VARIABLES; i++)
+        SimSlaveSetVariable(i, (uint32_t)i * 3u + 1u);
+
+    SCICacheInit(BenchTimeUs, BENCH_TIMEOUT_US, NULL);
+
+    while (BenchTimeUs() < BENCH_DURATION_US || ui32Pending > 0)
+    {
+        if (BenchTimeUs() >= ui32NextReadUs && BenchTimeUs() < BENCH_DURATION_US)
+        {
+            ui32NextReadUs += BENCH_READ_PERIOD_US;
+
+            for (uint8_t r = 0; r < BENCH_NUM_READERS; r++)
+            {
+                int16_t i16Num = (int16_t)((ui32Reads * 2u + r / 2) % BENCH_NUM_VARIABLES);
+
+                // Written through the cache: The next read must fetch the new value
+                if (!bLossy && (ui32Reads % BENCH_WRITE_INTERVAL) == BENCH_WRITE_INTERVAL - 1 && SCIGetProtocolState() == ePROTOCOL_IDLE)
+                {
+                    tuREQUESTVALUE uVal = {.ui32_hex = SimSlaveGetVariable(i16Num) + 1};
+
+                    if (SCICacheSetVar(i16Num, uVal))
+                    {
+                        // Applied by the slave with the request
+                        SimSlaveProcess();
+                        SCIMasterSM();
+                        ui32Written++;
+                    }
+                }
+
+                Read(i16Num);
+            }
+            ui32Reads++;
+        }
+
+        SCICacheProcess();
+
+        // Time passes while the master waits for a lost response
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+            bLost = false;
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE || bLost)
+            ui64IdleUs += BENCH_IDLE_STEP_US;
+
+        SCIMasterSM();
+
+        if (bLossy && !bLost && (SimSlaveGetStats().ui32RequestCnt % BENCH_LOSS_INTERVAL) == 0 &&
+            SimSlaveTakeResponse(&pui8Rsp, &ui16RspLen))
+        {
+            bLost = true;
+            ui32Dropped++;
+        }
+        else
+            SimSlaveProcess();
+    }
+
+    sStats = SCICacheGetStats();
+
+    printf("%-6s | %6u | %5u | %9u | %10u | %5u | %5u | %6u | %9u\n", bLossy ? "lossy" : "clean", sStats.ui32Reads, sStats.ui32Hits,
+           sStats.ui32Coalesced, sStats.ui32LinkReads, ui32Busy, ui32Written, sStats.ui32Aborts, ui32Cancelled);
+
+    if (sStats.ui32Aborts != ui32Dropped || (ui32Dropped > 0 && ui32Cancelled == 0) || ui32Delivered < sStats.ui32LinkReads / 2)
+    {
+        printf("FAIL: %u responses dropped, %u GETVARs given up, %u reads delivered\n", ui32Dropped, sStats.ui32Aborts, ui32Delivered);
+        ui32Failed++;
+    }
+}
+
+//=============================================================================
+int main (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.GetVarExternalCB       = SCICacheGetVarCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    printf("link   | reads  | hits  | coalesced | link reads | busy  | sets  | aborts | cancelled\n");
+    Bench(false);
+    Bench(true);
+
+    return ui32Failed > 0;
+}
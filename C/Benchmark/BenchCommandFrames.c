@@ -0,0 +1,125 @@
+/**************************************************************************//**
+ * \file BenchCommandFrames.c
+ * \author Roman Holderried
+ *
+ * \brief Round trip benchmark of a 64 value COMMAND result.
+ * 
+ * The slave answers with frames of 128, 512 and 2048 bytes, once limited to
+ * 10 values per frame (former fixed MAX_NUM_RESPONSE_VALUES) and once to 64.
+ * Reported are round trips, bytes on the wire, the estimated link time at
+ * 115200 baud (10 bit per byte plus 1 ms device turnaround per round trip)
+ * and the master CPU time per COMMAND.
+ * 
+ * Build (master buffers configured for the largest frame):
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=2048 -DTX_PACKET_LENGTH=2048
+ *     -DMAX_NUM_RESPONSE_VALUES=64 -I C/Inc -I C/Inc/config -I C/Benchmark
+ *     C/Src/SCI*.c C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchCommandFrames.c -o BenchCommandFrames
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "SCIMaster.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_CMD_NUM           0x40
+#define BENCH_NUM_VALUES        64
+#define BENCH_ITERATIONS        20000
+#define BENCH_BAUDRATE          115200.0
+#define BENCH_TURNAROUND_S      0.001
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static volatile bool bDone = false;
+static uint32_t ui32ResultCnt = 0;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static teTRANSFER_ACK BenchCommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    ui32ResultCnt = ui32DataCnt;
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void RunCommand (void)
+{
+    bDone = false;
+    SCIRequestCommand(BENCH_CMD_NUM, NULL, 0);
+
+    while (!bDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+}
+
+//=============================================================================
+static void Bench (uint16_t ui16PacketLength, uint16_t ui16MaxVals, const uint32_t *pui32Vals)
+{
+    tsSIM_SLAVE_STATS sStats;
+    clock_t t0;
+    double dCpu_us;
+    double dWire_ms;
+
+    SimSlaveInit(ui16PacketLength, ui16MaxVals);
+    SimSlaveSetCommandResult(BENCH_CMD_NUM, pui32Vals, BENCH_NUM_VALUES);
+
+    // Traffic of a single COMMAND
+    RunCommand();
+    sStats = SimSlaveGetStats();
+
+    t0 = clock();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        RunCommand();
+    dCpu_us = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e6 / BENCH_ITERATIONS;
+
+    dWire_ms = ((sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10.0 / BENCH_BAUDRATE + 
+                sStats.ui32ResponseCnt * BENCH_TURNAROUND_S) * 1e3;
+
+    printf("%6u | %8u | %11u | %8u | %10.2f | %8.2f | %u\n", 
+           ui16PacketLength, ui16MaxVals, sStats.ui32ResponseCnt, 
+           sStats.ui32RxByteCnt + sStats.ui32TxByteCnt, dWire_ms, dCpu_us, ui32ResultCnt);
+}
+
+//=============================================================================
+int main (void)
+{
+    static const uint16_t ui16PacketLengths[] = {128, 512, 2048};
+    uint32_t ui32Vals[BENCH_NUM_VALUES];
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+
+    // Mostly full width hex numbers
+    for (uint32_t i = 0; i < BENCH_NUM_VALUES; i++)
+        ui32Vals[i] = (i + 1) * 0x9E3779B1u;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.CommandExternalCB      = BenchCommandCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    printf("packet | vals/frm | round trips | bytes    | wire [ms]  | cpu [us] | results\n");
+
+    for (uint8_t i = 0; i < sizeof(ui16PacketLengths) / sizeof(ui16PacketLengths[0]); i++)
+    {
+        Bench(ui16PacketLengths[i], 10, ui32Vals);
+        Bench(ui16PacketLengths[i], BENCH_NUM_VALUES, ui32Vals);
+    }
+
+    return 0;
+}
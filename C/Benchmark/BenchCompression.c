@@ -0,0 +1,279 @@
+/**************************************************************************//**
+ * \file BenchCompression.c
+ * \author Roman Holderried
+ *
+ * \brief Compressed vs. raw UPSTREAM of datalogger captures.
+ *
+ * Three captures in the layout of a datalogger upstream (channel after
+ * channel, big endian samples) are fetched from the simulated slave, raw and
+ * with the delta codec of the sample width:
+ *  - temperature: 3 INT16 channels, slow drift with +-2 LSB noise
+ *  - sine:        3 INT16 channels, 50 Hz at 20 kHz, +-8 LSB noise
+ *  - position:    2 INT32 channels, encoder counters at varying speed
+ * The compressed upstreams are received buffered (decompressed into the
+ * upstream memory) and incrementally (decompressed chunk-wise into
+ * UpstreamDataExternalCB). Reported are the compression ratio, the bytes on
+ * the wire, the estimated link time at 115200 baud (10 bit per byte plus
+ * 1 ms device turnaround per response), the master CPU time and their sum.
+ * The received data is checked against the capture.
+ *
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchCompression.c -lm -o BenchCompression
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "SCIMaster.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_PACKET_LENGTH     1024
+#define BENCH_CAPTURE_SIZE      120000
+#define BENCH_ITERATIONS        20
+#define BENCH_CMD_GET_DATA      12
+
+#define BENCH_BAUDRATE          115200.0
+#define BENCH_TURNAROUND_S      0.001
+
+#define BENCH_PI                3.14159265358979
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t ui8Capture[BENCH_CAPTURE_SIZE];
+static uint8_t ui8Received[BENCH_CAPTURE_SIZE];
+static uint32_t ui32ReceivedCnt = 0;
+static bool bMismatch = false;
+static bool bHandshakeDone = false;
+static uint32_t ui32Failed = 0;
+static uint32_t ui32Noise = 12345;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static int32_t Noise (int32_t i32Amplitude)
+{
+    ui32Noise = ui32Noise * 1103515245u + 12345u;
+    return (int32_t)((ui32Noise >> 16) % (uint32_t)(2 * i32Amplitude + 1)) - i32Amplitude;
+}
+
+//=============================================================================
+static void PutBE (uint8_t *pui8Dst, uint32_t ui32Val, uint8_t ui8Len)
+{
+    for (uint8_t j = 0; j < ui8Len; j++)
+        pui8Dst[j] = (uint8_t)(ui32Val >> (8 * (ui8Len - 1 - j)));
+}
+
+//=============================================================================
+static void CaptureTemperature (void)
+{
+    uint32_t ui32Samples = BENCH_CAPTURE_SIZE / 3 / 2;
+
+    for (uint32_t ch = 0; ch < 3; ch++)
+    {
+        for (uint32_t i = 0; i < ui32Samples; i++)
+        {
+            int32_t i32Val = 2500 + 100 * (int32_t)ch + (int32_t)(40.0 * sin(i / 3000.0 + ch)) + Noise(2);
+            PutBE(&ui8Capture[(ch * ui32Samples + i) * 2], (uint32_t)i32Val, 2);
+        }
+    }
+}
+
+//=============================================================================
+static void CaptureSine (void)
+{
+    uint32_t ui32Samples = BENCH_CAPTURE_SIZE / 3 / 2;
+
+    for (uint32_t ch = 0; ch < 3; ch++)
+    {
+        for (uint32_t i = 0; i < ui32Samples; i++)
+        {
+            int32_t i32Val = (int32_t)(12000.0 * sin(2 * BENCH_PI * i / 400.0 + ch * 2 * BENCH_PI / 3)) + Noise(8);
+            PutBE(&ui8Capture[(ch * ui32Samples + i) * 2], (uint32_t)i32Val, 2);
+        }
+    }
+}
+
+//=============================================================================
+static void CapturePosition (void)
+{
+    uint32_t ui32Samples = BENCH_CAPTURE_SIZE / 2 / 4;
+
+    for (uint32_t ch = 0; ch < 2; ch++)
+    {
+        int32_t i32Pos = -100000 * (int32_t)ch;
+
+        for (uint32_t i = 0; i < ui32Samples; i++)
+        {
+            i32Pos += (int32_t)(300.0 * (ch + 1) * sin(i / 2000.0)) + Noise(3);
+            PutBE(&ui8Capture[(ch * ui32Samples + i) * 4], (uint32_t)i32Pos, 4);
+        }
+    }
+}
+
+//=============================================================================
+static void BenchUpstreamDataCB (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Offset, uint16_t ui16DataCnt)
+{
+    if (ui32Offset + ui16DataCnt > sizeof(ui8Received))
+    {
+        bMismatch = true;
+        return;
+    }
+
+    memcpy(&ui8Received[ui32Offset], pui8Data, ui16DataCnt);
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    // Buffered: Check the upstream memory directly
+    if (pui8Data != NULL && (ui32ByteCnt != sizeof(ui8Capture) || memcmp(pui8Data, ui8Capture, ui32ByteCnt) != 0))
+        bMismatch = true;
+
+    ui32ReceivedCnt = ui32ByteCnt;
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchCommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+    {
+        printf("command %d failed: ack %d\n", i16Num, eAck);
+        bMismatch = true;
+    }
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bHandshakeDone = true;
+}
+
+//=============================================================================
+static void MasterInit (bool bIncremental)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.CommandExternalCB      = BenchCommandCB;
+    sCbs.UpstreamExternalCB     = BenchUpstreamCB;
+    sCbs.UpstreamDataExternalCB = bIncremental ? BenchUpstreamDataCB : NULL;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    // Frame lengths and the compression are negotiated with the slave
+    bHandshakeDone = false;
+    SCIRequestHandshake();
+
+    while (!bHandshakeDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+}
+
+//=============================================================================
+static void Bench (const char *pcCapture, teSCI_COMPRESS_CODEC eCodec, bool bIncremental)
+{
+    tsSIM_SLAVE_STATS sStats;
+    clock_t t0;
+    double dCpu_us;
+    double dWire_ms;
+
+    SimSlaveSetUpstreamCodec(eCodec);
+    MasterInit(bIncremental);
+
+    bMismatch = false;
+    memset(ui8Received, 0, sizeof(ui8Received));
+
+    // Warm-up (the slave compresses the capture on the first request)
+    SCIRequestCommand(BENCH_CMD_GET_DATA, NULL, 0);
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    SimSlaveResetStats();
+
+    t0 = clock();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        SCIRequestCommand(BENCH_CMD_GET_DATA, NULL, 0);
+
+        while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+        {
+            SCIMasterSM();
+            SimSlaveProcess();
+        }
+    }
+    dCpu_us = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e6 / BENCH_ITERATIONS;
+
+    sStats = SimSlaveGetStats();
+    sStats.ui32RxByteCnt    /= BENCH_ITERATIONS;
+    sStats.ui32TxByteCnt    /= BENCH_ITERATIONS;
+    sStats.ui32ResponseCnt  /= BENCH_ITERATIONS;
+
+    dWire_ms = ((sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10.0 / BENCH_BAUDRATE +
+                sStats.ui32ResponseCnt * BENCH_TURNAROUND_S) * 1e3;
+
+    if (bIncremental && memcmp(ui8Received, ui8Capture, sizeof(ui8Capture)) != 0)
+        bMismatch = true;
+
+    if (bMismatch || ui32ReceivedCnt != sizeof(ui8Capture))
+    {
+        printf("%s: data mismatch!\n", pcCapture);
+        ui32Failed++;
+    }
+
+    printf("%-11s | %-5s | %-11s | %6.2f | %6u | %9.1f | %8.1f | %9.1f\n", pcCapture,
+           eCodec == eSCI_COMPRESS_NONE ? "raw" : eCodec == eSCI_COMPRESS_DELTA16 ? "d16" : "d32",
+           bIncremental ? "incremental" : "buffered",
+           (double)sizeof(ui8Capture) / sStats.ui32TxByteCnt, sStats.ui32TxByteCnt, dWire_ms, dCpu_us,
+           dWire_ms + dCpu_us * 1e-3);
+}
+
+//=============================================================================
+static void BenchCapture (const char *pcCapture, void (*Capture)(void), teSCI_COMPRESS_CODEC eCodec)
+{
+    Capture();
+    SimSlaveSetUpstream(BENCH_CMD_GET_DATA, ui8Capture, sizeof(ui8Capture));
+
+    Bench(pcCapture, eSCI_COMPRESS_NONE, false);
+    Bench(pcCapture, eCodec, false);
+    Bench(pcCapture, eCodec, true);
+}
+
+//=============================================================================
+int main (void)
+{
+    SimSlaveInit(BENCH_PACKET_LENGTH, 32);
+
+    printf("%u byte captures, %u byte frames (ratio: capture / bytes sent by the slave)\n\n",
+           BENCH_CAPTURE_SIZE, BENCH_PACKET_LENGTH);
+    printf("capture     | codec | upstream    | ratio  | bytes  | wire [ms] | cpu [us] | e2e [ms]\n");
+
+    BenchCapture("temperature", CaptureTemperature, eSCI_COMPRESS_DELTA16);
+    BenchCapture("sine", CaptureSine, eSCI_COMPRESS_DELTA16);
+    BenchCapture("position", CapturePosition, eSCI_COMPRESS_DELTA32);
+
+    return ui32Failed > 0;
+}
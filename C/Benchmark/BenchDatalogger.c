@@ -0,0 +1,346 @@
+/**************************************************************************//**
+ * \file BenchDatalogger.c
+ * \author Roman Holderried
+ *
+ * \brief Datalogger client: Capture of 3 INT16 channels from the simulated
+ * slave.
+ *
+ * The whole client sequence (base frequency, version, registration,
+ * initialization, start) is queued at once and driven by
+ * SCIDataloggerProcess. Captures are fetched with the upstream buffered by
+ * the master (UpstreamExternalCB only, demultiplexed afterwards) and with
+ * incremental delivery (UpstreamDataExternalCB, demultiplexed per frame).
+ * Compared are the heap in use while the upstream is received and the CPU
+ * time per capture, the channel buffers are checked against the upstream.
+ * Beforehand, the slave rejects a registration of a queued sequence to check
+ * the error path (cancelled remainder, released channels and budget).
+ *
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchDatalogger.c -o BenchDatalogger
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "SCIMaster.h"
+#include "SCIDatalogger.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_PACKET_LENGTH     1024
+#define BENCH_NUM_CHANNELS      3
+#define BENCH_REC_LEN           20000
+#define BENCH_BASE_FREQUENCY    20000
+#define BENCH_ITERATIONS        50
+
+#define BENCH_CMD_VERSION       5
+#define BENCH_VAR_BASE_FREQ     10
+#define BENCH_CMD_REGISTER      7
+#define BENCH_FAULT_ERR_NUM     5
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static bool bHandshakeDone = false;
+static uint32_t ui32Failed = 0;
+static size_t szHeapBase = 0;
+static size_t szHeapPeak = 0;
+
+static uint8_t ui8Upstream[BENCH_NUM_CHANNELS * BENCH_REC_LEN * 2];
+static uint8_t ui8Samples[BENCH_NUM_CHANNELS][BENCH_REC_LEN * 2];
+
+static const uint32_t ui32Version[3] = {1, 2, 0};
+
+// Results of the operations while a failure is expected
+static bool bExpectFailure = false;
+static uint8_t ui8DoneCnt = 0;
+static struct
+{
+    teSCI_DLOG_OP           eOp;
+    uint8_t                 ui8Channel;
+    teREQUEST_ACKNOWLEDGE   eAck;
+    uint16_t                ui16ErrNum;
+}sDone[8];
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static size_t HeapInUse (void)
+{
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+//=============================================================================
+static void SampleHeap (void)
+{
+    size_t szHeap = HeapInUse() - szHeapBase;
+
+    if (szHeap > szHeapPeak)
+        szHeapPeak = szHeap;
+}
+
+//=============================================================================
+static void BenchDoneCB (teSCI_DLOG_OP eOp, uint8_t ui8Channel, teREQUEST_ACKNOWLEDGE eAck, uint16_t ui16ErrNum)
+{
+    if (bExpectFailure)
+    {
+        if (ui8DoneCnt < sizeof(sDone) / sizeof(sDone[0]))
+        {
+            sDone[ui8DoneCnt].eOp           = eOp;
+            sDone[ui8DoneCnt].ui8Channel    = ui8Channel;
+            sDone[ui8DoneCnt].eAck          = eAck;
+            sDone[ui8DoneCnt].ui16ErrNum    = ui16ErrNum;
+        }
+        ui8DoneCnt++;
+        return;
+    }
+
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+    {
+        printf("operation %d (channel %u) failed: ack %d, error %u\n", eOp, ui8Channel, eAck, ui16ErrNum);
+        ui32Failed++;
+    }
+}
+
+//=============================================================================
+static void BenchUpstreamDataCB (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Offset, uint16_t ui16DataCnt)
+{
+    // Once per upstream (the heap query is expensive)
+    if (ui32Offset == 0)
+        SampleHeap();
+
+    SCIDataloggerUpstreamDataCB(i16Num, pui8Data, ui32Offset, ui16DataCnt);
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    SampleHeap();
+    return SCIDataloggerUpstreamCB(i16Num, pui8Data, ui32ByteCnt);
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bHandshakeDone = true;
+}
+
+//=============================================================================
+static void Run (void)
+{
+    do
+    {
+        SCIDataloggerProcess();
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+    while (!SCIDataloggerIsIdle() || SCIGetProtocolState() != ePROTOCOL_IDLE);
+}
+
+//=============================================================================
+static void MasterInit (bool bIncremental)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.GetVarExternalCB       = SCIDataloggerGetVarCB;
+    sCbs.CommandExternalCB      = SCIDataloggerCommandCB;
+    sCbs.UpstreamExternalCB     = BenchUpstreamCB;
+    sCbs.UpstreamDataExternalCB = bIncremental ? BenchUpstreamDataCB : NULL;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    // Frame lengths are negotiated with the slave
+    bHandshakeDone = false;
+    SCIRequestHandshake();
+
+    while (!bHandshakeDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+}
+
+//=============================================================================
+static void RejectedRegistration (uint32_t ui32MaxNumBytes)
+{
+    // The second registration fails, the rest of the sequence is cancelled
+    static const struct
+    {
+        teSCI_DLOG_OP           eOp;
+        uint8_t                 ui8Channel;
+        teREQUEST_ACKNOWLEDGE   eAck;
+        uint16_t                ui16ErrNum;
+    }sExpected[5] =
+    {
+        {eSCI_DLOG_OP_REGISTER,     1, eREQUEST_ACK_STATUS_SUCCESS,     0},
+        {eSCI_DLOG_OP_REGISTER,     2, eREQUEST_ACK_STATUS_ERROR,       BENCH_FAULT_ERR_NUM},
+        {eSCI_DLOG_OP_REGISTER,     3, eREQUEST_ACK_STATUS_CANCELLED,   0},
+        {eSCI_DLOG_OP_INITIALIZE,   0, eREQUEST_ACK_STATUS_CANCELLED,   0},
+        {eSCI_DLOG_OP_START,        0, eREQUEST_ACK_STATUS_CANCELLED,   0}
+    };
+    tsSCI_DLOG_INFO sInfo;
+
+    // Opened beforehand
+    Run();
+    SimSlaveSetCommandFault(BENCH_CMD_REGISTER, 1, BENCH_FAULT_ERR_NUM);
+
+    bExpectFailure = true;
+    ui8DoneCnt = 0;
+
+    for (uint8_t ch = 0; ch < BENCH_NUM_CHANNELS; ch++)
+        SCIDataloggerRegister(ch + 1, eSCI_DTYPE_INT16, BENCH_REC_LEN, ch + 1, 0, ui8Samples[ch], sizeof(ui8Samples[ch]));
+
+    SCIDataloggerInitialize();
+    SCIDataloggerStart();
+    Run();
+
+    bExpectFailure = false;
+
+    if (ui8DoneCnt != 5)
+    {
+        printf("rejected registration: %u results instead of 5\n", ui8DoneCnt);
+        ui32Failed++;
+    }
+
+    for (uint8_t i = 0; i < 5 && i < ui8DoneCnt; i++)
+    {
+        if (sDone[i].eOp != sExpected[i].eOp || sDone[i].ui8Channel != sExpected[i].ui8Channel ||
+            sDone[i].eAck != sExpected[i].eAck || sDone[i].ui16ErrNum != sExpected[i].ui16ErrNum)
+        {
+            printf("rejected registration: result %u is operation %d (channel %u), ack %d, error %u\n", i, sDone[i].eOp,
+                   sDone[i].ui8Channel, sDone[i].eAck, sDone[i].ui16ErrNum);
+            ui32Failed++;
+        }
+    }
+
+    // Only the first channel keeps its share of the budget
+    sInfo = SCIDataloggerGetInfo();
+    if (sInfo.bInitialized || sInfo.ui32NumBytesLeft != ui32MaxNumBytes - BENCH_REC_LEN * 2)
+    {
+        printf("rejected registration: %u bytes left, initialized %d\n", sInfo.ui32NumBytesLeft, sInfo.bInitialized);
+        ui32Failed++;
+    }
+
+    SCIDataloggerReset();
+    Run();
+}
+
+//=============================================================================
+static void Bench (const char *pcMode, bool bIncremental)
+{
+    clock_t t0;
+    double dCpu_us;
+
+    MasterInit(bIncremental);
+
+    memset(ui8Samples, 0, sizeof(ui8Samples));
+    szHeapBase = HeapInUse();
+    szHeapPeak = 0;
+
+    t0 = clock();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        SCIDataloggerGetData();
+        Run();
+    }
+    dCpu_us = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e6 / BENCH_ITERATIONS;
+
+    for (uint8_t ch = 1; ch <= BENCH_NUM_CHANNELS; ch++)
+    {
+        const tsSCI_DLOG_CHANNEL *psCh = SCIDataloggerGetChannel(ch);
+
+        if (psCh == NULL || psCh->ui32Count != BENCH_REC_LEN ||
+            memcmp(psCh->pui8Samples, &ui8Upstream[(ch - 1) * sizeof(ui8Samples[0])], sizeof(ui8Samples[0])) != 0)
+        {
+            printf("channel %u data mismatch!\n", ch);
+            ui32Failed++;
+        }
+    }
+
+    printf("%-12s | %9zu | %8.1f\n", pcMode, szHeapPeak, dCpu_us);
+}
+
+//=============================================================================
+int main (void)
+{
+    tsSCI_DLOG_CONFIG sConfig;
+    tsSCI_DLOG_INFO sInfo;
+
+    memset(&sConfig, 0, sizeof(sConfig));
+
+    // Big endian INT16 ramps, one per channel
+    for (uint32_t i = 0; i < BENCH_NUM_CHANNELS * BENCH_REC_LEN; i++)
+    {
+        int16_t i16Val = (int16_t)(i % BENCH_REC_LEN) * (int16_t)(i / BENCH_REC_LEN + 1);
+
+        ui8Upstream[2 * i]      = (uint8_t)((uint16_t)i16Val >> 8);
+        ui8Upstream[2 * i + 1]  = (uint8_t)i16Val;
+    }
+
+    SimSlaveInit(BENCH_PACKET_LENGTH, 32);
+    SimSlaveSetVariable(BENCH_VAR_BASE_FREQ, BENCH_BASE_FREQUENCY);
+    SimSlaveSetCommandResult(BENCH_CMD_VERSION, ui32Version, 3);
+
+    // Command numbers of Python/Tests/DataloggerCfg.py
+    sConfig.sCommands.i16GetDataloggerVersion       = BENCH_CMD_VERSION;
+    sConfig.sCommands.i16RegisterLogFromVarStruct   = BENCH_CMD_REGISTER;
+    sConfig.sCommands.i16InitializeDatalogger       = 9;
+    sConfig.sCommands.i16StartDatalogger            = 10;
+    sConfig.sCommands.i16GetLogData                 = 12;
+    sConfig.sCommands.i16ResetDatalogger            = 14;
+    sConfig.sCommands.i16BaseFrequencyVar           = BENCH_VAR_BASE_FREQ;
+    sConfig.ui32MaxNumBytes                         = 15000 * 8;
+    sConfig.DoneCB                                  = BenchDoneCB;
+
+    SimSlaveSetUpstream(sConfig.sCommands.i16GetLogData, ui8Upstream, sizeof(ui8Upstream));
+
+    MasterInit(true);
+    SCIDataloggerInit(sConfig);
+    RejectedRegistration(sConfig.ui32MaxNumBytes);
+
+    // The whole sequence at once
+    for (uint8_t ch = 0; ch < BENCH_NUM_CHANNELS; ch++)
+        SCIDataloggerRegister(ch + 1, eSCI_DTYPE_INT16, BENCH_REC_LEN, ch + 1, 0, ui8Samples[ch], sizeof(ui8Samples[ch]));
+
+    // Exceeds the budget: Rejected without request
+    if (SCIDataloggerRegister(4, eSCI_DTYPE_INT32, BENCH_REC_LEN, 1, 0, NULL, 0) != 0)
+        ui32Failed++;
+
+    SCIDataloggerInitialize();
+    SCIDataloggerStart();
+    Run();
+
+    sInfo = SCIDataloggerGetInfo();
+    printf("datalogger V%u_%u_%u, %u Hz, %u bytes left\n", sInfo.ui8VersionMajor, sInfo.ui8VersionMinor, sInfo.ui8Revision,
+           sInfo.ui32BaseFrequency, sInfo.ui32NumBytesLeft);
+    printf("%u channels x %u INT16 samples per capture (%u bytes), %u byte frames\n\n", BENCH_NUM_CHANNELS, BENCH_REC_LEN,
+           (uint32_t)sizeof(ui8Upstream), BENCH_PACKET_LENGTH);
+
+    printf("upstream     | heap [B]  | cpu [us]\n");
+    Bench("buffered", false);
+    Bench("incremental", true);
+
+    return ui32Failed > 0;
+}
@@ -0,0 +1,183 @@
+/**************************************************************************//**
+ * \file BenchDownstream.c
+ * \author Roman Holderried
+ *
+ * \brief Throughput benchmark of a DOWNSTREAM transfer vs. a SETVAR loop.
+ *
+ * A 4 KiB table (1024 32 bit values) is pushed to the simulated slave, once
+ * by one SETVAR per value and once by a DOWNSTREAM transfer with different
+ * frame lengths (negotiated by the handshake) and credit windows. The last
+ * rows repeat the transfer with every 7th data frame lost on the way.
+ * Reported are frames, link turnarounds, bytes on the wire, the estimated
+ * link time at 115200 baud (10 bit per byte plus 1 ms device turnaround per
+ * response) with the resulting throughput and the master CPU time.
+ *
+ * Build (master buffers configured for the largest frame):
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=2048 -DTX_PACKET_LENGTH=2048
+ *     -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c C/Src/Buffer.c
+ *     C/Src/Helpers.c C/Benchmark/SimSlave.c C/Benchmark/BenchDownstream.c
+ *     -o BenchDownstream
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "SCIMaster.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_DS_NUM            0x10
+#define BENCH_NUM_VALUES        1024
+#define BENCH_ITERATIONS        200
+#define BENCH_BAUDRATE          115200.0
+#define BENCH_TURNAROUND_S      0.001
+#define BENCH_DROP_INTERVAL     7
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static volatile bool bDone = false;
+static uint32_t ui32AckedCnt = 0;
+static uint32_t ui32Table[BENCH_NUM_VALUES];
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static teTRANSFER_ACK BenchSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchDownstreamCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32AckedByteCnt, uint16_t ui16ErrNum)
+{
+    ui32AckedCnt = ui32AckedByteCnt;
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bDone = true;
+}
+
+//=============================================================================
+static void Run (void)
+{
+    while (!bDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+}
+
+//=============================================================================
+static void RunSetVarLoop (void)
+{
+    for (uint16_t i = 0; i < BENCH_NUM_VALUES; i++)
+    {
+        tuREQUESTVALUE uVal = {.ui32_hex = ui32Table[i]};
+
+        bDone = false;
+        SCIRequestSetVar((int16_t)(i % SIM_SLAVE_NUM_VARIABLES), uVal);
+        Run();
+    }
+}
+
+//=============================================================================
+static void RunDownstream (void)
+{
+    bDone = false;
+    SCIRequestDownstream(BENCH_DS_NUM, (const uint8_t*)ui32Table, sizeof(ui32Table), 0);
+    Run();
+}
+
+//=============================================================================
+static void Bench (const char *pcMode, uint16_t ui16PacketLength, uint16_t ui16Credit, uint32_t ui32DropInterval, void (*Transfer)(void))
+{
+    tsSIM_SLAVE_STATS sStats;
+    clock_t t0;
+    double dCpu_us;
+    double dWire_ms;
+
+    // Frame lengths are negotiated with the slave
+    SimSlaveInit(ui16PacketLength, 1);
+    SimSlaveSetDownstream(ui16Credit, ui32DropInterval);
+    bDone = false;
+    SCIRequestHandshake();
+    Run();
+
+    // Traffic of a single transfer
+    SimSlaveResetStats();
+    Transfer();
+    sStats = SimSlaveGetStats();
+
+    t0 = clock();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        Transfer();
+    dCpu_us = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e6 / BENCH_ITERATIONS;
+
+    dWire_ms = ((sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10.0 / BENCH_BAUDRATE +
+                sStats.ui32ResponseCnt * BENCH_TURNAROUND_S) * 1e3;
+
+    printf("%-10s | %6u | %6u | %6u | %11u | %6u | %9.1f | %11.2f | %9.1f\n",
+           pcMode, ui16PacketLength, ui16Credit, sStats.ui32RequestCnt, sStats.ui32ResponseCnt,
+           sStats.ui32RxByteCnt + sStats.ui32TxByteCnt, dWire_ms, sizeof(ui32Table) / dWire_ms, dCpu_us);
+}
+
+//=============================================================================
+int main (void)
+{
+    static const uint16_t ui16PacketLengths[] = {128, 512, 2048};
+    static const uint16_t ui16Credits[] = {1, 4, 16};
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    const uint8_t *pui8Received;
+
+    // Mostly full width hex numbers (raw bytes include STX / ETX values)
+    for (uint32_t i = 0; i < BENCH_NUM_VALUES; i++)
+        ui32Table[i] = (i + 1) * 0x9E3779B1u;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.SetVarExternalCB       = BenchSetVarCB;
+    sCbs.DownstreamExternalCB   = BenchDownstreamCB;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    printf("mode       | packet | credit | frames | turnarounds | bytes  | wire [ms] | rate [kB/s] | cpu [us]\n");
+
+    Bench("SETVAR", 128, 1, 0, RunSetVarLoop);
+
+    for (uint8_t i = 0; i < sizeof(ui16PacketLengths) / sizeof(ui16PacketLengths[0]); i++)
+    {
+        for (uint8_t j = 0; j < sizeof(ui16Credits) / sizeof(ui16Credits[0]); j++)
+            Bench("DOWNSTREAM", ui16PacketLengths[i], ui16Credits[j], 0, RunDownstream);
+    }
+
+    // Lost frames are repeated from the acknowledged offset
+    Bench("DS lossy", 512, 4, BENCH_DROP_INTERVAL, RunDownstream);
+    Bench("DS lossy", 512, 16, BENCH_DROP_INTERVAL, RunDownstream);
+
+    if (SimSlaveGetDownstreamData(&pui8Received) != sizeof(ui32Table) || ui32AckedCnt != sizeof(ui32Table) ||
+        memcmp(pui8Received, ui32Table, sizeof(ui32Table)) != 0)
+    {
+        printf("DOWNSTREAM data mismatch!\n");
+        return 1;
+    }
+
+    return 0;
+}
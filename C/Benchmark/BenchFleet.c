@@ -0,0 +1,361 @@
+/**************************************************************************//**
+ * \file BenchFleet.c
+ * \author Roman Holderried
+ *
+ * \brief Scaling of the fleet manager: Up to 64 simulated devices, each one a
+ * process answering on its own pseudo terminal pair.
+ *
+ * Every device process runs the simulated slave (variables 1..255 hold their
+ * number, COMMAND 1 answers with a 64 KiB upstream). The fleet keeps two
+ * GETVAR requests queued per device (closed loop, every result queues the
+ * next one) for BENCH_DURATION_S per row:
+ *  - concurrent:   1, 8 and 64 devices served in one event loop
+ *  - sequential:   64 devices, one request in flight at a time (what one
+ *                  blocking master serving the devices in turn achieves)
+ *  - upstream:     64 devices, device 1 fetches 64 KiB upstreams back to back
+ *                  while the others poll, to show that a long transfer does
+ *                  not hold up the other links
+ * Reported are the GETVAR rate, the fairness across the polling devices
+ * (fewest / most results per device and Jain's index, 1.0: equal), the mean
+ * and maximum latency from queueing to the result and the CPU time of the
+ * loop per result. All values are checked.
+ *
+ * Build (Linux):
+ * gcc -std=c99 -O2 -DSCI_FLEET_ENABLE=1 -DRX_PACKET_LENGTH=1024 -DTX_PACKET_LENGTH=1024
+ *     -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c C/Src/Buffer.c
+ *     C/Src/Helpers.c C/Benchmark/SimSlave.c C/Benchmark/BenchFleet.c
+ *     -o BenchFleet
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "SCIFleet.h"
+#include "SimSlave.h"
+
+#if !SCI_FLEET_ENABLE
+#error "Build with -DSCI_FLEET_ENABLE=1"
+#endif
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_NUM_DEVICES       64
+#define BENCH_PACKET_LENGTH     1024
+#define BENCH_DURATION_S        1.0
+#define BENCH_QUEUE_DEPTH       2
+#define BENCH_TIMEOUT_MS        1000
+
+#define BENCH_UPS_NUM           1
+#define BENCH_UPS_LEN           65536u
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static int iLink[BENCH_NUM_DEVICES];
+static pid_t iPid[BENCH_NUM_DEVICES];
+
+static uint32_t ui32Results[BENCH_NUM_DEVICES + 1];
+static uint32_t ui32Upstreams = 0;
+static uint32_t ui32Failed = 0;
+static bool bRunning = false;
+static bool bSequential = false;
+static uint16_t ui16NumDevices = 0;
+static uint8_t ui8UpsData[BENCH_UPS_LEN];
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static double Now (void)
+{
+    struct timespec sTs;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTs);
+
+    return (double)sTs.tv_sec + (double)sTs.tv_nsec * 1e-9;
+}
+
+//=============================================================================
+static void Device (int iFd)
+{
+    uint8_t ui8Rx[4096];
+
+    SimSlaveInit(BENCH_PACKET_LENGTH, 10);
+    SimSlaveSetUpstream(BENCH_UPS_NUM, ui8UpsData, BENCH_UPS_LEN);
+
+    for (int16_t i = 1; i < SIM_SLAVE_NUM_VARIABLES; i++)
+        SimSlaveSetVariable(i, (uint32_t)i);
+
+    // Until the fleet side is closed
+    while (true)
+    {
+        ssize_t iCnt = read(iFd, ui8Rx, sizeof(ui8Rx));
+
+        if (iCnt <= 0)
+            _exit(0);
+
+        for (ssize_t i = 0; i < iCnt; i++)
+        {
+            const uint8_t *pui8Rsp;
+            uint16_t ui16RspLen;
+
+            SimSlaveTxCB(&ui8Rx[i], 1);
+
+            if (SimSlaveTakeResponse(&pui8Rsp, &ui16RspLen))
+            {
+                while (ui16RspLen > 0)
+                {
+                    ssize_t iSent = write(iFd, pui8Rsp, ui16RspLen);
+
+                    if (iSent <= 0)
+                        _exit(1);
+
+                    pui8Rsp += iSent;
+                    ui16RspLen -= (uint16_t)iSent;
+                }
+            }
+        }
+    }
+}
+
+//=============================================================================
+static bool SpawnDevices (void)
+{
+    for (uint32_t i = 0; i < BENCH_UPS_LEN; i++)
+        ui8UpsData[i] = (uint8_t)((i * 0x9E3779B1u) >> 24);
+
+    for (uint16_t n = 0; n < BENCH_NUM_DEVICES; n++)
+    {
+        struct termios sTermios;
+        int iMaster = posix_openpt(O_RDWR | O_NOCTTY);
+
+        if (iMaster < 0 || grantpt(iMaster) != 0 || unlockpt(iMaster) != 0)
+            return false;
+
+        // The fleet uses the terminal side like a serial port
+        iLink[n] = open(ptsname(iMaster), O_RDWR | O_NOCTTY);
+
+        if (iLink[n] < 0 || tcgetattr(iLink[n], &sTermios) != 0)
+            return false;
+
+        cfmakeraw(&sTermios);
+        tcsetattr(iLink[n], TCSANOW, &sTermios);
+
+        if ((iPid[n] = fork()) < 0)
+            return false;
+
+        if (iPid[n] == 0)
+        {
+            // Only the own link stays open, so every device ends with its link
+            for (uint16_t i = 0; i <= n; i++)
+                close(iLink[i]);
+
+            Device(iMaster);
+        }
+
+        close(iMaster);
+    }
+
+    return true;
+}
+
+//=============================================================================
+static void Poll (uint16_t ui16Id)
+{
+    int16_t i16Num = (int16_t)(1 + (ui16Id + ui32Results[ui16Id]) % (SIM_SLAVE_NUM_VARIABLES - 1));
+
+    if (!SCIFleetGetVar(ui16Id, i16Num, NULL))
+        ui32Failed++;
+}
+
+//=============================================================================
+static void BenchDoneCB (const tsSCI_FLEET_RESULT *psResult)
+{
+    bool bOk = psResult->eStatus == eSCI_FLEET_STATUS_DONE;
+
+    switch (psResult->eOp)
+    {
+        case eSCI_FLEET_OP_GETVAR:
+            bOk = bOk && psResult->ui32ValCnt == 1 && psResult->pui32Vals[0] == (uint32_t)psResult->i16Num;
+            ui32Results[psResult->ui16Id]++;
+            break;
+
+        case eSCI_FLEET_OP_COMMAND:
+            bOk = bOk && psResult->ui32UpstreamLen == BENCH_UPS_LEN &&
+                  memcmp(psResult->pui8Upstream, ui8UpsData, BENCH_UPS_LEN) == 0;
+            ui32Upstreams++;
+            break;
+
+        default:
+            bOk = bOk && psResult->eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA;
+            break;
+    }
+
+    if (!bOk)
+    {
+        printf("device %u: request %d failed (status %d, ack %d)\n", psResult->ui16Id, psResult->i16Num,
+               psResult->eStatus, psResult->eAck);
+        ui32Failed++;
+    }
+
+    if (!bRunning || psResult->eOp == eSCI_FLEET_OP_HANDSHAKE)
+        return;
+
+    // Closed loop: The device (or the next one) gets the next request
+    if (psResult->eOp == eSCI_FLEET_OP_COMMAND)
+        SCIFleetCommand(psResult->ui16Id, BENCH_UPS_NUM, NULL, 0, NULL);
+    else if (bSequential)
+        Poll(psResult->ui16Id % ui16NumDevices + 1);
+    else
+        Poll(psResult->ui16Id);
+}
+
+//=============================================================================
+static void Bench (const char *pcMode, uint16_t ui16Devices, bool bSeq, bool bUpstream)
+{
+    tsSCI_FLEET_CONFIG sConfig = {BENCH_TIMEOUT_MS, BenchDoneCB};
+    tsSCI_FLEET_STATS sStats;
+    tsSCI_FLEET_STATS sDevStats;
+    uint64_t ui64LatencySum = 0;
+    uint32_t ui32LatencyMax = 0;
+    uint32_t ui32Done = 0;
+    uint32_t ui32Min = UINT32_MAX, ui32Max = 0, ui32Total = 0;
+    uint16_t ui16First = bUpstream ? 2 : 1;
+    double dSum = 0.0, dSumSq = 0.0;
+    double dStart, dElapsed;
+    clock_t t0;
+
+    SCIFleetInit(sConfig);
+    memset(ui32Results, 0, sizeof(ui32Results));
+    ui32Upstreams   = 0;
+    ui16NumDevices  = ui16Devices;
+    bSequential     = bSeq;
+
+    // Device IDs 1..n, frame lengths negotiated per device
+    for (uint16_t n = 0; n < ui16Devices; n++)
+    {
+        if (!SCIFleetAddDevice(n + 1, iLink[n], eSCI_VALUE_MODE_HEX) || !SCIFleetHandshake(n + 1, NULL))
+            ui32Failed++;
+    }
+
+    while (!SCIFleetIsIdle())
+        SCIFleetProcess(-1);
+
+    bRunning = true;
+
+    if (bSeq)
+        Poll(1);
+    else
+    {
+        for (uint16_t id = ui16First; id <= ui16Devices; id++)
+        {
+            for (uint8_t i = 0; i < BENCH_QUEUE_DEPTH; i++)
+                Poll(id);
+        }
+    }
+
+    if (bUpstream)
+        SCIFleetCommand(1, BENCH_UPS_NUM, NULL, 0, NULL);
+
+    memset(ui32Results, 0, sizeof(ui32Results));
+    t0 = clock();
+    dStart = Now();
+
+    while ((dElapsed = Now() - dStart) < BENCH_DURATION_S)
+        SCIFleetProcess(10);
+
+    bRunning = false;
+
+    // Statistics of the measured period (the requests still in flight are drained below)
+    SCIFleetGetStats(SCI_FLEET_ALL, &sStats);
+
+    for (uint16_t id = ui16First; id <= ui16Devices; id++)
+    {
+        ui32Total += ui32Results[id];
+        dSum += ui32Results[id];
+        dSumSq += (double)ui32Results[id] * ui32Results[id];
+
+        // Latency of the polling devices only
+        SCIFleetGetStats(id, &sDevStats);
+        ui64LatencySum += sDevStats.ui64LatencySumUs;
+        ui32Done += sDevStats.ui32Done;
+
+        if (sDevStats.ui32LatencyMaxUs > ui32LatencyMax)
+            ui32LatencyMax = sDevStats.ui32LatencyMaxUs;
+
+        if (ui32Results[id] < ui32Min)
+            ui32Min = ui32Results[id];
+        if (ui32Results[id] > ui32Max)
+            ui32Max = ui32Results[id];
+    }
+
+    printf("%-10s | %7u | %10.0f | %6u | %6u | %5.3f | %8.1f | %8u | %5.2f",
+           pcMode, ui16Devices, ui32Total / dElapsed, ui32Min, ui32Max, dSum * dSum / ((ui16Devices - ui16First + 1) * dSumSq),
+           ui32Done > 0 ? (double)ui64LatencySum / ui32Done : 0.0, ui32LatencyMax,
+           (double)(clock() - t0) / CLOCKS_PER_SEC * 1e6 / (ui32Total + ui32Upstreams));
+
+    if (bUpstream)
+        printf(" | %.1f MB/s upstream", ui32Upstreams * (double)BENCH_UPS_LEN / dElapsed / 1e6);
+
+    printf("\n");
+
+    while (!SCIFleetIsIdle())
+        SCIFleetProcess(-1);
+
+    if (sStats.ui32Timeouts > 0 || sStats.ui32IoErrors > 0)
+    {
+        printf("%u timeouts, %u link errors\n", sStats.ui32Timeouts, sStats.ui32IoErrors);
+        ui32Failed++;
+    }
+
+    SCIFleetDeinit();
+}
+
+//=============================================================================
+int main (void)
+{
+    signal(SIGPIPE, SIG_IGN);
+
+    if (!SpawnDevices())
+    {
+        perror("pty");
+        return 1;
+    }
+
+    printf("%u devices on pseudo terminals, %u GETVAR requests queued per device, %.0f s per row\n\n",
+           BENCH_NUM_DEVICES, BENCH_QUEUE_DEPTH, BENCH_DURATION_S);
+    printf("mode       | devices | getvar [/s] | min    | max    | jain  | lat [us] | max [us] | cpu [us]\n");
+
+    Bench("concurrent", 1, false, false);
+    Bench("concurrent", 8, false, false);
+    Bench("concurrent", BENCH_NUM_DEVICES, false, false);
+    Bench("sequential", BENCH_NUM_DEVICES, true, false);
+    Bench("upstream", BENCH_NUM_DEVICES, false, true);
+
+    // Closing the links ends the device processes
+    for (uint16_t n = 0; n < BENCH_NUM_DEVICES; n++)
+        close(iLink[n]);
+
+    for (uint16_t n = 0; n < BENCH_NUM_DEVICES; n++)
+        waitpid(iPid[n], NULL, 0);
+
+    return ui32Failed > 0;
+}
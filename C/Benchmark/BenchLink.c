@@ -0,0 +1,274 @@
+/**************************************************************************//**
+ * \file BenchLink.c
+ * \author Roman Holderried
+ *
+ * \brief Predicted wire throughput of the master on an emulated serial link.
+ *
+ * The master talks to the simulated slave through the link emulator
+ * (SimLink.h), all times are virtual. Scenarios:
+ *  - GETVAR / SETVAR round trips at 115200 baud, 1 ms device turnaround
+ *  - 96 SETVARs as single frames and as batch frames of 2 and
+ *    SCI_SETVAR_BATCH_MAX writes
+ *  - 64 KiB upstream with 128, 512 and 2048 byte frames
+ *  - GETVARs at 921600 baud with the FIFO read every 1 ms (8 / 16 byte FIFO)
+ *  - GETVARs with bit errors (10^-5 / 10^-4)
+ * A lost response is treated as application timeout (20 ms after the link
+ * went quiet, the protocol is released).
+ *
+ * Build:
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=2048 -DTX_PACKET_LENGTH=2048
+ *     -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c C/Src/Buffer.c
+ *     C/Src/Helpers.c C/Benchmark/SimSlave.c C/Benchmark/SimLink.c
+ *     C/Benchmark/BenchLink.c -o BenchLink
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "SCIMaster.h"
+#include "SimSlave.h"
+#include "SimLink.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_UPS_NUM           0x20
+#define BENCH_UPS_LEN           65536u
+#define BENCH_ROUND_TRIPS       200
+#define BENCH_SETVARS           96
+#define BENCH_TIMEOUT_US        20000u
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t  ui8UpsData[BENCH_UPS_LEN];
+static bool     bDone = false;
+static uint32_t ui32Errors = 0;
+static uint32_t ui32Timeouts = 0;
+static tsSIM_LINK_STATS sStatsStart = tsSIM_LINK_STATS_DEFAULTS;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static teTRANSFER_ACK BenchGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS_DATA && eAck != eREQUEST_ACK_STATUS_SUCCESS)
+        ui32Errors++;
+
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+        ui32Errors++;
+
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    if (ui32ByteCnt != BENCH_UPS_LEN || memcmp(pui8Data, ui8UpsData, BENCH_UPS_LEN) != 0)
+        ui32Errors++;
+
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bDone = true;
+}
+
+//=============================================================================
+static void Run (void)
+{
+    while (!bDone)
+    {
+        SCIMasterSM();
+
+        // Nothing on the way while the master waits: Response lost
+        if (!SimLinkProcess() && SCIGetProtocolState() == ePROTOCOL_RECEIVING)
+        {
+            SimLinkAdvance(BENCH_TIMEOUT_US);
+            SCIReleaseProtocol();
+            ui32Timeouts++;
+            break;
+        }
+    }
+
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+    {
+        SCIMasterSM();
+        SimLinkProcess();
+    }
+
+    bDone = false;
+}
+
+//=============================================================================
+static void Connect (tsSIM_LINK_CONFIG sConfig, uint16_t ui16PacketLength)
+{
+    SimLinkInit(sConfig);
+    SimSlaveInit(ui16PacketLength, 8);
+    SimSlaveSetUpstream(BENCH_UPS_NUM, ui8UpsData, BENCH_UPS_LEN);
+    SCIRequestHandshake();
+    Run();
+
+    // The scenario starts after the handshake
+    ui32Errors = ui32Timeouts = 0;
+    sStatsStart = SimLinkGetStats();
+}
+
+//=============================================================================
+static void Report (const char *pcScenario, uint64_t ui64StartNs, uint32_t ui32Ops, const char *pcUnit, double dUnitsPerOp)
+{
+    double dSeconds = (SimLinkTimeNs() - ui64StartNs) / 1e9;
+    tsSIM_LINK_STATS sStats = SimLinkGetStats();
+
+    printf("%-34s | %10.1f | %10.1f %-6s | %6u | %6u | %7u | %7u\n", pcScenario, dSeconds * 1000.0,
+           ui32Ops * dUnitsPerOp / dSeconds, pcUnit, ui32Errors, ui32Timeouts, sStats.ui32BitErrors - sStatsStart.ui32BitErrors,
+           sStats.ui32OverrunBytes - sStatsStart.ui32OverrunBytes);
+}
+
+//=============================================================================
+static void BenchRoundTrips (const char *pcScenario, tsSIM_LINK_CONFIG sConfig, bool bSetVar)
+{
+    uint64_t ui64Start;
+
+    Connect(sConfig, 128);
+    ui64Start = SimLinkTimeNs();
+
+    for (uint32_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+    {
+        tuREQUESTVALUE uVal = {.ui32_hex = i * 0x10001u};
+
+        if (bSetVar)
+            SCIRequestSetVar((int16_t)(i % SIM_SLAVE_NUM_VARIABLES), uVal);
+        else
+            SCIRequestGetVar((int16_t)(i % SIM_SLAVE_NUM_VARIABLES));
+
+        Run();
+    }
+
+    Report(pcScenario, ui64Start, BENCH_ROUND_TRIPS, "req/s", 1.0);
+}
+
+//=============================================================================
+static void BenchSetVarBatch (const char *pcScenario, uint16_t ui16Batch)
+{
+    tsSIM_LINK_CONFIG sConfig = tsSIM_LINK_CONFIG_DEFAULTS;
+    int16_t i16Nums[SCI_SETVAR_BATCH_MAX];
+    tuREQUESTVALUE uVals[SCI_SETVAR_BATCH_MAX];
+    uint64_t ui64Start;
+
+    Connect(sConfig, 128);
+    ui64Start = SimLinkTimeNs();
+
+    for (uint32_t i = 0; i < BENCH_SETVARS; i += ui16Batch)
+    {
+        uint16_t ui16Cnt = BENCH_SETVARS - i < ui16Batch ? (uint16_t)(BENCH_SETVARS - i) : ui16Batch;
+
+        for (uint16_t j = 0; j < ui16Cnt; j++)
+        {
+            i16Nums[j] = (int16_t)(i + j);
+            uVals[j].ui32_hex = (i + j) * 0x10001u;
+        }
+
+        if (!SCIRequestSetVarBatch(i16Nums, uVals, ui16Cnt))
+        {
+            printf("  Batch request rejected!\n");
+            return;
+        }
+
+        Run();
+    }
+
+    Report(pcScenario, ui64Start, BENCH_SETVARS, "wr/s", 1.0);
+
+    for (int16_t i = 0; i < BENCH_SETVARS; i++)
+    {
+        if (SimSlaveGetVariable(i) != (uint32_t)i * 0x10001u)
+            printf("  Variable %d not written!\n", i);
+    }
+}
+
+//=============================================================================
+static void BenchUpstream (const char *pcScenario, uint16_t ui16PacketLength)
+{
+    tsSIM_LINK_CONFIG sConfig = tsSIM_LINK_CONFIG_DEFAULTS;
+    uint64_t ui64Start;
+
+    Connect(sConfig, ui16PacketLength);
+    ui64Start = SimLinkTimeNs();
+
+    SCIRequestCommand(BENCH_UPS_NUM, NULL, 0);
+    Run();
+
+    Report(pcScenario, ui64Start, 1, "KiB/s", BENCH_UPS_LEN / 1024.0);
+}
+
+//=============================================================================
+int main (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tsSIM_LINK_CONFIG sConfig = tsSIM_LINK_CONFIG_DEFAULTS;
+
+    for (uint32_t i = 0; i < BENCH_UPS_LEN; i++)
+        ui8UpsData[i] = (uint8_t)((i * 0x9E3779B1u) >> 24);
+
+    sCbs.BlockingTxExternalCB   = SimLinkTxCB;
+    sCbs.GetVarExternalCB       = BenchGetVarCB;
+    sCbs.SetVarExternalCB       = BenchSetVarCB;
+    sCbs.UpstreamExternalCB     = BenchUpstreamCB;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    printf("scenario                           |  time [ms] | throughput        | errors | timeout | bit err | overrun\n");
+
+    BenchRoundTrips("GETVAR 115200, 1 ms turnaround", sConfig, false);
+    BenchRoundTrips("SETVAR 115200, 1 ms turnaround", sConfig, true);
+
+    sConfig.ui32TurnaroundUs = 100;
+    BenchRoundTrips("GETVAR 115200, 100 us turnaround", sConfig, false);
+
+    BenchSetVarBatch("SETVAR single frames", 1);
+    BenchSetVarBatch("SETVAR batch of 2", 2);
+    BenchSetVarBatch("SETVAR batch (max.)", SCI_SETVAR_BATCH_MAX);
+
+    BenchUpstream("Upstream 64 KiB, 128 byte frames", 128);
+    BenchUpstream("Upstream 64 KiB, 512 byte frames", 512);
+    BenchUpstream("Upstream 64 KiB, 2048 byte frames", 2048);
+
+    sConfig = (tsSIM_LINK_CONFIG)tsSIM_LINK_CONFIG_DEFAULTS;
+    sConfig.ui32Baudrate = 921600;
+    sConfig.ui32PollUs = 1000;
+    sConfig.ui16FifoDepth = 16;
+    BenchRoundTrips("GETVAR 921600, 1 ms poll, FIFO 16", sConfig, false);
+    sConfig.ui16FifoDepth = 8;
+    BenchRoundTrips("GETVAR 921600, 1 ms poll, FIFO 8", sConfig, false);
+
+    sConfig = (tsSIM_LINK_CONFIG)tsSIM_LINK_CONFIG_DEFAULTS;
+    sConfig.dBitErrorRate = 1e-5;
+    BenchRoundTrips("GETVAR 115200, BER 1e-5", sConfig, false);
+    sConfig.dBitErrorRate = 1e-4;
+    BenchRoundTrips("GETVAR 115200, BER 1e-4", sConfig, false);
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/**************************************************************************//**
+ * \file BenchMetrics.c
+ * \author Roman Holderried
+ *
+ * \brief Protocol metrics of a mixed workload.
+ *
+ * GETVARs, SETVARs (some of them to unknown variables, answered by ERR) and
+ * COMMANDs returning a 4 KiB upstream are run against the simulated slave.
+ * The link runs at 115200 baud with 1 ms device turnaround per response, the
+ * time base is virtual (bytes on the wire plus turnarounds). Afterwards the
+ * metrics snapshot is printed: Counters, p50 / p99 / mean latency per request
+ * type and the time spent in each protocol state. A second snapshot checks
+ * that the first one reset the metrics.
+ *
+ * Build (the metrics are compiled in by SCI_METRICS_ENABLE):
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=512 -DTX_PACKET_LENGTH=512
+ *     -DSCI_METRICS_ENABLE=1 -I C/Inc -I C/Inc/config -I C/Benchmark
+ *     C/Src/SCI*.c C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchMetrics.c -o BenchMetrics
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "SCIMaster.h"
+#include "SCIMetrics.h"
+#include "SimSlave.h"
+
+#if !SCI_METRICS_ENABLE
+#error "Build with -DSCI_METRICS_ENABLE=1"
+#endif
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_UPS_NUM           0x20
+#define BENCH_UPS_LEN           4096u
+#define BENCH_BAUDRATE          115200u
+#define BENCH_TURNAROUND_US     1000u
+#define BENCH_GETVARS           2000
+#define BENCH_SETVARS           2000
+#define BENCH_COMMANDS          50
+#define BENCH_UNKNOWN_VAR_EVERY 100     // Every n-th SETVAR addresses an unknown variable
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t  ui8UpsData[BENCH_UPS_LEN];
+static bool     bDone = false;
+
+static const char *pcTypeNames[SCI_METRICS_NUM_TYPES] = {"NONE", "GETVAR", "SETVAR", "COMMAND", "UPSTREAM", "DOWNSTREAM", "HANDSHAKE"};
+static const char *pcStateNames[SCI_METRICS_NUM_STATES] = {"IDLE", "SENDING", "EVALUATING", "RECEIVING"};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t BenchTimeUs (void)
+{
+    tsSIM_SLAVE_STATS sStats = SimSlaveGetStats();
+    uint64_t ui64WireUs = (uint64_t)(sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10u * 1000000u / BENCH_BAUDRATE;
+
+    return (uint32_t)(ui64WireUs + (uint64_t)sStats.ui32ResponseCnt * BENCH_TURNAROUND_US);
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bDone = true;
+}
+
+//=============================================================================
+static void Run (void)
+{
+    while (!bDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+        SCIMasterSM();
+
+    bDone = false;
+}
+
+//=============================================================================
+static void PrintMetrics (const tsSCI_METRICS *psMetrics)
+{
+    uint64_t ui64TotalUs = 0;
+
+    printf("type       | requests | responses | bytes out | bytes in | ERR | NAK | parse | p50 [us] | p99 [us] | mean [us]\n");
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_TYPES; i++)
+    {
+        const tsSCI_REQUEST_METRICS *psType = &psMetrics->sTypes[i];
+
+        if (psType->ui32Requests == 0 && psType->ui32Responses == 0)
+            continue;
+
+        printf("%-10s | %8u | %9u | %9u | %8u | %3u | %3u | %5u | %8u | %8u | %9.1f\n", pcTypeNames[i],
+               psType->ui32Requests, psType->ui32Responses, psType->ui32BytesOut, psType->ui32BytesIn,
+               psType->ui32Errors, psType->ui32Naks, psType->ui32ParseErrors,
+               SCIMetricsPercentile(psType, 50), SCIMetricsPercentile(psType, 99),
+               psType->ui32Responses > 0 ? (double)psType->ui64LatencySumUs / psType->ui32Responses : 0.0);
+    }
+
+    printf("RX buffer overflows: %u\n", psMetrics->ui32RxOverflows);
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_STATES; i++)
+        ui64TotalUs += psMetrics->ui64StateUs[i];
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_STATES; i++)
+        printf("%-10s %10.1f ms (%5.1f %%)\n", pcStateNames[i], psMetrics->ui64StateUs[i] / 1000.0,
+               ui64TotalUs > 0 ? psMetrics->ui64StateUs[i] * 100.0 / ui64TotalUs : 0.0);
+}
+
+//=============================================================================
+int main (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tsSCI_METRICS sMetrics;
+
+    for (uint32_t i = 0; i < BENCH_UPS_LEN; i++)
+        ui8UpsData[i] = (uint8_t)((i * 0x9E3779B1u) >> 24);
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.GetVarExternalCB       = BenchGetVarCB;
+    sCbs.SetVarExternalCB       = BenchSetVarCB;
+    sCbs.UpstreamExternalCB     = BenchUpstreamCB;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+    SCIMetricsInit(BenchTimeUs);
+
+    SimSlaveInit(512, 1);
+    SimSlaveSetUpstream(BENCH_UPS_NUM, ui8UpsData, BENCH_UPS_LEN);
+    SCIRequestHandshake();
+    Run();
+
+    for (uint32_t i = 0; i < BENCH_GETVARS; i++)
+    {
+        SCIRequestGetVar((int16_t)(i % SIM_SLAVE_NUM_VARIABLES));
+        Run();
+    }
+
+    for (uint32_t i = 0; i < BENCH_SETVARS; i++)
+    {
+        tuREQUESTVALUE uVal = {.ui32_hex = i};
+
+        SCIRequestSetVar((int16_t)(i % BENCH_UNKNOWN_VAR_EVERY == 0 ? SIM_SLAVE_NUM_VARIABLES : i % SIM_SLAVE_NUM_VARIABLES), uVal);
+        Run();
+    }
+
+    for (uint32_t i = 0; i < BENCH_COMMANDS; i++)
+    {
+        SCIRequestCommand(BENCH_UPS_NUM, NULL, 0);
+        Run();
+    }
+
+    SCIMetricsSnapshot(&sMetrics, true);
+    PrintMetrics(&sMetrics);
+
+    // The reset must have started a new interval
+    SCIMetricsSnapshot(&sMetrics, false);
+
+    if (sMetrics.sTypes[eREQUEST_TYPE_GETVAR].ui32Requests != 0 || sMetrics.sTypes[eREQUEST_TYPE_SETVAR].ui32Responses != 0)
+    {
+        printf("Metrics not reset!\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/**************************************************************************//**
+ * \file BenchPreempt.c
+ * \author Roman Holderried
+ *
+ * \brief Latency of urgent SETVARs during a 64 KiB upstream.
+ *
+ * A 64 KiB upstream is read from the simulated slave while an urgent SETVAR
+ * is released every 97 ms. Once as a regular SETVAR (started as soon as the
+ * master is idle, i.e. after the whole upstream) and once as an urgent
+ * SETVAR, which is interleaved at the next chunk boundary of the upstream.
+ * The link runs at 115200 baud with 1 ms device turnaround per response, the
+ * time base is virtual (bytes on the wire plus turnarounds), so the results
+ * do not depend on the host. Reported are the worst case and the mean
+ * latency from the release to the response and the upstream duration.
+ *
+ * Build (master buffers configured for the largest frame):
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=512 -DTX_PACKET_LENGTH=512
+ *     -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c C/Src/Buffer.c
+ *     C/Src/Helpers.c C/Benchmark/SimSlave.c C/Benchmark/BenchPreempt.c
+ *     -o BenchPreempt
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "SCIMaster.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_UPS_NUM           0x20
+#define BENCH_UPS_LEN           65536u
+#define BENCH_BAUDRATE          115200u
+#define BENCH_TURNAROUND_US     1000u
+#define BENCH_URGENT_PERIOD_US  97000u
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t  ui8UpsData[BENCH_UPS_LEN];
+static bool     bUpsDone = false;
+static bool     bUpsValid = false;
+static bool     bHandshakeDone = false;
+
+static bool     bWritePending = false;      /*!< Released, not yet answered.*/
+static bool     bWriteStarted = false;      /*!< Passed to the master.*/
+static uint32_t ui32Release = 0;
+static uint32_t ui32Writes = 0;
+static uint32_t ui32MaxLatency = 0;
+static uint64_t ui64SumLatency = 0;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t BenchTimeUs (void)
+{
+    tsSIM_SLAVE_STATS sStats = SimSlaveGetStats();
+    uint64_t ui64WireUs = (uint64_t)(sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10u * 1000000u / BENCH_BAUDRATE;
+
+    return (uint32_t)(ui64WireUs + (uint64_t)sStats.ui32ResponseCnt * BENCH_TURNAROUND_US);
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    uint32_t ui32Latency = BenchTimeUs() - ui32Release;
+
+    if (ui32Latency > ui32MaxLatency)
+        ui32MaxLatency = ui32Latency;
+
+    ui64SumLatency += ui32Latency;
+    ui32Writes++;
+    bWritePending = false;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    bUpsValid = ui32ByteCnt == BENCH_UPS_LEN && memcmp(pui8Data, ui8UpsData, BENCH_UPS_LEN) == 0;
+    bUpsDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bHandshakeDone = true;
+}
+
+//=============================================================================
+static bool Bench (const char *pcMode, uint16_t ui16PacketLength, bool bUrgent)
+{
+    uint32_t ui32NextRelease = BENCH_URGENT_PERIOD_US;
+    uint32_t ui32Duration;
+
+    // Frame lengths are negotiated with the slave
+    SimSlaveInit(ui16PacketLength, 1);
+    SimSlaveSetUpstream(BENCH_UPS_NUM, ui8UpsData, BENCH_UPS_LEN);
+    bHandshakeDone = false;
+    SCIRequestHandshake();
+
+    while (!bHandshakeDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    SimSlaveResetStats();
+    bUpsDone = bUpsValid = false;
+    bWritePending = bWriteStarted = false;
+    ui32Writes = ui32MaxLatency = 0;
+    ui64SumLatency = 0;
+
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+        SCIMasterSM();
+
+    SCIRequestCommand(BENCH_UPS_NUM, NULL, 0);
+
+    while (!bUpsDone || bWritePending)
+    {
+        // Next write (the previous one must have been answered, releases passed meanwhile are skipped)
+        if (!bUpsDone && !bWritePending && BenchTimeUs() >= ui32NextRelease)
+        {
+            while (BenchTimeUs() - ui32NextRelease >= BENCH_URGENT_PERIOD_US)
+                ui32NextRelease += BENCH_URGENT_PERIOD_US;
+
+            ui32Release = ui32NextRelease;
+            ui32NextRelease += BENCH_URGENT_PERIOD_US;
+            bWritePending = true;
+            bWriteStarted = false;
+        }
+
+        if (bWritePending && !bWriteStarted)
+        {
+            tuREQUESTVALUE uVal = {.ui32_hex = ui32Release};
+
+            if (bUrgent)
+                bWriteStarted = SCIRequestUrgentSetVar(1, uVal);
+            else if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+                bWriteStarted = SCIRequestSetVar(1, uVal);
+        }
+
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    ui32Duration = BenchTimeUs();
+
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+        SCIMasterSM();
+
+    printf("%-7s | %6u | %6u | %16.1f | %17.1f | %15.1f\n", pcMode, ui16PacketLength, ui32Writes,
+           ui32MaxLatency / 1000.0, ui32Writes > 0 ? ui64SumLatency / 1000.0 / ui32Writes : 0.0, ui32Duration / 1000.0);
+
+    return bUpsValid && SimSlaveGetVariable(1) == ui32Release;
+}
+
+//=============================================================================
+int main (void)
+{
+    static const uint16_t ui16PacketLengths[] = {128, 512};
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    bool bValid = true;
+
+    // Raw bytes include STX / ETX values
+    for (uint32_t i = 0; i < BENCH_UPS_LEN; i++)
+        ui8UpsData[i] = (uint8_t)((i * 0x9E3779B1u) >> 24);
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.SetVarExternalCB       = BenchSetVarCB;
+    sCbs.UpstreamExternalCB     = BenchUpstreamCB;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    printf("mode    | packet | writes | max latency [ms] | mean latency [ms] | upstream [ms]\n");
+
+    for (uint8_t i = 0; i < sizeof(ui16PacketLengths) / sizeof(ui16PacketLengths[0]); i++)
+    {
+        bValid &= Bench("regular", ui16PacketLengths[i], false);
+        bValid &= Bench("urgent", ui16PacketLengths[i], true);
+    }
+
+    if (!bValid)
+    {
+        printf("Upstream data or variable mismatch!\n");
+        return 1;
+    }
+
+    return 0;
+}
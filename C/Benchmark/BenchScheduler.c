@@ -0,0 +1,236 @@
+/**************************************************************************//**
+ * \file BenchScheduler.c
+ * \author Roman Holderried
+ *
+ * \brief Simulation of the polling scheduler against the simulated slave.
+ *
+ * 20 variables are subscribed at 10 Hz, the remaining subscription slots
+ * are requested at 100 Hz (the admission control rejects those the link
+ * cannot serve). The link runs at 460800 baud with 200 us device turnaround,
+ * the time base is virtual (bytes on the wire plus turnarounds plus idle
+ * time), so the results do not depend on the host. 10 s are simulated per
+ * policy and the worst latency / jitter and the deadline misses of both rate
+ * groups are reported.
+ * Finally every 10th response of a single 10 ms subscription is dropped for
+ * 1 s, the scheduler must give those polls up after its timeout and go on
+ * polling.
+ * A configuration with a baud rate of 0 must be rejected.
+ *
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchScheduler.c -o BenchScheduler
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "SCIMaster.h"
+#include "SCIScheduler.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_BAUDRATE          460800
+#define BENCH_TURNAROUND_US     200
+#define BENCH_IDLE_STEP_US      20
+#define BENCH_DURATION_US       10000000u
+#define BENCH_NUM_SLOW          20
+#define BENCH_SLOW_PERIOD_US    100000
+#define BENCH_FAST_PERIOD_US    10000
+#define BENCH_LOSS_DURATION_US  1000000u
+#define BENCH_LOSS_INTERVAL     10
+#define BENCH_LOSS_TIMEOUT_US   2000
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint64_t ui64IdleUs = 0;
+static uint32_t ui32Samples = 0;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t BenchTimeUs (void)
+{
+    tsSIM_SLAVE_STATS sStats = SimSlaveGetStats();
+    uint64_t ui64WireUs = (uint64_t)(sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10u * 1000000u / BENCH_BAUDRATE;
+
+    return (uint32_t)(ui64IdleUs + ui64WireUs + (uint64_t)sStats.ui32ResponseCnt * BENCH_TURNAROUND_US);
+}
+
+//=============================================================================
+static void BenchSampleCB (const tsSCI_SCHED_SAMPLE *psSample)
+{
+    ui32Samples++;
+}
+
+//=============================================================================
+static void Bench (teSCI_SCHED_POLICY ePolicy, const char *pcPolicy)
+{
+    tsSCI_SCHED_CONFIG sConfig = tsSCI_SCHED_CONFIG_DEFAULTS;
+    uint8_t ui8Handles[SCI_SCHED_NUM_SUBSCRIPTIONS];
+    uint8_t ui8NumSubs = 0;
+    uint8_t ui8Handle;
+    uint8_t ui8Rejected = 0;
+
+    SimSlaveInit(TX_PACKET_LENGTH, 1);
+    SimSlaveResetStats();
+    ui64IdleUs = 0;
+    ui32Samples = 0;
+
+    sConfig.ePolicy             = ePolicy;
+    sConfig.ui32Baudrate        = BENCH_BAUDRATE;
+    sConfig.ui32TurnaroundUs    = BENCH_TURNAROUND_US;
+    sConfig.GetTimeUsCB         = BenchTimeUs;
+    sConfig.SampleCB            = BenchSampleCB;
+    SCISchedulerInit(sConfig);
+
+    // Priorities by rate (rate monotonic for the fixed priority policy)
+    for (uint8_t i = 0; i < BENCH_NUM_SLOW; i++)
+    {
+        if (SCISchedulerSubscribe(i, BENCH_SLOW_PERIOD_US, 1, &ui8Handle))
+            ui8Handles[ui8NumSubs++] = ui8Handle;
+    }
+
+    for (uint8_t i = 0; i < SCI_SCHED_NUM_SUBSCRIPTIONS - BENCH_NUM_SLOW; i++)
+    {
+        if (SCISchedulerSubscribe(BENCH_NUM_SLOW + i, BENCH_FAST_PERIOD_US, 0, &ui8Handle))
+            ui8Handles[ui8NumSubs++] = ui8Handle;
+        else
+            ui8Rejected++;
+    }
+
+    while (BenchTimeUs() < BENCH_DURATION_US)
+    {
+        SCISchedulerProcess();
+
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+            ui64IdleUs += BENCH_IDLE_STEP_US;
+
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    printf("%s: %u subscriptions (%u fast rejected), poll %u us, utilization %u permille, %u samples\n",
+           pcPolicy, ui8NumSubs, ui8Rejected, SCISchedulerPollCost(), SCISchedulerGetUtilization(), ui32Samples);
+    printf("period [ms] | subs | samples | misses | max latency [us] | max jitter [us]\n");
+
+    for (uint8_t ui8Fast = 0; ui8Fast < 2; ui8Fast++)
+    {
+        uint32_t ui32Cnt = 0, ui32SubSamples = 0, ui32Misses = 0, ui32Latency = 0, ui32Jitter = 0;
+
+        for (uint8_t i = 0; i < ui8NumSubs; i++)
+        {
+            tsSCI_SCHED_STATS sStats = SCISchedulerGetStats(ui8Handles[i]);
+
+            if ((i >= BENCH_NUM_SLOW) != ui8Fast)
+                continue;
+
+            ui32Cnt++;
+            ui32SubSamples += sStats.ui32Samples;
+            ui32Misses += sStats.ui32Misses;
+            if (sStats.ui32MaxLatency > ui32Latency)
+                ui32Latency = sStats.ui32MaxLatency;
+            if (sStats.ui32MaxJitter > ui32Jitter)
+                ui32Jitter = sStats.ui32MaxJitter;
+        }
+
+        printf("%11u | %4u | %7u | %6u | %16u | %15u\n", (ui8Fast ? BENCH_FAST_PERIOD_US : BENCH_SLOW_PERIOD_US) / 1000,
+               ui32Cnt, ui32SubSamples, ui32Misses, ui32Latency, ui32Jitter);
+    }
+}
+
+//=============================================================================
+static void BenchLostResponses (void)
+{
+    tsSCI_SCHED_CONFIG sConfig = tsSCI_SCHED_CONFIG_DEFAULTS;
+    tsSCI_SCHED_STATS sStats;
+    const uint8_t *pui8Rsp;
+    uint16_t ui16RspLen;
+    uint32_t ui32Dropped = 0;
+    uint8_t ui8Handle;
+    bool bLost = false;
+
+    SimSlaveInit(TX_PACKET_LENGTH, 1);
+    SimSlaveResetStats();
+    ui64IdleUs = 0;
+    ui32Samples = 0;
+
+    sConfig.ui32Baudrate        = BENCH_BAUDRATE;
+    sConfig.ui32TurnaroundUs    = BENCH_TURNAROUND_US;
+    sConfig.ui32TimeoutUs       = BENCH_LOSS_TIMEOUT_US;
+    sConfig.GetTimeUsCB         = BenchTimeUs;
+    sConfig.SampleCB            = BenchSampleCB;
+    SCISchedulerInit(sConfig);
+    SCISchedulerSubscribe(0, BENCH_FAST_PERIOD_US, 0, &ui8Handle);
+
+    while (BenchTimeUs() < BENCH_LOSS_DURATION_US)
+    {
+        SCISchedulerProcess();
+
+        // Time passes while the master waits for a lost response
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+            bLost = false;
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE || bLost)
+            ui64IdleUs += BENCH_IDLE_STEP_US;
+
+        SCIMasterSM();
+
+        if (!bLost && (SimSlaveGetStats().ui32RequestCnt % BENCH_LOSS_INTERVAL) == 0 &&
+            SimSlaveTakeResponse(&pui8Rsp, &ui16RspLen))
+        {
+            bLost = true;
+            ui32Dropped++;
+        }
+        else
+            SimSlaveProcess();
+    }
+
+    sStats = SCISchedulerGetStats(ui8Handle);
+
+    printf("Lost responses: %u dropped, %u samples, %u errors, %u misses\n",
+           ui32Dropped, sStats.ui32Samples, sStats.ui32Errors, sStats.ui32Misses);
+
+    if (sStats.ui32Errors != ui32Dropped || sStats.ui32Samples < (BENCH_LOSS_DURATION_US / BENCH_FAST_PERIOD_US) * 8 / 10)
+        printf("FAIL: The scheduler did not recover from lost responses\n");
+}
+
+//=============================================================================
+static void BenchZeroBaudrate (void)
+{
+    tsSCI_SCHED_CONFIG sConfig = tsSCI_SCHED_CONFIG_DEFAULTS;
+    uint8_t ui8Handle;
+
+    sConfig.ui32Baudrate        = 0;
+    sConfig.GetTimeUsCB         = BenchTimeUs;
+
+    if (SCISchedulerInit(sConfig) || SCISchedulerPollCost() != 0 ||
+        SCISchedulerSubscribe(0, BENCH_FAST_PERIOD_US, 0, &ui8Handle))
+        printf("FAIL: A baud rate of 0 was accepted\n");
+}
+
+//=============================================================================
+int main (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.GetVarExternalCB       = SCISchedulerGetVarCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    Bench(eSCI_SCHED_POLICY_EDF, "EDF");
+    Bench(eSCI_SCHED_POLICY_FIXED, "Fixed priority");
+    BenchLostResponses();
+    BenchZeroBaudrate();
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**************************************************************************//**
+ * \file BenchTrace.c
+ * \author Roman Holderried
+ *
+ * \brief Overhead of the frame trace.
+ *
+ * GETVAR round trips and a 64 KiB upstream (512 byte frames) are run against
+ * the simulated slave with the trace recording and paused. The additional
+ * master CPU time per frame is compared to the time of the frames on a
+ * 2 Mbaud link (10 bit per byte). If a file name is passed, the trace of the
+ * last run is exported as pcapng (decode with Python/SCITrace.py).
+ *
+ * Build (the trace is compiled in by SCI_TRACE_NUM_RECORDS):
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=512 -DTX_PACKET_LENGTH=512
+ *     -DSCI_TRACE_NUM_RECORDS=1024 -I C/Inc -I C/Inc/config -I C/Benchmark
+ *     C/Src/SCI*.c C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchTrace.c -o BenchTrace
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "SCIMaster.h"
+#include "SCITrace.h"
+#include "SimSlave.h"
+
+#if SCI_TRACE_NUM_RECORDS == 0
+#error "Build with -DSCI_TRACE_NUM_RECORDS=<records>"
+#endif
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_UPS_NUM           0x20
+#define BENCH_UPS_LEN           65536u
+#define BENCH_BAUDRATE          2000000.0
+#define BENCH_GETVARS           20000
+#define BENCH_UPSTREAMS         20
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t  ui8UpsData[BENCH_UPS_LEN];
+static bool     bDone = false;
+static FILE     *pFile = NULL;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t BenchTimeUs (void)
+{
+    return (uint32_t)((uint64_t)clock() * 1000000u / CLOCKS_PER_SEC);
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    bDone = true;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bDone = true;
+}
+
+//=============================================================================
+static void BenchWriteCB (const uint8_t *pui8Data, uint16_t ui16Len)
+{
+    fwrite(pui8Data, 1, ui16Len, pFile);
+}
+
+//=============================================================================
+static void Run (void)
+{
+    while (!bDone)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+        SCIMasterSM();
+
+    bDone = false;
+}
+
+//=============================================================================
+static void RunGetVars (void)
+{
+    for (uint32_t i = 0; i < BENCH_GETVARS; i++)
+    {
+        SCIRequestGetVar((int16_t)(i % SIM_SLAVE_NUM_VARIABLES));
+        Run();
+    }
+}
+
+//=============================================================================
+static void RunUpstreams (void)
+{
+    for (uint32_t i = 0; i < BENCH_UPSTREAMS; i++)
+    {
+        SCIRequestCommand(BENCH_UPS_NUM, NULL, 0);
+        Run();
+    }
+}
+
+//=============================================================================
+static void Bench (const char *pcMode, void (*Transfer)(void))
+{
+    double dCpu_us[2];
+    double dWire_us;
+    tsSIM_SLAVE_STATS sStats;
+
+    // Paused first, then recording
+    for (uint8_t ui8Trace = 0; ui8Trace < 2; ui8Trace++)
+    {
+        clock_t t0;
+
+        SCITraceEnable(ui8Trace != 0);
+        SimSlaveResetStats();
+
+        t0 = clock();
+        Transfer();
+        dCpu_us[ui8Trace] = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e6;
+    }
+
+    sStats = SimSlaveGetStats();
+    dWire_us = (sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10.0 / BENCH_BAUDRATE * 1e6;
+
+    printf("%-7s | %6u | %14.3f | %13.3f | %15.3f | %16.2f\n", pcMode, sStats.ui32RequestCnt + sStats.ui32ResponseCnt,
+           dCpu_us[0] / (sStats.ui32RequestCnt + sStats.ui32ResponseCnt), dCpu_us[1] / (sStats.ui32RequestCnt + sStats.ui32ResponseCnt),
+           (dCpu_us[1] - dCpu_us[0]) / (sStats.ui32RequestCnt + sStats.ui32ResponseCnt), (dCpu_us[1] - dCpu_us[0]) / dWire_us * 100.0);
+}
+
+//=============================================================================
+int main (int argc, char **argv)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+
+    for (uint32_t i = 0; i < BENCH_UPS_LEN; i++)
+        ui8UpsData[i] = (uint8_t)((i * 0x9E3779B1u) >> 24);
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.GetVarExternalCB       = BenchGetVarCB;
+    sCbs.UpstreamExternalCB     = BenchUpstreamCB;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+    SCITraceInit(BenchTimeUs);
+
+    SimSlaveInit(512, 1);
+    SimSlaveSetUpstream(BENCH_UPS_NUM, ui8UpsData, BENCH_UPS_LEN);
+    SCIRequestHandshake();
+    Run();
+
+    printf("mode    | frames | cpu paused [us] | cpu traced [us] | trace [us/frame] | of 2 Mbaud [%%]\n");
+    Bench("GETVAR", RunGetVars);
+    Bench("UPS 64k", RunUpstreams);
+
+    if (argc > 1)
+    {
+        pFile = fopen(argv[1], "wb");
+
+        if (pFile == NULL)
+            return 1;
+
+        printf("%u frames exported to %s\n", SCITraceExport(BenchWriteCB), argv[1]);
+        fclose(pFile);
+    }
+
+    return 0;
+}
@@ -0,0 +1,375 @@
+/**************************************************************************//**
+ * \file BenchValueMode.c
+ * \author Roman Holderried
+ *
+ * \brief Request building / response parsing cost per value mode.
+ * 
+ * Builds a COMMAND request with 10 values and parses a DAT response with 10
+ * values in both number formats, using the value codec dispatch of the 
+ * dataframe layer. Prints the CPU time per frame.
+ * 
+ * With BENCH_COMPILE_TIME_MODE, the former compile-time variant is measured
+ * instead for comparison: A copy of the builder / parser before the runtime
+ * selection, calling the conversion functions of the format selected by
+ * VALUE_MODE_HEX directly.
+ * 
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config C/Src/SCI*.c C/Src/Buffer.c
+ *     C/Src/Helpers.c C/Benchmark/BenchValueMode.c -o BenchValueMode
+ * 
+ * Former compile-time variant (HEX, omit -DVALUE_MODE_HEX for FLOAT):
+ * gcc -std=c99 -O2 -DBENCH_COMPILE_TIME_MODE -DVALUE_MODE_HEX -I C/Inc
+ *     -I C/Inc/config C/Src/SCI*.c C/Src/Buffer.c C/Src/Helpers.c
+ *     C/Benchmark/BenchValueMode.c -o BenchValueModeFixed
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "SCIDataframe.h"
+#include "Helpers.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_ITERATIONS    1000000
+#define BENCH_RUNS          3
+#define BENCH_NUM_VALUES    10
+
+#ifdef BENCH_COMPILE_TIME_MODE
+#define BENCH_VARIANT       "compile-time"
+#else
+#define BENCH_VARIANT       "codec"
+#endif
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+#ifdef BENCH_COMPILE_TIME_MODE
+static const uint8_t cmdIdArr[7] = {'#', '?', '!', ':', '>', '<', '%'};
+#endif
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+#ifdef BENCH_COMPILE_TIME_MODE
+__attribute__((noinline)) static teSCI_ERROR FixedRequestBuilder (uint8_t *pui8Buf, uint16_t *pui16Size, uint16_t ui16MaxSize, tsREQUEST sReq)
+{
+    uint8_t ui8AsciiSize;
+    uint8_t ui8DatBuf[30]   = {0};
+    uint16_t ui16DataCnt    = 0;
+
+    // Convert variable number to ASCII
+    #ifdef VALUE_MODE_HEX
+    *pui16Size = (uint8_t)hexToStrWord(pui8Buf, (uint16_t*)&sReq.i16Num, true);
+    #else
+    *pui16Size = ftoa(pui8Buf, (float)sReq.i16Num, true);
+    #endif
+
+    // Increase Buffer index and write request type identifier
+    pui8Buf += *pui16Size;
+    *pui8Buf++ = cmdIdArr[sReq.eReqType];
+    (*pui16Size)++;
+
+    for(uint16_t i = 0; i < sReq.ui16ValArrLen; i++)
+    {
+        if (i >= MAX_NUM_REQUEST_VALUES)
+            break;
+
+        #ifdef VALUE_MODE_HEX
+        ui8AsciiSize = (uint8_t)hexToStrDword(ui8DatBuf, &sReq.uValArr[i].ui32_hex, true);
+        #else
+        ui8AsciiSize = ftoa(ui8DatBuf, sReq.uValArr[i].f_float, true);
+        #endif
+
+        if((*pui16Size + ui8AsciiSize) < ui16MaxSize)
+        {
+            memcpy(pui8Buf, ui8DatBuf, ui8AsciiSize);
+            pui8Buf += ui8AsciiSize;
+            (*pui16Size) += ui8AsciiSize;
+            ui16DataCnt++;
+
+            if (ui16DataCnt < sReq.ui16ValArrLen)
+            {
+                *pui8Buf++ = ',';
+                (*pui16Size)++;
+            }
+            else
+                break;
+        }
+        else
+        {
+            // Ignore the last comma
+            (*pui16Size)--;
+
+            return eSCI_ERROR_MESSAGE_EXCEEDS_TX_BUFFER_SIZE;
+        }
+    }
+
+    return eSCI_ERROR_NONE;
+}
+
+//=============================================================================
+__attribute__((noinline)) static teSCI_ERROR FixedResponseParser (uint8_t* pui8Buf, uint16_t ui16DataframeLen, tsRESPONSE *psRsp)
+{
+    uint16_t i = 0;
+    int8_t i8Ack;
+    int32_t i32BytesToGo = (int32_t)ui16DataframeLen;
+    psRsp->pui8Raw = pui8Buf;
+
+    for (; i < i32BytesToGo; i++)
+    {
+        if (pui8Buf[i] == GETVAR_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_GETVAR;
+            break;
+        }
+        else if (pui8Buf[i] == SETVAR_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_SETVAR;
+            break;
+        }
+        else if (pui8Buf[i] == COMMAND_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_COMMAND;
+            break;
+        }
+        else if (pui8Buf[i] == UPSTREAM_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_UPSTREAM;
+            break;
+        }
+        else if (pui8Buf[i] == DOWNSTREAM_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_DOWNSTREAM;
+            break;
+        }
+    }
+
+    if (psRsp->eReqType == eREQUEST_TYPE_NONE)
+        return eSCI_ERROR_COMMAND_IDENTIFIER_NOT_FOUND;
+
+    // Variable number conversion
+    {
+        uint8_t *pui8NumStr = (uint8_t*)malloc(i+1);
+
+        memcpy(pui8NumStr,pui8Buf,i);
+        pui8NumStr[i] = '\0';
+        #ifdef VALUE_MODE_HEX
+        uint32_t ui32_tmp;
+        if(!strToHex(pui8NumStr, &ui32_tmp))
+           return eSCI_ERROR_NUMBER_CONVERSION_FAILED; 
+        psRsp->i16Num = (int16_t)(uint16_t)ui32_tmp;
+        #else
+        psRsp->i16Num = (int16_t)(atoi((char*)pui8NumStr));
+        #endif
+
+        free(pui8NumStr);
+    }
+
+    i++;
+    i32BytesToGo -= i;
+
+    i8Ack = _CheckAcknowledge(&pui8Buf[i], i32BytesToGo);
+
+    if (i8Ack >= 0)
+    {
+        psRsp->eReqAck = (teREQUEST_ACKNOWLEDGE)i8Ack;
+        i += 4;
+        i32BytesToGo -= 4;
+    }
+
+    if (i32BytesToGo <= 0)
+        return eSCI_ERROR_NONE;
+
+    if (i8Ack >= 0)
+    {
+        uint16_t j = 0;
+        tuREQUESTVALUE uNum = {.ui32_hex = 0};
+        uint8_t *pui8NumStr;
+
+        while (j < i32BytesToGo)
+        {
+            if (pui8Buf[j + i] == ';')
+                break;
+
+            j++;
+        }
+
+        pui8NumStr = (uint8_t*)malloc(j+1);
+        memcpy(pui8NumStr,&pui8Buf[i],j);
+        pui8NumStr[j] = '\0';
+
+        #ifdef VALUE_MODE_HEX
+        if(!strToHex(pui8NumStr, &uNum.ui32_hex))
+            return eSCI_ERROR_PARAMETER_CONVERSION_FAILED; 
+        #else
+        uNum.f_float = atof((char*)pui8NumStr);
+        #endif
+
+        free(pui8NumStr);
+
+        switch (psRsp->eReqAck)
+        {
+            case eREQUEST_ACK_STATUS_SUCCESS_DATA:
+            case eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM:
+                #ifdef VALUE_MODE_HEX
+                psRsp->ui32DataLength = uNum.ui32_hex;
+                #else
+                psRsp->ui32DataLength = uNum.f_float;
+                #endif
+                break;
+
+            case eREQUEST_ACK_STATUS_ERROR:
+                #ifdef VALUE_MODE_HEX
+                psRsp->ui16ErrNum = uNum.ui32_hex;
+                #else
+                psRsp->ui16ErrNum = uNum.f_float;
+                #endif
+                break;
+
+            default:
+                if (psRsp->eReqType == eREQUEST_TYPE_GETVAR)
+                    psRsp->uValArr[0] = uNum;
+                break;
+        }
+
+        i += (j + 1);
+        i32BytesToGo -= (j + 1);
+    }
+    else
+        psRsp->eReqAck = eREQUEST_ACK_STATUS_SUCCESS_DATA;
+
+    // Comma separated values
+    if (i32BytesToGo > 0)
+    {
+        uint16_t j = 0;
+        uint16_t ui16_numOfVals = 0;
+        uint16_t ui16_valueLen = 0;
+        uint8_t *p_valStr = NULL;
+
+        while (ui16_numOfVals < MAX_NUM_RESPONSE_VALUES)
+        {
+            ui16_numOfVals++;
+
+            while (j < i32BytesToGo)
+            {
+                if (pui8Buf[i + j] == ',')
+                    break;
+
+                j++;
+                ui16_valueLen++;
+            }
+
+            p_valStr = (uint8_t*)malloc(ui16_valueLen + 1);
+            memcpy(p_valStr, &pui8Buf[i + j - ui16_valueLen], ui16_valueLen);
+            p_valStr[ui16_valueLen] = '\0';
+
+            #ifdef VALUE_MODE_HEX
+            if(!strToHex(p_valStr, &psRsp->uValArr[ui16_numOfVals - 1].ui32_hex))
+                return eSCI_ERROR_PARAMETER_CONVERSION_FAILED;
+            #else
+            psRsp->uValArr[ui16_numOfVals - 1].f_float = atof((char*)p_valStr);
+            #endif
+
+            free(p_valStr);
+
+            if (j == i32BytesToGo)
+                break;
+
+            ui16_valueLen = 0;
+            j++;
+        }
+        psRsp->ui16ResponseDataLength = ui16_numOfVals;
+    }
+
+    return eSCI_ERROR_NONE;
+}
+#endif
+
+//=============================================================================
+static void Bench (const tsSCI_VALUE_CODEC *psCodec, const char *pcRsp, tuREQUESTVALUE *puVals)
+{
+    tsREQUEST sReq = tsREQUEST_DEFAULTS;
+    uint8_t ui8TxBuf[TX_PACKET_LENGTH];
+    uint8_t ui8RxBuf[RX_PACKET_LENGTH];
+    uint16_t ui16Size;
+    uint16_t ui16RspLen = (uint16_t)strlen(pcRsp);
+    volatile uint32_t ui32Sink = 0;
+
+    sReq.i16Num         = 31;
+    sReq.eReqType       = eREQUEST_TYPE_COMMAND;
+    sReq.uValArr        = puVals;
+    sReq.ui16ValArrLen  = BENCH_NUM_VALUES;
+
+    for (uint8_t ui8Run = 0; ui8Run < BENCH_RUNS; ui8Run++)
+    {
+        clock_t t0 = clock();
+        double dBuild_ns, dParse_ns;
+
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            #ifdef BENCH_COMPILE_TIME_MODE
+            FixedRequestBuilder(ui8TxBuf, &ui16Size, TX_PACKET_LENGTH, sReq);
+            #else
+            SCIMasterRequestBuilder(ui8TxBuf, &ui16Size, TX_PACKET_LENGTH, sReq, psCodec);
+            #endif
+            ui32Sink += ui16Size;
+        }
+        dBuild_ns = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e9 / BENCH_ITERATIONS;
+
+        t0 = clock();
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            tsRESPONSE sRsp = tsRESPONSE_DEFAULTS;
+            memcpy(ui8RxBuf, pcRsp, ui16RspLen);
+            #ifdef BENCH_COMPILE_TIME_MODE
+            FixedResponseParser(ui8RxBuf, ui16RspLen, &sRsp);
+            #else
+            SCIMasterResponseParser(ui8RxBuf, ui16RspLen, &sRsp, psCodec);
+            #endif
+            ui32Sink += sRsp.uValArr[BENCH_NUM_VALUES - 1].ui32_hex;
+        }
+        dParse_ns = (double)(clock() - t0) / CLOCKS_PER_SEC * 1e9 / BENCH_ITERATIONS;
+
+        printf("%-5s | %-12s | build %7.1f ns | parse %7.1f ns\n", 
+               psCodec->eMode == eSCI_VALUE_MODE_HEX ? "HEX" : "FLOAT", BENCH_VARIANT, dBuild_ns, dParse_ns);
+    }
+}
+
+//=============================================================================
+int main (void)
+{
+    tuREQUESTVALUE uHexVals[BENCH_NUM_VALUES];
+    tuREQUESTVALUE uFloatVals[BENCH_NUM_VALUES];
+
+    for (uint8_t i = 0; i < BENCH_NUM_VALUES; i++)
+    {
+        uHexVals[i].ui32_hex = 0x12345u * (i + 1) * 7919u;
+        uFloatVals[i].f_float = 1.25f * (i + 1) - 3.0f;
+    }
+
+    (void)uHexVals;
+    (void)uFloatVals;
+
+    #if !defined(BENCH_COMPILE_TIME_MODE) || defined(VALUE_MODE_HEX)
+    Bench(SCIGetValueCodec(eSCI_VALUE_MODE_HEX), 
+          "1F:DAT;A;3B9ACA07,12345678,FEDCBA98,1,22,333,4444,55555,666666,7777777", uHexVals);
+    #endif
+    #if !defined(BENCH_COMPILE_TIME_MODE) || !defined(VALUE_MODE_HEX)
+    Bench(SCIGetValueCodec(eSCI_VALUE_MODE_FLOAT), 
+          "31:DAT;10;1.5,-2.25,1000,0.125,33.5,-7,12345.5,0.001,42,99.75", uFloatVals);
+    #endif
+
+    return 0;
+}
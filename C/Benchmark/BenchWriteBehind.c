@@ -0,0 +1,307 @@
+/**************************************************************************//**
+ * \file BenchWriteBehind.c
+ * \author Roman Holderried
+ *
+ * \brief Simulation of a setpoint generator writing faster than the link.
+ *
+ * 8 setpoints are written every 1 ms over a 115200 baud link with 1 ms device
+ * turnaround for 2 s. Each written value is its write time, so the age of 
+ * the values applied by the simulated slave is known. Compared are a queue 
+ * of plain SETVARs, the write-behind buffer with single SETVARs and the 
+ * write-behind buffer with SETVAR batch frames (after a handshake). The time
+ * base is virtual (bytes on the wire plus turnarounds plus idle time).
+ * Finally every 10th response of the write-behind buffer is dropped for 1 s,
+ * it must give those frames up after its timeout and go on writing. The
+ * slave must hold the last written values afterwards.
+ *
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/BenchWriteBehind.c -o BenchWriteBehind
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "SCIMaster.h"
+#include "SCIWriteBehind.h"
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define BENCH_BAUDRATE          115200
+#define BENCH_TURNAROUND_US     1000
+#define BENCH_IDLE_STEP_US      20
+#define BENCH_DURATION_US       2000000u
+#define BENCH_TICK_US           1000
+#define BENCH_NUM_SETPOINTS     8
+#define BENCH_QUEUE_LENGTH      32768
+#define BENCH_LOSS_DURATION_US  1000000u
+#define BENCH_LOSS_INTERVAL     10
+#define BENCH_LOSS_TIMEOUT_US   5000
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint64_t ui64IdleUs = 0;
+static bool bQueueBusy = false;
+static bool bHandshakeDone = false;
+static uint32_t ui32Failed = 0;
+
+static struct
+{
+    int16_t         i16Num[BENCH_QUEUE_LENGTH];
+    tuREQUESTVALUE  uVal[BENCH_QUEUE_LENGTH];
+    uint32_t        ui32Head;
+    uint32_t        ui32Tail;
+}sQueue;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t BenchTimeUs (void)
+{
+    tsSIM_SLAVE_STATS sStats = SimSlaveGetStats();
+    uint64_t ui64WireUs = (uint64_t)(sStats.ui32RxByteCnt + sStats.ui32TxByteCnt) * 10u * 1000000u / BENCH_BAUDRATE;
+
+    return (uint32_t)(ui64IdleUs + ui64WireUs + (uint64_t)sStats.ui32ResponseCnt * BENCH_TURNAROUND_US);
+}
+
+//=============================================================================
+static teTRANSFER_ACK BenchQueueSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    bQueueBusy = false;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void BenchHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    bHandshakeDone = true;
+}
+
+//=============================================================================
+static void QueueWrite (int16_t i16Num, tuREQUESTVALUE uVal)
+{
+    sQueue.i16Num[sQueue.ui32Tail % BENCH_QUEUE_LENGTH] = i16Num;
+    sQueue.uVal[sQueue.ui32Tail % BENCH_QUEUE_LENGTH] = uVal;
+    sQueue.ui32Tail++;
+}
+
+//=============================================================================
+static void QueueProcess (void)
+{
+    if (bQueueBusy || sQueue.ui32Head == sQueue.ui32Tail || SCIGetProtocolState() != ePROTOCOL_IDLE)
+        return;
+
+    if (SCIRequestSetVar(sQueue.i16Num[sQueue.ui32Head % BENCH_QUEUE_LENGTH], sQueue.uVal[sQueue.ui32Head % BENCH_QUEUE_LENGTH]))
+    {
+        sQueue.ui32Head++;
+        bQueueBusy = true;
+    }
+}
+
+//=============================================================================
+static void Bench (const char *pcMode, bool bWriteBehind, bool bBatch)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tsSCI_WB_CONFIG sConfig = tsSCI_WB_CONFIG_DEFAULTS;
+    tsSCI_WB_STATS sStats;
+    uint32_t ui32NextTick = 0;
+    uint32_t ui32MaxAge = 0;
+    uint32_t ui32Writes = 0;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.SetVarExternalCB       = bWriteBehind ? SCIWriteBehindSetVarCB : BenchQueueSetVarCB;
+    sCbs.HandshakeExternalCB    = BenchHandshakeCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+    SCIWriteBehindInit(sConfig);
+    SimSlaveInit(TX_PACKET_LENGTH, 1);
+
+    if (bBatch)
+    {
+        bHandshakeDone = false;
+        SCIRequestHandshake();
+
+        while (!bHandshakeDone)
+        {
+            SCIMasterSM();
+            SimSlaveProcess();
+        }
+    }
+
+    SimSlaveResetStats();
+    ui64IdleUs = 0;
+    sQueue.ui32Head = sQueue.ui32Tail = 0;
+    bQueueBusy = false;
+
+    for (int16_t i = 0; i < BENCH_NUM_SETPOINTS; i++)
+        SimSlaveSetVariable(i, 0);
+
+    while (BenchTimeUs() < BENCH_DURATION_US)
+    {
+        uint32_t ui32Now = BenchTimeUs();
+
+        // Setpoint generator: The value is the write time
+        while (ui32NextTick <= ui32Now)
+        {
+            for (int16_t i = 0; i < BENCH_NUM_SETPOINTS; i++)
+            {
+                tuREQUESTVALUE uVal = {.ui32_hex = ui32NextTick};
+
+                if (bWriteBehind)
+                    SCIWriteBehindWrite(i, uVal);
+                else
+                    QueueWrite(i, uVal);
+
+                ui32Writes++;
+            }
+
+            ui32NextTick += BENCH_TICK_US;
+        }
+
+        if (bWriteBehind)
+            SCIWriteBehindProcess();
+        else
+            QueueProcess();
+
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+            ui64IdleUs += BENCH_IDLE_STEP_US;
+
+        SCIMasterSM();
+
+        // Age of the applied setpoints
+        if (SimSlaveProcess())
+        {
+            ui32Now = BenchTimeUs();
+
+            for (int16_t i = 0; i < BENCH_NUM_SETPOINTS; i++)
+            {
+                uint32_t ui32Age = ui32Now - SimSlaveGetVariable(i);
+
+                if (SimSlaveGetVariable(i) > 0 && ui32Age > ui32MaxAge)
+                    ui32MaxAge = ui32Age;
+            }
+        }
+    }
+
+    // Finish the request in flight
+    while (SCIGetProtocolState() != ePROTOCOL_IDLE)
+    {
+        SCIMasterSM();
+        SimSlaveProcess();
+    }
+
+    sStats = SCIWriteBehindGetStats();
+
+    printf("%-22s | %6u | %6u | %9u | %7u | %12.1f\n", pcMode, ui32Writes, 
+           bWriteBehind ? sStats.ui32Frames : sQueue.ui32Head, bWriteBehind ? sStats.ui32Coalesced : 0,
+           bWriteBehind ? sStats.ui32Batched : 0, ui32MaxAge / 1000.0);
+}
+
+//=============================================================================
+static void BenchLostResponses (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tsSCI_WB_CONFIG sConfig = tsSCI_WB_CONFIG_DEFAULTS;
+    tsSCI_WB_STATS sStats;
+    const uint8_t *pui8Rsp;
+    uint16_t ui16RspLen;
+    uint32_t ui32NextTick = 0;
+    uint32_t ui32LastValue = 0;
+    uint32_t ui32Dropped = 0;
+    uint32_t ui32LostRequest = 0;
+    bool bLost = false;
+
+    sCbs.BlockingTxExternalCB   = SimSlaveTxCB;
+    sCbs.SetVarExternalCB       = SCIWriteBehindSetVarCB;
+    SCIMasterInit(sCbs, eSCI_VALUE_MODE_HEX);
+
+    sConfig.GetTimeCB   = BenchTimeUs;
+    sConfig.ui32Timeout = BENCH_LOSS_TIMEOUT_US;
+    SCIWriteBehindInit(sConfig);
+    SimSlaveInit(TX_PACKET_LENGTH, 1);
+    SimSlaveResetStats();
+    ui64IdleUs = 0;
+
+    for (int16_t i = 0; i < BENCH_NUM_SETPOINTS; i++)
+        SimSlaveSetVariable(i, 0);
+
+    // Writes stop after the loss period, the buffer is drained without losses then
+    while (BenchTimeUs() < BENCH_LOSS_DURATION_US || !SCIWriteBehindIsEmpty() || SCIGetProtocolState() != ePROTOCOL_IDLE)
+    {
+        while (ui32NextTick <= BenchTimeUs() && ui32NextTick < BENCH_LOSS_DURATION_US)
+        {
+            for (int16_t i = 0; i < BENCH_NUM_SETPOINTS; i++)
+            {
+                tuREQUESTVALUE uVal = {.ui32_hex = ui32NextTick};
+
+                SCIWriteBehindWrite(i, uVal);
+            }
+
+            ui32LastValue = ui32NextTick;
+            ui32NextTick += BENCH_TICK_US;
+        }
+
+        SCIWriteBehindProcess();
+
+        // Time passes while the master waits for a lost response (the frame is sent again right after it has been given up)
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE || SimSlaveGetStats().ui32RequestCnt != ui32LostRequest)
+            bLost = false;
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE || bLost)
+            ui64IdleUs += BENCH_IDLE_STEP_US;
+
+        SCIMasterSM();
+
+        if (BenchTimeUs() < BENCH_LOSS_DURATION_US && !bLost && (SimSlaveGetStats().ui32RequestCnt % BENCH_LOSS_INTERVAL) == 0 &&
+            SimSlaveTakeResponse(&pui8Rsp, &ui16RspLen))
+        {
+            bLost = true;
+            ui32LostRequest = SimSlaveGetStats().ui32RequestCnt;
+            ui32Dropped++;
+        }
+        else
+            SimSlaveProcess();
+    }
+
+    sStats = SCIWriteBehindGetStats();
+
+    printf("\nLost responses: %u dropped, %u frames, %u given up\n", ui32Dropped, sStats.ui32Frames, sStats.ui32Aborts);
+
+    for (int16_t i = 0; i < BENCH_NUM_SETPOINTS; i++)
+    {
+        if (SimSlaveGetVariable(i) != ui32LastValue)
+        {
+            printf("FAIL: Setpoint %d holds %u instead of %u\n", i, SimSlaveGetVariable(i), ui32LastValue);
+            ui32Failed++;
+        }
+    }
+
+    if (sStats.ui32Aborts != ui32Dropped || ui32Dropped == 0)
+    {
+        printf("FAIL: The write-behind buffer did not recover from lost responses\n");
+        ui32Failed++;
+    }
+}
+
+//=============================================================================
+int main (void)
+{
+    printf("mode                   | writes | frames | coalesced | batched | max age [ms]\n");
+
+    Bench("SETVAR queue", false, false);
+    Bench("write-behind", true, false);
+    Bench("write-behind (batch)", true, true);
+    BenchLostResponses();
+
+    return ui32Failed > 0;
+}
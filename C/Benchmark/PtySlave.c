@@ -0,0 +1,135 @@
+/**************************************************************************//**
+ * \file PtySlave.c
+ * \author Roman Holderried
+ *
+ * \brief Simulated slave on a pseudo terminal (for the Python drivers).
+ *
+ * Prints the name of the pseudo terminal and answers the requests arriving
+ * there with the simulated slave (SimSlave.h) until it is terminated. The
+ * slave answers as fast as possible, so the throughput of the host side is
+ * measured (see Python/Benchmark/BenchNative.py).
+ *  - Variables 1..255: GETVAR / SETVAR (initial value = number)
+ *  - COMMAND 2: Returns 10 values
+ *  - COMMAND 1: Answers with a 64 KiB upstream
+ *
+ * Build:
+ * gcc -std=c99 -O2 -I C/Inc -I C/Inc/config -I C/Benchmark C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c C/Benchmark/SimSlave.c
+ *     C/Benchmark/PtySlave.c -o PtySlave
+ *
+ * Usage: PtySlave [packet length]
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "SimSlave.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define PTY_CMD_NUM         2
+#define PTY_UPS_NUM         1
+#define PTY_UPS_LEN         65536u
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t  ui8UpsData[PTY_UPS_LEN];
+static uint32_t ui32CmdResult[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static bool WriteAll (int iFd, const uint8_t *pui8Data, uint16_t ui16Len)
+{
+    while (ui16Len > 0)
+    {
+        ssize_t iCnt = write(iFd, pui8Data, ui16Len);
+
+        if (iCnt <= 0)
+            return false;
+
+        pui8Data += iCnt;
+        ui16Len -= (uint16_t)iCnt;
+    }
+
+    return true;
+}
+
+//=============================================================================
+int main (int argc, char **argv)
+{
+    uint16_t ui16PacketLength = argc > 1 ? (uint16_t)atoi(argv[1]) : 1024;
+    struct termios sTermios;
+    uint8_t ui8Rx[4096];
+    int iMaster = posix_openpt(O_RDWR | O_NOCTTY);
+    int iSlave;
+
+    if (iMaster < 0 || grantpt(iMaster) != 0 || unlockpt(iMaster) != 0)
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+
+    // Keep the terminal open (reads fail while no one else has it open) and raw
+    iSlave = open(ptsname(iMaster), O_RDWR | O_NOCTTY);
+
+    if (iSlave < 0 || tcgetattr(iSlave, &sTermios) != 0)
+    {
+        perror("open");
+        return 1;
+    }
+
+    cfmakeraw(&sTermios);
+    tcsetattr(iSlave, TCSANOW, &sTermios);
+
+    for (uint32_t i = 0; i < PTY_UPS_LEN; i++)
+        ui8UpsData[i] = (uint8_t)((i * 0x9E3779B1u) >> 24);
+
+    SimSlaveInit(ui16PacketLength, 10);
+    SimSlaveSetCommandResult(PTY_CMD_NUM, ui32CmdResult, 10);
+    SimSlaveSetUpstream(PTY_UPS_NUM, ui8UpsData, PTY_UPS_LEN);
+
+    for (int16_t i = 1; i < SIM_SLAVE_NUM_VARIABLES; i++)
+        SimSlaveSetVariable(i, (uint32_t)i);
+
+    printf("%s\n", ptsname(iMaster));
+    fflush(stdout);
+
+    while (true)
+    {
+        ssize_t iCnt = read(iMaster, ui8Rx, sizeof(ui8Rx));
+
+        if (iCnt <= 0)
+            break;
+
+        // Byte by byte: Every request is answered on its ETX
+        for (ssize_t i = 0; i < iCnt; i++)
+        {
+            const uint8_t *pui8Rsp;
+            uint16_t ui16RspLen;
+
+            SimSlaveTxCB(&ui8Rx[i], 1);
+
+            if (SimSlaveTakeResponse(&pui8Rsp, &ui16RspLen) && !WriteAll(iMaster, pui8Rsp, ui16RspLen))
+                return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+/**************************************************************************//**
+ * \file SimLink.c
+ * \author Roman Holderried
+ *
+ * \brief Serial link emulator with virtual time for benchmarks.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SimLink.h"
+#include "SimSlave.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static struct
+{
+    tsSIM_LINK_CONFIG   sConfig;
+    uint64_t            ui64ByteNs;                     /*!< Wire time of one byte.*/
+    uint32_t            ui32ErrorThreshold;             /*!< Bit error rate scaled to the random number range.*/
+    uint32_t            ui32Random;
+
+    uint64_t            ui64NowNs;
+    uint64_t            ui64MasterLineFreeNs;           /*!< End of the last byte sent by the master.*/
+    uint64_t            ui64SlaveLineFreeNs;            /*!< End of the last byte sent by the slave.*/
+
+    uint8_t             ui8Queue[SIM_LINK_QUEUE_LENGTH];        /*!< Bytes on the way to the master.*/
+    uint64_t            ui64Arrival[SIM_LINK_QUEUE_LENGTH];     /*!< Arrival times of the bytes.*/
+    uint16_t            ui16Head;
+    uint16_t            ui16Cnt;
+
+    tsSIM_LINK_STATS    sStats;
+}sLink;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint8_t _Corrupt (uint8_t ui8Data)
+{
+    if (sLink.ui32ErrorThreshold == 0)
+        return ui8Data;
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        // xorshift32
+        sLink.ui32Random ^= sLink.ui32Random << 13;
+        sLink.ui32Random ^= sLink.ui32Random >> 17;
+        sLink.ui32Random ^= sLink.ui32Random << 5;
+
+        if (sLink.ui32Random < sLink.ui32ErrorThreshold)
+        {
+            ui8Data ^= (uint8_t)(1u << i);
+            sLink.sStats.ui32BitErrors++;
+        }
+    }
+
+    return ui8Data;
+}
+
+//=============================================================================
+static void _QueueResponse (const uint8_t *pui8Rsp, uint16_t ui16Len)
+{
+    uint64_t ui64Time = sLink.ui64NowNs + (uint64_t)sLink.sConfig.ui32TurnaroundUs * 1000u;
+
+    // The slave cannot start before its previous response is on the wire
+    if (ui64Time < sLink.ui64SlaveLineFreeNs)
+        ui64Time = sLink.ui64SlaveLineFreeNs;
+
+    for (uint16_t i = 0; i < ui16Len && sLink.ui16Cnt < SIM_LINK_QUEUE_LENGTH; i++)
+    {
+        uint16_t ui16Idx = (uint16_t)((sLink.ui16Head + sLink.ui16Cnt) % SIM_LINK_QUEUE_LENGTH);
+
+        if (i > 0)
+            ui64Time += sLink.sConfig.ui32SlaveGapNs;
+
+        ui64Time += sLink.ui64ByteNs;
+
+        sLink.ui8Queue[ui16Idx]     = _Corrupt(pui8Rsp[i]);
+        sLink.ui64Arrival[ui16Idx]  = ui64Time;
+        sLink.ui16Cnt++;
+        sLink.sStats.ui32RxBytes++;
+    }
+
+    sLink.ui64SlaveLineFreeNs = ui64Time;
+}
+
+//=============================================================================
+void SimLinkInit (tsSIM_LINK_CONFIG sConfig)
+{
+    memset(&sLink, 0, sizeof(sLink));
+
+    sLink.sConfig               = sConfig;
+    sLink.ui64ByteNs            = (uint64_t)sConfig.ui8BitsPerByte * 1000000000u / sConfig.ui32Baudrate;
+    sLink.ui32ErrorThreshold    = (uint32_t)(sConfig.dBitErrorRate * 4294967296.0);
+    sLink.ui32Random            = sConfig.ui32Seed != 0 ? sConfig.ui32Seed : 1;
+
+    if (sLink.sConfig.ui16FifoDepth == 0)
+        sLink.sConfig.ui16FifoDepth = 1;
+}
+
+//=============================================================================
+void SimLinkTxCB (uint8_t *pui8Buf, uint16_t ui16Len)
+{
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        uint8_t ui8Data = _Corrupt(pui8Buf[i]);
+        const uint8_t *pui8Rsp;
+        uint16_t ui16RspLen;
+
+        // Back-to-back bytes are separated by the gap of the master
+        if (sLink.ui64NowNs == sLink.ui64MasterLineFreeNs && sLink.sStats.ui32TxBytes > 0)
+            sLink.ui64NowNs += sLink.sConfig.ui32MasterGapNs;
+
+        // The transmission blocks the master
+        sLink.ui64NowNs += sLink.ui64ByteNs;
+        sLink.ui64MasterLineFreeNs = sLink.ui64NowNs;
+        sLink.sStats.ui32TxBytes++;
+
+        SimSlaveTxCB(&ui8Data, 1);
+
+        // The slave evaluates the request on its end
+        if (SimSlaveTakeResponse(&pui8Rsp, &ui16RspLen))
+            _QueueResponse(pui8Rsp, ui16RspLen);
+    }
+}
+
+//=============================================================================
+bool SimLinkProcess (void)
+{
+    tePROTOCOL_STATE eState = SCIGetProtocolState();
+    uint8_t ui8Fifo[SIM_LINK_QUEUE_LENGTH];
+    uint16_t ui16Arrived = 0;
+    uint16_t ui16Read;
+    uint64_t ui64ReadNs;
+
+    if (sLink.ui16Cnt == 0)
+        return false;
+
+    // The master reads the FIFO once it is receiving (or idle) again
+    if (eState == ePROTOCOL_SENDING || eState == ePROTOCOL_EVALUATING)
+        return true;
+
+    // Next read of the FIFO with data
+    ui64ReadNs = sLink.ui64Arrival[sLink.ui16Head];
+
+    if (ui64ReadNs < sLink.ui64NowNs)
+        ui64ReadNs = sLink.ui64NowNs;
+
+    if (sLink.sConfig.ui32PollUs > 0)
+    {
+        uint64_t ui64PollNs = (uint64_t)sLink.sConfig.ui32PollUs * 1000u;
+        ui64ReadNs = (ui64ReadNs + ui64PollNs - 1) / ui64PollNs * ui64PollNs;
+    }
+
+    sLink.ui64NowNs = ui64ReadNs;
+
+    // Bytes beyond the FIFO depth (arrived since the last read) are lost
+    while (ui16Arrived < sLink.ui16Cnt && sLink.ui64Arrival[(sLink.ui16Head + ui16Arrived) % SIM_LINK_QUEUE_LENGTH] <= ui64ReadNs)
+    {
+        if (ui16Arrived < sLink.sConfig.ui16FifoDepth)
+            ui8Fifo[ui16Arrived] = sLink.ui8Queue[(sLink.ui16Head + ui16Arrived) % SIM_LINK_QUEUE_LENGTH];
+
+        ui16Arrived++;
+    }
+
+    ui16Read = ui16Arrived < sLink.sConfig.ui16FifoDepth ? ui16Arrived : sLink.sConfig.ui16FifoDepth;
+    sLink.sStats.ui32OverrunBytes += ui16Arrived - ui16Read;
+    sLink.ui16Head = (uint16_t)((sLink.ui16Head + ui16Arrived) % SIM_LINK_QUEUE_LENGTH);
+    sLink.ui16Cnt -= ui16Arrived;
+
+    SCIReceive(ui8Fifo, ui16Read);
+
+    return true;
+}
+
+//=============================================================================
+void SimLinkAdvance (uint32_t ui32Us)
+{
+    sLink.ui64NowNs += (uint64_t)ui32Us * 1000u;
+}
+
+//=============================================================================
+uint32_t SimLinkTimeUs (void)
+{
+    return (uint32_t)(sLink.ui64NowNs / 1000u);
+}
+
+//=============================================================================
+uint64_t SimLinkTimeNs (void)
+{
+    return sLink.ui64NowNs;
+}
+
+//=============================================================================
+tsSIM_LINK_STATS SimLinkGetStats (void)
+{
+    return sLink.sStats;
+}
@@ -0,0 +1,104 @@
+/**************************************************************************//**
+ * \file SimLink.h
+ * \author Roman Holderried
+ *
+ * \brief Serial link emulator with virtual time for benchmarks.
+ *
+ * The emulator sits between the master and the simulated slave (SimSlave.h).
+ * SimLinkTxCB is passed to the master as blocking transmit callback, every
+ * byte occupies the wire for (bits per byte / baud rate) plus the inter-byte
+ * gap of the sender, the virtual clock advances accordingly. The slave answers
+ * after its turnaround time, the response bytes arrive one after the other at
+ * the same rate.
+ *
+ * The master reads the received bytes from a FIFO of limited depth, either
+ * on every byte (poll period 0, like a receive interrupt) or every poll period.
+ * Bytes arriving while the FIFO is full are lost (overrun). Bits are flipped
+ * at the configured bit error rate (deterministic pseudo random sequence).
+ *
+ * The benchmark loop calls SCIMasterSM and SimLinkProcess alternately. The
+ * master itself takes no virtual time, its processing time is added with
+ * SimLinkAdvance if required. The master has no response timeout, so lost
+ * responses are detected by the caller (SimLinkProcess returns false while
+ * the master waits for data that does not come).
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SIMLINK_H_
+#define _SIMLINK_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SIM_LINK_QUEUE_LENGTH   8192    // Bytes on the way to the master
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Link parameters */
+typedef struct
+{
+    uint32_t ui32Baudrate;
+    uint8_t  ui8BitsPerByte;        /*!< Start + data + parity + stop bits (8N1: 10).*/
+    uint32_t ui32MasterGapNs;       /*!< Idle time between two bytes sent by the master.*/
+    uint32_t ui32SlaveGapNs;        /*!< Idle time between two bytes sent by the slave.*/
+    uint32_t ui32TurnaroundUs;      /*!< Slave: End of the request to the start of the response.*/
+    uint16_t ui16FifoDepth;         /*!< Receive FIFO of the master (bytes).*/
+    uint32_t ui32PollUs;            /*!< Period the master reads the FIFO (0: on every byte).*/
+    double   dBitErrorRate;         /*!< Probability of a flipped data bit (both directions).*/
+    uint32_t ui32Seed;              /*!< Seed of the bit error sequence.*/
+}tsSIM_LINK_CONFIG;
+
+#define tsSIM_LINK_CONFIG_DEFAULTS {115200, 10, 0, 0, 1000, 16, 0, 0.0, 1}
+
+/** \brief Link counters */
+typedef struct
+{
+    uint32_t ui32TxBytes;           /*!< Bytes sent by the master.*/
+    uint32_t ui32RxBytes;           /*!< Bytes sent by the slave.*/
+    uint32_t ui32BitErrors;         /*!< Flipped bits.*/
+    uint32_t ui32OverrunBytes;      /*!< Bytes lost due to a full receive FIFO.*/
+}tsSIM_LINK_STATS;
+
+#define tsSIM_LINK_STATS_DEFAULTS {0, 0, 0, 0}
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes the link (virtual clock at 0, no bytes in flight).*/
+void SimLinkInit (tsSIM_LINK_CONFIG sConfig);
+
+/** \brief Master transmit callback (to be passed as BlockingTxExternalCB).*/
+void SimLinkTxCB (uint8_t *pui8Buf, uint16_t ui16Len);
+
+/** \brief Delivers the bytes received by the master up to the next read of the FIFO.
+ *
+ * The virtual clock advances to the next FIFO read with data. Nothing is
+ * delivered while the master is sending or evaluating (it reads the FIFO
+ * once it is back receiving or idle).
+ *
+ * @returns False if no byte is on the way to the master
+ */
+bool SimLinkProcess (void);
+
+/** \brief Advances the virtual clock (e.g. processing time of the application).*/
+void SimLinkAdvance (uint32_t ui32Us);
+
+/** \brief Virtual time in us (e.g. time base of the scheduler or the metrics).*/
+uint32_t SimLinkTimeUs (void);
+
+/** \brief Virtual time in ns.*/
+uint64_t SimLinkTimeNs (void);
+
+/** \brief Returns the link counters.*/
+tsSIM_LINK_STATS SimLinkGetStats (void);
+
+#endif // _SIMLINK_H_
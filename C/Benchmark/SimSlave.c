@@ -0,0 +1,569 @@
+/**************************************************************************//**
+ * \file SimSlave.c
+ * \author Roman Holderried
+ *
+ * \brief Simulated SCI slave device for benchmarks.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SimSlave.h"
+#include "SCIMaster.h"
+#include "SCIDataLink.h"
+#include "Helpers.h"
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static struct
+{
+    uint16_t ui16TxPacketLength;
+    uint16_t ui16RxPacketLength;
+    uint16_t ui16MaxValsPerFrame;
+
+    uint8_t  ui8ReqBuf[SIM_SLAVE_MAX_PACKET_LENGTH];
+    uint16_t ui16ReqLen;
+    uint16_t ui16RawToGo;
+    bool     bInFrame;
+
+    uint8_t  ui8RspBuf[SIM_SLAVE_MAX_PACKET_LENGTH + 2];
+    uint16_t ui16RspLen;
+    bool     bRspPending;
+
+    uint32_t ui32Variables[SIM_SLAVE_NUM_VARIABLES];
+
+    int16_t         i16CmdNum;
+    const uint32_t  *pui32CmdVals;
+    uint32_t        ui32CmdCnt;
+    uint32_t        ui32CmdSent;
+
+    int16_t         i16FaultNum;        // Rejected COMMAND (-1: None)
+    uint32_t        ui32FaultSkip;
+    uint16_t        ui16FaultErrNum;    // 0: NAK
+
+    int16_t         i16UpsNum;
+    const uint8_t   *pui8UpsData;
+    uint32_t        ui32UpsLen;
+    uint32_t        ui32UpsSent;
+    teSCI_COMPRESS_CODEC eUpsCodec;
+    bool            bUpsCompression;    // Negotiated by the master
+    bool            bUpsPackedValid;
+    uint32_t        ui32UpsPackedLen;   // 0: Sent raw
+
+    uint8_t         ui8DsData[SIM_SLAVE_DOWNSTREAM_SIZE];
+    uint32_t        ui32DsLen;
+    uint32_t        ui32DsNextOffset;
+    uint16_t        ui16DsCredit;
+    uint16_t        ui16DsFramesSinceAck;
+    uint32_t        ui32DsDropInterval;
+    uint32_t        ui32DsFrameCnt;
+
+    tsSIM_SLAVE_STATS sStats;
+}sSlave;
+
+static uint8_t ui8UpsPacked[SIM_SLAVE_PACKED_SIZE];
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint16_t _AppendHex (uint8_t *pui8Dst, uint32_t ui32Val)
+{
+    return (uint16_t)hexToStrDword(pui8Dst, &ui32Val, true);
+}
+
+//=============================================================================
+static uint16_t _AppendStr (uint8_t *pui8Dst, const char *pcStr)
+{
+    uint16_t ui16Len = (uint16_t)strlen(pcStr);
+    memcpy(pui8Dst, pcStr, ui16Len);
+    return ui16Len;
+}
+
+//=============================================================================
+static uint32_t _ParseHex (const uint8_t *pui8Str, uint16_t ui16Len)
+{
+    uint32_t ui32Val = 0;
+
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        uint8_t c = pui8Str[i];
+        ui32Val <<= 4;
+
+        if (c >= '0' && c <= '9')
+            ui32Val |= c - '0';
+        else if (c >= 'A' && c <= 'F')
+            ui32Val |= c - 'A' + 10;
+    }
+
+    return ui32Val;
+}
+
+//=============================================================================
+static void _Send (uint16_t ui16Len)
+{
+    sSlave.ui8RspBuf[0] = STX;
+    sSlave.ui8RspBuf[ui16Len + 1] = ETX;
+
+    // The response is passed as soon as the master is ready to receive
+    sSlave.ui16RspLen = ui16Len + 2;
+    sSlave.bRspPending = true;
+}
+
+//=============================================================================
+static bool _Downstream (uint8_t *pui8Req, uint16_t ui16IdPos, uint8_t *pui8Rsp, uint16_t *pui16Len)
+{
+    uint16_t ui16Pos = ui16IdPos + 1;
+    uint16_t ui16ValLen = 0;
+    uint32_t ui32First, ui32Second;
+
+    // Header values: "len,offset" (announcement) or "offset,len;raw" (data)
+    while ((ui16Pos + ui16ValLen) < sSlave.ui16ReqLen && pui8Req[ui16Pos + ui16ValLen] != ',')
+        ui16ValLen++;
+
+    ui32First = _ParseHex(&pui8Req[ui16Pos], ui16ValLen);
+    ui16Pos += ui16ValLen + 1;
+    ui16ValLen = 0;
+
+    while ((ui16Pos + ui16ValLen) < sSlave.ui16ReqLen && pui8Req[ui16Pos + ui16ValLen] != ';')
+        ui16ValLen++;
+
+    ui32Second = _ParseHex(&pui8Req[ui16Pos], ui16ValLen);
+    ui16Pos += ui16ValLen;
+
+    // Announcement: Grant the credit
+    if (ui16Pos >= sSlave.ui16ReqLen)
+    {
+        sSlave.ui32DsLen = ui32First;
+        sSlave.ui32DsNextOffset = ui32Second;
+        sSlave.ui16DsFramesSinceAck = 0;
+
+        *pui16Len += _AppendStr(&pui8Rsp[*pui16Len], "ACK;");
+        *pui16Len += _AppendHex(&pui8Rsp[*pui16Len], sSlave.ui16DsCredit);
+        return true;
+    }
+
+    sSlave.ui32DsFrameCnt++;
+    sSlave.ui16DsFramesSinceAck++;
+
+    // Only in-order data is taken over (frames get lost on the drop interval)
+    if (ui32First == sSlave.ui32DsNextOffset && (ui32First + ui32Second) <= SIM_SLAVE_DOWNSTREAM_SIZE &&
+        (sSlave.ui32DsDropInterval == 0 || (sSlave.ui32DsFrameCnt % sSlave.ui32DsDropInterval) != 0))
+    {
+        memcpy(&sSlave.ui8DsData[ui32First], &pui8Req[ui16Pos + 1], ui32Second);
+        sSlave.ui32DsNextOffset += ui32Second;
+    }
+
+    // Cumulative acknowledge at the end of the credit window or of the data
+    if (sSlave.ui16DsFramesSinceAck < sSlave.ui16DsCredit && (ui32First + ui32Second) < sSlave.ui32DsLen)
+        return false;
+
+    sSlave.ui16DsFramesSinceAck = 0;
+    *pui16Len += _AppendStr(&pui8Rsp[*pui16Len], "ACK;");
+    *pui16Len += _AppendHex(&pui8Rsp[*pui16Len], sSlave.ui32DsNextOffset);
+    return true;
+}
+
+//=============================================================================
+static uint16_t _BuildCommandData (uint8_t *pui8Dst, uint16_t ui16Len)
+{
+    uint8_t  ui8Tmp[8];
+    uint16_t ui16ValsInFrame = 0;
+    uint16_t ui16AsciiSize;
+
+    while (sSlave.ui32CmdSent < sSlave.ui32CmdCnt && ui16ValsInFrame < sSlave.ui16MaxValsPerFrame)
+    {
+        ui16AsciiSize = _AppendHex(ui8Tmp, sSlave.pui32CmdVals[sSlave.ui32CmdSent]);
+
+        // Value plus separator must fit into the frame
+        if ((ui16Len + ui16AsciiSize + (ui16ValsInFrame > 0)) > sSlave.ui16TxPacketLength)
+            break;
+
+        if (ui16ValsInFrame > 0)
+            pui8Dst[ui16Len++] = ',';
+
+        memcpy(&pui8Dst[ui16Len], ui8Tmp, ui16AsciiSize);
+        ui16Len += ui16AsciiSize;
+        ui16ValsInFrame++;
+        sSlave.ui32CmdSent++;
+    }
+
+    return ui16Len;
+}
+
+//=============================================================================
+static void _Answer (void)
+{
+    uint8_t  *pui8Req = sSlave.ui8ReqBuf;
+    uint8_t  *pui8Rsp = &sSlave.ui8RspBuf[1];
+    uint16_t ui16Len = 0;
+    uint16_t ui16IdPos = 0;
+    int16_t  i16Num;
+    uint8_t  ui8Id;
+
+    while (ui16IdPos < sSlave.ui16ReqLen && 
+           ((pui8Req[ui16IdPos] >= '0' && pui8Req[ui16IdPos] <= '9') || (pui8Req[ui16IdPos] >= 'A' && pui8Req[ui16IdPos] <= 'F')))
+        ui16IdPos++;
+
+    if (ui16IdPos >= sSlave.ui16ReqLen)
+        return;
+
+    i16Num  = (int16_t)_ParseHex(pui8Req, ui16IdPos);
+    ui8Id   = pui8Req[ui16IdPos];
+
+    // Echo number and identifier
+    memcpy(pui8Rsp, pui8Req, ui16IdPos + 1);
+    ui16Len = ui16IdPos + 1;
+
+    switch (ui8Id)
+    {
+        case '?':
+            ui16Len += _AppendStr(&pui8Rsp[ui16Len], "ACK;");
+            ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui32Variables[(uint16_t)i16Num % SIM_SLAVE_NUM_VARIABLES]);
+            break;
+
+        case '!':
+            {
+                // "num!val" or batch "num!val,num,val,..." (applied in order up to the first unknown variable)
+                uint16_t ui16Pos = ui16IdPos + 1;
+                int16_t i16VarNum = i16Num;
+                bool bVal = true;
+
+                while (ui16Pos < sSlave.ui16ReqLen)
+                {
+                    uint16_t ui16ValLen = 0;
+                    uint32_t ui32Val;
+
+                    while ((ui16Pos + ui16ValLen) < sSlave.ui16ReqLen && pui8Req[ui16Pos + ui16ValLen] != ',')
+                        ui16ValLen++;
+
+                    ui32Val = _ParseHex(&pui8Req[ui16Pos], ui16ValLen);
+                    ui16Pos += ui16ValLen + 1;
+
+                    if (!bVal)
+                    {
+                        i16VarNum = (int16_t)ui32Val;
+                        bVal = true;
+                        continue;
+                    }
+
+                    if (i16VarNum < 0 || i16VarNum >= SIM_SLAVE_NUM_VARIABLES)
+                        break;
+
+                    sSlave.ui32Variables[i16VarNum] = ui32Val;
+                    bVal = false;
+                }
+
+                if (i16VarNum < 0 || i16VarNum >= SIM_SLAVE_NUM_VARIABLES)
+                {
+                    ui16Len = _AppendHex(pui8Rsp, (uint16_t)i16VarNum);
+                    pui8Rsp[ui16Len++] = '!';
+                    ui16Len += _AppendStr(&pui8Rsp[ui16Len], "ERR;1");
+                }
+                else
+                    ui16Len += _AppendStr(&pui8Rsp[ui16Len], "ACK");
+            }
+            break;
+
+        case ':':
+            // Injected fault
+            if (i16Num == sSlave.i16FaultNum && sSlave.ui32FaultSkip-- == 0)
+            {
+                sSlave.i16FaultNum = -1;
+
+                if (sSlave.ui16FaultErrNum > 0)
+                {
+                    ui16Len += _AppendStr(&pui8Rsp[ui16Len], "ERR;");
+                    ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui16FaultErrNum);
+                }
+                else
+                    ui16Len += _AppendStr(&pui8Rsp[ui16Len], "NAK");
+            }
+            else if (i16Num == sSlave.i16UpsNum && sSlave.pui8UpsData != NULL)
+            {
+                sSlave.ui32UpsSent = 0;
+
+                if (!sSlave.bUpsPackedValid)
+                {
+                    sSlave.ui32UpsPackedLen = SCICompress(sSlave.eUpsCodec, sSlave.pui8UpsData, sSlave.ui32UpsLen,
+                                                          ui8UpsPacked, sizeof(ui8UpsPacked));
+                    sSlave.bUpsPackedValid = true;
+                }
+
+                ui16Len += _AppendStr(&pui8Rsp[ui16Len], "UPS;");
+
+                // Compressed: Wire length, codec and decompressed length
+                if (sSlave.bUpsCompression && sSlave.ui32UpsPackedLen > 0)
+                {
+                    ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui32UpsPackedLen);
+                    pui8Rsp[ui16Len++] = ';';
+                    ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.eUpsCodec);
+                    pui8Rsp[ui16Len++] = ',';
+                    ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui32UpsLen);
+                }
+                else
+                    ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui32UpsLen);
+            }
+            else if (i16Num == sSlave.i16CmdNum && sSlave.ui32CmdCnt > 0)
+            {
+                // First frame of the result carries the acknowledge and the overall data length
+                if (sSlave.ui32CmdSent == 0)
+                {
+                    ui16Len += _AppendStr(&pui8Rsp[ui16Len], "DAT;");
+                    ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui32CmdCnt);
+                    pui8Rsp[ui16Len++] = ';';
+                }
+
+                ui16Len = _BuildCommandData(pui8Rsp, ui16Len);
+
+                if (sSlave.ui32CmdSent >= sSlave.ui32CmdCnt)
+                    sSlave.ui32CmdSent = 0;
+            }
+            else
+                ui16Len += _AppendStr(&pui8Rsp[ui16Len], "ACK");
+            break;
+
+        case '%':
+            {
+                // Master capabilities: Version, RX length, TX length, value modes, features
+                uint32_t ui32MasterCaps[SCI_HANDSHAKE_NUM_VALUES] = {0};
+                uint16_t ui16Pos = ui16IdPos + 1;
+
+                for (uint8_t i = 0; i < SCI_HANDSHAKE_NUM_VALUES && ui16Pos < sSlave.ui16ReqLen; i++)
+                {
+                    uint16_t ui16ValLen = 0;
+
+                    while ((ui16Pos + ui16ValLen) < sSlave.ui16ReqLen && pui8Req[ui16Pos + ui16ValLen] != ',')
+                        ui16ValLen++;
+
+                    ui32MasterCaps[i] = _ParseHex(&pui8Req[ui16Pos], ui16ValLen);
+                    ui16Pos += ui16ValLen + 1;
+                }
+
+                ui16Len += _AppendStr(&pui8Rsp[ui16Len], "DAT;");
+                ui16Len += _AppendHex(&pui8Rsp[ui16Len], SCI_HANDSHAKE_NUM_VALUES);
+                pui8Rsp[ui16Len++] = ';';
+                ui16Len += _AppendHex(&pui8Rsp[ui16Len], SCI_PROTOCOL_VERSION);
+                pui8Rsp[ui16Len++] = ',';
+                ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui16RxPacketLength);
+                pui8Rsp[ui16Len++] = ',';
+                ui16Len += _AppendHex(&pui8Rsp[ui16Len], sSlave.ui16TxPacketLength);
+                pui8Rsp[ui16Len++] = ',';
+                ui16Len += _AppendHex(&pui8Rsp[ui16Len], SCI_VALUE_MODE_BIT(eSCI_VALUE_MODE_HEX));
+                pui8Rsp[ui16Len++] = ',';
+                ui16Len += _AppendHex(&pui8Rsp[ui16Len], SCI_FEATURE_UPSTREAM | SCI_FEATURE_DOWNSTREAM | SCI_FEATURE_SETVAR_BATCH |
+                                                         SCI_FEATURE_UPSTREAM_COMPRESSION);
+
+                sSlave.bUpsCompression = (ui32MasterCaps[4] & SCI_FEATURE_UPSTREAM_COMPRESSION) != 0;
+
+                // Responses must fit into the master RX frames from now on
+                if (ui32MasterCaps[1] > 0 && ui32MasterCaps[1] < sSlave.ui16TxPacketLength)
+                    sSlave.ui16TxPacketLength = (uint16_t)ui32MasterCaps[1];
+            }
+            break;
+
+        case '<':
+            // Data frames within the credit window are not answered
+            if (!_Downstream(pui8Req, ui16IdPos, pui8Rsp, &ui16Len))
+                return;
+            break;
+
+        case '>':
+            {
+                bool bPacked = sSlave.bUpsCompression && sSlave.ui32UpsPackedLen > 0;
+                const uint8_t *pui8Wire = bPacked ? ui8UpsPacked : sSlave.pui8UpsData;
+                uint32_t ui32Chunk = (bPacked ? sSlave.ui32UpsPackedLen : sSlave.ui32UpsLen) - sSlave.ui32UpsSent;
+
+                if (ui32Chunk > sSlave.ui16TxPacketLength)
+                    ui32Chunk = sSlave.ui16TxPacketLength;
+
+                // Upstream frames carry raw data only
+                memcpy(pui8Rsp, &pui8Wire[sSlave.ui32UpsSent], ui32Chunk);
+                ui16Len = (uint16_t)ui32Chunk;
+                sSlave.ui32UpsSent += ui32Chunk;
+            }
+            break;
+
+        default:
+            ui16Len += _AppendStr(&pui8Rsp[ui16Len], "NAK");
+            break;
+    }
+
+    _Send(ui16Len);
+}
+
+//=============================================================================
+void SimSlaveInit (uint16_t ui16TxPacketLength, uint16_t ui16MaxValsPerFrame)
+{
+    memset(&sSlave, 0, sizeof(sSlave));
+
+    if (ui16TxPacketLength > SIM_SLAVE_MAX_PACKET_LENGTH)
+        ui16TxPacketLength = SIM_SLAVE_MAX_PACKET_LENGTH;
+
+    sSlave.ui16TxPacketLength   = ui16TxPacketLength;
+    sSlave.ui16RxPacketLength   = ui16TxPacketLength;
+    sSlave.ui16MaxValsPerFrame  = ui16MaxValsPerFrame;
+    sSlave.i16CmdNum            = -1;
+    sSlave.i16FaultNum          = -1;
+    sSlave.i16UpsNum            = -1;
+    sSlave.ui16DsCredit         = 1;
+}
+
+//=============================================================================
+void SimSlaveSetVariable (int16_t i16Num, uint32_t ui32Val)
+{
+    sSlave.ui32Variables[(uint16_t)i16Num % SIM_SLAVE_NUM_VARIABLES] = ui32Val;
+}
+
+//=============================================================================
+uint32_t SimSlaveGetVariable (int16_t i16Num)
+{
+    return sSlave.ui32Variables[(uint16_t)i16Num % SIM_SLAVE_NUM_VARIABLES];
+}
+
+//=============================================================================
+void SimSlaveSetCommandResult (int16_t i16Num, const uint32_t *pui32Vals, uint32_t ui32Cnt)
+{
+    sSlave.i16CmdNum    = i16Num;
+    sSlave.pui32CmdVals = pui32Vals;
+    sSlave.ui32CmdCnt   = ui32Cnt;
+    sSlave.ui32CmdSent  = 0;
+}
+
+//=============================================================================
+void SimSlaveSetCommandFault (int16_t i16Num, uint32_t ui32Skip, uint16_t ui16ErrNum)
+{
+    sSlave.i16FaultNum      = i16Num;
+    sSlave.ui32FaultSkip    = ui32Skip;
+    sSlave.ui16FaultErrNum  = ui16ErrNum;
+}
+
+//=============================================================================
+void SimSlaveSetUpstream (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    sSlave.i16UpsNum    = i16Num;
+    sSlave.pui8UpsData  = pui8Data;
+    sSlave.ui32UpsLen   = ui32Len;
+    sSlave.ui32UpsSent  = 0;
+    sSlave.bUpsPackedValid = false;
+}
+
+//=============================================================================
+void SimSlaveSetUpstreamCodec (teSCI_COMPRESS_CODEC eCodec)
+{
+    sSlave.eUpsCodec        = eCodec;
+    sSlave.bUpsPackedValid  = false;
+}
+
+//=============================================================================
+void SimSlaveSetDownstream (uint16_t ui16Credit, uint32_t ui32DropInterval)
+{
+    sSlave.ui16DsCredit         = ui16Credit > 0 ? ui16Credit : 1;
+    sSlave.ui32DsDropInterval   = ui32DropInterval;
+    sSlave.ui32DsFrameCnt       = 0;
+}
+
+//=============================================================================
+uint32_t SimSlaveGetDownstreamData (const uint8_t **ppui8Data)
+{
+    *ppui8Data = sSlave.ui8DsData;
+    return sSlave.ui32DsNextOffset;
+}
+
+//=============================================================================
+void SimSlaveTxCB (uint8_t *pui8Buf, uint16_t ui16Len)
+{
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        uint8_t ui8Data = pui8Buf[i];
+
+        sSlave.sStats.ui32RxByteCnt++;
+
+        // Raw data of a DOWNSTREAM frame may contain any byte value
+        if (sSlave.ui16RawToGo > 0)
+        {
+            sSlave.ui16RawToGo--;
+
+            if (sSlave.ui16ReqLen < SIM_SLAVE_MAX_PACKET_LENGTH)
+                sSlave.ui8ReqBuf[sSlave.ui16ReqLen++] = ui8Data;
+        }
+        else if (ui8Data == STX)
+        {
+            sSlave.bInFrame = true;
+            sSlave.ui16ReqLen = 0;
+        }
+        else if (ui8Data == ETX && sSlave.bInFrame)
+        {
+            sSlave.bInFrame = false;
+            sSlave.sStats.ui32RequestCnt++;
+
+            // Frames are evaluated on reception, because DOWNSTREAM frames follow each other without response
+            _Answer();
+        }
+        else if (sSlave.bInFrame && sSlave.ui16ReqLen < SIM_SLAVE_MAX_PACKET_LENGTH)
+        {
+            sSlave.ui8ReqBuf[sSlave.ui16ReqLen++] = ui8Data;
+
+            // End of a DOWNSTREAM data frame header "num<offset,len;"
+            if (ui8Data == ';' && memchr(sSlave.ui8ReqBuf, '<', sSlave.ui16ReqLen) != NULL)
+            {
+                uint8_t *pui8Sep = memchr(sSlave.ui8ReqBuf, ',', sSlave.ui16ReqLen);
+
+                if (pui8Sep != NULL)
+                    sSlave.ui16RawToGo = (uint16_t)_ParseHex(pui8Sep + 1, (uint16_t)(&sSlave.ui8ReqBuf[sSlave.ui16ReqLen - 1] - pui8Sep - 1));
+            }
+        }
+    }
+}
+
+//=============================================================================
+bool SimSlaveProcess (void)
+{
+    // The master must be ready to receive the response
+    if (!sSlave.bRspPending || SCIGetProtocolState() != ePROTOCOL_RECEIVING)
+        return false;
+
+    sSlave.bRspPending = false;
+    sSlave.sStats.ui32ResponseCnt++;
+    sSlave.sStats.ui32TxByteCnt += sSlave.ui16RspLen;
+
+    SCIReceive(sSlave.ui8RspBuf, sSlave.ui16RspLen);
+
+    return true;
+}
+
+//=============================================================================
+bool SimSlaveTakeResponse (const uint8_t **ppui8Rsp, uint16_t *pui16Len)
+{
+    if (!sSlave.bRspPending)
+        return false;
+
+    sSlave.bRspPending = false;
+    sSlave.sStats.ui32ResponseCnt++;
+    sSlave.sStats.ui32TxByteCnt += sSlave.ui16RspLen;
+
+    *ppui8Rsp = sSlave.ui8RspBuf;
+    *pui16Len = sSlave.ui16RspLen;
+
+    return true;
+}
+
+//=============================================================================
+tsSIM_SLAVE_STATS SimSlaveGetStats (void)
+{
+    return sSlave.sStats;
+}
+
+//=============================================================================
+void SimSlaveResetStats (void)
+{
+    tsSIM_SLAVE_STATS sStats = tsSIM_SLAVE_STATS_DEFAULTS;
+    sSlave.sStats = sStats;
+}
@@ -0,0 +1,137 @@
+/**************************************************************************//**
+ * \file SimSlave.h
+ * \author Roman Holderried
+ *
+ * \brief Simulated SCI slave device for benchmarks.
+ * 
+ * The simulated slave is connected to the master by using SimSlaveTxCB as the
+ * blocking transmit callback. Requests are collected byte by byte and
+ * evaluated on reception. SimSlaveProcess feeds the response back into
+ * SCIReceive as soon as the master is ready to receive.
+ * Only the HEX value mode is supported. The slave answers a capability
+ * handshake with its packet length for both directions and limits its own 
+ * TX length to the RX length of the master afterwards.
+ * Upstreams are compressed if a codec is set and the master announced
+ * SCI_FEATURE_UPSTREAM_COMPRESSION. A COMMAND can be rejected once
+ * (SimSlaveSetCommandFault) to check the error paths of the master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+#ifndef _SIMSLAVE_H_
+#define _SIMSLAVE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SCICompress.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SIM_SLAVE_MAX_PACKET_LENGTH 4096
+#define SIM_SLAVE_NUM_VARIABLES     256
+#define SIM_SLAVE_DOWNSTREAM_SIZE   65536
+#define SIM_SLAVE_PACKED_SIZE       262144
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Traffic counters of the simulated slave */
+typedef struct
+{
+    uint32_t ui32RequestCnt;    /*!< Number of request frames received.*/
+    uint32_t ui32RxByteCnt;     /*!< Bytes received from the master (including STX/ETX).*/
+    uint32_t ui32TxByteCnt;     /*!< Bytes sent to the master (including STX/ETX).*/
+    uint32_t ui32ResponseCnt;   /*!< Number of response frames sent (= turnarounds of the link).*/
+}tsSIM_SLAVE_STATS;
+
+#define tsSIM_SLAVE_STATS_DEFAULTS {0, 0, 0, 0}
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes the simulated slave.
+ * 
+ * @param ui16TxPacketLength    Maximum payload length of the slave frames (both directions)
+ * @param ui16MaxValsPerFrame   Maximum number of values the slave packs into one frame
+ */
+void SimSlaveInit (uint16_t ui16TxPacketLength, uint16_t ui16MaxValsPerFrame);
+
+/** \brief Sets the value of a slave variable (GETVAR / SETVAR).*/
+void SimSlaveSetVariable (int16_t i16Num, uint32_t ui32Val);
+
+/** \brief Returns the value of a slave variable.*/
+uint32_t SimSlaveGetVariable (int16_t i16Num);
+
+/** \brief Defines the result values the slave returns for a COMMAND.
+ * 
+ * Only one COMMAND result set is kept. The array must stay valid as long as it
+ * is in use by the slave.
+ */
+void SimSlaveSetCommandResult (int16_t i16Num, const uint32_t *pui32Vals, uint32_t ui32Cnt);
+
+/** \brief Rejects a COMMAND once.
+ *
+ * The next ui32Skip calls of the COMMAND are answered as usual, the following
+ * one is answered with "ERR;ui16ErrNum" (NAK if ui16ErrNum is 0).
+ */
+void SimSlaveSetCommandFault (int16_t i16Num, uint32_t ui32Skip, uint16_t ui16ErrNum);
+
+/** \brief Defines the data the slave returns as an upstream to a COMMAND.
+ * 
+ * Only one upstream is kept. The data must stay valid as long as it is in use by
+ * the slave.
+ */
+void SimSlaveSetUpstream (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Len);
+
+/** \brief Selects the codec of the upstream (eSCI_COMPRESS_NONE: Raw).
+ *
+ * The upstream is compressed once, when it is requested the first time after
+ * SimSlaveSetUpstream or SimSlaveSetUpstreamCodec. It is sent raw if the master
+ * did not negotiate the compression, the data does not fit into
+ * SIM_SLAVE_PACKED_SIZE or the compression does not pay off.
+ */
+void SimSlaveSetUpstreamCodec (teSCI_COMPRESS_CODEC eCodec);
+
+/** \brief Configures the DOWNSTREAM reception.
+ * 
+ * @param ui16Credit        Number of data frames the slave accepts before it acknowledges
+ * @param ui32DropInterval  Every n-th data frame is treated as lost (0: no losses)
+ */
+void SimSlaveSetDownstream (uint16_t ui16Credit, uint32_t ui32DropInterval);
+
+/** \brief Returns the DOWNSTREAM data received in order so far.
+ * 
+ * @returns Number of bytes received
+ */
+uint32_t SimSlaveGetDownstreamData (const uint8_t **ppui8Data);
+
+/** \brief Master transmit callback (to be passed as BlockingTxExternalCB).*/
+void SimSlaveTxCB (uint8_t *pui8Buf, uint16_t ui16Len);
+
+/** \brief Answers a received request.
+ * 
+ * @returns True if a response has been passed to the master.
+ */
+bool SimSlaveProcess (void);
+
+/** \brief Takes the response to the last request instead of passing it to the master.
+ *
+ * Used by a link emulator (SimLink.h), which delivers the response itself.
+ * The response stays valid until the next request is received.
+ *
+ * @returns True if a response is available
+ */
+bool SimSlaveTakeResponse (const uint8_t **ppui8Rsp, uint16_t *pui16Len);
+
+/** \brief Returns the traffic counters of the slave.*/
+tsSIM_SLAVE_STATS SimSlaveGetStats (void);
+
+/** \brief Resets the traffic counters of the slave.*/
+void SimSlaveResetStats (void);
+
+#endif // _SIMSLAVE_H_
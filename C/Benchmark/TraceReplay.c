@@ -0,0 +1,700 @@
+/**************************************************************************//**
+ * \file TraceReplay.c
+ * \author Roman Holderried
+ *
+ * \brief Deterministic replay of a recorded frame trace.
+ *
+ * Reads a pcapng trace written by SCITraceExport and replays it against the
+ * master: The recorded responses are fed into SCIReceive, the request frames
+ * the master sends are compared with the recorded ones. Requests of the
+ * application (the first frame of a transfer) are reconstructed from the
+ * recorded frame, GETVAR / SETVAR frames recorded directly after a response
+ * are queued as urgent requests (so that requests interleaved with a transfer
+ * are replayed at the same chunk boundary). Follow-up frames of a transfer
+ * must be generated by the master itself. The replay stops at the first
+ * mismatch.
+ *
+ * Afterwards the parse (responses) and build (requests) CPU time of every
+ * recorded frame is measured in isolation, by running SCIMasterResponseParser
+ * / SCIMasterStreamParser and SCIMasterRequestBuilder repeatedly on it.
+ * Reported are the mean and the maximum per request type and direction as
+ * well as the CPU time of the whole replay per frame.
+ *
+ * The trace must have been recorded with a snap length covering the largest
+ * frame. DOWNSTREAM transfers (their data source is not part of the trace)
+ * are not supported.
+ *
+ * Usage: TraceReplay [-f] [-c <bytes>] [-p] [-v] <trace.pcapng>
+ *  -f  Float value mode (default: HEX, a handshake in the trace negotiates it)
+ *  -c  Feed the responses in chunks of <bytes> (default: whole frames)
+ *  -p  Paced: Feed the responses at the recorded timing
+ *  -v  Parse / build time of every frame
+ *
+ * Build (master buffers and snap length configured as on the recording side):
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=512 -DTX_PACKET_LENGTH=512
+ *     -I C/Inc -I C/Inc/config C/Src/SCI*.c C/Src/Buffer.c C/Src/Helpers.c
+ *     C/Benchmark/TraceReplay.c -o TraceReplay
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SCIMaster.h"
+#include "SCIDataframe.h"
+#include "SCIDataLink.h"
+#include "SCITrace.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define REPLAY_MAX_FRAME_LEN    4096
+#define REPLAY_MAX_TX_FRAMES    8           // Frames sent by the master and not yet compared
+#define REPLAY_MAX_SM_CYCLES    100000      // State machine cycles until a stalled master is reported
+#define REPLAY_REPETITIONS      2000        // Parse / build runs per frame
+
+#define PCAPNG_BLOCK_SHB        0x0A0D0D0Au
+#define PCAPNG_BLOCK_IDB        0x00000001u
+#define PCAPNG_BLOCK_EPB        0x00000006u
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4Du
+#define PCAPNG_OPT_EPB_FLAGS    2
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+typedef struct
+{
+    uint64_t    ui64TimeUs;
+    uint8_t     ui8Dir;
+    uint8_t     ui8RecMode;
+    uint8_t     ui8ReqType;
+    uint16_t    ui16Len;
+    uint8_t     *pui8Data;
+}tsREPLAY_RECORD;
+
+typedef struct
+{
+    uint8_t     ui8Data[REPLAY_MAX_FRAME_LEN];
+    uint16_t    ui16Len;
+}tsREPLAY_FRAME;
+
+typedef struct
+{
+    uint32_t    ui32Frames;
+    double      dSumNs;
+    double      dMaxNs;
+}tsREPLAY_TIMING;
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsREPLAY_RECORD  *psRecords = NULL;
+static uint32_t         ui32RecordCnt = 0;
+
+static tsREPLAY_FRAME   sTxFrames[REPLAY_MAX_TX_FRAMES];    /*!< Frames sent by the master (FIFO).*/
+static uint8_t          ui8TxHead = 0;
+static uint8_t          ui8TxCnt = 0;
+static tsREPLAY_FRAME   sTxAssembly;
+static bool             bTxInFrame = false;
+static bool             bUrgentQueued = false;                      /*!< The next request frame has been queued as urgent request.*/
+
+static teSCI_VALUE_MODE eValueMode = eSCI_VALUE_MODE_HEX;
+static tuREQUESTVALUE   uReqVals[MAX_NUM_REQUEST_VALUES];  /*!< Values of the reconstructed request (valid during the transfer).*/
+static int16_t          i16BatchNums[MAX_NUM_REQUEST_VALUES];
+static tuREQUESTVALUE   uBatchVals[MAX_NUM_REQUEST_VALUES];
+
+static const char *pcTypeNames[] = {"NONE", "GETVAR", "SETVAR", "COMMAND", "UPSTREAM", "DOWNSTREAM", "HANDSHAKE"};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static double ReplayCpuNs (void)
+{
+    return (double)clock() * 1e9 / CLOCKS_PER_SEC;
+}
+
+//=============================================================================
+static bool ReplayLoad (const char *pcPath)
+{
+    FILE *pFile = fopen(pcPath, "rb");
+    uint8_t *pui8Content;
+    long lSize;
+    uint32_t ui32Pos = 0;
+    uint32_t ui32Capacity = 0;
+
+    if (pFile == NULL)
+        return false;
+
+    fseek(pFile, 0, SEEK_END);
+    lSize = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    pui8Content = malloc((size_t)lSize);
+
+    if (pui8Content == NULL || fread(pui8Content, 1, (size_t)lSize, pFile) != (size_t)lSize)
+    {
+        fclose(pFile);
+        return false;
+    }
+
+    fclose(pFile);
+
+    // Blocks are read in host byte order (same host as SCITraceExport, Python/SCITrace.py reads both)
+    while (ui32Pos + 12 <= (uint32_t)lSize)
+    {
+        uint32_t ui32Type, ui32BlockLen;
+
+        memcpy(&ui32Type, &pui8Content[ui32Pos], 4);
+        memcpy(&ui32BlockLen, &pui8Content[ui32Pos + 4], 4);
+
+        if (ui32BlockLen < 12 || ui32Pos + ui32BlockLen > (uint32_t)lSize)
+        {
+            printf("Truncated block at offset %u\n", ui32Pos);
+            return false;
+        }
+
+        if (ui32Type == PCAPNG_BLOCK_SHB)
+        {
+            uint32_t ui32Magic;
+
+            memcpy(&ui32Magic, &pui8Content[ui32Pos + 8], 4);
+
+            if (ui32Magic != PCAPNG_BYTE_ORDER_MAGIC)
+            {
+                printf("Trace of a host with different byte order\n");
+                return false;
+            }
+        }
+        else if (ui32Type == PCAPNG_BLOCK_EPB)
+        {
+            const uint8_t *pui8Body = &pui8Content[ui32Pos + 8];
+            uint32_t ui32TsHigh, ui32TsLow, ui32CapLen, ui32OrigLen, ui32Flags = 0;
+            uint32_t ui32OptPos = 20;
+            tsREPLAY_RECORD *psRecord;
+
+            memcpy(&ui32TsHigh, &pui8Body[4], 4);
+            memcpy(&ui32TsLow, &pui8Body[8], 4);
+            memcpy(&ui32CapLen, &pui8Body[12], 4);
+            memcpy(&ui32OrigLen, &pui8Body[16], 4);
+
+            if (ui32CapLen != ui32OrigLen || ui32CapLen < SCI_TRACE_PSEUDO_HDR_LEN)
+            {
+                printf("Frame %u truncated by the snap length (%u of %u bytes)\n", ui32RecordCnt, ui32CapLen, ui32OrigLen);
+                return false;
+            }
+
+            // Options: epb_flags holds the direction
+            ui32OptPos += (ui32CapLen + 3) & ~3u;
+
+            while (ui32OptPos + 4 <= ui32BlockLen - 12)
+            {
+                uint16_t ui16Code, ui16Len;
+
+                memcpy(&ui16Code, &pui8Body[ui32OptPos], 2);
+                memcpy(&ui16Len, &pui8Body[ui32OptPos + 2], 2);
+
+                if (ui16Code == 0)
+                    break;
+
+                if (ui16Code == PCAPNG_OPT_EPB_FLAGS && ui16Len == 4)
+                    memcpy(&ui32Flags, &pui8Body[ui32OptPos + 4], 4);
+
+                ui32OptPos += 4 + ((ui16Len + 3u) & ~3u);
+            }
+
+            if (ui32RecordCnt == ui32Capacity)
+            {
+                ui32Capacity = ui32Capacity > 0 ? ui32Capacity * 2 : 1024;
+                psRecords = realloc(psRecords, ui32Capacity * sizeof(tsREPLAY_RECORD));
+
+                if (psRecords == NULL)
+                    return false;
+            }
+
+            psRecord = &psRecords[ui32RecordCnt++];
+            psRecord->ui64TimeUs    = ((uint64_t)ui32TsHigh << 32) | ui32TsLow;
+            psRecord->ui8Dir        = (ui32Flags & 3) == 1 ? SCI_TRACE_DIR_RX : SCI_TRACE_DIR_TX;
+            psRecord->ui8RecMode    = pui8Body[20 + 1];
+            psRecord->ui8ReqType    = pui8Body[20 + 2];
+            psRecord->ui16Len       = (uint16_t)(ui32CapLen - SCI_TRACE_PSEUDO_HDR_LEN);
+            psRecord->pui8Data      = (uint8_t*)&pui8Body[20 + SCI_TRACE_PSEUDO_HDR_LEN];
+        }
+
+        ui32Pos += ui32BlockLen;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static void ReplayTxCB (uint8_t *pui8Buf, uint16_t ui16Len)
+{
+    for (uint16_t i = 0; i < ui16Len; i++)
+    {
+        if (pui8Buf[i] == STX && !bTxInFrame)
+        {
+            bTxInFrame = true;
+            sTxAssembly.ui16Len = 0;
+        }
+        else if (pui8Buf[i] == ETX && bTxInFrame)
+        {
+            bTxInFrame = false;
+
+            if (ui8TxCnt < REPLAY_MAX_TX_FRAMES)
+            {
+                sTxFrames[(ui8TxHead + ui8TxCnt) % REPLAY_MAX_TX_FRAMES] = sTxAssembly;
+                ui8TxCnt++;
+            }
+        }
+        else if (bTxInFrame && sTxAssembly.ui16Len < REPLAY_MAX_FRAME_LEN)
+            sTxAssembly.ui8Data[sTxAssembly.ui16Len++] = pui8Buf[i];
+    }
+}
+
+//=============================================================================
+static teTRANSFER_ACK ReplayGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK ReplaySetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK ReplayCommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK ReplayUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void ReplayHandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+}
+
+//=============================================================================
+static const tsSCI_VALUE_CODEC *ReplayCodec (uint8_t ui8ReqType)
+{
+    // As selected by the master (see _SCIRequestCodec)
+    if (ui8ReqType == eREQUEST_TYPE_HANDSHAKE || ui8ReqType == eREQUEST_TYPE_DOWNSTREAM)
+        return &SCIValueCodecHex;
+
+    return SCIGetValueCodec(eValueMode);
+}
+
+//=============================================================================
+static bool ReplayDecodeRequest (const tsREPLAY_RECORD *psRecord, tsREQUEST *psReq, tuREQUESTVALUE *puVals)
+{
+    static const char cIds[] = {'#', GETVAR_IDENTIFIER, SETVAR_IDENTIFIER, COMMAND_IDENTIFIER, UPSTREAM_IDENTIFIER, DOWNSTREAM_IDENTIFIER, HANDSHAKE_IDENTIFIER};
+    const tsSCI_VALUE_CODEC *psCodec = ReplayCodec(psRecord->ui8ReqType);
+    uint8_t ui8Token[32];
+    uint16_t ui16TokenLen = 0;
+    tuREQUESTVALUE uNum;
+    bool bNum = true;
+
+    psReq->eReqType         = (teREQUEST_TYPE)psRecord->ui8ReqType;
+    psReq->uValArr          = puVals;
+    psReq->ui16ValArrLen    = 0;
+    psReq->pui8Raw          = NULL;
+    psReq->ui16RawLen       = 0;
+    psReq->bNoResponse      = false;
+
+    if (psRecord->ui8ReqType > eREQUEST_TYPE_HANDSHAKE || psRecord->ui8ReqType == eREQUEST_TYPE_DOWNSTREAM)
+        return false;
+
+    // "<num><id><val>,<val>,..."
+    for (uint16_t i = 0; i <= psRecord->ui16Len; i++)
+    {
+        uint8_t ui8Char = i < psRecord->ui16Len ? psRecord->pui8Data[i] : ',';
+
+        if ((bNum && ui8Char == (uint8_t)cIds[psRecord->ui8ReqType]) || (!bNum && ui8Char == ','))
+        {
+            ui8Token[ui16TokenLen] = '\0';
+
+            if (bNum)
+            {
+                if (!psCodec->StrToVal(ui8Token, &uNum))
+                    return false;
+
+                psReq->i16Num = (int16_t)(uint16_t)psCodec->ValToU32(uNum);
+                bNum = false;
+            }
+            else if (ui16TokenLen > 0)
+            {
+                if (psReq->ui16ValArrLen >= MAX_NUM_REQUEST_VALUES || !psCodec->StrToVal(ui8Token, &puVals[psReq->ui16ValArrLen]))
+                    return false;
+
+                psReq->ui16ValArrLen++;
+            }
+
+            ui16TokenLen = 0;
+        }
+        else if (ui16TokenLen < sizeof(ui8Token) - 1)
+            ui8Token[ui16TokenLen++] = ui8Char;
+        else
+            return false;
+    }
+
+    return !bNum;
+}
+
+//=============================================================================
+static bool ReplayIsSingleVarRequest (const tsREPLAY_RECORD *psRecord)
+{
+    tsREQUEST sReq;
+    tuREQUESTVALUE uVals[MAX_NUM_REQUEST_VALUES];
+
+    if (psRecord->ui8Dir != SCI_TRACE_DIR_TX || !ReplayDecodeRequest(psRecord, &sReq, uVals))
+        return false;
+
+    return (sReq.eReqType == eREQUEST_TYPE_GETVAR && sReq.ui16ValArrLen == 0) ||
+           (sReq.eReqType == eREQUEST_TYPE_SETVAR && sReq.ui16ValArrLen == 1);
+}
+
+//=============================================================================
+static bool ReplayStartRequest (const tsREPLAY_RECORD *psRecord, bool bUrgent)
+{
+    tsREQUEST sReq;
+
+    if (!ReplayDecodeRequest(psRecord, &sReq, uReqVals))
+        return false;
+
+    switch (sReq.eReqType)
+    {
+        case eREQUEST_TYPE_GETVAR:
+            return bUrgent ? SCIRequestUrgentGetVar(sReq.i16Num) : SCIRequestGetVar(sReq.i16Num);
+
+        case eREQUEST_TYPE_SETVAR:
+            if (sReq.ui16ValArrLen == 1)
+                return bUrgent ? SCIRequestUrgentSetVar(sReq.i16Num, uReqVals[0]) : SCIRequestSetVar(sReq.i16Num, uReqVals[0]);
+
+            // Batch frame: "num!val,num,val,..."
+            if (sReq.ui16ValArrLen % 2 == 0)
+                return false;
+
+            i16BatchNums[0] = sReq.i16Num;
+            uBatchVals[0] = uReqVals[0];
+
+            for (uint16_t i = 1; i < sReq.ui16ValArrLen; i += 2)
+            {
+                i16BatchNums[(i + 1) / 2] = (int16_t)(uint16_t)SCIGetValueCodec(eValueMode)->ValToU32(uReqVals[i]);
+                uBatchVals[(i + 1) / 2] = uReqVals[i + 1];
+            }
+
+            return SCIRequestSetVarBatch(i16BatchNums, uBatchVals, (sReq.ui16ValArrLen + 1) / 2);
+
+        case eREQUEST_TYPE_COMMAND:
+            return SCIRequestCommand(sReq.i16Num, uReqVals, sReq.ui16ValArrLen);
+
+        case eREQUEST_TYPE_HANDSHAKE:
+            return SCIRequestHandshake();
+
+        default:
+            return false;
+    }
+}
+
+//=============================================================================
+static bool ReplayRunUntil (bool (*Done)(void))
+{
+    for (uint32_t i = 0; i < REPLAY_MAX_SM_CYCLES; i++)
+    {
+        if (Done())
+            return true;
+
+        SCIMasterSM();
+    }
+
+    return Done();
+}
+
+//=============================================================================
+static bool ReplayTxAvailable (void)
+{
+    return ui8TxCnt > 0;
+}
+
+//=============================================================================
+static bool ReplayReceiving (void)
+{
+    return SCIGetProtocolState() == ePROTOCOL_RECEIVING;
+}
+
+//=============================================================================
+static bool ReplayEvaluated (void)
+{
+    tePROTOCOL_STATE eState = SCIGetProtocolState();
+
+    return eState != ePROTOCOL_RECEIVING && eState != ePROTOCOL_EVALUATING;
+}
+
+//=============================================================================
+static void ReplayPace (uint64_t ui64OffsetUs, const struct timespec *psStart)
+{
+    struct timespec sNow, sWait;
+    int64_t i64WaitUs;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    i64WaitUs = (int64_t)ui64OffsetUs - ((int64_t)(sNow.tv_sec - psStart->tv_sec) * 1000000 + (sNow.tv_nsec - psStart->tv_nsec) / 1000);
+
+    if (i64WaitUs > 0)
+    {
+        sWait.tv_sec = i64WaitUs / 1000000;
+        sWait.tv_nsec = (long)(i64WaitUs % 1000000) * 1000;
+        nanosleep(&sWait, NULL);
+    }
+}
+
+//=============================================================================
+static bool ReplayFrame (uint32_t ui32Idx, uint16_t ui16Chunk, bool bPaced, const struct timespec *psStart)
+{
+    const tsREPLAY_RECORD *psRecord = &psRecords[ui32Idx];
+
+    if (psRecord->ui8Dir == SCI_TRACE_DIR_TX)
+    {
+        tsREPLAY_FRAME *psSent;
+
+        // Request of the application (the master is idle instead of sending a follow-up frame)
+        if (ui8TxCnt == 0 && !bUrgentQueued && SCIGetProtocolState() == ePROTOCOL_IDLE)
+        {
+            if (psRecord->ui8ReqType == eREQUEST_TYPE_DOWNSTREAM)
+            {
+                printf("Frame %u: DOWNSTREAM transfers are not supported\n", ui32Idx);
+                return false;
+            }
+
+            if (!ReplayStartRequest(psRecord, false))
+            {
+                printf("Frame %u: Request %.*s could not be started\n", ui32Idx, psRecord->ui16Len, psRecord->pui8Data);
+                return false;
+            }
+        }
+
+        if (!ReplayRunUntil(ReplayTxAvailable))
+        {
+            printf("Frame %u: Master did not send %.*s\n", ui32Idx, psRecord->ui16Len, psRecord->pui8Data);
+            return false;
+        }
+
+        bUrgentQueued = false;
+        psSent = &sTxFrames[ui8TxHead];
+        ui8TxHead = (ui8TxHead + 1) % REPLAY_MAX_TX_FRAMES;
+        ui8TxCnt--;
+
+        if (psSent->ui16Len != psRecord->ui16Len || memcmp(psSent->ui8Data, psRecord->pui8Data, psRecord->ui16Len) != 0)
+        {
+            printf("Frame %u: TX mismatch\n  recorded %.*s\n  sent     %.*s\n", ui32Idx, psRecord->ui16Len, psRecord->pui8Data,
+                   psSent->ui16Len, psSent->ui8Data);
+            return false;
+        }
+    }
+    else
+    {
+        uint8_t ui8Delim = STX;
+
+        // A GETVAR / SETVAR right after this response was queued while the transfer was running
+        if (ui32Idx + 1 < ui32RecordCnt && ReplayIsSingleVarRequest(&psRecords[ui32Idx + 1]))
+        {
+            if (!ReplayStartRequest(&psRecords[ui32Idx + 1], true))
+            {
+                printf("Frame %u: Urgent request could not be queued\n", ui32Idx + 1);
+                return false;
+            }
+
+            bUrgentQueued = true;
+        }
+
+        if (!ReplayRunUntil(ReplayReceiving))
+        {
+            printf("Frame %u: Master is not receiving\n", ui32Idx);
+            return false;
+        }
+
+        if (bPaced)
+            ReplayPace(psRecord->ui64TimeUs - psRecords[0].ui64TimeUs, psStart);
+
+        SCIReceive(&ui8Delim, 1);
+
+        for (uint16_t ui16Pos = 0; ui16Pos < psRecord->ui16Len; ui16Pos += ui16Chunk)
+        {
+            uint16_t ui16Len = psRecord->ui16Len - ui16Pos < ui16Chunk ? psRecord->ui16Len - ui16Pos : ui16Chunk;
+
+            SCIReceive(&psRecord->pui8Data[ui16Pos], ui16Len);
+            SCIMasterSM();
+        }
+
+        ui8Delim = ETX;
+        SCIReceive(&ui8Delim, 1);
+
+        if (!ReplayRunUntil(ReplayEvaluated))
+        {
+            printf("Frame %u: Response not evaluated\n", ui32Idx);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================
+static double ReplayFrameCpuNs (const tsREPLAY_RECORD *psRecord)
+{
+    static uint8_t ui8Buf[REPLAY_MAX_FRAME_LEN];
+    const tsSCI_VALUE_CODEC *psCodec = ReplayCodec(psRecord->ui8ReqType);
+    double dStart;
+
+    if (psRecord->ui8Dir == SCI_TRACE_DIR_RX)
+    {
+        dStart = ReplayCpuNs();
+
+        for (uint32_t i = 0; i < REPLAY_REPETITIONS; i++)
+        {
+            tsRESPONSE sRsp = tsRESPONSE_DEFAULTS;
+
+            // The parser terminates the value strings within the buffer
+            memcpy(ui8Buf, psRecord->pui8Data, psRecord->ui16Len);
+
+            if (psRecord->ui8RecMode == SCI_RECEIVE_MODE_STREAM)
+                SCIMasterStreamParser(ui8Buf, psRecord->ui16Len, &sRsp);
+            else
+                SCIMasterResponseParser(ui8Buf, psRecord->ui16Len, &sRsp, psCodec);
+        }
+    }
+    else
+    {
+        tsREQUEST sReq;
+        tuREQUESTVALUE uVals[MAX_NUM_REQUEST_VALUES];
+        uint16_t ui16Size;
+
+        if (!ReplayDecodeRequest(psRecord, &sReq, uVals))
+            return -1.0;
+
+        dStart = ReplayCpuNs();
+
+        for (uint32_t i = 0; i < REPLAY_REPETITIONS; i++)
+            SCIMasterRequestBuilder(ui8Buf, &ui16Size, REPLAY_MAX_FRAME_LEN, sReq, psCodec);
+    }
+
+    return (ReplayCpuNs() - dStart) / REPLAY_REPETITIONS;
+}
+
+//=============================================================================
+int main (int argc, char **argv)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tsREPLAY_TIMING sTiming[2][eREQUEST_TYPE_HANDSHAKE + 1] = {{{0}}};
+    struct timespec sStart;
+    uint16_t ui16Chunk = REPLAY_MAX_FRAME_LEN;
+    bool bPaced = false;
+    bool bVerbose = false;
+    const char *pcPath = NULL;
+    uint32_t ui32Replayed = 0;
+    double dReplayNs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0)
+            eValueMode = eSCI_VALUE_MODE_FLOAT;
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            ui16Chunk = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0)
+            bPaced = true;
+        else if (strcmp(argv[i], "-v") == 0)
+            bVerbose = true;
+        else
+            pcPath = argv[i];
+    }
+
+    if (pcPath == NULL || ui16Chunk == 0)
+    {
+        printf("Usage: TraceReplay [-f] [-c <bytes>] [-p] [-v] <trace.pcapng>\n");
+        return 2;
+    }
+
+    if (!ReplayLoad(pcPath))
+    {
+        printf("%s could not be read\n", pcPath);
+        return 2;
+    }
+
+    sCbs.BlockingTxExternalCB   = ReplayTxCB;
+    sCbs.GetVarExternalCB       = ReplayGetVarCB;
+    sCbs.SetVarExternalCB       = ReplaySetVarCB;
+    sCbs.CommandExternalCB      = ReplayCommandCB;
+    sCbs.UpstreamExternalCB     = ReplayUpstreamCB;
+    sCbs.HandshakeExternalCB    = ReplayHandshakeCB;
+    SCIMasterInit(sCbs, eValueMode);
+
+    // Behavioral replay
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    dReplayNs = ReplayCpuNs();
+
+    while (ui32Replayed < ui32RecordCnt && ReplayFrame(ui32Replayed, ui16Chunk, bPaced, &sStart))
+        ui32Replayed++;
+
+    dReplayNs = ReplayCpuNs() - dReplayNs;
+
+    if (ui32Replayed == ui32RecordCnt && ui8TxCnt > 0)
+        printf("Master sent %u frames beyond the end of the trace\n", ui8TxCnt);
+
+    printf("%u of %u frames replayed, %.1f us CPU per frame\n", ui32Replayed, ui32RecordCnt,
+           ui32Replayed > 0 ? dReplayNs / 1000.0 / ui32Replayed : 0.0);
+
+    // Parse / build time per frame
+    for (uint32_t i = 0; i < ui32RecordCnt; i++)
+    {
+        const tsREPLAY_RECORD *psRecord = &psRecords[i];
+        double dNs = ReplayFrameCpuNs(psRecord);
+        tsREPLAY_TIMING *psTiming;
+
+        if (dNs < 0.0 || psRecord->ui8ReqType > eREQUEST_TYPE_HANDSHAKE)
+            continue;
+
+        psTiming = &sTiming[psRecord->ui8Dir][psRecord->ui8ReqType];
+        psTiming->ui32Frames++;
+        psTiming->dSumNs += dNs;
+
+        if (dNs > psTiming->dMaxNs)
+            psTiming->dMaxNs = dNs;
+
+        if (bVerbose)
+            printf("%6u %s %-10s %5u %9.1f ns\n", i, psRecord->ui8Dir == SCI_TRACE_DIR_TX ? "build" : "parse",
+                   pcTypeNames[psRecord->ui8ReqType], psRecord->ui16Len, dNs);
+    }
+
+    printf("dir   | type       | frames | mean [ns] | max [ns]\n");
+
+    for (uint8_t ui8Dir = 0; ui8Dir < 2; ui8Dir++)
+    {
+        for (uint8_t ui8Type = 0; ui8Type <= eREQUEST_TYPE_HANDSHAKE; ui8Type++)
+        {
+            const tsREPLAY_TIMING *psTiming = &sTiming[ui8Dir][ui8Type];
+
+            if (psTiming->ui32Frames == 0)
+                continue;
+
+            printf("%-5s | %-10s | %6u | %9.1f | %8.1f\n", ui8Dir == SCI_TRACE_DIR_TX ? "build" : "parse", pcTypeNames[ui8Type],
+                   psTiming->ui32Frames, psTiming->dSumNs / psTiming->ui32Frames, psTiming->dMaxNs);
+        }
+    }
+
+    return ui32Replayed == ui32RecordCnt && ui8TxCnt == 0 ? 0 : 1;
+}
@@ -29,9 +29,9 @@
 typedef struct
 {
     uint8_t     *pui8_bufPtr;   /*!< Pointer to the external buffer. */
-    int16_t     i16_bufIdx;     /*!< Actual buffer index (Last written index). */
-    uint8_t     ui8_bufLen;     /*!< Length of the buffer array. */
-    uint8_t     ui8_bufSpace;   /*!< Actual remaining buffer space. */
+    int32_t     i32_bufIdx;     /*!< Actual buffer index (Last written index). */
+    uint16_t    ui16_bufLen;    /*!< Length of the buffer array. */
+    uint16_t    ui16_bufSpace;  /*!< Actual remaining buffer space. */
     bool        b_ovfl;         /*!< Overflow indicator. */
 }tsFIFO_BUF;
 
@@ -44,9 +44,9 @@ typedef struct
  *
  * @param *p_inst   Pointer to the buffer data structure
  * @param *pui8_buf Pointer to the start of the buffer space
- * @param ui8_bufLen Desired length of the buffer
+ * @param ui16_bufLen Desired length of the buffer
  */
-void fifoBufInit(tsFIFO_BUF* p_inst, uint8_t *pui8_buf, uint8_t ui8_bufLen);
+void fifoBufInit(tsFIFO_BUF* p_inst, uint8_t *pui8_buf, uint16_t ui16_bufLen);
 
 /** \brief Puts one byte into the buffer
  *
@@ -62,7 +62,7 @@ void putElem(tsFIFO_BUF* p_inst, uint8_t ui8_data);
  * @param   **pui8_target Pointer address.
  * @returns Size of the stored data in bytes.
  */
-uint8_t readBuf (tsFIFO_BUF* p_inst, uint8_t **pui8_target);
+uint16_t readBuf (tsFIFO_BUF* p_inst, uint8_t **pui8_target);
 
 /** \brief Empties the buffer
  *
@@ -80,15 +80,15 @@ bool getNextFreeBufSpace(tsFIFO_BUF* p_inst, uint8_t **pui8_target);
 
 /** \brief Increases the buffer index.
  *
- * @param   ui8_size counts about which to increase the index.
+ * @param   ui16_size counts about which to increase the index.
  * @returns True if the operation was successful, false otherwise.
  */
-bool increaseBufIdx(tsFIFO_BUF* p_inst, uint8_t ui8_size);
+bool increaseBufIdx(tsFIFO_BUF* p_inst, uint16_t ui16_size);
 
 /** \brief Returns the actual (last written) buffer index.
  *
  * @returns actual buffer index.
  */
-int16_t getActualIdx(tsFIFO_BUF* p_inst);
+int32_t getActualIdx(tsFIFO_BUF* p_inst);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+/**************************************************************************//**
+ * \file SCICache.h
+ * \author Roman Holderried
+ *
+ * \brief Host-side GETVAR cache on top of the SCI master.
+ *
+ * Keeps the last value and its timestamp per variable. Reads that are younger
+ * than the maximum age given by the caller are served from the cache, reads of
+ * a variable whose GETVAR is already in flight are merged into this request.
+ * SETVARs through the cache invalidate the variable.
+ *
+ * A GETVAR without response is given up after the timeout passed to
+ * SCICacheInit, the master is released then. If the application releases the
+ * master itself, the GETVAR is given up on the next call of SCICacheProcess
+ * (or by SCICacheAbort right away). The merged reads are notified with
+ * eREQUEST_ACK_STATUS_CANCELLED.
+ *
+ * SCICacheGetVarCB must be registered as GetVarExternalCB of the master.
+ * Results of GETVARs that have not been requested by the cache are forwarded
+ * to the callback passed to SCICacheInit.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCICACHE_H_
+#define _SCICACHE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Result delivery of a cache read that needs a GETVAR */
+typedef void (*SCI_CACHE_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
+
+/** \brief Outcome of a cache read */
+typedef enum
+{
+    eSCI_CACHE_HIT      = 0,    /*!< Value served from the cache (no callback).*/
+    eSCI_CACHE_PENDING  = 1,    /*!< Value is going to be delivered by the read callback.*/
+    eSCI_CACHE_BUSY     = 2     /*!< Link busy or no waiter slot left, read must be repeated.*/
+}teSCI_CACHE_RESULT;
+
+/** \brief Cache statistics */
+typedef struct
+{
+    uint32_t ui32Reads;         /*!< Reads through the cache.*/
+    uint32_t ui32Hits;          /*!< Reads served from the cache.*/
+    uint32_t ui32Coalesced;     /*!< Reads merged into a GETVAR in flight.*/
+    uint32_t ui32LinkReads;     /*!< GETVARs issued by the cache.*/
+    uint32_t ui32Invalidations; /*!< Entries invalidated by SETVARs.*/
+    uint32_t ui32Aborts;        /*!< GETVARs given up without response.*/
+}tsSCI_CACHE_STATS;
+
+#define tsSCI_CACHE_STATS_DEFAULTS {0, 0, 0, 0, 0, 0}
+
+/** \brief Cached variable */
+typedef struct
+{
+    int16_t     i16Num;         /*!< Variable number.*/
+    uint32_t    ui32Data;       /*!< Last value.*/
+    uint32_t    ui32Timestamp;  /*!< Time of the last value.*/
+    bool        bValid;         /*!< Value and timestamp are valid.*/
+    bool        bInFlight;      /*!< GETVAR of this variable in flight.*/
+    bool        bUsed;          /*!< Entry is assigned to the variable.*/
+}tsSCI_CACHE_ENTRY;
+
+/** \brief Read waiting for the GETVAR in flight */
+typedef struct
+{
+    int16_t         i16Num;
+    SCI_CACHE_CB    ReadCB;     /*!< NULL if the slot is free.*/
+}tsSCI_CACHE_WAITER;
+
+/** \brief Cache main structure */
+typedef struct
+{
+    tsSCI_CACHE_ENTRY   sEntries[SCI_CACHE_NUM_ENTRIES];
+    tsSCI_CACHE_WAITER  sWaiters[SCI_CACHE_NUM_WAITERS];
+
+    int16_t             i16InFlight;        /*!< Entry of the GETVAR in flight (-1: none).*/
+    uint32_t            ui32InFlightStart;  /*!< Start time of the GETVAR in flight.*/
+    uint32_t            ui32Timeout;        /*!< Response timeout (0: None).*/
+
+    uint32_t            (*GetTimeCB)(void); /*!< Time base of the timestamps / maximum ages.*/
+    GETVAR_CB           GetVarForwardCB;    /*!< Application GETVAR callback.*/
+
+    tsSCI_CACHE_STATS   sStats;
+}tsSCI_CACHE;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes (and empties) the cache.
+ *
+ * @param GetTimeCB         Returns the current time (any unit, used for the maximum ages)
+ * @param ui32Timeout       Response timeout of a GETVAR (unit of GetTimeCB, 0: None)
+ * @param GetVarForwardCB   Application callback for all GETVAR results (may be NULL)
+*/
+void SCICacheInit (uint32_t (*GetTimeCB)(void), uint32_t ui32Timeout, GETVAR_CB GetVarForwardCB);
+
+/** \brief Gives up a GETVAR without response.
+ *
+ * The GETVAR in flight is given up if the master has been released without
+ * its response or if the timeout elapsed. To be called cyclically (next to
+ * SCIMasterSM).
+ */
+void SCICacheProcess (void);
+
+/** \brief Gives up the GETVAR in flight right away.
+ *
+ * To be called if the application releases the master (SCIReleaseProtocol)
+ * while a GETVAR of the cache may be in flight. A late response refreshes the
+ * cache like the result of a foreign GETVAR.
+ *
+ * @returns False if no GETVAR is in flight
+ */
+bool SCICacheAbort (void);
+
+/** \brief GETVAR result callback (to be passed as GetVarExternalCB of the master).*/
+teTRANSFER_ACK SCICacheGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
+
+/** \brief Reads a variable through the cache.
+ *
+ * @param i16Num        Variable number
+ * @param ui32MaxAge    Maximum age of a cached value to be served
+ * @param pui32Data     Destination of the value on a cache hit
+ * @param ReadCB        Result callback if the value must be fetched (NULL: prefetch only)
+ *
+ * @returns Outcome of the read
+*/
+teSCI_CACHE_RESULT SCICacheRead (int16_t i16Num, uint32_t ui32MaxAge, uint32_t *pui32Data, SCI_CACHE_CB ReadCB);
+
+/** \brief Initiates a SETVAR and invalidates the cached value.
+ *
+ * @param i16Num    Variable number
+ * @param uVal      Value to set
+ *
+ * @returns True if the request has been started
+*/
+bool SCICacheSetVar (int16_t i16Num, tuREQUESTVALUE uVal);
+
+/** \brief Invalidates the cached value of a variable.*/
+void SCICacheInvalidate (int16_t i16Num);
+
+/** \brief Returns the cache statistics.
+ *
+ * The hit rate is ui32Hits / ui32Reads, the saved round trips are
+ * ui32Hits + ui32Coalesced.
+*/
+tsSCI_CACHE_STATS SCICacheGetStats (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCICACHE_H_
@@ -0,0 +1,171 @@
+/**************************************************************************//**
+ * \file SCICapture.h
+ * \author Roman Holderried
+ *
+ * \brief Writer of datalogger capture files.
+ *
+ * A capture file holds the samples of the datalogger channels as binary
+ * columns, so it can be memory-mapped and sliced by time without parsing
+ * (reader: Python/SCICapture.py). All fields are little endian, the samples
+ * are stored as received (big endian, file flag SCI_CAPTURE_FLAG_BIG_ENDIAN).
+ *
+ *  - File header (32 bytes): Magic "SCICAPT\x1A", version, number of
+ *    channels, base frequency, flags, start time (Unix time in us, 0 if
+ *    unknown)
+ *  - Channel table (16 bytes per channel): Channel, datatype (teSCI_DATATYPE),
+ *    variable number, divider, record length
+ *  - Blocks: Block header (24 bytes: magic, channel, index of the first
+ *    sample, number of samples, data length), samples of one channel, padded
+ *    to 8 bytes
+ *  - Chunk index (written by SCICaptureClose): One entry (24 bytes) per block
+ *    with its file offset, channel, first sample index and number of samples,
+ *    followed by the footer (24 bytes: index offset, number of entries, magic
+ *    "SCICAPIX")
+ *
+ * The sample index of a channel counts its samples since the start of the
+ * recording, the time of a sample is index * divider / base frequency.
+ * Files without footer (recording aborted, index storage too small) are read
+ * by walking the block headers.
+ *
+ * The writer is append only: All data is passed to the write callback in
+ * file order, so it can stream to a file, a socket or a flash region. The
+ * upstream of a datalogger is written as it arrives (e.g. from the upstream
+ * callback of the master), both the single capture layout and the drain
+ * layout of the continuous mode (see Python/Datalogger.py) are split into
+ * blocks by the writer.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCICAPTURE_H_
+#define _SCICAPTURE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCICommon.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_CAPTURE_VERSION             1
+#define SCI_CAPTURE_MAX_CHANNELS        8   /*!< Channels of a datalogger.*/
+
+#define SCI_CAPTURE_HEADER_LEN          32
+#define SCI_CAPTURE_CHANNEL_LEN         16
+#define SCI_CAPTURE_BLOCK_HEADER_LEN    24
+#define SCI_CAPTURE_INDEX_ENTRY_LEN     24
+#define SCI_CAPTURE_FOOTER_LEN          24
+
+#define SCI_CAPTURE_FLAG_BIG_ENDIAN     0x00000001u     /*!< Samples stored big endian.*/
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Channel metadata (channel table of the file) */
+typedef struct
+{
+    uint8_t     ui8Channel;             /*!< Datalogger channel (1..8).*/
+    uint8_t     ui8Dtype;               /*!< Sample datatype (teSCI_DATATYPE).*/
+    uint16_t    ui16VarNum;             /*!< Logged variable.*/
+    uint32_t    ui32Divider;            /*!< Frequency divider of the channel.*/
+    uint32_t    ui32RecLen;             /*!< Record length (ring length in continuous mode).*/
+}tsSCI_CAPTURE_CHANNEL;
+
+/** \brief Entry of the chunk index */
+typedef struct
+{
+    uint64_t    ui64Offset;             /*!< File offset of the block header.*/
+    uint64_t    ui64FirstIndex;         /*!< Index of the first sample.*/
+    uint32_t    ui32Count;              /*!< Number of samples.*/
+    uint8_t     ui8Channel;
+}tsSCI_CAPTURE_INDEX;
+
+/** \brief Capture file writer */
+typedef struct
+{
+    void                    (*WriteCB)(const uint8_t *pui8Data, uint32_t ui32Len);
+    tsSCI_CAPTURE_CHANNEL   sChannels[SCI_CAPTURE_MAX_CHANNELS];
+    uint8_t                 ui8NumChannels;
+    uint64_t                ui64NextIndex[SCI_CAPTURE_MAX_CHANNELS];    /*!< Index of the next sample per channel.*/
+    bool                    bIndexed[SCI_CAPTURE_MAX_CHANNELS];         /*!< Drain index of the channel received.*/
+    tsSCI_CAPTURE_INDEX     *psIndex;                                   /*!< Chunk index storage (caller).*/
+    uint32_t                ui32IndexSize;
+    uint32_t                ui32IndexCnt;
+    bool                    bIndexOverflow;                             /*!< More blocks than index entries: No index written.*/
+    uint64_t                ui64Offset;                                 /*!< Bytes written.*/
+    uint32_t                ui32Gaps;                                   /*!< Sample index gaps of the continuous mode.*/
+}tsSCI_CAPTURE;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/**
+ * @brief Starts a capture file: Writes the file header and the channel table.
+ *
+ * @param psCapture         Writer
+ * @param WriteCB           Output of the file data (called in file order)
+ * @param psChannels        Channels in the order of the upstream (ascending channel numbers)
+ * @param ui8NumChannels    Number of channels (max. SCI_CAPTURE_MAX_CHANNELS)
+ * @param ui32BaseFrequency Base frequency of the datalogger in Hz
+ * @param ui64StartTimeUs   Start of the recording (Unix time in us, 0 if unknown)
+ * @param psIndex           Storage of the chunk index (one entry per block, NULL: No index)
+ * @param ui32IndexSize     Number of index entries
+ *
+ * @returns false if the channel set is invalid
+ */
+bool SCICaptureOpen (tsSCI_CAPTURE *psCapture, void (*WriteCB)(const uint8_t *pui8Data, uint32_t ui32Len),
+                     const tsSCI_CAPTURE_CHANNEL *psChannels, uint8_t ui8NumChannels, uint32_t ui32BaseFrequency,
+                     uint64_t ui64StartTimeUs, tsSCI_CAPTURE_INDEX *psIndex, uint32_t ui32IndexSize);
+
+/**
+ * @brief Writes a block of samples of one channel.
+ *
+ * @param psCapture         Writer
+ * @param ui8Channel        Datalogger channel
+ * @param ui64FirstIndex    Index of the first sample
+ * @param pui8Samples       Samples (big endian, as received)
+ * @param ui32Count         Number of samples
+ *
+ * @returns false if the channel is not part of the file
+ */
+bool SCICaptureWriteBlock (tsSCI_CAPTURE *psCapture, uint8_t ui8Channel, uint64_t ui64FirstIndex, const uint8_t *pui8Samples, uint32_t ui32Count);
+
+/**
+ * @brief Writes the upstream of a single capture (record length samples per
+ * channel, channels concatenated). Successive captures continue the sample
+ * indices.
+ *
+ * @returns Number of samples written (less than expected if the upstream is short)
+ */
+uint32_t SCICaptureWriteUpstream (tsSCI_CAPTURE *psCapture, const uint8_t *pui8Data, uint32_t ui32Len);
+
+/**
+ * @brief Writes the upstream of a continuous mode drain (per channel: UINT32
+ * index of the first sample, UINT16 number of samples, samples). The 32 bit
+ * sample counter is unwrapped, samples already written are skipped and gaps
+ * are counted (ui32Gaps).
+ *
+ * @returns Number of samples written
+ */
+uint32_t SCICaptureWriteDrain (tsSCI_CAPTURE *psCapture, const uint8_t *pui8Data, uint32_t ui32Len);
+
+/**
+ * @brief Finishes the file: Writes the chunk index and the footer (no index
+ * if the index storage was too small).
+ */
+void SCICaptureClose (tsSCI_CAPTURE *psCapture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCICAPTURE_H_
@@ -13,10 +13,25 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
+#include <stdint.h>
 
 /******************************************************************************
  * defines
  *****************************************************************************/
+// Version of the protocol (exchanged by the handshake)
+#define SCI_PROTOCOL_VERSION        1
+
+// Number of values of a handshake request / response
+#define SCI_HANDSHAKE_NUM_VALUES    5
+
+// Bit of a value mode within the value mode mask of the capabilities
+#define SCI_VALUE_MODE_BIT(eMode)   (1u << (eMode))
+
+// Optional feature bits of the capabilities
+#define SCI_FEATURE_UPSTREAM             0x0001
+#define SCI_FEATURE_DOWNSTREAM           0x0002
+#define SCI_FEATURE_SETVAR_BATCH         0x0004
+#define SCI_FEATURE_UPSTREAM_COMPRESSION 0x0008
 
 /******************************************************************************
  * Type definitions
@@ -34,7 +49,8 @@ typedef enum
     eSCI_ERROR_PARAMETER_CONVERSION_FAILED,
     eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET,
     eSCI_ERROR_MESSAGE_EXCEEDS_TX_BUFFER_SIZE,
-    eSCI_ERROR_FEATURE_NOT_IMPLEMENTED
+    eSCI_ERROR_FEATURE_NOT_IMPLEMENTED,
+    eSCI_ERROR_DOWNSTREAM_SOURCE_FAILED
 }teSCI_ERROR;
 
 /** \brief Request acknowledge enumeration */
@@ -44,9 +60,52 @@ typedef enum
     eREQUEST_ACK_STATUS_SUCCESS_DATA        = 1,
     eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM    = 2,
     eREQUEST_ACK_STATUS_ERROR               = 3,
-    eREQUEST_ACK_STATUS_UNKNOWN             = 4
+    eREQUEST_ACK_STATUS_UNKNOWN             = 4,
+    eREQUEST_ACK_STATUS_CANCELLED           = 5     /*!< Transfer aborted by the master (SCICancel).*/
 }teREQUEST_ACKNOWLEDGE;
 
+/** \brief Number format of the values within the dataframes */
+typedef enum
+{
+    eSCI_VALUE_MODE_HEX     = 0,    /*!< Raw value bits as hexadecimal number.*/
+    eSCI_VALUE_MODE_FLOAT   = 1     /*!< Value as decimal (floating point) number.*/
+}teSCI_VALUE_MODE;
+
+/** \brief Datatypes of variables and function arguments / return values.
+ * 
+ * Note: The values are used as indizes of the codec tables!
+ */
+typedef enum
+{
+    eSCI_DTYPE_UINT8    = 0,
+    eSCI_DTYPE_INT8     = 1,
+    eSCI_DTYPE_UINT16   = 2,
+    eSCI_DTYPE_INT16    = 3,
+    eSCI_DTYPE_UINT32   = 4,
+    eSCI_DTYPE_INT32    = 5,
+    eSCI_DTYPE_F32      = 6,
+    eSCI_DTYPE_NUM
+}teSCI_DATATYPE;
+
+/** \brief Capabilities of a communication partner (handshake).
+ * 
+ * Both sides exchange their own capabilities in HEX format and apply the same 
+ * rule to agree on the communication settings without a further round trip:
+ * - Frame lengths: Minimum of the own RX (TX) length and the peer TX (RX) length.
+ * - Value modes / features: Intersection of both masks.
+ * - Value mode: HEX if supported by both (faster and lossless), FLOAT otherwise.
+ */
+typedef struct
+{
+    uint16_t ui16ProtocolVersion;   /*!< Protocol version (SCI_PROTOCOL_VERSION).*/
+    uint16_t ui16RxPacketLength;    /*!< Maximum payload length of received frames.*/
+    uint16_t ui16TxPacketLength;    /*!< Maximum payload length of transmitted frames.*/
+    uint16_t ui16ValueModes;        /*!< Supported value modes (SCI_VALUE_MODE_BIT mask).*/
+    uint16_t ui16Features;          /*!< Supported optional features (SCI_FEATURE_* mask).*/
+}tsSCI_CAPABILITIES;
+
+#define tsSCI_CAPABILITIES_DEFAULTS {0, 0, 0, 0, 0}
+
 /** \brief Return value of the Transfer callbacks*/
 typedef enum
 {
@@ -0,0 +1,124 @@
+/**************************************************************************//**
+ * \file SCICompress.h
+ * \author Roman Holderried
+ *
+ * \brief Compression of UPSTREAM payloads.
+ *
+ * Datalogger and other bulk upstreams mostly carry slowly varying samples.
+ * The delta codecs interpret the payload as big endian words of 1, 2 or 4
+ * bytes and transmit the difference to the previous word, zig-zag mapped
+ * (small negative and positive differences become small numbers) and
+ * encoded as a varint (7 bits per byte, MSB set: More bytes follow). A
+ * difference below 64 takes one byte, so 16 bit samples shrink to about half
+ * and 32 bit samples to about a quarter. A last incomplete word is padded
+ * with zeros, the decoder drops the padding by the decompressed length.
+ *
+ * The compression is negotiated by the handshake (SCI_FEATURE_UPSTREAM_COMPRESSION).
+ * Afterwards a slave may answer a COMMAND with a compressed upstream:
+ *
+ *      <num>:UPS;<wire length>;<codec>,<decompressed length>
+ *
+ * The wire length counts the compressed bytes transferred by the upstream
+ * frames. The slave sends the upstream uncompressed (UPS;<length>) if the
+ * compression does not pay off (SCICompress returns 0).
+ *
+ * The decoder works incrementally: Every upstream frame is decompressed as
+ * it arrives, a varint may be split between frames.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCICOMPRESS_H_
+#define _SCICOMPRESS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_COMPRESS_MAX_WORD_LEN   4   /*!< Largest word of the delta codecs (minimum output space of SCIDecompress).*/
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Upstream codecs */
+typedef enum
+{
+    eSCI_COMPRESS_NONE      = 0,
+    eSCI_COMPRESS_DELTA8    = 1,    /*!< Delta / zig-zag varint of 8 bit words.*/
+    eSCI_COMPRESS_DELTA16   = 2,    /*!< Delta / zig-zag varint of 16 bit words.*/
+    eSCI_COMPRESS_DELTA32   = 3,    /*!< Delta / zig-zag varint of 32 bit words.*/
+    eSCI_COMPRESS_NUM
+}teSCI_COMPRESS_CODEC;
+
+/** \brief Incremental decoder */
+typedef struct
+{
+    uint8_t     ui8WordLen;         /*!< Word length of the codec in bytes.*/
+    uint32_t    ui32Prev;           /*!< Previous word.*/
+    uint32_t    ui32Acc;            /*!< Varint in progress.*/
+    uint8_t     ui8Shift;           /*!< Bits of the varint in progress (0: None).*/
+    uint32_t    ui32RawLen;         /*!< Decompressed length.*/
+    uint32_t    ui32RawCnt;         /*!< Bytes decompressed so far.*/
+    bool        bError;             /*!< Malformed data (varint too long, data beyond the decompressed length).*/
+}tsSCI_DECOMPRESS;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/**
+ * @brief Compresses a payload.
+ *
+ * @param eCodec        Codec
+ * @param pui8Src       Payload
+ * @param ui32Len       Length of the payload
+ * @param pui8Dst       Compressed data
+ * @param ui32DstSize   Size of the destination
+ *
+ * @returns Length of the compressed data (0: Not smaller than the payload or
+ *          destination too small, the payload is to be sent uncompressed)
+ */
+uint32_t SCICompress (teSCI_COMPRESS_CODEC eCodec, const uint8_t *pui8Src, uint32_t ui32Len, uint8_t *pui8Dst, uint32_t ui32DstSize);
+
+/**
+ * @brief Prepares the decoder of a compressed upstream.
+ *
+ * @returns false if the codec is unknown
+ */
+bool SCIDecompressInit (tsSCI_DECOMPRESS *psDec, teSCI_COMPRESS_CODEC eCodec, uint32_t ui32RawLen);
+
+/**
+ * @brief Decompresses a part of the compressed data.
+ *
+ * Decoding stops if less than SCI_COMPRESS_MAX_WORD_LEN bytes of output space
+ * are left, the rest of the input is to be passed again.
+ *
+ * @param psDec         Decoder
+ * @param pui8Src       Compressed data
+ * @param ui32Len       Length of the compressed data
+ * @param pui8Dst       Decompressed data
+ * @param ui32DstSize   Size of the destination (at least SCI_COMPRESS_MAX_WORD_LEN)
+ * @param pui32Produced Number of decompressed bytes
+ *
+ * @returns Number of compressed bytes consumed
+ */
+uint32_t SCIDecompress (tsSCI_DECOMPRESS *psDec, const uint8_t *pui8Src, uint32_t ui32Len,
+                        uint8_t *pui8Dst, uint32_t ui32DstSize, uint32_t *pui32Produced);
+
+/** \brief True if the upstream has been decompressed completely and without error.*/
+bool SCIDecompressDone (const tsSCI_DECOMPRESS *psDec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCICOMPRESS_H_
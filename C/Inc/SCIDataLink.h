@@ -34,8 +34,8 @@
  *****************************************************************************/
 
 typedef void(*DBG_FCN_CB)(void);
-typedef void(*BLOCKING_TX_CB)(uint8_t*, uint8_t);
-typedef uint8_t(*NONBLOCKING_TX_CB)(uint8_t*, uint8_t);
+typedef void(*BLOCKING_TX_CB)(uint8_t*, uint16_t);
+typedef uint16_t(*NONBLOCKING_TX_CB)(uint8_t*, uint16_t);
 typedef bool(*GET_BUSY_STATE_CB)(void);
 
 typedef enum
@@ -87,18 +87,19 @@ typedef struct
     struct 
     {
         uint8_t * pui8_buf;
-        uint8_t ui8_bufLen;
+        uint16_t ui16_bufLen;
     }sTxInfo;
 
     struct
     {
         uint32_t ui32BytesToGo;
-        uint8_t ui8MsgByteCnt;
+        uint16_t ui16MsgByteCnt;
+        uint16_t ui16MaxMsgLen;     /*!< Maximum payload length of a received stream frame.*/
     }sRxInfo;
 
 }tsDATALINK;
 
-#define tsDATALINK_DEFAULTS {eDATALINK_RSTATE_IDLE, eDATALINK_TSTATE_IDLE, eDATALINK_DBGSTATE_IDLE, {NULL}, NULL, NULL, NULL, {NULL, 0}, {0,0}}
+#define tsDATALINK_DEFAULTS {eDATALINK_RSTATE_IDLE, eDATALINK_TSTATE_IDLE, eDATALINK_DBGSTATE_IDLE, {NULL}, NULL, NULL, NULL, {NULL, 0}, {0,0,0}}
 
 
 
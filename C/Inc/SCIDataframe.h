@@ -30,57 +30,90 @@
 #define COMMAND_IDENTIFIER      ':'
 #define UPSTREAM_IDENTIFIER     '>'
 #define DOWNSTREAM_IDENTIFIER   '<'
+#define HANDSHAKE_IDENTIFIER    '%'
 
 #define REQUEST_ACKNOWLEDGE_NOT_FOUND   -1
 
 /******************************************************************************
  * Type definitions
  *****************************************************************************/
+/** \brief Value codec of a number format.
+ * 
+ * The codec is selected once (on initialization) and passed to the builder 
+ * and parser functions, which hence do not branch on the number format.
+ */
+typedef struct
+{
+    teSCI_VALUE_MODE        eMode;                                          /*!< Number format of the codec.*/
+    uint8_t                 (*NumToStr)(uint8_t *pui8Buf, int16_t i16Num);  /*!< Request number to ASCII.*/
+    uint8_t                 (*ValToStr)(uint8_t *pui8Buf, tuREQUESTVALUE uVal); /*!< Value to ASCII.*/
+    bool                    (*StrToVal)(uint8_t *pui8Str, tuREQUESTVALUE *puVal); /*!< Terminated ASCII string to value.*/
+    uint32_t                (*ValToU32)(tuREQUESTVALUE uVal);               /*!< Value to integer (numbers, lengths, error codes).*/
+    const SCI_DECODE_FCN    *pDecodeTable;                                  /*!< Typed value decoders (indexed by teSCI_DATATYPE).*/
+    const SCI_ENCODE_FCN    *pEncodeTable;                                  /*!< Typed value encoders (indexed by teSCI_DATATYPE).*/
+}tsSCI_VALUE_CODEC;
+
+/******************************************************************************
+ * Global variable declarations
+ *****************************************************************************/
+extern const tsSCI_VALUE_CODEC SCIValueCodecHex;
+extern const tsSCI_VALUE_CODEC SCIValueCodecFloat;
 
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
 
+/** \brief Returns the value codec of a number format.
+ * 
+ * @param eMode         Number format
+ * 
+ * @returns Pointer to the (constant) codec
+*/
+const tsSCI_VALUE_CODEC *SCIGetValueCodec(teSCI_VALUE_MODE eMode);
+
 /** \brief Formulates the dataframe of an SCI Request.
  * 
  * @param pui8Buf       Pointer to the message buffer
- * @param pui8Size      Pointer to a variable that holds the actual byte count of the packet
+ * @param pui16Size     Pointer to a variable that holds the actual byte count of the packet
+ * @param ui16MaxSize   Maximum payload length of the packet (negotiated TX packet length)
  * @param sReq          Structure of type tsREQUEST holding all the relevant data
+ * @param psCodec       Value codec of the number format to use
  * 
  * @returns Error indicator
 */
-teSCI_ERROR SCIMasterRequestBuilder(uint8_t *pui8Buf, uint8_t *pui8Size, tsREQUEST sReq);
+teSCI_ERROR SCIMasterRequestBuilder(uint8_t *pui8Buf, uint16_t *pui16Size, uint16_t ui16MaxSize, tsREQUEST sReq, const tsSCI_VALUE_CODEC *psCodec);
 
 /** \brief Parses the SCI response from the device (transfer).
  * 
  * @param pui8Buf       Pointer to the message buffer
- * @param ui8MsgSize    Size of the message to be analyzed 
+ * @param ui16MsgSize   Size of the message to be analyzed 
  * @param pRsp          pointer to the response data structure
+ * @param psCodec       Value codec of the number format to use
  * 
  * @returns Error indicator
 */
-teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8MsgSize, tsRESPONSE *pRsp);
+teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint16_t ui16MsgSize, tsRESPONSE *pRsp, const tsSCI_VALUE_CODEC *psCodec);
 
 /** \brief Parses the SCI response from the device (stream).
  * 
  * @param pui8Buf       Pointer to the message buffer
- * @param ui8MsgSize    Size of the message to be analyzed 
+ * @param ui16MsgSize   Size of the message to be analyzed 
  * @param pRsp          pointer to the response data structure
  * 
  * @returns Error indicator
 */
-teSCI_ERROR SCIMasterStreamParser(uint8_t* pui8Buf, uint8_t ui8MsgSize, tsRESPONSE *pRsp);
+teSCI_ERROR SCIMasterStreamParser(uint8_t* pui8Buf, uint16_t ui16MsgSize, tsRESPONSE *pRsp);
 
 /** \brief Internal function to check the acknowledge string of the messages
  * 
  * The function expects the acknowledge string at the beginning of the buffer segment.
  * 
  * @param pui8Buf       Pointer to the Buffer segment to analyse
- * @param ui8BytesToGo  Remaining characters to the end of the buffer segment
+ * @param i32BytesToGo  Remaining characters to the end of the buffer segment
  * 
  * @returns Acknowledge identificator (-1 if no Acknowledge was found). 
  * */
-int16_t _CheckAcknowledge (uint8_t *pui8Buf, uint8_t ui8BytesToGo);
+int16_t _CheckAcknowledge (uint8_t *pui8Buf, int32_t i32BytesToGo);
 
 
 
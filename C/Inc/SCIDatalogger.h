@@ -0,0 +1,260 @@
+/**************************************************************************//**
+ * \file SCIDatalogger.h
+ * \author Roman Holderried
+ *
+ * \brief Datalogger client on top of the SCI master (C counterpart of
+ * Python/Datalogger.py).
+ *
+ * The command numbers of the datalogger functions are configured like in
+ * DataloggerCfg.py (0: Function not active). The client keeps the channel
+ * table and the budget of the onboard buffer, so invalid registrations are
+ * rejected without a request.
+ *
+ * Operations are queued and sent by SCIDataloggerProcess whenever the master
+ * is idle, so a whole sequence (e.g. register, initialize, start) can be
+ * issued at once. The channel table, the buffer budget and the initialized
+ * state are updated when an operation is queued. DoneCB reports the result of
+ * every operation. A failed operation cancels the operations queued behind it
+ * (reported with eREQUEST_ACK_STATUS_CANCELLED). Failed or cancelled
+ * registrations release their channel again, failed or cancelled
+ * initializations clear the initialized state.
+ *
+ * The GetLogData upstream is demultiplexed into the sample buffers of the
+ * channels (passed at registration) as the frames arrive, the upstream is not
+ * buffered as a whole. A single capture (SCIDataloggerGetData) holds record
+ * length samples per channel, a drain of the continuous mode
+ * (SCIDataloggerDrain) the samples written since the last drain (per channel:
+ * UINT32 index of the first sample, UINT16 number of samples, samples). The
+ * channels are concatenated in ascending channel order. Samples are stored as
+ * received (big endian), as expected by SCICaptureWriteBlock.
+ *
+ * The result callbacks of the client must be registered with the master:
+ * SCIDataloggerGetVarCB (GetVarExternalCB), SCIDataloggerCommandCB
+ * (CommandExternalCB), SCIDataloggerUpstreamCB (UpstreamExternalCB) and
+ * SCIDataloggerUpstreamDataCB (UpstreamDataExternalCB). Results of other
+ * requests are forwarded to the callbacks in the configuration (other
+ * upstreams are delivered incrementally as well). The COMMAND results are
+ * read from CommandExternalCB, so CommandDataExternalCB must not be used
+ * together with the client.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIDATALOGGER_H_
+#define _SCIDATALOGGER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_DLOG_MAX_CHANNELS       8   /*!< Channels of a datalogger.*/
+#define SCI_DLOG_NUM_CHANNEL_INFO   5   /*!< Result values of GetChannelInfo.*/
+
+#define SCI_DLOG_OP_MODE_SINGLE     0   /*!< Record length samples per start.*/
+#define SCI_DLOG_OP_MODE_CONTINUOUS 1   /*!< Ring buffer, drained cyclically.*/
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Datalogger operations */
+typedef enum
+{
+    eSCI_DLOG_OP_NONE           = 0,
+    eSCI_DLOG_OP_OPEN           = 1,    /*!< Base frequency and version (queued by SCIDataloggerInit).*/
+    eSCI_DLOG_OP_REGISTER       = 2,
+    eSCI_DLOG_OP_INITIALIZE     = 3,
+    eSCI_DLOG_OP_START          = 4,
+    eSCI_DLOG_OP_STOP           = 5,
+    eSCI_DLOG_OP_GET_DATA       = 6,
+    eSCI_DLOG_OP_DRAIN          = 7,
+    eSCI_DLOG_OP_CHANNEL_INFO   = 8,
+    eSCI_DLOG_OP_RESET          = 9,
+    eSCI_DLOG_OP_SET_OP_MODE    = 10
+}teSCI_DLOG_OP;
+
+/** \brief Command numbers of the datalogger functions (0: Not active) */
+typedef struct
+{
+    int16_t i16GetDataloggerVersion;
+    int16_t i16RegisterLogFromVarStruct;
+    int16_t i16InitializeDatalogger;
+    int16_t i16StartDatalogger;
+    int16_t i16StopDatalogger;
+    int16_t i16GetLogData;
+    int16_t i16GetChannelInfo;
+    int16_t i16ResetDatalogger;
+    int16_t i16SetOpMode;
+    int16_t i16BaseFrequencyVar;        /*!< Variable holding the base frequency (negative: Not read).*/
+}tsSCI_DLOG_COMMANDS;
+
+/** \brief Datalogger client configuration */
+typedef struct
+{
+    tsSCI_DLOG_COMMANDS sCommands;
+    uint8_t             ui8Index;           /*!< Index of the datalogger on the device.*/
+    uint32_t            ui32MaxNumBytes;    /*!< Size of the onboard buffer.*/
+
+    // Result of an operation (ui8Channel: Channel of REGISTER / CHANNEL_INFO, may be NULL)
+    void                (*DoneCB)(teSCI_DLOG_OP eOp, uint8_t ui8Channel, teREQUEST_ACKNOWLEDGE eAck, uint16_t ui16ErrNum);
+
+    // Callbacks for the results of other requests (may be NULL)
+    GETVAR_CB           GetVarForwardCB;
+    COMMAND_CB          CommandForwardCB;
+    UPSTREAM_CB         UpstreamForwardCB;
+    UPSTREAM_DATA_CB    UpstreamDataForwardCB;
+}tsSCI_DLOG_CONFIG;
+
+/** \brief Registered channel */
+typedef struct
+{
+    uint8_t         ui8Channel;         /*!< Datalogger channel (1..SCI_DLOG_MAX_CHANNELS).*/
+    teSCI_DATATYPE  eDtype;             /*!< Sample datatype.*/
+    uint16_t        ui16VarNum;         /*!< Logged variable.*/
+    uint16_t        ui16Divider;        /*!< Frequency divider of the channel.*/
+    uint32_t        ui32RecLen;         /*!< Record length (ring length in continuous mode).*/
+
+    uint8_t         *pui8Samples;       /*!< Sample buffer (caller, NULL: Samples are discarded).*/
+    uint32_t        ui32SamplesSize;    /*!< Size of the sample buffer in bytes.*/
+    uint32_t        ui32Count;          /*!< Samples of the last capture / drain in the buffer.*/
+    uint32_t        ui32FirstIndex;     /*!< Device index of the first sample of the last drain.*/
+    uint32_t        ui32Dropped;        /*!< Samples not fitting into the buffer (last capture / drain).*/
+}tsSCI_DLOG_CHANNEL;
+
+/** \brief Datalogger state */
+typedef struct
+{
+    uint8_t     ui8VersionMajor;
+    uint8_t     ui8VersionMinor;
+    uint8_t     ui8Revision;
+    uint32_t    ui32BaseFrequency;                              /*!< Base frequency in Hz (0: Unknown).*/
+    uint32_t    ui32NumBytesLeft;                               /*!< Budget of the onboard buffer.*/
+    bool        bInitialized;                                   /*!< Channels initialized since the last registration.*/
+    uint32_t    ui32ChannelInfo[SCI_DLOG_NUM_CHANNEL_INFO];     /*!< Result of the last GetChannelInfo.*/
+}tsSCI_DLOG_INFO;
+
+/** \brief Queued operation */
+typedef struct
+{
+    teSCI_DLOG_OP   eOp;
+    uint8_t         ui8Channel;
+    uint32_t        ui32Arg;            /*!< Operation mode (SET_OP_MODE), reset generation (REGISTER).*/
+}tsSCI_DLOG_OPERATION;
+
+/** \brief Datalogger client main structure */
+typedef struct
+{
+    tsSCI_DLOG_CONFIG       sConfig;
+    tsSCI_DLOG_INFO         sInfo;
+    tsSCI_DLOG_CHANNEL      sChannels[SCI_DLOG_MAX_CHANNELS];   /*!< Indexed by channel - 1.*/
+    bool                    bRegistered[SCI_DLOG_MAX_CHANNELS];
+    uint32_t                ui32Generation; /*!< Number of resets (channels of a failed registration are only released within the same generation).*/
+
+    tsSCI_DLOG_OPERATION    sQueue[SCI_DLOG_QUEUE_LENGTH];
+    uint8_t                 ui8Head;        /*!< Index of the oldest operation.*/
+    uint8_t                 ui8Cnt;         /*!< Number of queued operations.*/
+
+    tsSCI_DLOG_OPERATION    sActive;        /*!< Operation in progress (eSCI_DLOG_OP_NONE: None).*/
+    uint8_t                 ui8Step;        /*!< Request of the operation in progress.*/
+    bool                    bInFlight;      /*!< A request of the operation is on the link.*/
+    teREQUEST_TYPE          eInFlightType;  /*!< Type of the request on the link (GETVAR or COMMAND).*/
+    int16_t                 i16InFlightNum; /*!< Number of the request on the link.*/
+
+    /** \brief Demultiplexer of the GetLogData upstream */
+    struct
+    {
+        uint8_t     ui8Channel;             /*!< Channel of the current segment (0: Upstream finished).*/
+        bool        bHeader;                /*!< Drain header of the channel in progress.*/
+        uint8_t     ui8Header[6];
+        uint8_t     ui8HeaderCnt;
+        uint32_t    ui32Remaining;          /*!< Sample bytes left in the current segment.*/
+        uint32_t    ui32Offset;             /*!< Sample bytes of the current segment received.*/
+    }sDemux;
+}tsSCI_DATALOGGER;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes the client and queues the query of the base frequency
+ * and the version (eSCI_DLOG_OP_OPEN).*/
+void SCIDataloggerInit (tsSCI_DLOG_CONFIG sConfig);
+
+/** \brief Registers a channel.
+ *
+ * @param ui16VarNum        Variable to log
+ * @param eDtype            Datatype of the variable
+ * @param ui32RecLen        Number of samples to record
+ * @param ui16Divider       Frequency divider of the channel (0: 1)
+ * @param ui8Channel        Channel to use (0: Next free channel)
+ * @param pui8Samples       Sample buffer of the channel (NULL: Samples are discarded)
+ * @param ui32SamplesSize   Size of the sample buffer in bytes
+ *
+ * @returns Channel (0: Function not active, no channel left, channel assigned
+ *          or record length exceeding the budget)
+ */
+uint8_t SCIDataloggerRegister (uint16_t ui16VarNum, teSCI_DATATYPE eDtype, uint32_t ui32RecLen, uint16_t ui16Divider,
+                               uint8_t ui8Channel, uint8_t *pui8Samples, uint32_t ui32SamplesSize);
+
+/** \brief Initializes the registered channels (required before the start).*/
+bool SCIDataloggerInitialize (void);
+
+/** \brief Starts the initialized datalogger.*/
+bool SCIDataloggerStart (void);
+
+/** \brief Stops the datalogger.*/
+bool SCIDataloggerStop (void);
+
+/** \brief Fetches a single capture into the sample buffers.*/
+bool SCIDataloggerGetData (void);
+
+/** \brief Fetches the samples written since the last drain into the sample
+ * buffers (continuous mode).*/
+bool SCIDataloggerDrain (void);
+
+/** \brief Queries the channel info (result in tsSCI_DLOG_INFO).*/
+bool SCIDataloggerGetChannelInfo (uint8_t ui8Channel);
+
+/** \brief Resets the datalogger: All channels are released.*/
+bool SCIDataloggerReset (void);
+
+/** \brief Sets the operation mode (SCI_DLOG_OP_MODE_SINGLE / SCI_DLOG_OP_MODE_CONTINUOUS).*/
+bool SCIDataloggerSetOpMode (uint32_t ui32Mode);
+
+/** \brief Sends the next queued request if the master is idle.
+ *
+ * To be called cyclically (next to SCIMasterSM).
+ */
+void SCIDataloggerProcess (void);
+
+/** \brief True if no operation is queued or in progress.*/
+bool SCIDataloggerIsIdle (void);
+
+/** \brief Returns a registered channel (NULL if not registered).*/
+const tsSCI_DLOG_CHANNEL* SCIDataloggerGetChannel (uint8_t ui8Channel);
+
+/** \brief Returns the datalogger state.*/
+tsSCI_DLOG_INFO SCIDataloggerGetInfo (void);
+
+/** \brief Result callbacks (to be passed as the external callbacks of the master).*/
+teTRANSFER_ACK SCIDataloggerGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
+teTRANSFER_ACK SCIDataloggerCommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
+teTRANSFER_ACK SCIDataloggerUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt);
+void SCIDataloggerUpstreamDataCB (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Offset, uint16_t ui16DataCnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCIDATALOGGER_H_
@@ -0,0 +1,103 @@
+/**************************************************************************//**
+ * \file SCIDescriptor.h
+ * \author Roman Holderried
+ *
+ * \brief Typed variable and function descriptors.
+ * 
+ * Descriptors are built with the macros below and are meant to be defined as
+ * constants at file scope, e.g.:
+ * 
+ * static const tsSCI_VARIABLE sTempAct = SCI_VARIABLE(1, INT32);
+ * static const tsSCI_FUNCTION sGetVersion = 
+ *      SCI_FUNCTION(5, SCI_TYPES(UINT8), SCI_TYPES(UINT8, UINT8, UINT8));
+ * 
+ * Values are converted from / to the user storage by the codec tables of the
+ * active value mode, which are indexed by the datatype. There is no type 
+ * switch on the request path.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIDESCRIPTOR_H_
+#define _SCIDESCRIPTOR_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "SCICommon.h"
+#include "SCITransfer.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+/** \brief Maps a short type name (UINT8, INT16, F32, ...) to its teSCI_DATATYPE value.*/
+#define SCI_DTYPE(dtype)    eSCI_DTYPE_##dtype
+
+#define _SCI_DTYPE_1(a)                 SCI_DTYPE(a)
+#define _SCI_DTYPE_2(a, b)              SCI_DTYPE(a), SCI_DTYPE(b)
+#define _SCI_DTYPE_3(a, b, c)           SCI_DTYPE(a), _SCI_DTYPE_2(b, c)
+#define _SCI_DTYPE_4(a, b, c, d)        SCI_DTYPE(a), _SCI_DTYPE_3(b, c, d)
+#define _SCI_DTYPE_5(a, b, c, d, e)     SCI_DTYPE(a), _SCI_DTYPE_4(b, c, d, e)
+#define _SCI_DTYPE_6(a, b, c, d, e, f)  SCI_DTYPE(a), _SCI_DTYPE_5(b, c, d, e, f)
+#define _SCI_DTYPE_7(a, b, c, d, e, f, g)               SCI_DTYPE(a), _SCI_DTYPE_6(b, c, d, e, f, g)
+#define _SCI_DTYPE_8(a, b, c, d, e, f, g, h)            SCI_DTYPE(a), _SCI_DTYPE_7(b, c, d, e, f, g, h)
+#define _SCI_DTYPE_9(a, b, c, d, e, f, g, h, i)         SCI_DTYPE(a), _SCI_DTYPE_8(b, c, d, e, f, g, h, i)
+#define _SCI_DTYPE_10(a, b, c, d, e, f, g, h, i, j)     SCI_DTYPE(a), _SCI_DTYPE_9(b, c, d, e, f, g, h, i, j)
+#define _SCI_DTYPE_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, NAME, ...) NAME
+#define _SCI_DTYPE_LIST(...)  _SCI_DTYPE_SELECT(__VA_ARGS__, _SCI_DTYPE_10, _SCI_DTYPE_9, _SCI_DTYPE_8, _SCI_DTYPE_7, \
+                              _SCI_DTYPE_6, _SCI_DTYPE_5, _SCI_DTYPE_4, _SCI_DTYPE_3, _SCI_DTYPE_2, _SCI_DTYPE_1, 0)(__VA_ARGS__)
+
+/** \brief Constant type list (up to 10 types) plus its length, e.g. SCI_TYPES(UINT8, F32).*/
+#define SCI_TYPES(...)      ((const teSCI_DATATYPE[]){_SCI_DTYPE_LIST(__VA_ARGS__)}), \
+                            ((uint8_t)(sizeof((const teSCI_DATATYPE[]){_SCI_DTYPE_LIST(__VA_ARGS__)}) / sizeof(teSCI_DATATYPE)))
+
+/** \brief Empty type list.*/
+#define SCI_NO_TYPES        NULL, 0
+
+/** \brief Variable descriptor initializer.*/
+#define SCI_VARIABLE(num, dtype)                {(num), SCI_DTYPE(dtype)}
+
+/** \brief Function descriptor initializer (argument and return type lists built by SCI_TYPES / SCI_NO_TYPES).*/
+#define SCI_FUNCTION(num, argTypes, retTypes)   {(num), argTypes, retTypes, false}
+
+/** \brief Descriptor initializer of a function answering with an upstream (no return types).*/
+#define SCI_UPSTREAM_FUNCTION(num, argTypes)    {(num), argTypes, SCI_NO_TYPES, true}
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Variable descriptor */
+typedef struct
+{
+    int16_t         i16Num;         /*!< Variable number.*/
+    teSCI_DATATYPE  eType;          /*!< Datatype of the variable.*/
+}tsSCI_VARIABLE;
+
+/** \brief Function (COMMAND) descriptor */
+typedef struct
+{
+    int16_t                 i16Num;             /*!< Command number.*/
+    const teSCI_DATATYPE    *peArgTypes;        /*!< Argument datatypes.*/
+    uint8_t                 ui8ArgCnt;          /*!< Number of arguments.*/
+    const teSCI_DATATYPE    *peRetTypes;        /*!< Return value datatypes.*/
+    uint8_t                 ui8RetCnt;          /*!< Number of return values.*/
+    bool                    bRequestsUpstream;  /*!< Function answers with an upstream.*/
+}tsSCI_FUNCTION;
+
+/******************************************************************************
+ * Global variable declarations
+ *****************************************************************************/
+/** \brief Decoder tables of the value modes (indexed by teSCI_DATATYPE).*/
+extern const SCI_DECODE_FCN SCIDecodeTableHex[eSCI_DTYPE_NUM];
+extern const SCI_DECODE_FCN SCIDecodeTableFloat[eSCI_DTYPE_NUM];
+
+/** \brief Encoder tables of the value modes (indexed by teSCI_DATATYPE).*/
+extern const SCI_ENCODE_FCN SCIEncodeTableHex[eSCI_DTYPE_NUM];
+extern const SCI_ENCODE_FCN SCIEncodeTableFloat[eSCI_DTYPE_NUM];
+
+#endif //_SCIDESCRIPTOR_H_
@@ -0,0 +1,198 @@
+/**************************************************************************//**
+ * \file SCIFleet.h
+ * \author Roman Holderried
+ *
+ * \brief Fleet manager: Many devices, each on its own serial link, served by
+ * one SCI master in one event loop (Linux, epoll).
+ *
+ * Every device has its own master context (see SCIMasterSaveContext) and its
+ * own request queue. Requests are addressed by the device ID and answered by
+ * DoneCB. SCIFleetProcess runs one turn of the event loop:
+ *  - Idle devices start their next queued request
+ *  - epoll waits until a link is readable / writable or a timeout is due
+ *  - Every ready device reads at most SCI_FLEET_RX_BUDGET bytes per turn and
+ *    the device served first rotates from turn to turn, so a device receiving
+ *    a long upstream does not delay the others by more than one budget
+ *  - Requests without a received byte within the timeout are aborted
+ * The master context is only switched if another device is served, the
+ * context of the device served last stays in the master.
+ *
+ * The links are passed as opened, configured (baud rate, raw mode) file
+ * descriptors. The fleet sets them non-blocking and neither closes them. A
+ * link failing (read / write error, hang-up) fails the requests of its device
+ * and is taken out of the loop until the device is added again.
+ *
+ * Per device, the fleet counts requests, results, timeouts and bytes and
+ * accumulates the latency from queueing to the result (tsSCI_FLEET_STATS).
+ * If the protocol metrics are compiled in (SCI_METRICS_ENABLE), they are kept
+ * per device as part of its master context (SCIFleetMetrics). The frame
+ * trace records the frames of all devices.
+ *
+ * The master of the process is used by the fleet exclusively. The module is
+ * compiled in if SCI_FLEET_ENABLE is set (SCIMasterConfig.h).
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIFLEET_H_
+#define _SCIFLEET_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+#include "SCIMaster.h"
+#include "SCIMetrics.h"
+
+#if SCI_FLEET_ENABLE
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_FLEET_ALL   0xFFFF  /*!< Device ID of the aggregate statistics / metrics.*/
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Request types */
+typedef enum
+{
+    eSCI_FLEET_OP_NONE          = 0,
+    eSCI_FLEET_OP_GETVAR        = 1,
+    eSCI_FLEET_OP_SETVAR        = 2,
+    eSCI_FLEET_OP_COMMAND       = 3,
+    eSCI_FLEET_OP_HANDSHAKE     = 4
+}teSCI_FLEET_OP;
+
+/** \brief Outcome of a request */
+typedef enum
+{
+    eSCI_FLEET_STATUS_DONE      = 0,    /*!< The response has been evaluated (see eAck).*/
+    eSCI_FLEET_STATUS_TIMEOUT   = 1,    /*!< No byte received within the timeout.*/
+    eSCI_FLEET_STATUS_IO_ERROR  = 2,    /*!< The link failed.*/
+    eSCI_FLEET_STATUS_REJECTED  = 3,    /*!< The master did not start the request.*/
+    eSCI_FLEET_STATUS_REMOVED   = 4     /*!< The device has been removed.*/
+}teSCI_FLEET_STATUS;
+
+/** \brief Result of a request (valid during DoneCB only) */
+typedef struct
+{
+    uint16_t                ui16Id;             /*!< Device.*/
+    teSCI_FLEET_OP          eOp;
+    int16_t                 i16Num;             /*!< Variable / command number.*/
+    teSCI_FLEET_STATUS      eStatus;
+    teREQUEST_ACKNOWLEDGE   eAck;               /*!< Acknowledge of the slave (eSCI_FLEET_STATUS_DONE).*/
+    uint16_t                ui16ErrNum;         /*!< Error number of an ERR response.*/
+    const uint32_t          *pui32Vals;         /*!< GETVAR value / COMMAND results (raw values of the value mode).*/
+    uint32_t                ui32ValCnt;
+    const uint8_t           *pui8Upstream;      /*!< Upstream of a COMMAND (NULL: None).*/
+    uint32_t                ui32UpstreamLen;
+    uint32_t                ui32LatencyUs;      /*!< From queueing to the result.*/
+    void                    *pvUser;            /*!< Passed with the request.*/
+}tsSCI_FLEET_RESULT;
+
+/** \brief Fleet configuration */
+typedef struct
+{
+    uint32_t    ui32TimeoutMs;                              /*!< Response timeout: No byte received (0: None).*/
+    void        (*DoneCB)(const tsSCI_FLEET_RESULT *psResult);
+}tsSCI_FLEET_CONFIG;
+
+/** \brief Request and link statistics of a device (or of all devices) */
+typedef struct
+{
+    uint32_t    ui32Queued;             /*!< Requests accepted.*/
+    uint32_t    ui32QueueFull;          /*!< Requests refused (queue full, link failed).*/
+    uint32_t    ui32Done;               /*!< Responses evaluated.*/
+    uint32_t    ui32Failed;             /*!< Thereof ERR / NAK / cancelled.*/
+    uint32_t    ui32Timeouts;
+    uint32_t    ui32IoErrors;           /*!< Requests failed by the link.*/
+    uint32_t    ui32Pending;            /*!< Requests queued or in progress (snapshot).*/
+    uint64_t    ui64BytesOut;
+    uint64_t    ui64BytesIn;
+    uint64_t    ui64LatencySumUs;       /*!< Sum of the latencies of the evaluated responses.*/
+    uint32_t    ui32LatencyMaxUs;
+    uint16_t    ui16Devices;            /*!< Number of devices (1 for a single device).*/
+}tsSCI_FLEET_STATS;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes the fleet (without devices).
+ *
+ * @returns False if the event loop could not be created
+ */
+bool SCIFleetInit (tsSCI_FLEET_CONFIG sConfig);
+
+/** \brief Removes all devices and releases the event loop.*/
+void SCIFleetDeinit (void);
+
+/** \brief Adds a device.
+ *
+ * @param ui16Id        Device ID (unique, not SCI_FLEET_ALL)
+ * @param iFd           Opened link
+ * @param eValueMode    Initial value mode of the master (until a handshake)
+ *
+ * @returns False if the ID is in use, no device is left or the link is invalid
+ */
+bool SCIFleetAddDevice (uint16_t ui16Id, int iFd, teSCI_VALUE_MODE eValueMode);
+
+/** \brief Removes a device, its pending requests are reported (eSCI_FLEET_STATUS_REMOVED).*/
+bool SCIFleetRemoveDevice (uint16_t ui16Id);
+
+/** \brief Queues a capability handshake (see SCIRequestHandshake).*/
+bool SCIFleetHandshake (uint16_t ui16Id, void *pvUser);
+
+/** \brief Queues a GETVAR request.*/
+bool SCIFleetGetVar (uint16_t ui16Id, int16_t i16Num, void *pvUser);
+
+/** \brief Queues a SETVAR request.*/
+bool SCIFleetSetVar (uint16_t ui16Id, int16_t i16Num, tuREQUESTVALUE uVal, void *pvUser);
+
+/** \brief Queues a COMMAND request.
+ *
+ * @param puVals    Arguments (copied)
+ * @param ui16Cnt   Number of arguments (max. MAX_NUM_REQUEST_VALUES)
+ */
+bool SCIFleetCommand (uint16_t ui16Id, int16_t i16Num, const tuREQUESTVALUE *puVals, uint16_t ui16Cnt, void *pvUser);
+
+/** \brief Runs one turn of the event loop.
+ *
+ * @param iTimeoutMs    Maximum wait for link events (-1: Until an event or a request timeout)
+ *
+ * @returns Number of results reported (-1: epoll failed)
+ */
+int SCIFleetProcess (int iTimeoutMs);
+
+/** \brief True if no request is queued or in progress.*/
+bool SCIFleetIsIdle (void);
+
+/** \brief Active communication settings of a device (see SCIGetCapabilities).*/
+bool SCIFleetGetCapabilities (uint16_t ui16Id, tsSCI_CAPABILITIES *psCapabilities);
+
+/** \brief Statistics of a device (SCI_FLEET_ALL: Sum of all devices, maximum latency of all).*/
+bool SCIFleetGetStats (uint16_t ui16Id, tsSCI_FLEET_STATS *psStats);
+
+#if SCI_METRICS_ENABLE
+/** \brief Protocol metrics of a device (SCI_FLEET_ALL: Sum of all devices).
+ *
+ * @param bReset    The next snapshot starts from this one (all devices for SCI_FLEET_ALL)
+ */
+bool SCIFleetMetrics (uint16_t ui16Id, tsSCI_METRICS *psMetrics, bool bReset);
+#endif
+
+#endif // SCI_FLEET_ENABLE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCIFLEET_H_
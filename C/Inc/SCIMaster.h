@@ -24,6 +24,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +34,8 @@ extern "C" {
 #include "Buffer.h"
 #include "SCIDataLink.h"
 #include "SCICommon.h"
+#include "SCIDescriptor.h"
+#include "SCIDataframe.h"
 
 /******************************************************************************
  * Defines
@@ -43,6 +46,9 @@ extern "C" {
 #define SCI_MASTER_VERSION_MINOR    5
 #define SCI_MASTER_REVISION         0
 
+// Maximum number of writes within one SETVAR batch frame
+#define SCI_SETVAR_BATCH_MAX        ((MAX_NUM_REQUEST_VALUES + 1) / 2)
+
 #define SCI_RECEIVE_MODE_TRANSFER   0
 #define SCI_RECEIVE_MODE_STREAM     1
 
@@ -71,8 +77,13 @@ typedef enum
 
 typedef teTRANSFER_ACK (*SETVAR_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum);
 typedef teTRANSFER_ACK (*GETVAR_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
-typedef teTRANSFER_ACK (*COMMAND_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint8_t ui8DataCnt, uint16_t ui16ErrNum);
+typedef teTRANSFER_ACK (*COMMAND_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
+typedef void (*COMMAND_DATA_CB)(int16_t i16Num, uint32_t *pui32Data, uint32_t ui32Offset, uint16_t ui16DataCnt);
 typedef teTRANSFER_ACK (*UPSTREAM_CB)(int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt);
+typedef void (*UPSTREAM_DATA_CB)(int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Offset, uint16_t ui16DataCnt);
+typedef void (*HANDSHAKE_CB)(teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities);
+typedef teTRANSFER_ACK (*DOWNSTREAM_CB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32AckedByteCnt, uint16_t ui16ErrNum);
+typedef uint16_t (*DOWNSTREAM_SOURCE_CB)(int16_t i16Num, uint32_t ui32Offset, uint8_t *pui8Dst, uint16_t ui16MaxLen);
 
 typedef struct
 {
@@ -82,9 +93,31 @@ typedef struct
     COMMAND_CB CommandExternalCB;
     UPSTREAM_CB UpstreamExternalCB;
 
+    // Optional incremental COMMAND result delivery: If set, every received batch of
+    // result values is passed with its index offset as soon as it arrives and
+    // CommandExternalCB only reports the completion status and the overall number
+    // of values (no data).
+    COMMAND_DATA_CB CommandDataExternalCB;
+
+    // Optional incremental upstream delivery: If set, every received upstream frame is
+    // passed with its byte offset as soon as it arrives (the upstream is not buffered)
+    // and UpstreamExternalCB only reports the completion (no data, overall byte count).
+    // Compressed upstreams are passed decompressed, offsets and counts refer to the
+    // decompressed data.
+    UPSTREAM_DATA_CB UpstreamDataExternalCB;
+
+    // Handshake result: Called with the negotiated (now active) communication settings.
+    HANDSHAKE_CB HandshakeExternalCB;
+
+    // DOWNSTREAM completion (with the acknowledged byte count to resume from) and data
+    // source for transfers without a buffer (returns the number of bytes written, 0 aborts
+    // the transfer with eREQUEST_ACK_STATUS_ERROR / eSCI_ERROR_DOWNSTREAM_SOURCE_FAILED).
+    DOWNSTREAM_CB DownstreamExternalCB;
+    DOWNSTREAM_SOURCE_CB DownstreamSourceExternalCB;
+
     // Transmission related external callbacks
-    void        (*BlockingTxExternalCB)(uint8_t* pui8Buf, uint8_t ui8Len);
-    uint8_t     (*NonBlockingTxExternalCB)(uint8_t* pui8Buf, uint8_t ui8Len);
+    void        (*BlockingTxExternalCB)(uint8_t* pui8Buf, uint16_t ui16Len);
+    uint16_t    (*NonBlockingTxExternalCB)(uint8_t* pui8Buf, uint16_t ui16Len);
     bool        (*GetTxBusyStateExternalCB)(void);
 
 }tsSCI_MASTER_CALLBACKS;
@@ -109,6 +142,16 @@ typedef struct
 
     tsSCI_TRANSFER sSCITransfer;
 
+    void *pvTypedResult; /*!< Result destination of a typed GETVAR */
+
+    const tsSCI_VALUE_CODEC *psCodec;  /*!< Value codec of the active number format */
+
+    tsSCI_CAPABILITIES sCapabilities;   /*!< Active communication settings (own capabilities or handshake result) */
+    HANDSHAKE_CB HandshakeExternalCB;   /*!< Handshake result callback */
+
+    bool bNoResponse;   /*!< The request in transmission is not answered by the slave */
+    teREQUEST_TYPE eReqInFlight;    /*!< Type of the request in transmission (selects the codec of the response) */
+
 }tsSCI_MASTER;
 
 #define tsSCI_MASTER_DEFAULTS { \
@@ -119,17 +162,34 @@ typedef struct
     tsFIFO_BUF_DEFAULTS, \
     SCI_RECEIVE_MODE_TRANSFER, \
     tsDATALINK_DEFAULTS, \
-    tsSCI_TRANSFER_DEFAULTS \
+    tsSCI_TRANSFER_DEFAULTS, \
+    NULL, \
+    &SCIValueCodecHex, \
+    tsSCI_CAPABILITIES_DEFAULTS, \
+    NULL, \
+    false, \
+    eREQUEST_TYPE_NONE \
 }
 
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
 /** \brief Initializes the SCI Master.
+ * 
+ * The master starts from its default state (a transfer in progress is
+ * dropped). The number format is selected once here: All request building, response 
+ * parsing and typed value conversion is dispatched to the codec of this format.
+ * It stays active until a handshake (SCIRequestHandshake) negotiates the 
+ * settings with the slave.
+ * 
+ * The master exists once per process, so the number format is a process-wide
+ * setting. Slaves with different formats are served by one master context per
+ * slave (SCIMasterSaveContext), e.g. by the fleet manager (SCIFleetAddDevice).
  * 
  * @param sCallbacks    External functions to call by the SCI Master.
+ * @param eValueMode    Number format of the values (HEX or FLOAT).
 */
-void SCIMasterInit (tsSCI_MASTER_CALLBACKS sCallbacks);
+void SCIMasterInit (tsSCI_MASTER_CALLBACKS sCallbacks, teSCI_VALUE_MODE eValueMode);
 
 /** \brief Main state machine for the SCI master.
  * 
@@ -150,9 +210,9 @@ void SCIMasterSM (void);
 /** \brief High level receive routine.
  * 
  * @param pui8RecBuf    Pointer to the receive buffer or FIFO
- * @param ui8ByteCount  Number of bytes to process
+ * @param ui16ByteCount Number of bytes to process
 */
-void SCIReceive (uint8_t *pui8RecBuf, uint16_t ui8ByteCount);
+void SCIReceive (uint8_t *pui8RecBuf, uint16_t ui16ByteCount);
 
 /** \brief Switch the receive mode of the protocol.
  * 
@@ -180,23 +240,169 @@ void SCIReleaseProtocol (void);
 /** \brief Initiate a GETVAR request
  * 
  * @param i16VarNum Variable number to request
+ * 
+ * @returns True if the request has been started
  */
-void SCIRequestGetVar (int16_t i16VarNum);
+bool SCIRequestGetVar (int16_t i16VarNum);
 
 /** \brief Initiate a SETVAR request
  * 
  * @param i16VarNum Variable number to request
  * @param uVal      Variable value to set
+ * 
+ * @returns True if the request has been started
  */
-void SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal);
+bool SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal);
+
+/** \brief Initiate a batch of SETVARs within one frame
+ * 
+ * The frame "num!val,num,val,..." is applied by the slave in order. It answers
+ * with "num!ACK" (number of the first write) or stops at the first failing 
+ * write and answers "num!ERR;code" with its number, the writes before it are 
+ * applied. SetVarExternalCB is called once for the whole batch. Batches of 
+ * more than one write require SCI_FEATURE_SETVAR_BATCH (handshake).
+ * 
+ * @param pi16VarNums   Variable numbers
+ * @param puVals        Variable values to set
+ * @param ui16Cnt       Number of writes (max. SCI_SETVAR_BATCH_MAX)
+ * 
+ * @returns True if the request has been started (false also if the frame exceeds the TX length)
+ */
+bool SCIRequestSetVarBatch (const int16_t *pi16VarNums, const tuREQUESTVALUE *puVals, uint16_t ui16Cnt);
+
+/** \brief Initiate an urgent SETVAR request
+ * 
+ * If the protocol is idle, the request is started immediately. Otherwise it 
+ * waits for the next chunk boundary of the running transfer (COMMAND result 
+ * frames, UPSTREAM chunks, DOWNSTREAM credit windows), is sent in between and 
+ * the transfer is resumed afterwards (see SCITransferUrgent). The worst case 
+ * delay is one chunk instead of the whole transfer. SetVarExternalCB reports 
+ * the result.
+ * 
+ * @param i16VarNum Variable number to request
+ * @param uVal      Variable value to set
+ * 
+ * @returns True if the request has been started or queued (false if SCI_URGENT_QUEUE_LENGTH is exceeded)
+ */
+bool SCIRequestUrgentSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal);
+
+/** \brief Initiate an urgent GETVAR request (see SCIRequestUrgentSetVar)
+ * 
+ * @param i16VarNum Variable number to request
+ * 
+ * @returns True if the request has been started or queued
+ */
+bool SCIRequestUrgentGetVar (int16_t i16VarNum);
 
 /** \brief Initiate a COMMAND request
  * 
  * @param i16CmdNum Variable number to request
  * @param puValArr  Pointer to the value array to transmit
- * @param ui8ArgNum Number of elements in the value array
+ * @param ui16ArgNum Number of elements in the value array
+ * 
+ * @returns True if the request has been started
+ */
+bool SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint16_t ui16ArgNum);
+
+/** \brief Initiate a typed GETVAR request
+ * 
+ * The received value is decoded into the storage pointed to by pvDst (which
+ * must match the datatype of the descriptor) before GetVarExternalCB is called.
+ * 
+ * @param psVar Variable descriptor
+ * @param pvDst Pointer to the result storage
+ * 
+ * @returns True if the request has been started
+ */
+bool SCIRequestGetVarTyped (const tsSCI_VARIABLE *psVar, void *pvDst);
+
+/** \brief Initiate a typed SETVAR request
+ * 
+ * @param psVar Variable descriptor
+ * @param pvVal Pointer to the value to set (of the descriptor datatype)
+ * 
+ * @returns True if the request has been started
+ */
+bool SCIRequestSetVarTyped (const tsSCI_VARIABLE *psVar, const void *pvVal);
+
+/** \brief Initiate a typed COMMAND request
+ * 
+ * The arguments are encoded according to the argument types of the descriptor,
+ * the results are decoded into the destinations according to its return types.
+ * CommandExternalCB only reports the completion status and the number of
+ * received results afterwards (no data). If the slave returns more or less
+ * results than return types, eREQUEST_ACK_STATUS_ERROR is reported with
+ * eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET (surplus results are dropped).
+ * 
+ * @param psFcn         Function descriptor
+ * @param ppvArgs       Pointers to the arguments (one per argument type)
+ * @param ppvResults    Pointers to the result storage (one per return type, must stay 
+ *                      valid until the transfer is finished)
+ * 
+ * @returns True if the request has been started
  */
-void SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8ArgNum);
+bool SCIRequestCommandTyped (const tsSCI_FUNCTION *psFcn, const void * const *ppvArgs, void * const *ppvResults);
+
+/** \brief Initiate a DOWNSTREAM transfer (bulk data to the slave)
+ * 
+ * The data is sent in chunks of the negotiated TX packet length. Several chunks
+ * are in flight according to the credit the slave grants (see 
+ * SCITransferStartDownstream). DownstreamExternalCB reports the completion 
+ * together with the acknowledged byte count, which is the start offset to 
+ * resume an aborted transfer.
+ * 
+ * @param i16Num            Downstream number
+ * @param pui8Data          Data to transfer (must stay valid until the transfer is finished). 
+ *                          If NULL, the data is fetched by DownstreamSourceExternalCB.
+ * @param ui32Len           Overall length of the data
+ * @param ui32StartOffset   Offset to start (or resume) the transfer from
+ * 
+ * @returns True if the transfer has been started
+ */
+bool SCIRequestDownstream (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Len, uint32_t ui32StartOffset);
+
+/** \brief Cancels a running COMMAND result, UPSTREAM or DOWNSTREAM transfer
+ * 
+ * The transfer stops at its next chunk boundary instead of requesting the next
+ * chunk, its memory is freed and the link is released for the next request.
+ * CommandExternalCB (COMMAND results and upstreams) or DownstreamExternalCB 
+ * report eREQUEST_ACK_STATUS_CANCELLED (see SCITransferCancel).
+ * 
+ * @param i16Num    Number of the transfer to cancel (SCI_CANCEL_CURRENT: the running one)
+ * 
+ * @returns False if no such transfer is running
+ */
+bool SCICancel (int16_t i16Num);
+
+/** \brief Initiate a capability handshake
+ * 
+ * The master capabilities are sent to the slave, which responds with its own.
+ * Both sides then select the largest frame lengths and the value mode they 
+ * have in common (see tsSCI_CAPABILITIES). The handshake itself is always 
+ * exchanged in HEX format. HandshakeExternalCB reports the result.
+ * 
+ * @returns True if the request has been started
+ */
+bool SCIRequestHandshake (void);
+
+/** \brief Returns the active communication settings
+ * 
+ * @returns Negotiated capabilities (own capabilities without SETVAR batches if no 
+ *          handshake took place)
+ */
+tsSCI_CAPABILITIES SCIGetCapabilities (void);
+
+/** \brief Negotiates the communication settings of two partners.
+ * 
+ * @param psOwn         Own capabilities
+ * @param psPeer        Capabilities of the communication partner
+ * @param psResult      Negotiated settings (from the own point of view)
+ * @param peValueMode   Selected value mode
+ * 
+ * @returns False if the partners have no value mode in common
+ */
+bool SCINegotiateCapabilities (const tsSCI_CAPABILITIES *psOwn, const tsSCI_CAPABILITIES *psPeer, 
+                               tsSCI_CAPABILITIES *psResult, teSCI_VALUE_MODE *peValueMode);
 
 /** \brief Returns the current protocol state
  * 
@@ -204,6 +410,28 @@ void SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8
  */
 tePROTOCOL_STATE SCIGetProtocolState (void);
 
+/** \brief Size of a master context in bytes (see SCIMasterSaveContext).*/
+size_t SCIMasterContextSize (void);
+
+/** \brief Copies the complete master state into a context.
+ *
+ * The master is a singleton. Several slaves are served by switching contexts:
+ * The state of one link (protocol state, buffers, transfer in progress,
+ * negotiated capabilities, callbacks and, if compiled in, the protocol
+ * metrics) is saved and the state of another one restored. A context refers
+ * to the memory of the master and may only be restored into it. The frame
+ * trace is not switched.
+ *
+ * @param pvCtx Context memory (SCIMasterContextSize bytes)
+ */
+void SCIMasterSaveContext (void *pvCtx);
+
+/** \brief Restores a context saved by SCIMasterSaveContext.
+ *
+ * @param pvCtx Context memory
+ */
+void SCIMasterRestoreContext (const void *pvCtx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ * \file SCIMetrics.h
+ * \author Roman Holderried
+ *
+ * \brief Protocol metrics of the SCI master.
+ *
+ * Per request type, the master counts requests, responses, bytes in and out
+ * (including STX/ETX), ERR and NAK responses and parse errors. The latency
+ * from the start of a request transmission to the evaluation of its response
+ * is collected in a histogram with logarithmic buckets: Every power of two
+ * [2^n, 2^(n+1)) us is split into four buckets of equal width (below 4 us one
+ * bucket per us), so a percentile is known within 25 %. The last bucket holds
+ * everything above (SCIMetricsBucketLimit). Further, receive buffer overflows are counted
+ * and the time spent in each protocol state is accumulated.
+ *
+ * The metrics are compiled in if SCI_METRICS_ENABLE is set (SCIMasterConfig.h),
+ * otherwise the SCI_METRICS_* hooks of the master expand to nothing. All
+ * memory is static. The master context is the only writer. Snapshots are taken
+ * without locking it (the copy is repeated if the master updated the metrics
+ * meanwhile). A reset only moves the baseline the snapshots are related to,
+ * so snapshot and reset are one atomic step for the reader.
+ *
+ * The C master has no response timeout and no request repetition (see the
+ * TODOs in SCIMaster.h / SCITransfer.c), so there are no timeout and retry
+ * counters on this side (the Python driver reports both).
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIMETRICS_H_
+#define _SCIMETRICS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+#include "SCICommon.h"
+#include "SCITransfer.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_METRICS_NUM_TYPES       (eREQUEST_TYPE_HANDSHAKE + 1)   // Indexed by teREQUEST_TYPE
+#define SCI_METRICS_NUM_STATES      4                               // IDLE ... RECEIVING (tePROTOCOL_STATE)
+#define SCI_METRICS_SUB_BUCKETS     4                               // Latency buckets per power of two
+
+#if SCI_METRICS_ENABLE
+#define SCI_METRICS_REQUEST(eReqType, ui16Bytes)                            SCIMetricsRequest(eReqType, ui16Bytes)
+#define SCI_METRICS_RESPONSE(eReqType, ui16Bytes, eAck, eError, bOverflow)  SCIMetricsResponse(eReqType, ui16Bytes, eAck, eError, bOverflow)
+#define SCI_METRICS_STATE(eState)                                           SCIMetricsState(eState)
+#else
+#define SCI_METRICS_REQUEST(eReqType, ui16Bytes)
+#define SCI_METRICS_RESPONSE(eReqType, ui16Bytes, eAck, eError, bOverflow)
+#define SCI_METRICS_STATE(eState)
+#endif
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Metrics of one request type */
+typedef struct
+{
+    uint32_t    ui32Requests;           /*!< Request frames sent.*/
+    uint32_t    ui32Responses;          /*!< Response frames evaluated.*/
+    uint32_t    ui32BytesOut;           /*!< Request bytes (including STX/ETX).*/
+    uint32_t    ui32BytesIn;            /*!< Response bytes (including STX/ETX).*/
+    uint32_t    ui32Errors;             /*!< ERR responses.*/
+    uint32_t    ui32Naks;               /*!< NAK responses (unknown number).*/
+    uint32_t    ui32ParseErrors;        /*!< Responses the parser rejected.*/
+    uint64_t    ui64LatencySumUs;       /*!< Sum of the latencies (mean = sum / responses).*/
+    uint32_t    ui32Latency[SCI_METRICS_NUM_BUCKETS];   /*!< Latency histogram (see SCIMetricsBucketLimit).*/
+}tsSCI_REQUEST_METRICS;
+
+/** \brief Protocol metrics */
+typedef struct
+{
+    tsSCI_REQUEST_METRICS   sTypes[SCI_METRICS_NUM_TYPES];
+    uint32_t                ui32RxOverflows;                    /*!< Responses exceeding the receive buffer.*/
+    uint64_t                ui64StateUs[SCI_METRICS_NUM_STATES];/*!< Time spent in each protocol state.*/
+}tsSCI_METRICS;
+
+#if SCI_METRICS_ENABLE
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes (and clears) the metrics.
+ *
+ * @param GetTimeUsCB   Monotonic time in us (NULL: no latencies and state times)
+ */
+void SCIMetricsInit (uint32_t (*GetTimeUsCB)(void));
+
+/** \brief Takes a snapshot of the metrics since the last reset.
+ *
+ * @param psMetrics Snapshot storage
+ * @param bReset    The next snapshot starts from this one
+ */
+void SCIMetricsSnapshot (tsSCI_METRICS *psMetrics, bool bReset);
+
+/** \brief Upper latency limit of a histogram bucket.
+ *
+ * @param ui8Bucket Bucket index
+ *
+ * @returns Latencies of the bucket are below this limit (us)
+ */
+uint32_t SCIMetricsBucketLimit (uint8_t ui8Bucket);
+
+/** \brief Latency percentile of a request type.
+ *
+ * @param psMetrics Metrics of the request type
+ * @param ui8Percent Percentile (e.g. 50, 99)
+ *
+ * @returns Upper bound of the histogram bucket holding the percentile (us, 0 without responses)
+ */
+uint32_t SCIMetricsPercentile (const tsSCI_REQUEST_METRICS *psMetrics, uint8_t ui8Percent);
+
+/** \brief Adds metrics (e.g. of several links) to a sum.
+ *
+ * @param psSum     Sum
+ * @param psMetrics Metrics to add
+ */
+void SCIMetricsAccumulate (tsSCI_METRICS *psSum, const tsSCI_METRICS *psMetrics);
+
+/** \brief Size of the metrics context (part of the master context, see SCIMasterSaveContext).*/
+size_t SCIMetricsContextSize (void);
+
+/** \brief Copies the metrics state into a context.*/
+void SCIMetricsSaveContext (void *pvCtx);
+
+/** \brief Restores a context saved by SCIMetricsSaveContext.*/
+void SCIMetricsRestoreContext (const void *pvCtx);
+
+/** \brief Request hook of the master (see SCI_METRICS_REQUEST).*/
+void SCIMetricsRequest (teREQUEST_TYPE eReqType, uint16_t ui16Bytes);
+
+/** \brief Response hook of the master (see SCI_METRICS_RESPONSE).*/
+void SCIMetricsResponse (teREQUEST_TYPE eReqType, uint16_t ui16Bytes, teREQUEST_ACKNOWLEDGE eAck, teSCI_ERROR eError, bool bOverflow);
+
+/** \brief Protocol state hook of the master (see SCI_METRICS_STATE).*/
+void SCIMetricsState (int8_t i8State);
+
+#endif // SCI_METRICS_ENABLE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCIMETRICS_H_
@@ -0,0 +1,200 @@
+/**************************************************************************//**
+ * \file SCIScheduler.h
+ * \author Roman Holderried
+ *
+ * \brief Cyclic GETVAR polling scheduler on top of the SCI master.
+ *
+ * Variables are subscribed with a period and a priority. Every period a poll
+ * job is released, its deadline is the next release. The link is shared by
+ * one GETVAR at a time, so a job is not preempted once its frame is sent.
+ * The next job is selected either by the earliest deadline (EDF, priority as
+ * tie breaker) or by the fixed priority (0 = highest, the period as tie
+ * breaker; rate monotonic if the priorities are assigned by period).
+ *
+ * The link time of a poll is estimated from SCI_SCHED_GETVAR_FRAME_BYTES at
+ * the configured baud rate plus the device turnaround. Subscriptions are only
+ * admitted if the set stays schedulable:
+ * - EDF: U + Cmax / Tmin <= 1 (blocking by one frame already on the link)
+ * - Fixed priority: Non-preemptive response time analysis, R <= T for all
+ * - Both: U <= SCI_SCHED_MAX_UTILIZATION (link time left for other requests)
+ *
+ * Jobs that are not polled before their deadline are dropped and counted as
+ * misses. A poll without response is given up (counted as error) after the
+ * timeout of the configuration, the master is released then. If the
+ * application releases the master itself, the poll is given up on the next
+ * call of SCISchedulerProcess (or by SCISchedulerAbort right away).
+ * Samples are delivered by the sample callback or, if none is given, stored
+ * in a ring buffer (SCISchedulerReadSample, the oldest is overwritten).
+ *
+ * SCISchedulerGetVarCB must be registered as GetVarExternalCB of the master
+ * (or be called by the callback in use). Results of other GETVARs are
+ * forwarded to the callback given in the configuration.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCISCHEDULER_H_
+#define _SCISCHEDULER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Scheduling policy */
+typedef enum
+{
+    eSCI_SCHED_POLICY_EDF       = 0,    /*!< Earliest deadline first.*/
+    eSCI_SCHED_POLICY_FIXED     = 1     /*!< Fixed priority.*/
+}teSCI_SCHED_POLICY;
+
+/** \brief Polled sample */
+typedef struct
+{
+    uint8_t                 ui8Handle;      /*!< Subscription handle.*/
+    int16_t                 i16Num;         /*!< Variable number.*/
+    uint32_t                ui32Data;       /*!< Variable value (raw).*/
+    uint32_t                ui32Release;    /*!< Release time of the poll job.*/
+    uint32_t                ui32Timestamp;  /*!< Time of the response.*/
+    teREQUEST_ACKNOWLEDGE   eAck;           /*!< Result of the GETVAR.*/
+}tsSCI_SCHED_SAMPLE;
+
+typedef void (*SCI_SCHED_SAMPLE_CB)(const tsSCI_SCHED_SAMPLE *psSample);
+
+/** \brief Scheduler configuration */
+typedef struct
+{
+    teSCI_SCHED_POLICY  ePolicy;
+    uint32_t            ui32Baudrate;       /*!< Link baud rate (10 bit per byte).*/
+    uint32_t            ui32TurnaroundUs;   /*!< Device turnaround per poll (us).*/
+    uint32_t            ui32TimeoutUs;      /*!< Response timeout of a poll (us, 0: None).*/
+
+    uint32_t            (*GetTimeUsCB)(void);   /*!< Time base (us).*/
+    SCI_SCHED_SAMPLE_CB SampleCB;               /*!< Sample delivery (NULL: ring buffer).*/
+    GETVAR_CB           GetVarForwardCB;        /*!< Application GETVAR callback (may be NULL).*/
+}tsSCI_SCHED_CONFIG;
+
+#define tsSCI_SCHED_CONFIG_DEFAULTS {eSCI_SCHED_POLICY_EDF, 115200, 0, 0, NULL, NULL, NULL}
+
+/** \brief Statistics of a subscription */
+typedef struct
+{
+    uint32_t ui32Samples;       /*!< Completed polls.*/
+    uint32_t ui32Errors;        /*!< Polls answered with an error or given up.*/
+    uint32_t ui32Misses;        /*!< Jobs completed after or dropped at their deadline.*/
+    uint32_t ui32MaxLatency;    /*!< Maximum time from release to response (us).*/
+    uint32_t ui32MaxJitter;     /*!< Maximum deviation of the sample interval from the period (us).*/
+}tsSCI_SCHED_STATS;
+
+#define tsSCI_SCHED_STATS_DEFAULTS {0, 0, 0, 0, 0}
+
+/** \brief Subscription */
+typedef struct
+{
+    int16_t             i16Num;         /*!< Variable number.*/
+    uint32_t            ui32Period;     /*!< Period and relative deadline (us).*/
+    uint32_t            ui32Cost;       /*!< Estimated link time of a poll (us).*/
+    uint8_t             ui8Priority;    /*!< Fixed priority (0 = highest).*/
+    uint32_t            ui32Release;    /*!< Release time of the pending job.*/
+    uint32_t            ui32LastSample; /*!< Timestamp of the last sample.*/
+    bool                bSampled;       /*!< ui32LastSample is valid.*/
+    bool                bUsed;
+    tsSCI_SCHED_STATS   sStats;
+}tsSCI_SCHED_SUBSCRIPTION;
+
+/** \brief Scheduler main structure */
+typedef struct
+{
+    tsSCI_SCHED_CONFIG          sConfig;
+    tsSCI_SCHED_SUBSCRIPTION    sSubs[SCI_SCHED_NUM_SUBSCRIPTIONS];
+
+    int16_t                     i16InFlight;    /*!< Handle of the poll in flight (-1: none).*/
+    uint32_t                    ui32InFlightStart;  /*!< Start time of the poll in flight.*/
+
+    tsSCI_SCHED_SAMPLE          sRing[SCI_SCHED_RING_LENGTH];
+    uint16_t                    ui16RingHead;
+    uint16_t                    ui16RingCnt;
+    uint32_t                    ui32RingOverruns;   /*!< Samples overwritten before being read.*/
+}tsSCI_SCHEDULER;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes the scheduler (without subscriptions).
+ *
+ * @returns False if the baud rate is 0 (subscriptions are refused then)
+ */
+bool SCISchedulerInit (tsSCI_SCHED_CONFIG sConfig);
+
+/** \brief Subscribes a variable for cyclic polling.
+ *
+ * The first job is released immediately.
+ *
+ * @param i16Num        Variable number
+ * @param ui32PeriodUs  Polling period (us)
+ * @param ui8Priority   Fixed priority (0 = highest), tie breaker for EDF
+ * @param pui8Handle    Handle of the subscription
+ *
+ * @returns False if no slot is left or the set would not be schedulable
+ */
+bool SCISchedulerSubscribe (int16_t i16Num, uint32_t ui32PeriodUs, uint8_t ui8Priority, uint8_t *pui8Handle);
+
+/** \brief Removes a subscription (the result of a poll in flight is discarded).*/
+void SCISchedulerUnsubscribe (uint8_t ui8Handle);
+
+/** \brief Releases the poll jobs and starts the next GETVAR if the master is idle.
+ *
+ * A poll in flight is given up if the master has been released without its
+ * response or if its timeout elapsed. To be called cyclically (next to
+ * SCIMasterSM).
+ */
+void SCISchedulerProcess (void);
+
+/** \brief Gives up the poll in flight (counted as error, its job is done).
+ *
+ * To be called if the application releases the master (SCIReleaseProtocol)
+ * while a poll may be in flight. A late response is forwarded like the
+ * result of a foreign GETVAR.
+ *
+ * @returns False if no poll is in flight
+ */
+bool SCISchedulerAbort (void);
+
+/** \brief GETVAR result callback (to be passed as GetVarExternalCB of the master).*/
+teTRANSFER_ACK SCISchedulerGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
+
+/** \brief Takes the oldest sample out of the ring buffer.
+ *
+ * @returns False if the ring buffer is empty
+ */
+bool SCISchedulerReadSample (tsSCI_SCHED_SAMPLE *psSample);
+
+/** \brief Returns the statistics of a subscription.*/
+tsSCI_SCHED_STATS SCISchedulerGetStats (uint8_t ui8Handle);
+
+/** \brief Returns the number of samples lost by ring buffer overruns.*/
+uint32_t SCISchedulerGetRingOverruns (void);
+
+/** \brief Returns the estimated link time of one poll (us), 0 if not initialized.*/
+uint32_t SCISchedulerPollCost (void);
+
+/** \brief Returns the link utilization of the subscriptions (per mille).*/
+uint16_t SCISchedulerGetUtilization (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCISCHEDULER_H_
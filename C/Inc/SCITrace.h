@@ -0,0 +1,137 @@
+/**************************************************************************//**
+ * \file SCITrace.h
+ * \author Roman Holderried
+ *
+ * \brief Binary frame trace of the SCI master.
+ *
+ * Every request frame sent and every response frame received by the master
+ * is recorded with a timestamp, the direction, the protocol state, the type
+ * of the request on the link and the parse result. The records are kept in a
+ * preallocated ring of SCI_TRACE_NUM_RECORDS entries, the oldest record is
+ * overwritten. Frames are captured up to SCI_TRACE_SNAP_LENGTH bytes (STX
+ * and ETX excluded).
+ *
+ * The trace is compiled in if SCI_TRACE_NUM_RECORDS > 0 (SCIMasterConfig.h).
+ * Otherwise SCI_TRACE_FRAME expands to nothing and the functions below are
+ * not available. It can be paused at runtime (SCITraceEnable).
+ *
+ * The ring has a single writer (the context of SCIMasterSM). Readers do not
+ * lock it: A record is copied and taken only if its sequence number is still
+ * the expected one afterwards, records overwritten meanwhile are reported as
+ * lost.
+ *
+ * SCITraceExport writes the records as pcapng (section header, interface of
+ * link type LINKTYPE_USER0, one enhanced packet block per frame with the
+ * direction in the flags option). The packet data starts with a 4 byte
+ * pseudo header (protocol state, receive mode, request type, parse result)
+ * followed by the frame. Python/SCITrace.py decodes these files,
+ * C/Benchmark/TraceReplay.c replays them against the master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCITRACE_H_
+#define _SCITRACE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_TRACE_DIR_TX            0   /*!< Request frame (master to slave) */
+#define SCI_TRACE_DIR_RX            1   /*!< Response frame (slave to master) */
+
+// pcapng link type of the exported frames and length of the pseudo header in front of each frame
+#define SCI_TRACE_LINKTYPE          147
+#define SCI_TRACE_PSEUDO_HDR_LEN    4
+
+#if SCI_TRACE_NUM_RECORDS > 0
+#define SCI_TRACE_FRAME(ui8Dir, ui8State, ui8RecMode, ui8ReqType, ui8Result, pui8Frame, ui16Len) \
+    SCITraceFrame(ui8Dir, ui8State, ui8RecMode, ui8ReqType, ui8Result, pui8Frame, ui16Len)
+#else
+#define SCI_TRACE_FRAME(ui8Dir, ui8State, ui8RecMode, ui8ReqType, ui8Result, pui8Frame, ui16Len)
+#endif
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Trace record of one frame */
+typedef struct
+{
+    uint32_t    ui32Seq;                /*!< Sequence number (written last).*/
+    uint64_t    ui64TimeUs;             /*!< Monotonic timestamp (wrap-around of the time callback extended).*/
+    uint8_t     ui8Dir;                 /*!< SCI_TRACE_DIR_TX or SCI_TRACE_DIR_RX.*/
+    uint8_t     ui8State;               /*!< Protocol state (tePROTOCOL_STATE).*/
+    uint8_t     ui8RecMode;             /*!< Receive mode (SCI_RECEIVE_MODE_TRANSFER / _STREAM).*/
+    uint8_t     ui8ReqType;             /*!< Type of the request on the link (teREQUEST_TYPE).*/
+    uint8_t     ui8Result;              /*!< Build / parse result (teSCI_ERROR).*/
+    uint16_t    ui16Len;                /*!< Frame length.*/
+    uint16_t    ui16CapLen;             /*!< Captured bytes (max. SCI_TRACE_SNAP_LENGTH).*/
+    uint8_t     ui8Data[SCI_TRACE_SNAP_LENGTH];
+}tsSCI_TRACE_RECORD;
+
+/** \brief Trace reader position */
+typedef struct
+{
+    uint32_t    ui32Next;               /*!< Sequence number of the next record to read.*/
+    uint32_t    ui32Lost;               /*!< Records overwritten before they were read.*/
+}tsSCI_TRACE_READER;
+
+#define tsSCI_TRACE_READER_DEFAULTS {0, 0}
+
+#if SCI_TRACE_NUM_RECORDS > 0
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes (and empties) the trace.
+ *
+ * @param GetTimeUsCB   Monotonic time in us (wraps around at 32 bit)
+ */
+void SCITraceInit (uint32_t (*GetTimeUsCB)(void));
+
+/** \brief Pauses or resumes the recording.*/
+void SCITraceEnable (bool bEnable);
+
+/** \brief Records a frame (called by the master, see SCI_TRACE_FRAME).*/
+void SCITraceFrame (uint8_t ui8Dir, uint8_t ui8State, uint8_t ui8RecMode, uint8_t ui8ReqType, uint8_t ui8Result,
+                    const uint8_t *pui8Frame, uint16_t ui16Len);
+
+/** \brief Reads the next record.
+ *
+ * A reader starting at sequence number 0 begins with the oldest record still
+ * in the ring.
+ *
+ * @param psReader  Reader position
+ * @param psRecord  Record storage
+ *
+ * @returns False if no record is left
+ */
+bool SCITraceRead (tsSCI_TRACE_READER *psReader, tsSCI_TRACE_RECORD *psRecord);
+
+/** \brief Writes all records in the ring as pcapng.
+ *
+ * @param WriteCB   Output of the file data (called per block part)
+ *
+ * @returns Number of exported frames
+ */
+uint32_t SCITraceExport (void (*WriteCB)(const uint8_t *pui8Data, uint16_t ui16Len));
+
+#endif // SCI_TRACE_NUM_RECORDS > 0
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCITRACE_H_
@@ -20,13 +20,25 @@
 #include <stddef.h>
 #include "SCIMasterConfig.h"
 #include "SCICommon.h"
+#include "SCICompress.h"
 
 /******************************************************************************
  * Defines
  *****************************************************************************/
 
-#define MAX_NUM_REQUEST_VALUES  10
-#define MAX_NUM_RESPONSE_VALUES 10
+#if RX_PACKET_LENGTH > 65535 || TX_PACKET_LENGTH > 65535
+#error "SCI frame lengths are limited to 16 bit."
+#endif
+
+#if MAX_NUM_RESPONSE_VALUES < SCI_HANDSHAKE_NUM_VALUES
+#error "The handshake response must fit into one response."
+#endif
+
+// Maximum length of a DOWNSTREAM data frame header ("num<offset,len;" in HEX)
+#define SCI_DOWNSTREAM_HEADER_LENGTH    19
+
+// Cancels the running transfer regardless of its number
+#define SCI_CANCEL_CURRENT              INT16_MIN
 
 /******************************************************************************
  * Type definitions
@@ -44,6 +56,12 @@ typedef union
 
 typedef tuREQUESTVALUE tuRESPONSEVALUE;
 
+/** \brief Converts a received value into the user storage of a certain datatype.*/
+typedef void (*SCI_DECODE_FCN)(tuRESPONSEVALUE uVal, void *pvDst);
+
+/** \brief Converts a value from the user storage of a certain datatype into a request value.*/
+typedef tuREQUESTVALUE (*SCI_ENCODE_FCN)(const void *pvSrc);
+
 
 /** \brief Request type enumeration.*/
 typedef enum 
@@ -53,7 +71,8 @@ typedef enum
     eREQUEST_TYPE_SETVAR        = 2,
     eREQUEST_TYPE_COMMAND       = 3,
     eREQUEST_TYPE_UPSTREAM      = 4,
-    eREQUEST_TYPE_DOWNSTREAM    = 5
+    eREQUEST_TYPE_DOWNSTREAM    = 5,
+    eREQUEST_TYPE_HANDSHAKE     = 6
 }teREQUEST_TYPE;
 
 
@@ -64,10 +83,13 @@ typedef struct
     int16_t         i16Num;                            /*!< ID Number.*/
     teREQUEST_TYPE  eReqType;                          /*!< REQUEST Type.*/
     tuREQUESTVALUE  *uValArr;                          /*!< Pointer to the value array.*/
-    uint8_t         ui8ValArrLen;                      /*!< Length of the value Array.*/
+    uint16_t        ui16ValArrLen;                     /*!< Length of the value Array.*/
+    const uint8_t   *pui8Raw;                          /*!< Raw data appended after the values (';' separated).*/
+    uint16_t        ui16RawLen;                        /*!< Length of the raw data.*/
+    bool            bNoResponse;                       /*!< The slave does not answer this request.*/
 }tsREQUEST;
 
-#define tsREQUEST_DEFAULTS         {0, 0, NULL, eREQUEST_TYPE_NONE}
+#define tsREQUEST_DEFAULTS         {0, 0, NULL, eREQUEST_TYPE_NONE, NULL, 0, false}
 
 /** \brief Response structure declaration.*/
 typedef struct
@@ -75,7 +97,7 @@ typedef struct
     int16_t                 i16Num;                             /*!< ID Number. (Reflects REQUEST ID number).*/
     teREQUEST_TYPE          eReqType;                           /*!< Response type inherited from REQUEST type.*/
     teREQUEST_ACKNOWLEDGE   eReqAck;                            /*!< Acknowledge returned by the REQUEST callback.*/
-    uint8_t                 ui8ResponseDataLength;              /*!< Data length within actual response */
+    uint16_t                ui16ResponseDataLength;             /*!< Data length within actual response */
     tuRESPONSEVALUE         uValArr[MAX_NUM_RESPONSE_VALUES];   /*!< Pointer to the value array.*/                           /*!< Response value.*/
     uint8_t                 *pui8Raw;                           /*!< Raw data of the response dataframe */
     uint16_t                ui16ErrNum;                         /*!< Returned error number */
@@ -92,45 +114,179 @@ typedef struct
     uint32_t        ui32TransferCnt;
     tuRESPONSEVALUE *uTransferResults;
     uint8_t         *pui8UpstreamBuffer;
+
+    const teSCI_DATATYPE    *peResultTypes;     /*!< Result datatypes of a typed request (NULL if untyped).*/
+    void * const            *ppvResults;        /*!< Result destinations of a typed request.*/
+    uint16_t                ui16ResultCnt;      /*!< Number of result destinations.*/
+
+    /** \brief DOWNSTREAM transfer state */
+    struct
+    {
+        const uint8_t   *pui8Data;              /*!< Source buffer (NULL: Data is fetched by DownstreamSourceCB).*/
+        uint8_t         *pui8Chunk;             /*!< Chunk memory if the data is fetched by DownstreamSourceCB.*/
+        uint32_t        ui32Len;                /*!< Overall length of the data.*/
+        uint32_t        ui32AckedOffset;        /*!< Data up to this offset has been acknowledged by the slave.*/
+        uint32_t        ui32SendOffset;         /*!< Offset of the next chunk to send.*/
+        uint16_t        ui16MaxChunkLen;        /*!< Maximum payload of a chunk (negotiated TX length minus header).*/
+        uint16_t        ui16Credit;             /*!< Number of chunks the slave accepts before it acknowledges.*/
+        uint16_t        ui16ChunksInFlight;     /*!< Chunks sent since the last acknowledge.*/
+    }sDownstream;
+
+    bool            bCancel;                    /*!< The transfer is aborted at the next chunk boundary.*/
+
+    bool                bCompressed;            /*!< The UPSTREAM in progress is compressed (the data counts refer to the wire).*/
+    tsSCI_DECOMPRESS    sDecompress;            /*!< Decoder of a compressed UPSTREAM.*/
 }tsTRANSFER_INFO;
 
-#define tsTRANSFER_INFO_DEFAULTS {tsREQUEST_DEFAULTS, 0, 0, 0, NULL, NULL}
+#define tsTRANSFER_INFO_DEFAULTS {tsREQUEST_DEFAULTS, 0, 0, 0, NULL, NULL, NULL, NULL, 0, {NULL, NULL, 0, 0, 0, 0, 0, 0}, false, false, {0}}
+
+/** \brief Urgent request waiting for the next chunk boundary */
+typedef struct
+{
+    teREQUEST_TYPE  eReqType;           /*!< GETVAR or SETVAR.*/
+    int16_t         i16Num;
+    tuREQUESTVALUE  uVal;               /*!< Value to set (SETVAR).*/
+}tsURGENT_REQUEST;
+
+#define tsURGENT_REQUEST_DEFAULTS {eREQUEST_TYPE_NONE, 0, {.ui32_hex = 0}}
 
 typedef struct
 {
     tsTRANSFER_INFO     sTransferInfo;
+    const SCI_DECODE_FCN *pDecodeTable;     /*!< Decoder table of the active value mode (indexed by teSCI_DATATYPE).*/
 
     struct
     {
         teTRANSFER_ACK  (*SetVarCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum);
         teTRANSFER_ACK  (*GetVarCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum);
-        teTRANSFER_ACK  (*CommandCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint8_t ui8DataCnt, uint16_t ui16ErrNum);
+        teTRANSFER_ACK  (*CommandCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum);
+        void            (*CommandDataCB)(int16_t i16Num, uint32_t *pui32Data, uint32_t ui32Offset, uint16_t ui16DataCnt);
         teTRANSFER_ACK  (*UpstreamCB)(int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt);
+        void            (*UpstreamDataCB)(int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Offset, uint16_t ui16DataCnt);
+        void            (*HandshakeCB)(teREQUEST_ACKNOWLEDGE eAck, tuRESPONSEVALUE *puVals, uint16_t ui16ValCnt);
+        uint16_t        (*DownstreamSourceCB)(int16_t i16Num, uint32_t ui32Offset, uint8_t *pui8Dst, uint16_t ui16MaxLen);
+        teTRANSFER_ACK  (*DownstreamCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32AckedByteCnt, uint16_t ui16ErrNum);
 
         bool        (*RequestCB)(tsREQUEST sReq);
         void        (*InitiateStreamCB)(uint32_t ui32ByteCount);
         void        (*FinishStreamCB)(void);
         void        (*ReleaseProtocolCB)(void);
     }sCallbacks;
+
+    /** \brief Urgent requests interleaved with a running transfer */
+    struct
+    {
+        tsURGENT_REQUEST    sQueue[SCI_URGENT_QUEUE_LENGTH];
+        uint8_t             ui8Head;            /*!< Index of the oldest request.*/
+        uint8_t             ui8Cnt;             /*!< Number of waiting requests.*/
+        tsURGENT_REQUEST    sInFlight;          /*!< Request on the link (value storage while it is built).*/
+        bool                bInFlight;          /*!< The next response belongs to sInFlight.*/
+        tsREQUEST           sResume;            /*!< Follow-up request of the interrupted transfer.*/
+        bool                bResumeDownstream;  /*!< The interrupted transfer continues with the next DOWNSTREAM chunk.*/
+        bool                bResumeStream;      /*!< The receive mode is switched back to stream on resume.*/
+    }sUrgent;
 }tsSCI_TRANSFER;
 
-#define tsSCI_TRANSFER_DEFAULTS {tsTRANSFER_INFO_DEFAULTS, {NULL}}
+#define tsSCI_URGENT_DEFAULTS {{tsURGENT_REQUEST_DEFAULTS}, 0, 0, tsURGENT_REQUEST_DEFAULTS, false, tsREQUEST_DEFAULTS, false, false}
+
+#define tsSCI_TRANSFER_DEFAULTS {tsTRANSFER_INFO_DEFAULTS, NULL, {NULL}, tsSCI_URGENT_DEFAULTS}
 
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
 
 /** \brief Builds the request and starts the transmission.
+ * 
+ * If result types are passed, the results of a GETVAR or COMMAND are decoded
+ * directly into the result destinations (typed request). In this case, the
+ * result callbacks only report the completion status (a COMMAND also the
+ * number of received results, an error if it does not match ui16ResultCnt).
  * 
  * @param psSciTransfer Pointer to the transfer data
  * @param eReqType      Request type of the transfer
  * @param i16CmdNum     Request number of the transfer
  * @param uVal          Pointer to the array of parameters to transmit
- * @param ui8Argnum     Number of parameters to transmit
+ * @param ui16ArgNum    Number of parameters to transmit
+ * @param peResultTypes Datatypes of the results (NULL for untyped requests)
+ * @param ppvResults    Result destinations (one per result type)
+ * @param ui16ResultCnt Number of result types / destinations
  * 
  * @returns Error indicator
  * */
-bool SCITransferStart (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16CmdNum, tuREQUESTVALUE *uVal, uint8_t ui8ArgNum);
+bool SCITransferStart (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16CmdNum, tuREQUESTVALUE *uVal, uint16_t ui16ArgNum,
+                       const teSCI_DATATYPE *peResultTypes, void * const *ppvResults, uint16_t ui16ResultCnt);
+
+/** \brief Starts a DOWNSTREAM transfer (bulk data to the slave).
+ * 
+ * The transfer is announced with "num<len,offset". The slave grants a credit 
+ * ("num<ACK;credit"), i.e. the number of data frames ("num<offset,len;raw") it
+ * accepts before it acknowledges cumulatively with the next expected offset
+ * ("num<ACK;offset"). All frames but the last one of a credit window are sent 
+ * without waiting for a response. The transfer goes back to the acknowledged 
+ * offset if the slave misses data. All numbers are in HEX format.
+ * 
+ * @param psSciTransfer     Pointer to the transfer data
+ * @param i16Num            Downstream number
+ * @param pui8Data          Data to transfer (NULL: Data is fetched by DownstreamSourceCB)
+ * @param ui32Len           Overall length of the data
+ * @param ui32StartOffset   Offset to start (or resume) the transfer from
+ * @param ui16MaxChunkLen   Maximum raw data length of one frame
+ * 
+ * @returns True if the transfer has been started
+ * */
+bool SCITransferStartDownstream (tsSCI_TRANSFER *psSciTransfer, int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Len, 
+                                 uint32_t ui32StartOffset, uint16_t ui16MaxChunkLen);
+
+/** \brief Queues an urgent GETVAR or SETVAR.
+ * 
+ * Multi-frame transfers (COMMAND results, UPSTREAM, DOWNSTREAM) check the queue 
+ * at every chunk boundary, i.e. before they request the next chunk from the slave 
+ * (DOWNSTREAM: after an acknowledge). Waiting urgent requests are sent first, 
+ * one after the other. The transfer is resumed from its offset afterwards. The
+ * results are reported by SetVarCB / GetVarCB (untyped). Requests queued 
+ * while a single-frame request is on the link are started by 
+ * SCITransferStartUrgent once the protocol is idle.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * @param eReqType      eREQUEST_TYPE_GETVAR or eREQUEST_TYPE_SETVAR
+ * @param i16Num        Variable number
+ * @param uVal          Value to set (SETVAR)
+ * 
+ * @returns False if the queue is full or the request type can't be interleaved
+ * */
+bool SCITransferUrgent (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16Num, tuREQUESTVALUE uVal);
+
+/** \brief Starts the oldest waiting urgent request (to be called if no transfer is active).
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * 
+ * @returns True if a request has been started
+ * */
+bool SCITransferStartUrgent (tsSCI_TRANSFER *psSciTransfer);
+
+/** \brief Cancels a running multi-frame transfer.
+ * 
+ * The transfer is stopped at its next chunk boundary (see SCITransferUrgent) 
+ * instead of requesting the next chunk: The transfer memory is freed, the 
+ * receive mode is switched back from stream to transfer frames and the protocol
+ * is released before the caller is notified with eREQUEST_ACK_STATUS_CANCELLED.
+ * COMMAND results and upstreams report by CommandCB, DOWNSTREAM transfers by 
+ * DownstreamCB (with the acknowledged offset to resume from). Waiting urgent 
+ * requests are still sent. The slave is not informed (the protocol has no abort 
+ * frame): It restarts its transfer state with the next announcing request.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * @param i16Num        Number of the transfer to cancel (SCI_CANCEL_CURRENT: any)
+ * 
+ * @returns False if no COMMAND, UPSTREAM or DOWNSTREAM transfer with this number is running
+ * */
+bool SCITransferCancel (tsSCI_TRANSFER *psSciTransfer, int16_t i16Num);
+
+/** \brief Continues a transfer after a request without response has been sent.
+ * 
+ * @param psSciTransfer Pointer to the transfer data
+ * */
+void SCITransferSent (tsSCI_TRANSFER *psSciTransfer);
 
 /** \brief Handles the transfer responses according to the protocol mechanisms.
  * 
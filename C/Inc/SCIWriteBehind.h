@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ * \file SCIWriteBehind.h
+ * \author Roman Holderried
+ *
+ * \brief Write-behind SETVAR buffer on top of the SCI master.
+ *
+ * Writes are accepted immediately and sent whenever the link is free. Until
+ * then, a newer write to the same variable replaces the pending value (last
+ * writer wins), so the slave never applies stale values late. A variable
+ * whose value is on the link meanwhile is written again afterwards.
+ *
+ * Pending writes to different variables are packed into SETVAR batch frames
+ * (SCIRequestSetVarBatch) if the slave supports SCI_FEATURE_SETVAR_BATCH,
+ * one SETVAR per write otherwise. Writes between two barriers are not ordered
+ * among each other. A barrier (SCIWriteBehindBarrier) separates them: Writes
+ * after it are neither merged into nor sent before the writes in front of it.
+ * The barrier callback reports when all writes before a barrier are finished.
+ *
+ * A frame without response is given up after the timeout of the
+ * configuration, the master is released then. If the application releases
+ * the master itself, the frame is given up on the next call of
+ * SCIWriteBehindProcess (or by SCIWriteBehindAbort right away). The writes of
+ * a given up frame are sent again (with their newest value).
+ *
+ * SCIWriteBehindSetVarCB must be registered as SetVarExternalCB of the master.
+ * Results of other SETVARs are forwarded to the callback in the configuration.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+#ifndef _SCIWRITEBEHIND_H_
+#define _SCIWRITEBEHIND_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "SCIMasterConfig.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Write-behind configuration */
+typedef struct
+{
+    void        (*BarrierCB)(uint32_t ui32Barrier);  /*!< All writes before the barrier are finished (may be NULL).*/
+    void        (*WriteErrorCB)(teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum); /*!< Failed write (may be NULL).*/
+    SETVAR_CB   SetVarForwardCB;    /*!< Application SETVAR callback (may be NULL).*/
+    uint32_t    (*GetTimeCB)(void); /*!< Time base of the timeout (may be NULL without timeout).*/
+    uint32_t    ui32Timeout;        /*!< Response timeout of a frame (unit of GetTimeCB, 0: None).*/
+}tsSCI_WB_CONFIG;
+
+#define tsSCI_WB_CONFIG_DEFAULTS {NULL, NULL, NULL, NULL, 0}
+
+/** \brief Write-behind statistics */
+typedef struct
+{
+    uint32_t ui32Writes;        /*!< Writes accepted.*/
+    uint32_t ui32Coalesced;     /*!< Writes replaced by a newer value before being sent.*/
+    uint32_t ui32Rejected;      /*!< Writes rejected (no entry left).*/
+    uint32_t ui32Frames;        /*!< SETVAR frames sent.*/
+    uint32_t ui32Batched;       /*!< Writes sent within batch frames (more than one write).*/
+    uint32_t ui32Errors;        /*!< Writes answered with an error.*/
+    uint32_t ui32Aborts;        /*!< Frames given up without response.*/
+}tsSCI_WB_STATS;
+
+#define tsSCI_WB_STATS_DEFAULTS {0, 0, 0, 0, 0, 0, 0}
+
+/** \brief Variable with a pending write */
+typedef struct
+{
+    int16_t         i16Num;
+    tuREQUESTVALUE  uVal;           /*!< Newest value.*/
+    uint32_t        ui32Epoch;      /*!< Barrier interval of the write.*/
+    uint32_t        ui32Order;      /*!< Order of the first write (sending order).*/
+    bool            bPending;       /*!< uVal has not been sent yet.*/
+    bool            bInFlight;      /*!< A value of the variable is on the link.*/
+}tsSCI_WB_ENTRY;
+
+/** \brief Write-behind main structure */
+typedef struct
+{
+    tsSCI_WB_CONFIG sConfig;
+    tsSCI_WB_ENTRY  sEntries[SCI_WB_NUM_ENTRIES];
+
+    uint8_t         ui8Batch[SCI_SETVAR_BATCH_MAX];     /*!< Entries of the frame in flight.*/
+    uint8_t         ui8BatchCnt;                        /*!< 0: No frame in flight.*/
+    uint32_t        ui32BatchStart;                     /*!< Start time of the frame in flight.*/
+
+    uint32_t        ui32Epoch;          /*!< Current barrier interval.*/
+    uint32_t        ui32Notified;       /*!< Barriers reported so far.*/
+    uint32_t        ui32Order;
+
+    tsSCI_WB_STATS  sStats;
+}tsSCI_WRITE_BEHIND;
+
+/******************************************************************************
+ * Function declarations
+ *****************************************************************************/
+/** \brief Initializes (and empties) the write-behind buffer.*/
+void SCIWriteBehindInit (tsSCI_WB_CONFIG sConfig);
+
+/** \brief Writes a variable.
+ *
+ * @param i16Num    Variable number
+ * @param uVal      Value to set
+ *
+ * @returns False if no entry is left (the write is dropped)
+ */
+bool SCIWriteBehindWrite (int16_t i16Num, tuREQUESTVALUE uVal);
+
+/** \brief Inserts a barrier (flush).
+ *
+ * @returns Barrier number (passed to the barrier callback once all writes before it are finished)
+ */
+uint32_t SCIWriteBehindBarrier (void);
+
+/** \brief Sends the pending writes if the master is idle.
+ *
+ * A frame in flight is given up if the master has been released without its
+ * response or if its timeout elapsed. To be called cyclically (next to
+ * SCIMasterSM).
+ */
+void SCIWriteBehindProcess (void);
+
+/** \brief Gives up the frame in flight (its writes are sent again).
+ *
+ * To be called if the application releases the master (SCIReleaseProtocol)
+ * while a frame may be in flight. A late response is forwarded like the
+ * result of a foreign SETVAR.
+ *
+ * @returns False if no frame is in flight
+ */
+bool SCIWriteBehindAbort (void);
+
+/** \brief True if no write is pending or in flight.*/
+bool SCIWriteBehindIsEmpty (void);
+
+/** \brief SETVAR result callback (to be passed as SetVarExternalCB of the master).*/
+teTRANSFER_ACK SCIWriteBehindSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum);
+
+/** \brief Returns the write-behind statistics.*/
+tsSCI_WB_STATS SCIWriteBehindGetStats (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SCIWRITEBEHIND_H_
@@ -18,11 +18,98 @@
 /******************************************************************************
  * Defines
  *****************************************************************************/
+// Frame sizes (payload bytes between STX and ETX, max. 65535)
+#ifndef RX_PACKET_LENGTH
 #define RX_PACKET_LENGTH    128
+#endif
+#ifndef TX_PACKET_LENGTH
 #define TX_PACKET_LENGTH    128
+#endif
 
-// Mode configuration
+// Maximum number of values within one request / response dataframe
+#ifndef MAX_NUM_REQUEST_VALUES
+#define MAX_NUM_REQUEST_VALUES  10
+#endif
+#ifndef MAX_NUM_RESPONSE_VALUES
+#define MAX_NUM_RESPONSE_VALUES 10
+#endif
+
+// GETVAR cache: Number of cached variables and of reads waiting for a response
+#ifndef SCI_CACHE_NUM_ENTRIES
+#define SCI_CACHE_NUM_ENTRIES   32
+#endif
+#ifndef SCI_CACHE_NUM_WAITERS
+#define SCI_CACHE_NUM_WAITERS   8
+#endif
+
+// Polling scheduler: Number of subscriptions and of buffered samples (if no sample callback is used)
+#ifndef SCI_SCHED_NUM_SUBSCRIPTIONS
+#define SCI_SCHED_NUM_SUBSCRIPTIONS 32
+#endif
+#ifndef SCI_SCHED_RING_LENGTH
+#define SCI_SCHED_RING_LENGTH       64
+#endif
+// Polling scheduler: Worst case bytes of a GETVAR request plus response (incl. STX/ETX) and
+// share of the link time the subscriptions may occupy (percent, the rest is left to other requests)
+#ifndef SCI_SCHED_GETVAR_FRAME_BYTES
+#define SCI_SCHED_GETVAR_FRAME_BYTES 32
+#endif
+#ifndef SCI_SCHED_MAX_UTILIZATION
+#define SCI_SCHED_MAX_UTILIZATION   90
+#endif
+
+// Write-behind: Number of variables with pending writes
+#ifndef SCI_WB_NUM_ENTRIES
+#define SCI_WB_NUM_ENTRIES          32
+#endif
+
+// Urgent requests: Number of GETVAR/SETVAR requests waiting to be interleaved with a running transfer
+#ifndef SCI_URGENT_QUEUE_LENGTH
+#define SCI_URGENT_QUEUE_LENGTH     4
+#endif
+
+// Frame trace: Number of recorded frames (0: Trace not compiled in) and captured bytes per frame
+#ifndef SCI_TRACE_NUM_RECORDS
+#define SCI_TRACE_NUM_RECORDS       0
+#endif
+#ifndef SCI_TRACE_SNAP_LENGTH
+#define SCI_TRACE_SNAP_LENGTH       64
+#endif
+
+// Protocol metrics: Counters and latency histograms per request type (0: Not compiled in), latency buckets (80: up to ~1.8 s)
+#ifndef SCI_METRICS_ENABLE
+#define SCI_METRICS_ENABLE          0
+#endif
+#ifndef SCI_METRICS_NUM_BUCKETS
+#define SCI_METRICS_NUM_BUCKETS     80
+#endif
+
+// Datalogger client: Number of queued operations
+#ifndef SCI_DLOG_QUEUE_LENGTH
+#define SCI_DLOG_QUEUE_LENGTH       16
+#endif
+
+// Stack buffer for compressed upstreams delivered incrementally (at least SCI_COMPRESS_MAX_WORD_LEN)
+#ifndef SCI_UPSTREAM_DECOMPRESS_CHUNK
+#define SCI_UPSTREAM_DECOMPRESS_CHUNK 256
+#endif
+
+// Fleet manager (Linux hosts, epoll): Compiled in if set, number of devices, requests queued per
+// device and bytes read from a device per turn of the event loop
+#ifndef SCI_FLEET_ENABLE
+#define SCI_FLEET_ENABLE            0
+#endif
+#ifndef SCI_FLEET_MAX_DEVICES
+#define SCI_FLEET_MAX_DEVICES       64
+#endif
+#ifndef SCI_FLEET_QUEUE_LENGTH
+#define SCI_FLEET_QUEUE_LENGTH      8
+#endif
+#ifndef SCI_FLEET_RX_BUDGET
+#define SCI_FLEET_RX_BUDGET         512
+#endif
+
+// Mode configuration (The value mode is selected at runtime by SCIMasterInit)
 #define SEND_MODE_BYTE_BY_BYTE
-#define VALUE_MODE_HEX
 
 #endif // _SCIMASTERCONFIG_H_
\ No newline at end of file
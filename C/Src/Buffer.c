@@ -13,11 +13,11 @@
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
-void fifoBufInit(tsFIFO_BUF* p_inst, uint8_t *pui8_buf, uint8_t ui8_bufLen)
+void fifoBufInit(tsFIFO_BUF* p_inst, uint8_t *pui8_buf, uint16_t ui16_bufLen)
 {
     p_inst->b_ovfl = false;
-    p_inst->ui8_bufLen = ui8_bufLen;
-    p_inst->ui8_bufSpace = ui8_bufLen;
+    p_inst->ui16_bufLen = ui16_bufLen;
+    p_inst->ui16_bufSpace = ui16_bufLen;
     p_inst->pui8_bufPtr = pui8_buf;
 }
 
@@ -25,20 +25,20 @@ void fifoBufInit(tsFIFO_BUF* p_inst, uint8_t *pui8_buf, uint8_t ui8_bufLen)
 void putElem(tsFIFO_BUF* p_inst, uint8_t ui8_data)
 {
     // Put the data into the buffer only when it is not going to be overflowed
-    if (p_inst->ui8_bufSpace > 0)
+    if (p_inst->ui16_bufSpace > 0)
     {
-        p_inst->ui8_bufSpace--;
-        p_inst->i16_bufIdx++;
-        p_inst->pui8_bufPtr[p_inst->i16_bufIdx] = ui8_data;
+        p_inst->ui16_bufSpace--;
+        p_inst->i32_bufIdx++;
+        p_inst->pui8_bufPtr[p_inst->i32_bufIdx] = ui8_data;
     }
     else
         p_inst->b_ovfl = true;
 }
 
 //=============================================================================
-uint8_t readBuf(tsFIFO_BUF* p_inst, uint8_t **pui8_target)
+uint16_t readBuf(tsFIFO_BUF* p_inst, uint8_t **pui8_target)
 {
-    uint8_t size = p_inst->i16_bufIdx + 1;
+    uint16_t size = (uint16_t)(p_inst->i32_bufIdx + 1);
 
     *pui8_target = p_inst->pui8_bufPtr;
 
@@ -50,8 +50,8 @@ uint8_t readBuf(tsFIFO_BUF* p_inst, uint8_t **pui8_target)
 //=============================================================================
 void flushBuf (tsFIFO_BUF* p_inst)
 {
-    p_inst->i16_bufIdx      = -1;
-    p_inst->ui8_bufSpace    = p_inst->ui8_bufLen;
+    p_inst->i32_bufIdx      = -1;
+    p_inst->ui16_bufSpace   = p_inst->ui16_bufLen;
     p_inst->b_ovfl          = false;
 } 
 
@@ -60,9 +60,9 @@ bool getNextFreeBufSpace(tsFIFO_BUF* p_inst, uint8_t **pui8_target)
 {
     bool success = false;
 
-    if (p_inst->ui8_bufSpace > 0)
+    if (p_inst->ui16_bufSpace > 0)
     {
-        *pui8_target = &p_inst->pui8_bufPtr[p_inst->i16_bufIdx + 1];
+        *pui8_target = &p_inst->pui8_bufPtr[p_inst->i32_bufIdx + 1];
         success = true;
     }
 
@@ -70,14 +70,14 @@ bool getNextFreeBufSpace(tsFIFO_BUF* p_inst, uint8_t **pui8_target)
 }
 
 //=============================================================================
-bool increaseBufIdx(tsFIFO_BUF* p_inst, uint8_t ui8_size)
+bool increaseBufIdx(tsFIFO_BUF* p_inst, uint16_t ui16_size)
 {
     bool success = false;
 
-    if ((p_inst->i16_bufIdx + ui8_size) < p_inst->ui8_bufLen)
+    if ((p_inst->i32_bufIdx + ui16_size) < p_inst->ui16_bufLen)
     {
-        p_inst->i16_bufIdx      += ui8_size;
-        p_inst->ui8_bufSpace    -= ui8_size;
+        p_inst->i32_bufIdx      += ui16_size;
+        p_inst->ui16_bufSpace   -= ui16_size;
         success         = true;
     }
 
@@ -86,7 +86,7 @@ bool increaseBufIdx(tsFIFO_BUF* p_inst, uint8_t ui8_size)
 }
 
 //=============================================================================
-int16_t getActualIdx(tsFIFO_BUF* p_inst)
+int32_t getActualIdx(tsFIFO_BUF* p_inst)
 {
-    return p_inst->i16_bufIdx;
+    return p_inst->i32_bufIdx;
 }
\ No newline at end of file
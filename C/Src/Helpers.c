@@ -6,6 +6,7 @@
  *
  * <b> History </b>
  * 	- 2022-11-17 - Copy from SCI
+ * 	- 2026-10-18 - ftoa: Integral part up to UINT32_MAX
  *****************************************************************************/
 /******************************************************************************
  * Includes
@@ -27,13 +28,14 @@ uint8_t ftoa (uint8_t *pui8_resBuf, float val, bool b_round)
 {
     float signum            = (val < 0) * -1 + (val > 0);
     float rval              = val + b_round * signum * 0.5f / ui32_pow10[FTOA_MAX_AFTERPOINT]; 
-    int32_t i32_tmp         = (int32_t)(rval);
-    int32_t i32_tmp2        = 0;
+    // Magnitude of the integral part (covers the UINT32 range)
+    uint32_t ui32_tmp       = (uint32_t)(signum * rval);
+    uint32_t ui32_tmp2      = 0;
     uint32_t ui32_decimator = 1;
     uint8_t ui8_size        = 0;
     int8_t i8_exp           = -1;
     uint8_t ui8_digit       = 0;
-    uint32_t ui32_afterPoint= (uint32_t)(signum * (rval - i32_tmp) * ui32_pow10[FTOA_MAX_AFTERPOINT]);
+    uint32_t ui32_afterPoint= (uint32_t)((signum * rval - ui32_tmp) * ui32_pow10[FTOA_MAX_AFTERPOINT]);
 
 
     // Sign evaluation - Add the sign if necessary
@@ -41,19 +43,18 @@ uint8_t ftoa (uint8_t *pui8_resBuf, float val, bool b_round)
     {
         *pui8_resBuf++ = '-';
         ui8_size++;
-        i32_tmp = -1 * i32_tmp;
     }
 
     // Determine decimator -> Determine how big the number is
-    i32_tmp2 = i32_tmp;
-    while (i32_tmp2 > 0)
+    ui32_tmp2 = ui32_tmp;
+    while (ui32_tmp2 > 0)
     {
         i8_exp++;
         
         if (i8_exp > 0)
             ui32_decimator *= 10;
 
-        i32_tmp2 /= 10;
+        ui32_tmp2 /= 10;
     }
 
     // If 1 > rval > -1, write a '0' into the buffer place
@@ -71,11 +72,11 @@ uint8_t ftoa (uint8_t *pui8_resBuf, float val, bool b_round)
         while(i8_exp >= 0)
         {
             // Determine next digit
-            ui8_digit = i32_tmp/ui32_decimator;
+            ui8_digit = ui32_tmp/ui32_decimator;
             // Write ASCII digit into the buffer
             *pui8_resBuf++ = ui8_digit + '0';
             
-            i32_tmp -= ui8_digit * ui32_decimator;
+            ui32_tmp -= ui8_digit * ui32_decimator;
             ui32_decimator /= 10;
             i8_exp--;
         }
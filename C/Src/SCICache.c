@@ -0,0 +1,273 @@
+/**************************************************************************//**
+ * \file SCICache.c
+ * \author Roman Holderried
+ *
+ * \brief Host-side GETVAR cache on top of the SCI master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCICache.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_CACHE sSciCache;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static tsSCI_CACHE_ENTRY *_FindEntry (int16_t i16Num)
+{
+    for (uint16_t i = 0; i < SCI_CACHE_NUM_ENTRIES; i++)
+    {
+        if (sSciCache.sEntries[i].bUsed && sSciCache.sEntries[i].i16Num == i16Num)
+            return &sSciCache.sEntries[i];
+    }
+
+    return NULL;
+}
+
+//=============================================================================
+static tsSCI_CACHE_ENTRY *_AssignEntry (int16_t i16Num)
+{
+    tsSCI_CACHE_ENTRY *psEntry = NULL;
+    uint32_t ui32Now = sSciCache.GetTimeCB();
+
+    // Free entry or the one with the oldest value (entries in flight are kept)
+    for (uint16_t i = 0; i < SCI_CACHE_NUM_ENTRIES; i++)
+    {
+        tsSCI_CACHE_ENTRY *psCandidate = &sSciCache.sEntries[i];
+
+        if (!psCandidate->bUsed)
+        {
+            psEntry = psCandidate;
+            break;
+        }
+
+        if (psCandidate->bInFlight)
+            continue;
+
+        if (psEntry == NULL || !psCandidate->bValid ||
+            (ui32Now - psCandidate->ui32Timestamp) > (ui32Now - psEntry->ui32Timestamp))
+            psEntry = psCandidate;
+    }
+
+    if (psEntry != NULL)
+    {
+        memset(psEntry, 0, sizeof(tsSCI_CACHE_ENTRY));
+        psEntry->i16Num = i16Num;
+        psEntry->bUsed  = true;
+    }
+
+    return psEntry;
+}
+
+//=============================================================================
+static bool _AddWaiter (int16_t i16Num, SCI_CACHE_CB ReadCB)
+{
+    if (ReadCB == NULL)
+        return true;
+
+    for (uint16_t i = 0; i < SCI_CACHE_NUM_WAITERS; i++)
+    {
+        if (sSciCache.sWaiters[i].ReadCB == NULL)
+        {
+            sSciCache.sWaiters[i].i16Num = i16Num;
+            sSciCache.sWaiters[i].ReadCB = ReadCB;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//=============================================================================
+static void _Deliver (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    // The slot is freed first, so the callback may read again
+    for (uint16_t i = 0; i < SCI_CACHE_NUM_WAITERS; i++)
+    {
+        SCI_CACHE_CB ReadCB = sSciCache.sWaiters[i].ReadCB;
+
+        if (ReadCB != NULL && sSciCache.sWaiters[i].i16Num == i16Num)
+        {
+            sSciCache.sWaiters[i].ReadCB = NULL;
+            ReadCB(eAck, i16Num, ui32Data, ui16ErrNum);
+        }
+    }
+}
+
+//=============================================================================
+static void _AbortRead (void)
+{
+    tsSCI_CACHE_ENTRY *psEntry = &sSciCache.sEntries[sSciCache.i16InFlight];
+
+    sSciCache.i16InFlight = -1;
+    psEntry->bInFlight = false;
+    sSciCache.sStats.ui32Aborts++;
+
+    _Deliver(eREQUEST_ACK_STATUS_CANCELLED, psEntry->i16Num, 0, 0);
+}
+
+//=============================================================================
+void SCICacheInit (uint32_t (*GetTimeCB)(void), uint32_t ui32Timeout, GETVAR_CB GetVarForwardCB)
+{
+    tsSCI_CACHE_STATS sStats = tsSCI_CACHE_STATS_DEFAULTS;
+
+    memset(&sSciCache, 0, sizeof(sSciCache));
+
+    sSciCache.i16InFlight       = -1;
+    sSciCache.ui32Timeout       = ui32Timeout;
+    sSciCache.GetTimeCB         = GetTimeCB;
+    sSciCache.GetVarForwardCB   = GetVarForwardCB;
+    sSciCache.sStats            = sStats;
+}
+
+//=============================================================================
+void SCICacheProcess (void)
+{
+    if (sSciCache.i16InFlight < 0)
+        return;
+
+    // GETVAR without response: The master has been released meanwhile or the timeout elapsed
+    if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+        _AbortRead();
+    else if (sSciCache.ui32Timeout > 0 && (sSciCache.GetTimeCB() - sSciCache.ui32InFlightStart) >= sSciCache.ui32Timeout)
+    {
+        SCIReleaseProtocol();
+        _AbortRead();
+    }
+}
+
+//=============================================================================
+bool SCICacheAbort (void)
+{
+    if (sSciCache.i16InFlight < 0)
+        return false;
+
+    _AbortRead();
+
+    return true;
+}
+
+//=============================================================================
+teTRANSFER_ACK SCICacheGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    tsSCI_CACHE_ENTRY *psEntry = _FindEntry(i16Num);
+
+    if (psEntry != NULL)
+    {
+        if (psEntry->bInFlight)
+            sSciCache.i16InFlight = -1;
+
+        psEntry->bInFlight = false;
+
+        // Results of foreign GETVARs refresh the cache as well
+        if (eAck == eREQUEST_ACK_STATUS_SUCCESS)
+        {
+            psEntry->ui32Data       = ui32Data;
+            psEntry->ui32Timestamp  = sSciCache.GetTimeCB();
+            psEntry->bValid         = true;
+        }
+    }
+
+    // Deliver the result to all merged reads
+    _Deliver(eAck, i16Num, ui32Data, ui16ErrNum);
+
+    if (sSciCache.GetVarForwardCB != NULL)
+        return sSciCache.GetVarForwardCB(eAck, i16Num, ui32Data, ui16ErrNum);
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+teSCI_CACHE_RESULT SCICacheRead (int16_t i16Num, uint32_t ui32MaxAge, uint32_t *pui32Data, SCI_CACHE_CB ReadCB)
+{
+    tsSCI_CACHE_ENTRY *psEntry = _FindEntry(i16Num);
+
+    sSciCache.sStats.ui32Reads++;
+
+    // Young enough
+    if (psEntry != NULL && psEntry->bValid && (sSciCache.GetTimeCB() - psEntry->ui32Timestamp) <= ui32MaxAge)
+    {
+        *pui32Data = psEntry->ui32Data;
+        sSciCache.sStats.ui32Hits++;
+        return eSCI_CACHE_HIT;
+    }
+
+    // Merge into the GETVAR in flight
+    if (psEntry != NULL && psEntry->bInFlight)
+    {
+        if (!_AddWaiter(i16Num, ReadCB))
+            return eSCI_CACHE_BUSY;
+
+        sSciCache.sStats.ui32Coalesced++;
+        return eSCI_CACHE_PENDING;
+    }
+
+    if (psEntry == NULL)
+        psEntry = _AssignEntry(i16Num);
+
+    if (psEntry == NULL || !_AddWaiter(i16Num, ReadCB))
+        return eSCI_CACHE_BUSY;
+
+    if (!SCIRequestGetVar(i16Num))
+    {
+        // Take the waiter back
+        for (uint16_t i = 0; i < SCI_CACHE_NUM_WAITERS; i++)
+        {
+            if (sSciCache.sWaiters[i].ReadCB == ReadCB && sSciCache.sWaiters[i].i16Num == i16Num)
+            {
+                sSciCache.sWaiters[i].ReadCB = NULL;
+                break;
+            }
+        }
+        return eSCI_CACHE_BUSY;
+    }
+
+    psEntry->bInFlight = true;
+    sSciCache.i16InFlight = (int16_t)(psEntry - sSciCache.sEntries);
+    sSciCache.ui32InFlightStart = sSciCache.GetTimeCB();
+    sSciCache.sStats.ui32LinkReads++;
+
+    return eSCI_CACHE_PENDING;
+}
+
+//=============================================================================
+bool SCICacheSetVar (int16_t i16Num, tuREQUESTVALUE uVal)
+{
+    if (!SCIRequestSetVar(i16Num, uVal))
+        return false;
+
+    SCICacheInvalidate(i16Num);
+
+    return true;
+}
+
+//=============================================================================
+void SCICacheInvalidate (int16_t i16Num)
+{
+    tsSCI_CACHE_ENTRY *psEntry = _FindEntry(i16Num);
+
+    if (psEntry != NULL && psEntry->bValid)
+    {
+        psEntry->bValid = false;
+        sSciCache.sStats.ui32Invalidations++;
+    }
+}
+
+//=============================================================================
+tsSCI_CACHE_STATS SCICacheGetStats (void)
+{
+    return sSciCache.sStats;
+}
@@ -0,0 +1,287 @@
+/**************************************************************************//**
+ * \file SCICapture.c
+ * \author Roman Holderried
+ *
+ * \brief Writer of datalogger capture files.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCICapture.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_CAPTURE_BLOCK_MAGIC     0x4B4C4253u     // "SBLK"
+#define SCI_CAPTURE_ALIGN           8
+#define SCI_CAPTURE_DRAIN_HDR_LEN   6               // UINT32 first sample index, UINT16 number of samples
+#define SCI_CAPTURE_INDEX_RANGE     0x100000000ull  // Range of the device sample counter
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static const uint8_t ui8FileMagic[8]    = {'S', 'C', 'I', 'C', 'A', 'P', 'T', 0x1A};
+static const uint8_t ui8FooterMagic[8]  = {'S', 'C', 'I', 'C', 'A', 'P', 'I', 'X'};
+static const uint8_t ui8Padding[SCI_CAPTURE_ALIGN];
+
+// Sample sizes (teSCI_DATATYPE)
+static const uint8_t ui8DtypeSize[eSCI_DTYPE_NUM] = {1, 1, 2, 2, 4, 4, 4};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static void _PutLE (uint8_t *pui8Dst, uint64_t ui64Val, uint8_t ui8Len)
+{
+    for (uint8_t i = 0; i < ui8Len; i++)
+        pui8Dst[i] = (uint8_t)(ui64Val >> (8 * i));
+}
+
+//=============================================================================
+static uint64_t _GetBE (const uint8_t *pui8Src, uint8_t ui8Len)
+{
+    uint64_t ui64Val = 0;
+
+    for (uint8_t i = 0; i < ui8Len; i++)
+        ui64Val = (ui64Val << 8) | pui8Src[i];
+
+    return ui64Val;
+}
+
+//=============================================================================
+static void _Write (tsSCI_CAPTURE *psCapture, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    if (ui32Len == 0)
+        return;
+
+    psCapture->WriteCB(pui8Data, ui32Len);
+    psCapture->ui64Offset += ui32Len;
+}
+
+//=============================================================================
+static int8_t _ChannelPos (const tsSCI_CAPTURE *psCapture, uint8_t ui8Channel)
+{
+    for (uint8_t i = 0; i < psCapture->ui8NumChannels; i++)
+    {
+        if (psCapture->sChannels[i].ui8Channel == ui8Channel)
+            return (int8_t)i;
+    }
+
+    return -1;
+}
+
+//=============================================================================
+bool SCICaptureOpen (tsSCI_CAPTURE *psCapture, void (*WriteCB)(const uint8_t *pui8Data, uint32_t ui32Len),
+                     const tsSCI_CAPTURE_CHANNEL *psChannels, uint8_t ui8NumChannels, uint32_t ui32BaseFrequency,
+                     uint64_t ui64StartTimeUs, tsSCI_CAPTURE_INDEX *psIndex, uint32_t ui32IndexSize)
+{
+    uint8_t ui8Header[SCI_CAPTURE_HEADER_LEN] = {0};
+
+    if (WriteCB == NULL || ui8NumChannels == 0 || ui8NumChannels > SCI_CAPTURE_MAX_CHANNELS)
+        return false;
+
+    for (uint8_t i = 0; i < ui8NumChannels; i++)
+    {
+        if (psChannels[i].ui8Dtype >= eSCI_DTYPE_NUM)
+            return false;
+    }
+
+    memset(psCapture, 0, sizeof(tsSCI_CAPTURE));
+    psCapture->WriteCB          = WriteCB;
+    psCapture->ui8NumChannels   = ui8NumChannels;
+    psCapture->psIndex          = psIndex;
+    psCapture->ui32IndexSize    = psIndex != NULL ? ui32IndexSize : 0;
+    memcpy(psCapture->sChannels, psChannels, ui8NumChannels * sizeof(tsSCI_CAPTURE_CHANNEL));
+
+    memcpy(ui8Header, ui8FileMagic, sizeof(ui8FileMagic));
+    _PutLE(&ui8Header[8], SCI_CAPTURE_VERSION, 2);
+    _PutLE(&ui8Header[10], ui8NumChannels, 2);
+    _PutLE(&ui8Header[12], ui32BaseFrequency, 4);
+    _PutLE(&ui8Header[16], SCI_CAPTURE_FLAG_BIG_ENDIAN, 4);
+    _PutLE(&ui8Header[24], ui64StartTimeUs, 8);
+    _Write(psCapture, ui8Header, sizeof(ui8Header));
+
+    for (uint8_t i = 0; i < ui8NumChannels; i++)
+    {
+        uint8_t ui8Entry[SCI_CAPTURE_CHANNEL_LEN] = {0};
+
+        ui8Entry[0] = psChannels[i].ui8Channel;
+        ui8Entry[1] = psChannels[i].ui8Dtype;
+        _PutLE(&ui8Entry[2], psChannels[i].ui16VarNum, 2);
+        _PutLE(&ui8Entry[4], psChannels[i].ui32Divider, 4);
+        _PutLE(&ui8Entry[8], psChannels[i].ui32RecLen, 4);
+        _Write(psCapture, ui8Entry, sizeof(ui8Entry));
+    }
+
+    return true;
+}
+
+//=============================================================================
+bool SCICaptureWriteBlock (tsSCI_CAPTURE *psCapture, uint8_t ui8Channel, uint64_t ui64FirstIndex, const uint8_t *pui8Samples, uint32_t ui32Count)
+{
+    uint8_t ui8Header[SCI_CAPTURE_BLOCK_HEADER_LEN] = {0};
+    int8_t i8Pos = _ChannelPos(psCapture, ui8Channel);
+    uint32_t ui32DataLen;
+
+    if (i8Pos < 0)
+        return false;
+
+    if (ui32Count == 0)
+        return true;
+
+    ui32DataLen = ui32Count * ui8DtypeSize[psCapture->sChannels[i8Pos].ui8Dtype];
+
+    if (psCapture->ui32IndexCnt < psCapture->ui32IndexSize)
+    {
+        tsSCI_CAPTURE_INDEX *psEntry = &psCapture->psIndex[psCapture->ui32IndexCnt++];
+
+        psEntry->ui64Offset     = psCapture->ui64Offset;
+        psEntry->ui64FirstIndex = ui64FirstIndex;
+        psEntry->ui32Count      = ui32Count;
+        psEntry->ui8Channel     = ui8Channel;
+    }
+    else
+    {
+        psCapture->bIndexOverflow = true;
+    }
+
+    _PutLE(&ui8Header[0], SCI_CAPTURE_BLOCK_MAGIC, 4);
+    ui8Header[4] = ui8Channel;
+    _PutLE(&ui8Header[8], ui64FirstIndex, 8);
+    _PutLE(&ui8Header[16], ui32Count, 4);
+    _PutLE(&ui8Header[20], ui32DataLen, 4);
+
+    _Write(psCapture, ui8Header, sizeof(ui8Header));
+    _Write(psCapture, pui8Samples, ui32DataLen);
+    // Keep the following block headers (and so the sample columns) aligned
+    _Write(psCapture, ui8Padding, (SCI_CAPTURE_ALIGN - ui32DataLen % SCI_CAPTURE_ALIGN) % SCI_CAPTURE_ALIGN);
+
+    if (ui64FirstIndex + ui32Count > psCapture->ui64NextIndex[i8Pos])
+        psCapture->ui64NextIndex[i8Pos] = ui64FirstIndex + ui32Count;
+
+    return true;
+}
+
+//=============================================================================
+uint32_t SCICaptureWriteUpstream (tsSCI_CAPTURE *psCapture, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    uint32_t ui32Offset = 0;
+    uint32_t ui32Written = 0;
+
+    for (uint8_t i = 0; i < psCapture->ui8NumChannels; i++)
+    {
+        const tsSCI_CAPTURE_CHANNEL *psChannel = &psCapture->sChannels[i];
+        uint8_t ui8Size = ui8DtypeSize[psChannel->ui8Dtype];
+        uint32_t ui32Count = psChannel->ui32RecLen;
+
+        if (ui32Offset >= ui32Len)
+            break;
+
+        if ((ui32Len - ui32Offset) / ui8Size < ui32Count)
+            ui32Count = (ui32Len - ui32Offset) / ui8Size;
+
+        SCICaptureWriteBlock(psCapture, psChannel->ui8Channel, psCapture->ui64NextIndex[i], &pui8Data[ui32Offset], ui32Count);
+
+        ui32Offset += ui32Count * ui8Size;
+        ui32Written += ui32Count;
+    }
+
+    return ui32Written;
+}
+
+//=============================================================================
+uint32_t SCICaptureWriteDrain (tsSCI_CAPTURE *psCapture, const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    uint32_t ui32Offset = 0;
+    uint32_t ui32Written = 0;
+
+    for (uint8_t i = 0; i < psCapture->ui8NumChannels && ui32Offset + SCI_CAPTURE_DRAIN_HDR_LEN <= ui32Len; i++)
+    {
+        const tsSCI_CAPTURE_CHANNEL *psChannel = &psCapture->sChannels[i];
+        uint8_t ui8Size = ui8DtypeSize[psChannel->ui8Dtype];
+        uint32_t ui32DevIndex = (uint32_t)_GetBE(&pui8Data[ui32Offset], 4);
+        uint32_t ui32Count = (uint32_t)_GetBE(&pui8Data[ui32Offset + 4], 2);
+        const uint8_t *pui8Samples = &pui8Data[ui32Offset + SCI_CAPTURE_DRAIN_HDR_LEN];
+        uint64_t ui64First;
+
+        ui32Offset += SCI_CAPTURE_DRAIN_HDR_LEN;
+
+        if ((ui32Len - ui32Offset) / ui8Size < ui32Count)
+            ui32Count = (ui32Len - ui32Offset) / ui8Size;
+
+        ui32Offset += ui32Count * ui8Size;
+
+        if (!psCapture->bIndexed[i])
+        {
+            // First drain: The recording starts at the device counter
+            ui64First = ui32DevIndex;
+            psCapture->bIndexed[i] = true;
+        }
+        else
+        {
+            uint64_t ui64Next = psCapture->ui64NextIndex[i];
+            uint32_t ui32Delta = (uint32_t)(ui32DevIndex - (uint32_t)ui64Next);
+
+            if (ui32Delta >= SCI_CAPTURE_INDEX_RANGE / 2)
+            {
+                // Counter behind the expected index: Skip the samples already written
+                uint32_t ui32Skip = (uint32_t)(SCI_CAPTURE_INDEX_RANGE - ui32Delta);
+
+                if (ui32Skip > ui32Count)
+                    ui32Skip = ui32Count;
+
+                pui8Samples += ui32Skip * ui8Size;
+                ui32Count -= ui32Skip;
+                ui32Delta = 0;
+            }
+            else if (ui32Delta > 0)
+            {
+                psCapture->ui32Gaps++;
+            }
+
+            ui64First = ui64Next + ui32Delta;
+        }
+
+        SCICaptureWriteBlock(psCapture, psChannel->ui8Channel, ui64First, pui8Samples, ui32Count);
+        psCapture->ui64NextIndex[i] = ui64First + ui32Count;
+
+        ui32Written += ui32Count;
+    }
+
+    return ui32Written;
+}
+
+//=============================================================================
+void SCICaptureClose (tsSCI_CAPTURE *psCapture)
+{
+    uint8_t ui8Footer[SCI_CAPTURE_FOOTER_LEN] = {0};
+    uint64_t ui64IndexOffset = psCapture->ui64Offset;
+
+    // An incomplete index would hide blocks: The reader walks the block headers instead
+    if (psCapture->bIndexOverflow)
+        return;
+
+    for (uint32_t i = 0; i < psCapture->ui32IndexCnt; i++)
+    {
+        const tsSCI_CAPTURE_INDEX *psEntry = &psCapture->psIndex[i];
+        uint8_t ui8Entry[SCI_CAPTURE_INDEX_ENTRY_LEN] = {0};
+
+        _PutLE(&ui8Entry[0], psEntry->ui64Offset, 8);
+        _PutLE(&ui8Entry[8], psEntry->ui64FirstIndex, 8);
+        _PutLE(&ui8Entry[16], psEntry->ui32Count, 4);
+        ui8Entry[20] = psEntry->ui8Channel;
+        _Write(psCapture, ui8Entry, sizeof(ui8Entry));
+    }
+
+    _PutLE(&ui8Footer[0], ui64IndexOffset, 8);
+    _PutLE(&ui8Footer[8], psCapture->ui32IndexCnt, 4);
+    memcpy(&ui8Footer[16], ui8FooterMagic, sizeof(ui8FooterMagic));
+    _Write(psCapture, ui8Footer, sizeof(ui8Footer));
+}
@@ -0,0 +1,158 @@
+/**************************************************************************//**
+ * \file SCICompress.c
+ * \author Roman Holderried
+ *
+ * \brief Compression of UPSTREAM payloads.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCICompress.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_COMPRESS_MAX_SHIFT  28  // Fifth byte of a 32 bit varint
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+// Word lengths (teSCI_COMPRESS_CODEC)
+static const uint8_t ui8WordLen[eSCI_COMPRESS_NUM] = {0, 1, 2, 4};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t _WordMask (uint8_t ui8Len)
+{
+    return ui8Len >= 4 ? 0xFFFFFFFFu : ((1u << (8 * ui8Len)) - 1u);
+}
+
+//=============================================================================
+uint32_t SCICompress (teSCI_COMPRESS_CODEC eCodec, const uint8_t *pui8Src, uint32_t ui32Len, uint8_t *pui8Dst, uint32_t ui32DstSize)
+{
+    uint8_t ui8Len;
+    uint8_t ui8Shift;
+    uint32_t ui32Prev = 0;
+    uint32_t ui32Out = 0;
+
+    if (eCodec <= eSCI_COMPRESS_NONE || eCodec >= eSCI_COMPRESS_NUM)
+        return 0;
+
+    ui8Len = ui8WordLen[eCodec];
+    ui8Shift = 32 - 8 * ui8Len;
+
+    // Only smaller results are worth it
+    if (ui32DstSize >= ui32Len)
+        ui32DstSize = ui32Len > 0 ? ui32Len - 1 : 0;
+
+    for (uint32_t i = 0; i < ui32Len; i += ui8Len)
+    {
+        uint32_t ui32Word = 0;
+        uint32_t ui32Zz;
+        int32_t i32Delta;
+
+        // Big endian word (last one padded with zeros)
+        for (uint8_t j = 0; j < ui8Len; j++)
+            ui32Word = (ui32Word << 8) | (i + j < ui32Len ? pui8Src[i + j] : 0);
+
+        // Difference sign extended from the word length, zig-zag mapped
+        i32Delta = (int32_t)((ui32Word - ui32Prev) << ui8Shift) >> ui8Shift;
+        ui32Zz = ((uint32_t)i32Delta << 1) ^ (uint32_t)(i32Delta >> 31);
+        ui32Prev = ui32Word;
+
+        do
+        {
+            if (ui32Out >= ui32DstSize)
+                return 0;
+
+            pui8Dst[ui32Out++] = (uint8_t)(ui32Zz & 0x7F) | (ui32Zz > 0x7F ? 0x80 : 0x00);
+            ui32Zz >>= 7;
+        }
+        while (ui32Zz > 0);
+    }
+
+    return ui32Out;
+}
+
+//=============================================================================
+bool SCIDecompressInit (tsSCI_DECOMPRESS *psDec, teSCI_COMPRESS_CODEC eCodec, uint32_t ui32RawLen)
+{
+    memset(psDec, 0, sizeof(*psDec));
+
+    if (eCodec <= eSCI_COMPRESS_NONE || eCodec >= eSCI_COMPRESS_NUM)
+        return false;
+
+    psDec->ui8WordLen = ui8WordLen[eCodec];
+    psDec->ui32RawLen = ui32RawLen;
+
+    return true;
+}
+
+//=============================================================================
+uint32_t SCIDecompress (tsSCI_DECOMPRESS *psDec, const uint8_t *pui8Src, uint32_t ui32Len,
+                        uint8_t *pui8Dst, uint32_t ui32DstSize, uint32_t *pui32Produced)
+{
+    uint32_t ui32Mask = _WordMask(psDec->ui8WordLen);
+    uint32_t ui32Out = 0;
+    uint32_t i = 0;
+
+    for (; i < ui32Len; i++)
+    {
+        uint8_t ui8Byte = pui8Src[i];
+        uint32_t ui32Word;
+
+        // A complete word must fit (the rest of the input is passed again)
+        if (!(ui8Byte & 0x80) && ui32DstSize - ui32Out < psDec->ui8WordLen)
+            break;
+
+        psDec->ui32Acc |= (uint32_t)(ui8Byte & 0x7F) << psDec->ui8Shift;
+
+        if (ui8Byte & 0x80)
+        {
+            if (psDec->ui8Shift >= SCI_COMPRESS_MAX_SHIFT)
+                psDec->bError = true;
+            else
+                psDec->ui8Shift += 7;
+
+            continue;
+        }
+
+        ui32Word = (psDec->ui32Prev + ((psDec->ui32Acc >> 1) ^ (0u - (psDec->ui32Acc & 1u)))) & ui32Mask;
+        psDec->ui32Prev = ui32Word;
+        psDec->ui32Acc  = 0;
+        psDec->ui8Shift = 0;
+
+        // Big endian, the padding of the last word is dropped
+        for (int8_t j = psDec->ui8WordLen - 1; j >= 0; j--)
+        {
+            if (psDec->ui32RawCnt >= psDec->ui32RawLen)
+            {
+                // Words starting beyond the decompressed length are malformed
+                psDec->bError |= j == psDec->ui8WordLen - 1;
+                break;
+            }
+
+            pui8Dst[ui32Out++] = (uint8_t)(ui32Word >> (8 * j));
+            psDec->ui32RawCnt++;
+        }
+    }
+
+    *pui32Produced = ui32Out;
+
+    return i;
+}
+
+//=============================================================================
+bool SCIDecompressDone (const tsSCI_DECOMPRESS *psDec)
+{
+    return !psDec->bError && psDec->ui8Shift == 0 && psDec->ui32RawCnt == psDec->ui32RawLen;
+}
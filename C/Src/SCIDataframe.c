@@ -19,61 +19,131 @@
 #include "SCICommon.h"
 #include "SCIDataframe.h"
 #include "SCITransfer.h"
+#include "SCIDescriptor.h"
 #include "Helpers.h"
 
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_VALUE_STR_LEN   48  // Value strings up to this length are converted on the stack
+
 /******************************************************************************
  * Global variable definition
  *****************************************************************************/
 // Note: The idizes correspond to the values of the C enum values!
 static const char acknowledgeArr [5][4] = {"ACK", "DAT", "UPS", "ERR", "NAK"};
-static const uint8_t cmdIdArr[6] = {'#', '?', '!', ':', '>', '<'};
+static const uint8_t cmdIdArr[7] = {'#', '?', '!', ':', '>', '<', '%'};
 // const uint8_t ui8_byteLength[7] = {1,1,2,2,4,4,4};
 
+/******************************************************************************
+ * Value codec definitions
+ *****************************************************************************/
+static uint8_t _NumToStrHex (uint8_t *pui8Buf, int16_t i16Num)          { return (uint8_t)hexToStrWord(pui8Buf, (uint16_t*)&i16Num, true); }
+static uint8_t _ValToStrHex (uint8_t *pui8Buf, tuREQUESTVALUE uVal)     { return (uint8_t)hexToStrDword(pui8Buf, &uVal.ui32_hex, true); }
+static bool _StrToValHex (uint8_t *pui8Str, tuREQUESTVALUE *puVal)      { return strToHex(pui8Str, &puVal->ui32_hex); }
+static uint32_t _ValToU32Hex (tuREQUESTVALUE uVal)                      { return uVal.ui32_hex; }
+
+static uint8_t _NumToStrFloat (uint8_t *pui8Buf, int16_t i16Num)        { return ftoa(pui8Buf, (float)i16Num, true); }
+static uint8_t _ValToStrFloat (uint8_t *pui8Buf, tuREQUESTVALUE uVal)   { return ftoa(pui8Buf, uVal.f_float, true); }
+static bool _StrToValFloat (uint8_t *pui8Str, tuREQUESTVALUE *puVal)    { puVal->f_float = (float)atof((char*)pui8Str); return true; }
+static uint32_t _ValToU32Float (tuREQUESTVALUE uVal)                    { return (uint32_t)(int32_t)uVal.f_float; }
+
+const tsSCI_VALUE_CODEC SCIValueCodecHex = 
+{
+    eSCI_VALUE_MODE_HEX, _NumToStrHex, _ValToStrHex, _StrToValHex, _ValToU32Hex, SCIDecodeTableHex, SCIEncodeTableHex
+};
+
+const tsSCI_VALUE_CODEC SCIValueCodecFloat = 
+{
+    eSCI_VALUE_MODE_FLOAT, _NumToStrFloat, _ValToStrFloat, _StrToValFloat, _ValToU32Float, SCIDecodeTableFloat, SCIEncodeTableFloat
+};
+
+// HEX (the default format) is bound directly on the parse path
+static inline bool _StrToVal (const tsSCI_VALUE_CODEC *psCodec, uint8_t *pui8Str, tuREQUESTVALUE *puVal)
+{
+    if (psCodec == &SCIValueCodecHex)
+        return strToHex(pui8Str, &puVal->ui32_hex);
+
+    return psCodec->StrToVal(pui8Str, puVal);
+}
+
+// Converts a value string of the frame (not terminated). Usual values are terminated
+// on the stack, only longer ones are copied to the heap.
+static bool _TokenToVal (const tsSCI_VALUE_CODEC *psCodec, const uint8_t *pui8Tok, uint16_t ui16Len, tuREQUESTVALUE *puVal)
+{
+    uint8_t ui8Str[SCI_VALUE_STR_LEN];
+    uint8_t *pui8Str = ui8Str;
+    bool bValid;
+
+    if (ui16Len >= sizeof(ui8Str))
+    {
+        pui8Str = (uint8_t*)malloc(ui16Len + 1);
+
+        if (pui8Str == NULL)
+            return false;
+    }
+
+    memcpy(pui8Str, pui8Tok, ui16Len);
+    pui8Str[ui16Len] = '\0';
+
+    bValid = _StrToVal(psCodec, pui8Str, puVal);
+
+    if (pui8Str != ui8Str)
+        free(pui8Str);
+
+    return bValid;
+}
+
+static inline uint32_t _ValToU32 (const tsSCI_VALUE_CODEC *psCodec, tuREQUESTVALUE uVal)
+{
+    if (psCodec == &SCIValueCodecHex)
+        return uVal.ui32_hex;
+
+    return psCodec->ValToU32(uVal);
+}
+
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
+const tsSCI_VALUE_CODEC *SCIGetValueCodec(teSCI_VALUE_MODE eMode)
+{
+    return eMode == eSCI_VALUE_MODE_FLOAT ? &SCIValueCodecFloat : &SCIValueCodecHex;
+}
 
-teSCI_ERROR SCIMasterRequestBuilder(uint8_t *pui8Buf, uint8_t *pui8Size, tsREQUEST sReq)
+//=============================================================================
+teSCI_ERROR SCIMasterRequestBuilder(uint8_t *pui8Buf, uint16_t *pui16Size, uint16_t ui16MaxSize, tsREQUEST sReq, const tsSCI_VALUE_CODEC *psCodec)
 {
     uint8_t ui8AsciiSize;
     uint8_t ui8DatBuf[30]   = {0};
-    uint8_t ui8DataCnt      = 0;
+    uint16_t ui16DataCnt    = 0;
     bool bCommaSet = false;
 
     // Convert variable number to ASCII
-    #ifdef VALUE_MODE_HEX
-    *pui8Size = (uint8_t)hexToStrWord(pui8Buf, (uint16_t*)&sReq.i16Num, true);
-    #else
-    *pui8Size = ftoa(pui8Buf, (float)sReq.i16Num, true);
-    #endif
+    *pui16Size = psCodec->NumToStr(pui8Buf, sReq.i16Num);
 
     // Increase Buffer index and write request type identifier
-    pui8Buf += *pui8Size;
+    pui8Buf += *pui16Size;
     *pui8Buf++ = cmdIdArr[sReq.eReqType];
-    (*pui8Size)++;
+    (*pui16Size)++;
 
-    for(uint8_t i = 0; i < sReq.ui8ValArrLen; i++)
+    for(uint16_t i = 0; i < sReq.ui16ValArrLen; i++)
     {
         if (i >= MAX_NUM_REQUEST_VALUES)
             break;
 
-        #ifdef VALUE_MODE_HEX
-        ui8AsciiSize = (uint8_t)hexToStrDword(ui8DatBuf, &sReq.uValArr[i].ui32_hex, true);
-        #else
-        ui8AsciiSize = ftoa(ui8DatBuf, sReq.uValArr[i].f_float, true);
-        #endif
+        ui8AsciiSize = psCodec->ValToStr(ui8DatBuf, sReq.uValArr[i]);
 
-        if((*pui8Size + ui8AsciiSize) < TX_PACKET_LENGTH)
+        if((*pui16Size + ui8AsciiSize) < ui16MaxSize)
         {
             memcpy(pui8Buf, ui8DatBuf, ui8AsciiSize);
             pui8Buf += ui8AsciiSize;
-            (*pui8Size) += ui8AsciiSize;
-            ui8DataCnt++;
+            (*pui16Size) += ui8AsciiSize;
+            ui16DataCnt++;
 
-            if (ui8DataCnt < sReq.ui8ValArrLen)
+            if (ui16DataCnt < sReq.ui16ValArrLen)
             {
                 *pui8Buf++ = ',';
-                (*pui8Size)++;
+                (*pui16Size)++;
             }
             else
                 break;
@@ -82,29 +152,40 @@ teSCI_ERROR SCIMasterRequestBuilder(uint8_t *pui8Buf, uint8_t *pui8Size, tsREQUE
         else
         {
             // Ignore the last comma
-            (*pui8Size)--;
+            (*pui16Size)--;
 
             return eSCI_ERROR_MESSAGE_EXCEEDS_TX_BUFFER_SIZE;
         }
 
     }
 
+    // Raw data (DOWNSTREAM) is appended after the values without conversion
+    if (sReq.pui8Raw != NULL)
+    {
+        if ((*pui16Size + 1 + sReq.ui16RawLen) > ui16MaxSize)
+            return eSCI_ERROR_MESSAGE_EXCEEDS_TX_BUFFER_SIZE;
+
+        *pui8Buf++ = ';';
+        memcpy(pui8Buf, sReq.pui8Raw, sReq.ui16RawLen);
+        (*pui16Size) += sReq.ui16RawLen + 1;
+    }
+
     return eSCI_ERROR_NONE;
 }
 
 //=============================================================================
-teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, tsRESPONSE *psRsp)
+teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint16_t ui16DataframeLen, tsRESPONSE *psRsp, const tsSCI_VALUE_CODEC *psCodec)
 {
-    uint8_t i = 0;
+    uint16_t i = 0;
     bool bAckPresent = false;
     int8_t i8Ack;
-    int16_t i16BytesToGo = (int16_t)ui8DataframeLen;
+    int32_t i32BytesToGo = (int32_t)ui16DataframeLen;
     psRsp->pui8Raw = pui8Buf;
     
     // uint8_t cmdIdx  = 0;
     // COMMAND cmd     = COMMAND_DEFAULT;
 
-    for (; i < i16BytesToGo; i++)
+    for (; i < i32BytesToGo; i++)
     {
 
         if (pui8Buf[i] == GETVAR_IDENTIFIER)
@@ -132,6 +213,11 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
             psRsp->eReqType = eREQUEST_TYPE_DOWNSTREAM;
             break;
         }      
+        else if (pui8Buf[i] == HANDSHAKE_IDENTIFIER)
+        {
+            psRsp->eReqType = eREQUEST_TYPE_HANDSHAKE;
+            break;
+        }
     }
 
     // No valid command identifier found (TODO: Error handling)
@@ -144,57 +230,44 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
     // Loop breaks when i reflects the buffer position of the command identifier
     // Variable number conversion
     {
-        uint32_t ui32_tmp;
-        // One additional character necessary for string termination
-        uint8_t *pui8NumStr = (uint8_t*)malloc(i+1);
-
-        // copy the number string into new array
-        memcpy(pui8NumStr,pui8Buf,i);
-        // Properly terminate string to use the atoi buildin
-        pui8NumStr[i] = '\0';
+        tuREQUESTVALUE uNum;
+
         // Convert
-        #ifdef VALUE_MODE_HEX
-        if(!strToHex(pui8NumStr, &ui32_tmp))
+        if(!_TokenToVal(psCodec, pui8Buf, i, &uNum))
            return eSCI_ERROR_NUMBER_CONVERSION_FAILED; 
-        psRsp->i16Num = *(int16_t*)(&ui32_tmp);
-        #else
-        psRsp->i16Num = (int16_t)(atoi((char*)pui8NumStr));
-        #endif
-
-        free(pui8NumStr);
+        psRsp->i16Num = (int16_t)(uint16_t)_ValToU32(psCodec, uNum);
     }
 
     // let i correspond to the position of the char after the ID
     i++;
-    i16BytesToGo -= i;
+    i32BytesToGo -= i;
 
     /*******************************************************************************************
      * Find the command acknowledge
     *******************************************************************************************/
     // UPSTREAM message has no acknowledge, just data and is not going to be processed by this 
     // function
-    i8Ack = _CheckAcknowledge(&pui8Buf[i], i16BytesToGo) ;
+    i8Ack = _CheckAcknowledge(&pui8Buf[i], i32BytesToGo) ;
 
     if (i8Ack >= 0)
     {
         psRsp->eReqAck = (teREQUEST_ACKNOWLEDGE)i8Ack;
         // For i: Take care of the ';'
         i += 4;
-        i16BytesToGo -= 4;
+        i32BytesToGo -= 4;
     }
 
     // Message could be complete here (COMMAND without results)
-    if (i16BytesToGo <= 0)
+    if (i32BytesToGo <= 0)
         return eSCI_ERROR_NONE;
 
     // Get the control number after the acknowledge (Which can only happen if there is an acknowledge in the message)
     if (i8Ack >= 0)
     {
-        uint8_t j = 0;
+        uint16_t j = 0;
         tuREQUESTVALUE uNum = {.ui32_hex = 0};
-        uint8_t *pui8NumStr;
 
-        while (j < i16BytesToGo)
+        while (j < i32BytesToGo)
         {
             if (pui8Buf[j + i] == ';')
                 break;
@@ -202,18 +275,8 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
             j++;
         }
 
-        pui8NumStr = (uint8_t*)malloc(j+1);
-        memcpy(pui8NumStr,&pui8Buf[i],j);
-        pui8NumStr[j] = '\0';
-
-        #ifdef VALUE_MODE_HEX
-        if(!strToHex(pui8NumStr, &uNum.ui32_hex))
+        if(!_TokenToVal(psCodec, &pui8Buf[i], j, &uNum))
             return eSCI_ERROR_PARAMETER_CONVERSION_FAILED; 
-        #else
-            uNum.f_float = atof((char*)pui8NumStr);
-        #endif
-
-        free(pui8NumStr);
 
         // Assign the number to the data field
         
@@ -221,24 +284,16 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
         {
             case eREQUEST_ACK_STATUS_SUCCESS_DATA:
             case eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM:
-                #ifdef VALUE_MODE_HEX
-                psRsp->ui32DataLength = uNum.ui32_hex;
-                #else
-                psRsp->ui32DataLength = uNum.f_float;
-                #endif
+                psRsp->ui32DataLength = _ValToU32(psCodec, uNum);
                 break;
 
             case eREQUEST_ACK_STATUS_ERROR:
-                #ifdef VALUE_MODE_HEX
-                psRsp->ui16ErrNum = uNum.ui32_hex;
-                #else
-                psRsp->ui16ErrNum = uNum.f_float;
-                #endif
+                psRsp->ui16ErrNum = (uint16_t)_ValToU32(psCodec, uNum);
                 break;
 
             default:
-                // Save GetVar result
-                if (psRsp->eReqType == eREQUEST_TYPE_GETVAR)
+                // Save GetVar result (or DOWNSTREAM credit / next offset)
+                if (psRsp->eReqType == eREQUEST_TYPE_GETVAR || psRsp->eReqType == eREQUEST_TYPE_DOWNSTREAM)
                 {
                     psRsp->uValArr[0] = uNum;
                 }
@@ -249,7 +304,7 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
 
         //let i correspond to the position of the char after the first data number
         i += (j + 1);
-        i16BytesToGo -= (j + 1);
+        i32BytesToGo -= (j + 1);
     }
     // If we get into this else, that means we are dealing with a consecutive Command Data message,
     // which has no acknowledge, only data
@@ -264,52 +319,45 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
      * Variable value conversion (Values that are comma separated)
     *******************************************************************************************/
    // Only if at least 1 return value has been passed
-   if (i16BytesToGo > 0)
+   if (i32BytesToGo > 0)
    {
-        uint8_t j = 0;
-        uint8_t ui8_numOfVals = 0;
-        uint8_t ui8_valueLen = 0;
-        uint8_t *p_valStr = NULL;
+        uint16_t j = 0;
+        uint16_t ui16_numOfVals = 0;
+        uint16_t ui16_valueLen = 0;
 
-        while (ui8_numOfVals < MAX_NUM_RESPONSE_VALUES)
+        while (ui16_numOfVals < MAX_NUM_RESPONSE_VALUES)
         {
-            ui8_numOfVals++;
+            ui16_numOfVals++;
 
-            while (j < i16BytesToGo)
+            while (j < i32BytesToGo)
             {
                 // Value seperator found
                 if (pui8Buf[i + j] == ',')
                     break;
                 
                 j++;
-                ui8_valueLen++;
+                ui16_valueLen++;
             }
 
-            p_valStr = (uint8_t*)malloc(ui8_valueLen + 1);
-
-            // copy the number string into new array
-            memcpy(p_valStr, &pui8Buf[i + j - ui8_valueLen], ui8_valueLen);
-
-            p_valStr[ui8_valueLen] = '\0';
-
-            #ifdef VALUE_MODE_HEX
-            if(!strToHex(p_valStr, &psRsp->uValArr[ui8_numOfVals - 1].ui32_hex))
+            if(!_TokenToVal(psCodec, &pui8Buf[i + j - ui16_valueLen], ui16_valueLen, &psRsp->uValArr[ui16_numOfVals - 1]))
                 return eSCI_ERROR_PARAMETER_CONVERSION_FAILED;
-            #else
-            psRsp->uValArr[ui8_numOfVals - 1].f_float = atof((char*)p_valStr);
-            #endif
-
-            free(p_valStr);
 
-            if (j == i16BytesToGo)
+            if (j == i32BytesToGo)
                 break;
             
-            ui8_valueLen = 0;
+            ui16_valueLen = 0;
             j++;
         }
-        psRsp->ui8ResponseDataLength = ui8_numOfVals;
+        psRsp->ui16ResponseDataLength = ui16_numOfVals;
+
+        // Compression info of an upstream (codec, decompressed length) are integers
+        if (psRsp->eReqAck == eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM)
+        {
+            for (uint16_t k = 0; k < ui16_numOfVals; k++)
+                psRsp->uValArr[k].ui32_hex = _ValToU32(psCodec, psRsp->uValArr[k]);
+        }
 
-        // if (ui8_numOfVals != psRsp->ui32DataLength)
+        // if (ui16_numOfVals != psRsp->ui32DataLength)
         //     return eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET;
     }
 
@@ -317,22 +365,22 @@ teSCI_ERROR SCIMasterResponseParser(uint8_t* pui8Buf, uint8_t ui8DataframeLen, t
 }
 
 //=============================================================================
-teSCI_ERROR SCIMasterStreamParser (uint8_t* pui8Buf, uint8_t ui8DataframeLen, tsRESPONSE *psRsp)
+teSCI_ERROR SCIMasterStreamParser (uint8_t* pui8Buf, uint16_t ui16DataframeLen, tsRESPONSE *psRsp)
 {
     psRsp->eReqType = eREQUEST_TYPE_UPSTREAM;
-    psRsp->ui8ResponseDataLength = ui8DataframeLen;
+    psRsp->ui16ResponseDataLength = ui16DataframeLen;
     psRsp->pui8Raw = pui8Buf;
 
     return eSCI_ERROR_NONE;
 }
 
 //=============================================================================
-int16_t _CheckAcknowledge (uint8_t *pui8Buf, uint8_t i16BytesToGo)
+int16_t _CheckAcknowledge (uint8_t *pui8Buf, int32_t i32BytesToGo)
 {
     char cAck[4];
     uint8_t j = 0;
 
-    if (i16BytesToGo < 3)
+    if (i32BytesToGo < 3)
         return REQUEST_ACKNOWLEDGE_NOT_FOUND;
 
     memcpy(cAck, pui8Buf, 3);
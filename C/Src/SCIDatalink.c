@@ -105,17 +105,17 @@ void SCIDataLinkReceiveStream(tsDATALINK *p_inst, tsFIFO_BUF *p_rBuf, uint8_t ui
             flushBuf(p_rBuf);
             p_inst->rState = eDATALINK_RSTATE_BUSY;
             // putElem(p_rBuf, ui8_data);
-            p_inst->sRxInfo.ui8MsgByteCnt = 0;
+            p_inst->sRxInfo.ui16MsgByteCnt = 0;
             // Receiver now ready to receive stream bytes
         }
     }
     else if (p_inst->rState == eDATALINK_RSTATE_BUSY)
     {
-        if (p_inst->sRxInfo.ui32BytesToGo > 0 && p_inst->sRxInfo.ui8MsgByteCnt < RX_PACKET_LENGTH)
+        if (p_inst->sRxInfo.ui32BytesToGo > 0 && p_inst->sRxInfo.ui16MsgByteCnt < p_inst->sRxInfo.ui16MaxMsgLen)
         {
             putElem(p_rBuf, ui8_data);
             p_inst->sRxInfo.ui32BytesToGo--;
-            p_inst->sRxInfo.ui8MsgByteCnt++;
+            p_inst->sRxInfo.ui16MsgByteCnt++;
         }
         // Last byte (of transfer or message) must be ETX
         else if (ui8_data == ETX)
@@ -152,7 +152,7 @@ bool SCIDatalinkTransmit(tsDATALINK *p_inst, tsFIFO_BUF * p_tBuf)
 
     if (p_inst->tState == eDATALINK_TSTATE_IDLE)
     {
-        p_inst->sTxInfo.ui8_bufLen = readBuf(p_tBuf, &p_inst->sTxInfo.pui8_buf);
+        p_inst->sTxInfo.ui16_bufLen = readBuf(p_tBuf, &p_inst->sTxInfo.pui8_buf);
         p_inst->tState = eDATALINK_TSTATE_SEND_STX;     
     }
 
@@ -185,15 +185,15 @@ void SCIDatalinkTransmitStateMachine(tsDATALINK *p_inst)
             {   
                 #ifdef SEND_MODE_BYTE_BY_BYTE
                 p_inst->txBlockingCallback(p_inst->sTxInfo.pui8_buf++, 1);
-                p_inst->sTxInfo.ui8_bufLen--;
+                p_inst->sTxInfo.ui16_bufLen--;
 
-                if (p_inst->sTxInfo.ui8_bufLen == 0)
+                if (p_inst->sTxInfo.ui16_bufLen == 0)
                 {
                     p_inst->tState = eDATALINK_TSTATE_SEND_ETX;
                 }
                 #else
                
-                p_inst->txNonBlockingCallback(p_inst->sTxInfo.pui8_buf, p_inst->sTxInfo.ui8_bufLen);
+                p_inst->txNonBlockingCallback(p_inst->sTxInfo.pui8_buf, p_inst->sTxInfo.ui16_bufLen);
                 p_inst->tState = eDATALINK_TSTATE_SEND_ETX;
                 
                 #endif   
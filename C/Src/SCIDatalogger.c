@@ -0,0 +1,611 @@
+/**************************************************************************//**
+ * \file SCIDatalogger.c
+ * \author Roman Holderried
+ *
+ * \brief Datalogger client on top of the SCI master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCIDatalogger.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_DLOG_DRAIN_HDR_LEN  6   // UINT32 first sample index, UINT16 number of samples
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_DATALOGGER sSciDlog;
+
+// Sample sizes (teSCI_DATATYPE)
+static const uint8_t ui8DtypeSize[eSCI_DTYPE_NUM] = {1, 1, 2, 2, 4, 4, 4};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static int16_t _CommandNum (teSCI_DLOG_OP eOp)
+{
+    const tsSCI_DLOG_COMMANDS *psCmds = &sSciDlog.sConfig.sCommands;
+
+    switch (eOp)
+    {
+        case eSCI_DLOG_OP_OPEN:         return psCmds->i16GetDataloggerVersion;
+        case eSCI_DLOG_OP_REGISTER:     return psCmds->i16RegisterLogFromVarStruct;
+        case eSCI_DLOG_OP_INITIALIZE:   return psCmds->i16InitializeDatalogger;
+        case eSCI_DLOG_OP_START:        return psCmds->i16StartDatalogger;
+        case eSCI_DLOG_OP_STOP:         return psCmds->i16StopDatalogger;
+        case eSCI_DLOG_OP_GET_DATA:     return psCmds->i16GetLogData;
+        case eSCI_DLOG_OP_DRAIN:        return psCmds->i16GetLogData;
+        case eSCI_DLOG_OP_CHANNEL_INFO: return psCmds->i16GetChannelInfo;
+        case eSCI_DLOG_OP_RESET:        return psCmds->i16ResetDatalogger;
+        case eSCI_DLOG_OP_SET_OP_MODE:  return psCmds->i16SetOpMode;
+        default:                        return 0;
+    }
+}
+
+//=============================================================================
+static bool _Push (teSCI_DLOG_OP eOp, uint8_t ui8Channel, uint32_t ui32Arg)
+{
+    tsSCI_DLOG_OPERATION *psOp;
+
+    if (sSciDlog.ui8Cnt >= SCI_DLOG_QUEUE_LENGTH)
+        return false;
+
+    psOp = &sSciDlog.sQueue[(sSciDlog.ui8Head + sSciDlog.ui8Cnt) % SCI_DLOG_QUEUE_LENGTH];
+    psOp->eOp           = eOp;
+    psOp->ui8Channel    = ui8Channel;
+    psOp->ui32Arg       = ui32Arg;
+    sSciDlog.ui8Cnt++;
+
+    return true;
+}
+
+//=============================================================================
+static bool _Queue (teSCI_DLOG_OP eOp, uint8_t ui8Channel, uint32_t ui32Arg)
+{
+    // Function not active on the device
+    if (_CommandNum(eOp) <= 0)
+        return false;
+
+    return _Push(eOp, ui8Channel, ui32Arg);
+}
+
+//=============================================================================
+static uint32_t _RecByteLen (const tsSCI_DLOG_CHANNEL *psCh)
+{
+    return psCh->ui32RecLen * ui8DtypeSize[psCh->eDtype];
+}
+
+//=============================================================================
+static void _Revert (const tsSCI_DLOG_OPERATION *psOp)
+{
+    uint8_t ui8Pos = psOp->ui8Channel - 1;
+
+    if (psOp->eOp == eSCI_DLOG_OP_INITIALIZE)
+        sSciDlog.sInfo.bInitialized = false;
+
+    // A reset queued meanwhile has released all channels already
+    if (psOp->eOp != eSCI_DLOG_OP_REGISTER || psOp->ui32Arg != sSciDlog.ui32Generation || !sSciDlog.bRegistered[ui8Pos])
+        return;
+
+    sSciDlog.bRegistered[ui8Pos] = false;
+    sSciDlog.sInfo.ui32NumBytesLeft += _RecByteLen(&sSciDlog.sChannels[ui8Pos]);
+    sSciDlog.sInfo.bInitialized = false;
+}
+
+//=============================================================================
+static void _Finish (teREQUEST_ACKNOWLEDGE eAck, uint16_t ui16ErrNum)
+{
+    tsSCI_DLOG_OPERATION sOp = sSciDlog.sActive;
+    tsSCI_DLOG_OPERATION sCancelled[SCI_DLOG_QUEUE_LENGTH];
+    uint8_t ui8CancelCnt = 0;
+    bool bFailed = eAck != eREQUEST_ACK_STATUS_SUCCESS;
+
+    sSciDlog.sActive.eOp    = eSCI_DLOG_OP_NONE;
+    sSciDlog.bInFlight      = false;
+
+    // The rest of the sequence depends on the failed operation
+    if (bFailed)
+    {
+        _Revert(&sOp);
+
+        while (sSciDlog.ui8Cnt > 0)
+        {
+            sCancelled[ui8CancelCnt] = sSciDlog.sQueue[sSciDlog.ui8Head];
+            _Revert(&sCancelled[ui8CancelCnt++]);
+            sSciDlog.ui8Head = (sSciDlog.ui8Head + 1) % SCI_DLOG_QUEUE_LENGTH;
+            sSciDlog.ui8Cnt--;
+        }
+    }
+
+    // The queue is consistent before the caller is notified (it may queue the next operations)
+    if (sSciDlog.sConfig.DoneCB == NULL)
+        return;
+
+    sSciDlog.sConfig.DoneCB(sOp.eOp, sOp.ui8Channel, eAck, ui16ErrNum);
+
+    for (uint8_t i = 0; i < ui8CancelCnt; i++)
+        sSciDlog.sConfig.DoneCB(sCancelled[i].eOp, sCancelled[i].ui8Channel, eREQUEST_ACK_STATUS_CANCELLED, 0);
+}
+
+//=============================================================================
+static uint8_t _NextChannel (uint8_t ui8Channel)
+{
+    for (uint8_t i = ui8Channel; i < SCI_DLOG_MAX_CHANNELS; i++)
+    {
+        if (sSciDlog.bRegistered[i])
+            return i + 1;
+    }
+
+    return 0;
+}
+
+//=============================================================================
+static void _SegmentStart (uint8_t ui8Channel)
+{
+    sSciDlog.sDemux.ui8Channel      = ui8Channel;
+    sSciDlog.sDemux.ui8HeaderCnt    = 0;
+    sSciDlog.sDemux.ui32Offset      = 0;
+
+    if (ui8Channel == 0)
+        return;
+
+    tsSCI_DLOG_CHANNEL *psCh = &sSciDlog.sChannels[ui8Channel - 1];
+
+    psCh->ui32Count         = 0;
+    psCh->ui32FirstIndex    = 0;
+    psCh->ui32Dropped       = 0;
+
+    // A drain segment starts with its header, a single capture holds record length samples
+    sSciDlog.sDemux.bHeader         = sSciDlog.sActive.eOp == eSCI_DLOG_OP_DRAIN;
+    sSciDlog.sDemux.ui32Remaining   = sSciDlog.sDemux.bHeader ? 0 : _RecByteLen(psCh);
+}
+
+//=============================================================================
+static void _SegmentEnd (void)
+{
+    tsSCI_DLOG_CHANNEL *psCh = &sSciDlog.sChannels[sSciDlog.sDemux.ui8Channel - 1];
+    uint32_t ui32Stored = sSciDlog.sDemux.ui32Offset;
+
+    if (ui32Stored > psCh->ui32SamplesSize || psCh->pui8Samples == NULL)
+        ui32Stored = psCh->pui8Samples != NULL ? psCh->ui32SamplesSize : 0;
+
+    psCh->ui32Count     = ui32Stored / ui8DtypeSize[psCh->eDtype];
+    psCh->ui32Dropped   = sSciDlog.sDemux.ui32Offset / ui8DtypeSize[psCh->eDtype] - psCh->ui32Count;
+
+    _SegmentStart(_NextChannel(sSciDlog.sDemux.ui8Channel));
+}
+
+//=============================================================================
+static void _Demux (const uint8_t *pui8Data, uint32_t ui32Len)
+{
+    while (sSciDlog.sDemux.ui8Channel != 0)
+    {
+        tsSCI_DLOG_CHANNEL *psCh = &sSciDlog.sChannels[sSciDlog.sDemux.ui8Channel - 1];
+        uint32_t ui32Take;
+
+        // Drain header (may be split between frames)
+        if (sSciDlog.sDemux.bHeader)
+        {
+            const uint8_t *pui8Hdr = sSciDlog.sDemux.ui8Header;
+
+            ui32Take = SCI_DLOG_DRAIN_HDR_LEN - sSciDlog.sDemux.ui8HeaderCnt;
+
+            if (ui32Take > ui32Len)
+                ui32Take = ui32Len;
+
+            if (ui32Take == 0)
+                return;
+
+            memcpy(&sSciDlog.sDemux.ui8Header[sSciDlog.sDemux.ui8HeaderCnt], pui8Data, ui32Take);
+            sSciDlog.sDemux.ui8HeaderCnt += ui32Take;
+            pui8Data += ui32Take;
+            ui32Len -= ui32Take;
+
+            if (sSciDlog.sDemux.ui8HeaderCnt < SCI_DLOG_DRAIN_HDR_LEN)
+                return;
+
+            psCh->ui32FirstIndex = ((uint32_t)pui8Hdr[0] << 24) | ((uint32_t)pui8Hdr[1] << 16) | ((uint32_t)pui8Hdr[2] << 8) | pui8Hdr[3];
+            sSciDlog.sDemux.ui32Remaining = (((uint32_t)pui8Hdr[4] << 8) | pui8Hdr[5]) * ui8DtypeSize[psCh->eDtype];
+            sSciDlog.sDemux.bHeader = false;
+        }
+
+        // Segments ending with the data are closed right away (completion check)
+        if (sSciDlog.sDemux.ui32Remaining == 0)
+        {
+            _SegmentEnd();
+            continue;
+        }
+
+        if (ui32Len == 0)
+            return;
+
+        ui32Take = sSciDlog.sDemux.ui32Remaining < ui32Len ? sSciDlog.sDemux.ui32Remaining : ui32Len;
+
+        // Samples beyond the sample buffer are dropped
+        if (psCh->pui8Samples != NULL && sSciDlog.sDemux.ui32Offset < psCh->ui32SamplesSize)
+        {
+            uint32_t ui32Copy = psCh->ui32SamplesSize - sSciDlog.sDemux.ui32Offset;
+
+            memcpy(&psCh->pui8Samples[sSciDlog.sDemux.ui32Offset], pui8Data, ui32Copy < ui32Take ? ui32Copy : ui32Take);
+        }
+
+        sSciDlog.sDemux.ui32Offset += ui32Take;
+        sSciDlog.sDemux.ui32Remaining -= ui32Take;
+        pui8Data += ui32Take;
+        ui32Len -= ui32Take;
+    }
+}
+
+//=============================================================================
+static bool _Send (void)
+{
+    tsSCI_DLOG_OPERATION *psOp = &sSciDlog.sActive;
+    tuREQUESTVALUE uArgs[5];
+    uint16_t ui16ArgNum = 1;
+    int16_t i16Num = _CommandNum(psOp->eOp);
+
+    uArgs[0].ui32_hex = sSciDlog.sConfig.ui8Index;
+
+    if (psOp->eOp == eSCI_DLOG_OP_OPEN && sSciDlog.ui8Step == 0)
+    {
+        // Base frequency first (not read: Version only)
+        if (sSciDlog.sConfig.sCommands.i16BaseFrequencyVar >= 0)
+        {
+            if (!SCIRequestGetVar(sSciDlog.sConfig.sCommands.i16BaseFrequencyVar))
+                return false;
+
+            sSciDlog.eInFlightType  = eREQUEST_TYPE_GETVAR;
+            sSciDlog.i16InFlightNum = sSciDlog.sConfig.sCommands.i16BaseFrequencyVar;
+            sSciDlog.bInFlight      = true;
+            return true;
+        }
+
+        sSciDlog.ui8Step = 1;
+    }
+
+    if (i16Num <= 0)
+    {
+        _Finish(eREQUEST_ACK_STATUS_SUCCESS, 0);
+        return true;
+    }
+
+    switch (psOp->eOp)
+    {
+        case eSCI_DLOG_OP_REGISTER:
+        {
+            const tsSCI_DLOG_CHANNEL *psCh = &sSciDlog.sChannels[psOp->ui8Channel - 1];
+
+            uArgs[1].ui32_hex = psOp->ui8Channel;
+            uArgs[2].ui32_hex = psCh->ui16VarNum;
+            uArgs[3].ui32_hex = psCh->ui16Divider;
+            uArgs[4].ui32_hex = psCh->ui32RecLen;
+            ui16ArgNum = 5;
+            break;
+        }
+
+        case eSCI_DLOG_OP_CHANNEL_INFO:
+            uArgs[1].ui32_hex = psOp->ui8Channel;
+            ui16ArgNum = 2;
+            break;
+
+        case eSCI_DLOG_OP_SET_OP_MODE:
+            uArgs[1].ui32_hex = psOp->ui32Arg;
+            ui16ArgNum = 2;
+            break;
+
+        case eSCI_DLOG_OP_GET_DATA:
+        case eSCI_DLOG_OP_DRAIN:
+            _SegmentStart(_NextChannel(0));
+            break;
+
+        default:
+            break;
+    }
+
+    if (!SCIRequestCommand(i16Num, uArgs, ui16ArgNum))
+        return false;
+
+    sSciDlog.eInFlightType  = eREQUEST_TYPE_COMMAND;
+    sSciDlog.i16InFlightNum = i16Num;
+    sSciDlog.bInFlight      = true;
+
+    return true;
+}
+
+//=============================================================================
+static bool _Own (teREQUEST_TYPE eReqType, int16_t i16Num)
+{
+    return sSciDlog.bInFlight && sSciDlog.eInFlightType == eReqType && sSciDlog.i16InFlightNum == i16Num;
+}
+
+//=============================================================================
+static bool _Streaming (void)
+{
+    return sSciDlog.sActive.eOp == eSCI_DLOG_OP_GET_DATA || sSciDlog.sActive.eOp == eSCI_DLOG_OP_DRAIN;
+}
+
+//=============================================================================
+void SCIDataloggerInit (tsSCI_DLOG_CONFIG sConfig)
+{
+    memset(&sSciDlog, 0, sizeof(sSciDlog));
+
+    sSciDlog.sConfig = sConfig;
+    sSciDlog.sInfo.ui32NumBytesLeft = sConfig.ui32MaxNumBytes;
+
+    _Push(eSCI_DLOG_OP_OPEN, 0, 0);
+}
+
+//=============================================================================
+uint8_t SCIDataloggerRegister (uint16_t ui16VarNum, teSCI_DATATYPE eDtype, uint32_t ui32RecLen, uint16_t ui16Divider,
+                               uint8_t ui8Channel, uint8_t *pui8Samples, uint32_t ui32SamplesSize)
+{
+    tsSCI_DLOG_CHANNEL *psCh;
+
+    if (eDtype >= eSCI_DTYPE_NUM || ui8Channel > SCI_DLOG_MAX_CHANNELS)
+        return 0;
+
+    // Next free channel
+    if (ui8Channel == 0)
+    {
+        for (uint8_t i = 0; i < SCI_DLOG_MAX_CHANNELS && ui8Channel == 0; i++)
+        {
+            if (!sSciDlog.bRegistered[i])
+                ui8Channel = i + 1;
+        }
+
+        if (ui8Channel == 0)
+            return 0;
+    }
+    else if (sSciDlog.bRegistered[ui8Channel - 1])
+        return 0;
+
+    // The record must fit into the onboard buffer
+    if ((uint64_t)ui32RecLen * ui8DtypeSize[eDtype] > sSciDlog.sInfo.ui32NumBytesLeft)
+        return 0;
+
+    if (!_Queue(eSCI_DLOG_OP_REGISTER, ui8Channel, sSciDlog.ui32Generation))
+        return 0;
+
+    psCh = &sSciDlog.sChannels[ui8Channel - 1];
+    memset(psCh, 0, sizeof(*psCh));
+
+    psCh->ui8Channel        = ui8Channel;
+    psCh->eDtype            = eDtype;
+    psCh->ui16VarNum        = ui16VarNum;
+    psCh->ui16Divider       = ui16Divider > 0 ? ui16Divider : 1;
+    psCh->ui32RecLen        = ui32RecLen;
+    psCh->pui8Samples       = pui8Samples;
+    psCh->ui32SamplesSize   = pui8Samples != NULL ? ui32SamplesSize : 0;
+
+    sSciDlog.bRegistered[ui8Channel - 1] = true;
+    sSciDlog.sInfo.ui32NumBytesLeft -= _RecByteLen(psCh);
+    sSciDlog.sInfo.bInitialized = false;
+
+    return ui8Channel;
+}
+
+//=============================================================================
+bool SCIDataloggerInitialize (void)
+{
+    if (_NextChannel(0) == 0 || !_Queue(eSCI_DLOG_OP_INITIALIZE, 0, 0))
+        return false;
+
+    sSciDlog.sInfo.bInitialized = true;
+
+    return true;
+}
+
+//=============================================================================
+bool SCIDataloggerStart (void)
+{
+    return sSciDlog.sInfo.bInitialized && _Queue(eSCI_DLOG_OP_START, 0, 0);
+}
+
+//=============================================================================
+bool SCIDataloggerStop (void)
+{
+    return _Queue(eSCI_DLOG_OP_STOP, 0, 0);
+}
+
+//=============================================================================
+bool SCIDataloggerGetData (void)
+{
+    return _Queue(eSCI_DLOG_OP_GET_DATA, 0, 0);
+}
+
+//=============================================================================
+bool SCIDataloggerDrain (void)
+{
+    return _Queue(eSCI_DLOG_OP_DRAIN, 0, 0);
+}
+
+//=============================================================================
+bool SCIDataloggerGetChannelInfo (uint8_t ui8Channel)
+{
+    return ui8Channel > 0 && ui8Channel <= SCI_DLOG_MAX_CHANNELS && _Queue(eSCI_DLOG_OP_CHANNEL_INFO, ui8Channel, 0);
+}
+
+//=============================================================================
+bool SCIDataloggerReset (void)
+{
+    if (!_Queue(eSCI_DLOG_OP_RESET, 0, 0))
+        return false;
+
+    memset(sSciDlog.bRegistered, 0, sizeof(sSciDlog.bRegistered));
+    sSciDlog.sInfo.ui32NumBytesLeft = sSciDlog.sConfig.ui32MaxNumBytes;
+    sSciDlog.sInfo.bInitialized = false;
+    sSciDlog.ui32Generation++;
+
+    return true;
+}
+
+//=============================================================================
+bool SCIDataloggerSetOpMode (uint32_t ui32Mode)
+{
+    return _Queue(eSCI_DLOG_OP_SET_OP_MODE, 0, ui32Mode);
+}
+
+//=============================================================================
+void SCIDataloggerProcess (void)
+{
+    // Operations without active function finish without request
+    while (!sSciDlog.bInFlight && SCIGetProtocolState() == ePROTOCOL_IDLE)
+    {
+        if (sSciDlog.sActive.eOp == eSCI_DLOG_OP_NONE)
+        {
+            if (sSciDlog.ui8Cnt == 0)
+                return;
+
+            sSciDlog.sActive = sSciDlog.sQueue[sSciDlog.ui8Head];
+            sSciDlog.ui8Head = (sSciDlog.ui8Head + 1) % SCI_DLOG_QUEUE_LENGTH;
+            sSciDlog.ui8Cnt--;
+            sSciDlog.ui8Step = 0;
+        }
+
+        // Master rejected the request: Retried with the next call
+        if (!_Send())
+            return;
+    }
+}
+
+//=============================================================================
+bool SCIDataloggerIsIdle (void)
+{
+    return sSciDlog.sActive.eOp == eSCI_DLOG_OP_NONE && sSciDlog.ui8Cnt == 0;
+}
+
+//=============================================================================
+const tsSCI_DLOG_CHANNEL* SCIDataloggerGetChannel (uint8_t ui8Channel)
+{
+    if (ui8Channel == 0 || ui8Channel > SCI_DLOG_MAX_CHANNELS || !sSciDlog.bRegistered[ui8Channel - 1])
+        return NULL;
+
+    return &sSciDlog.sChannels[ui8Channel - 1];
+}
+
+//=============================================================================
+tsSCI_DLOG_INFO SCIDataloggerGetInfo (void)
+{
+    return sSciDlog.sInfo;
+}
+
+//=============================================================================
+teTRANSFER_ACK SCIDataloggerGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    if (!_Own(eREQUEST_TYPE_GETVAR, i16Num))
+    {
+        if (sSciDlog.sConfig.GetVarForwardCB != NULL)
+            return sSciDlog.sConfig.GetVarForwardCB(eAck, i16Num, ui32Data, ui16ErrNum);
+
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+    {
+        _Finish(eAck, ui16ErrNum);
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    // The version query follows
+    sSciDlog.sInfo.ui32BaseFrequency = ui32Data;
+    sSciDlog.ui8Step = 1;
+    sSciDlog.bInFlight = false;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+teTRANSFER_ACK SCIDataloggerCommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    if (!_Own(eREQUEST_TYPE_COMMAND, i16Num))
+    {
+        if (sSciDlog.sConfig.CommandForwardCB != NULL)
+            return sSciDlog.sConfig.CommandForwardCB(eAck, i16Num, pui32Data, ui32DataCnt, ui16ErrNum);
+
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS && eAck != eREQUEST_ACK_STATUS_SUCCESS_DATA)
+    {
+        _Finish(eAck, ui16ErrNum);
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    switch (sSciDlog.sActive.eOp)
+    {
+        case eSCI_DLOG_OP_OPEN:
+            if (pui32Data != NULL && ui32DataCnt >= 3)
+            {
+                sSciDlog.sInfo.ui8VersionMajor  = (uint8_t)pui32Data[0];
+                sSciDlog.sInfo.ui8VersionMinor  = (uint8_t)pui32Data[1];
+                sSciDlog.sInfo.ui8Revision      = (uint8_t)pui32Data[2];
+            }
+            break;
+
+        case eSCI_DLOG_OP_CHANNEL_INFO:
+            for (uint32_t i = 0; pui32Data != NULL && i < ui32DataCnt && i < SCI_DLOG_NUM_CHANNEL_INFO; i++)
+                sSciDlog.sInfo.ui32ChannelInfo[i] = pui32Data[i];
+            break;
+
+        // Answered without upstream: Nothing recorded
+        case eSCI_DLOG_OP_GET_DATA:
+        case eSCI_DLOG_OP_DRAIN:
+            _Demux(NULL, 0);
+            _Finish(sSciDlog.sDemux.ui8Channel == 0 ? eREQUEST_ACK_STATUS_SUCCESS : eREQUEST_ACK_STATUS_ERROR, 0);
+            return eTRANSFER_ACK_SUCCESS;
+
+        default:
+            break;
+    }
+
+    _Finish(eREQUEST_ACK_STATUS_SUCCESS, 0);
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+void SCIDataloggerUpstreamDataCB (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Offset, uint16_t ui16DataCnt)
+{
+    if (!_Own(eREQUEST_TYPE_COMMAND, i16Num) || !_Streaming())
+    {
+        if (sSciDlog.sConfig.UpstreamDataForwardCB != NULL)
+            sSciDlog.sConfig.UpstreamDataForwardCB(i16Num, pui8Data, ui32Offset, ui16DataCnt);
+
+        return;
+    }
+
+    _Demux(pui8Data, ui16DataCnt);
+}
+
+//=============================================================================
+teTRANSFER_ACK SCIDataloggerUpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    if (!_Own(eREQUEST_TYPE_COMMAND, i16Num) || !_Streaming())
+    {
+        if (sSciDlog.sConfig.UpstreamForwardCB != NULL)
+            return sSciDlog.sConfig.UpstreamForwardCB(i16Num, pui8Data, ui32ByteCnt);
+
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    // Buffered upstream (no incremental delivery registered)
+    if (pui8Data != NULL)
+        _Demux(pui8Data, ui32ByteCnt);
+
+    // All channel segments must be complete
+    _Finish(sSciDlog.sDemux.ui8Channel == 0 ? eREQUEST_ACK_STATUS_SUCCESS : eREQUEST_ACK_STATUS_ERROR, 0);
+
+    return eTRANSFER_ACK_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/**************************************************************************//**
+ * \file SCIDescriptor.c
+ * \author Roman Holderried
+ *
+ * \brief Value codecs of the typed variable and function descriptors.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SCIDescriptor.h"
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+// HEX mode: The value carries the raw bits, truncated to the type width
+static void _DecodeUINT8Hex (tuRESPONSEVALUE uVal, void *pvDst)  { *(uint8_t*)pvDst  = (uint8_t)uVal.ui32_hex; }
+static void _DecodeINT8Hex (tuRESPONSEVALUE uVal, void *pvDst)   { *(int8_t*)pvDst   = (int8_t)(uint8_t)uVal.ui32_hex; }
+static void _DecodeUINT16Hex (tuRESPONSEVALUE uVal, void *pvDst) { *(uint16_t*)pvDst = (uint16_t)uVal.ui32_hex; }
+static void _DecodeINT16Hex (tuRESPONSEVALUE uVal, void *pvDst)  { *(int16_t*)pvDst  = (int16_t)(uint16_t)uVal.ui32_hex; }
+static void _DecodeUINT32Hex (tuRESPONSEVALUE uVal, void *pvDst) { *(uint32_t*)pvDst = uVal.ui32_hex; }
+static void _DecodeINT32Hex (tuRESPONSEVALUE uVal, void *pvDst)  { *(int32_t*)pvDst  = (int32_t)uVal.ui32_hex; }
+static void _DecodeF32Hex (tuRESPONSEVALUE uVal, void *pvDst)    { *(float*)pvDst    = uVal.f_float; }
+
+//=============================================================================
+static tuREQUESTVALUE _EncodeUINT8Hex (const void *pvSrc)  { tuREQUESTVALUE uVal = {.ui32_hex = *(const uint8_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeINT8Hex (const void *pvSrc)   { tuREQUESTVALUE uVal = {.ui32_hex = (uint8_t)*(const int8_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeUINT16Hex (const void *pvSrc) { tuREQUESTVALUE uVal = {.ui32_hex = *(const uint16_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeINT16Hex (const void *pvSrc)  { tuREQUESTVALUE uVal = {.ui32_hex = (uint16_t)*(const int16_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeUINT32Hex (const void *pvSrc) { tuREQUESTVALUE uVal = {.ui32_hex = *(const uint32_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeINT32Hex (const void *pvSrc)  { tuREQUESTVALUE uVal = {.ui32_hex = (uint32_t)*(const int32_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeF32Hex (const void *pvSrc)    { tuREQUESTVALUE uVal = {.f_float = *(const float*)pvSrc}; return uVal; }
+
+//=============================================================================
+// FLOAT mode: The value is transmitted as a number
+static void _DecodeUINT8Float (tuRESPONSEVALUE uVal, void *pvDst)  { *(uint8_t*)pvDst  = (uint8_t)(int32_t)uVal.f_float; }
+static void _DecodeINT8Float (tuRESPONSEVALUE uVal, void *pvDst)   { *(int8_t*)pvDst   = (int8_t)uVal.f_float; }
+static void _DecodeUINT16Float (tuRESPONSEVALUE uVal, void *pvDst) { *(uint16_t*)pvDst = (uint16_t)(int32_t)uVal.f_float; }
+static void _DecodeINT16Float (tuRESPONSEVALUE uVal, void *pvDst)  { *(int16_t*)pvDst  = (int16_t)uVal.f_float; }
+static void _DecodeUINT32Float (tuRESPONSEVALUE uVal, void *pvDst) { *(uint32_t*)pvDst = (uint32_t)uVal.f_float; }
+static void _DecodeINT32Float (tuRESPONSEVALUE uVal, void *pvDst)  { *(int32_t*)pvDst  = (int32_t)uVal.f_float; }
+static void _DecodeF32Float (tuRESPONSEVALUE uVal, void *pvDst)    { *(float*)pvDst    = uVal.f_float; }
+
+//=============================================================================
+static tuREQUESTVALUE _EncodeUINT8Float (const void *pvSrc)  { tuREQUESTVALUE uVal = {.f_float = (float)*(const uint8_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeINT8Float (const void *pvSrc)   { tuREQUESTVALUE uVal = {.f_float = (float)*(const int8_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeUINT16Float (const void *pvSrc) { tuREQUESTVALUE uVal = {.f_float = (float)*(const uint16_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeINT16Float (const void *pvSrc)  { tuREQUESTVALUE uVal = {.f_float = (float)*(const int16_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeUINT32Float (const void *pvSrc) { tuREQUESTVALUE uVal = {.f_float = (float)*(const uint32_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeINT32Float (const void *pvSrc)  { tuREQUESTVALUE uVal = {.f_float = (float)*(const int32_t*)pvSrc}; return uVal; }
+static tuREQUESTVALUE _EncodeF32Float (const void *pvSrc)    { tuREQUESTVALUE uVal = {.f_float = *(const float*)pvSrc}; return uVal; }
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+// Note: The idizes correspond to the values of teSCI_DATATYPE!
+const SCI_DECODE_FCN SCIDecodeTableHex[eSCI_DTYPE_NUM] = 
+{
+    _DecodeUINT8Hex, _DecodeINT8Hex, _DecodeUINT16Hex, _DecodeINT16Hex, _DecodeUINT32Hex, _DecodeINT32Hex, _DecodeF32Hex
+};
+
+const SCI_ENCODE_FCN SCIEncodeTableHex[eSCI_DTYPE_NUM] = 
+{
+    _EncodeUINT8Hex, _EncodeINT8Hex, _EncodeUINT16Hex, _EncodeINT16Hex, _EncodeUINT32Hex, _EncodeINT32Hex, _EncodeF32Hex
+};
+
+const SCI_DECODE_FCN SCIDecodeTableFloat[eSCI_DTYPE_NUM] = 
+{
+    _DecodeUINT8Float, _DecodeINT8Float, _DecodeUINT16Float, _DecodeINT16Float, _DecodeUINT32Float, _DecodeINT32Float, _DecodeF32Float
+};
+
+const SCI_ENCODE_FCN SCIEncodeTableFloat[eSCI_DTYPE_NUM] = 
+{
+    _EncodeUINT8Float, _EncodeINT8Float, _EncodeUINT16Float, _EncodeINT16Float, _EncodeUINT32Float, _EncodeINT32Float, _EncodeF32Float
+};
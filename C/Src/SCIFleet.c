@@ -0,0 +1,813 @@
+/**************************************************************************//**
+ * \file SCIFleet.c
+ * \author Roman Holderried
+ *
+ * \brief Fleet manager: Many devices served by one SCI master in one event
+ * loop.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "SCIFleet.h"
+
+#if SCI_FLEET_ENABLE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Queued request */
+typedef struct
+{
+    teSCI_FLEET_OP  eOp;
+    int16_t         i16Num;
+    tuREQUESTVALUE  uVals[MAX_NUM_REQUEST_VALUES];
+    uint16_t        ui16Cnt;
+    uint64_t        ui64QueuedUs;
+    void            *pvUser;
+}tsSCI_FLEET_REQUEST;
+
+/** \brief Device */
+typedef struct
+{
+    bool                bUsed;
+    uint16_t            ui16Id;
+    int                 iFd;
+    bool                bLinkFailed;        /*!< Taken out of the loop.*/
+    bool                bFlushInput;        /*!< Discard late responses of a timed out request.*/
+    uint32_t            ui32Events;         /*!< Events registered with epoll.*/
+    void                *pvCtx;             /*!< Master context.*/
+
+    tsSCI_FLEET_REQUEST sQueue[SCI_FLEET_QUEUE_LENGTH];
+    uint8_t             ui8Head;
+    uint8_t             ui8Cnt;
+
+    tsSCI_FLEET_REQUEST sActive;            /*!< Request in progress (eSCI_FLEET_OP_NONE: None).*/
+    uint64_t            ui64DeadlineUs;     /*!< Timeout of the request in progress.*/
+
+    uint8_t             ui8Tx[TX_PACKET_LENGTH + 2];    /*!< Frame passed byte by byte by the master.*/
+    uint16_t            ui16TxLen;
+    uint16_t            ui16TxSent;
+
+    tsSCI_FLEET_STATS   sStats;
+}tsSCI_FLEET_DEVICE;
+
+/** \brief Fleet main structure */
+typedef struct
+{
+    tsSCI_FLEET_CONFIG  sConfig;
+    int                 iEpollFd;
+    tsSCI_FLEET_DEVICE  sDevices[SCI_FLEET_MAX_DEVICES];
+    tsSCI_FLEET_DEVICE  *psActive;          /*!< Device whose context is in the master.*/
+    uint16_t            ui16Next;           /*!< Device served first in the next turn.*/
+    int                 iResults;           /*!< Results reported in this turn.*/
+}tsSCI_FLEET;
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_FLEET sSciFleet = {.iEpollFd = -1};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint64_t _NowUs (void)
+{
+    struct timespec sTs;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTs);
+
+    return (uint64_t)sTs.tv_sec * 1000000u + (uint64_t)sTs.tv_nsec / 1000u;
+}
+
+#if SCI_METRICS_ENABLE
+//=============================================================================
+static uint32_t _MetricsTimeUs (void)
+{
+    return (uint32_t)_NowUs();
+}
+#endif
+
+//=============================================================================
+static tsSCI_FLEET_DEVICE* _Find (uint16_t ui16Id)
+{
+    for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES; i++)
+    {
+        if (sSciFleet.sDevices[i].bUsed && sSciFleet.sDevices[i].ui16Id == ui16Id)
+            return &sSciFleet.sDevices[i];
+    }
+
+    return NULL;
+}
+
+//=============================================================================
+static void _Switch (tsSCI_FLEET_DEVICE *psDev)
+{
+    if (sSciFleet.psActive == psDev)
+        return;
+
+    if (sSciFleet.psActive != NULL)
+        SCIMasterSaveContext(sSciFleet.psActive->pvCtx);
+
+    SCIMasterRestoreContext(psDev->pvCtx);
+    sSciFleet.psActive = psDev;
+}
+
+//=============================================================================
+static void _Report (tsSCI_FLEET_DEVICE *psDev, const tsSCI_FLEET_REQUEST *psReq, tsSCI_FLEET_RESULT *psResult)
+{
+    uint64_t ui64Latency = _NowUs() - psReq->ui64QueuedUs;
+
+    psResult->ui16Id        = psDev->ui16Id;
+    psResult->eOp           = psReq->eOp;
+    psResult->i16Num        = psReq->i16Num;
+    psResult->pvUser        = psReq->pvUser;
+    psResult->ui32LatencyUs = ui64Latency < UINT32_MAX ? (uint32_t)ui64Latency : UINT32_MAX;
+
+    switch (psResult->eStatus)
+    {
+        case eSCI_FLEET_STATUS_DONE:
+            psDev->sStats.ui32Done++;
+            psDev->sStats.ui64LatencySumUs += psResult->ui32LatencyUs;
+
+            if (psResult->ui32LatencyUs > psDev->sStats.ui32LatencyMaxUs)
+                psDev->sStats.ui32LatencyMaxUs = psResult->ui32LatencyUs;
+
+            if (psResult->eAck == eREQUEST_ACK_STATUS_ERROR || psResult->eAck == eREQUEST_ACK_STATUS_UNKNOWN ||
+                psResult->eAck == eREQUEST_ACK_STATUS_CANCELLED)
+                psDev->sStats.ui32Failed++;
+            break;
+
+        case eSCI_FLEET_STATUS_TIMEOUT:
+            psDev->sStats.ui32Timeouts++;
+            break;
+
+        case eSCI_FLEET_STATUS_IO_ERROR:
+            psDev->sStats.ui32IoErrors++;
+            break;
+
+        default:
+            break;
+    }
+
+    sSciFleet.iResults++;
+
+    if (sSciFleet.sConfig.DoneCB != NULL)
+        sSciFleet.sConfig.DoneCB(psResult);
+}
+
+//=============================================================================
+static void _Complete (teREQUEST_ACKNOWLEDGE eAck, uint16_t ui16ErrNum, const uint32_t *pui32Vals, uint32_t ui32ValCnt,
+                       const uint8_t *pui8Upstream, uint32_t ui32UpstreamLen)
+{
+    tsSCI_FLEET_DEVICE *psDev = sSciFleet.psActive;
+    tsSCI_FLEET_RESULT sResult;
+    tsSCI_FLEET_REQUEST sReq;
+
+    // Result without request (e.g. a late response of a timed out one)
+    if (psDev == NULL || psDev->sActive.eOp == eSCI_FLEET_OP_NONE)
+        return;
+
+    sReq = psDev->sActive;
+    psDev->sActive.eOp = eSCI_FLEET_OP_NONE;
+
+    memset(&sResult, 0, sizeof(sResult));
+    sResult.eStatus         = eSCI_FLEET_STATUS_DONE;
+    sResult.eAck            = eAck;
+    sResult.ui16ErrNum      = ui16ErrNum;
+    sResult.pui32Vals       = pui32Vals;
+    sResult.ui32ValCnt      = ui32ValCnt;
+    sResult.pui8Upstream    = pui8Upstream;
+    sResult.ui32UpstreamLen = ui32UpstreamLen;
+
+    _Report(psDev, &sReq, &sResult);
+}
+
+//=============================================================================
+static void _Fail (tsSCI_FLEET_DEVICE *psDev, const tsSCI_FLEET_REQUEST *psReq, teSCI_FLEET_STATUS eStatus)
+{
+    tsSCI_FLEET_RESULT sResult;
+
+    memset(&sResult, 0, sizeof(sResult));
+    sResult.eStatus = eStatus;
+    sResult.eAck    = eREQUEST_ACK_STATUS_UNKNOWN;
+
+    _Report(psDev, psReq, &sResult);
+}
+
+//=============================================================================
+static void _FailAll (tsSCI_FLEET_DEVICE *psDev, teSCI_FLEET_STATUS eStatus)
+{
+    tsSCI_FLEET_REQUEST sReq;
+
+    if (psDev->sActive.eOp != eSCI_FLEET_OP_NONE)
+    {
+        sReq = psDev->sActive;
+        psDev->sActive.eOp = eSCI_FLEET_OP_NONE;
+        _Fail(psDev, &sReq, eStatus);
+    }
+
+    // DoneCB may queue new requests: Only those queued before are failed
+    for (uint8_t ui8Cnt = psDev->ui8Cnt; ui8Cnt > 0 && psDev->ui8Cnt > 0; ui8Cnt--)
+    {
+        sReq = psDev->sQueue[psDev->ui8Head];
+        psDev->ui8Head = (psDev->ui8Head + 1) % SCI_FLEET_QUEUE_LENGTH;
+        psDev->ui8Cnt--;
+        _Fail(psDev, &sReq, eStatus);
+    }
+}
+
+/******************************************************************************
+ * Master callbacks (called with the context of the active device)
+ *****************************************************************************/
+static void _TxCB (uint8_t *pui8Buf, uint16_t ui16Len)
+{
+    tsSCI_FLEET_DEVICE *psDev = sSciFleet.psActive;
+
+    if (psDev == NULL || psDev->ui16TxLen + ui16Len > sizeof(psDev->ui8Tx))
+        return;
+
+    memcpy(&psDev->ui8Tx[psDev->ui16TxLen], pui8Buf, ui16Len);
+    psDev->ui16TxLen += ui16Len;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _GetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    bool bData = eAck == eREQUEST_ACK_STATUS_SUCCESS || eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA;
+
+    (void)i16Num;
+
+    _Complete(eAck, ui16ErrNum, bData ? &ui32Data : NULL, bData ? 1 : 0, NULL, 0);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _SetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    (void)i16Num;
+
+    _Complete(eAck, ui16ErrNum, NULL, 0, NULL, 0);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _CommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    (void)i16Num;
+
+    _Complete(eAck, ui16ErrNum, pui32Data, pui32Data != NULL ? ui32DataCnt : 0, NULL, 0);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _UpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    (void)i16Num;
+
+    _Complete(eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM, 0, NULL, 0, pui8Data, ui32ByteCnt);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void _HandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    (void)sCapabilities;
+
+    _Complete(eAck, 0, NULL, 0, NULL, 0);
+}
+
+/******************************************************************************
+ * Link handling (called with the context of the device)
+ *****************************************************************************/
+static void _Watch (tsSCI_FLEET_DEVICE *psDev, uint32_t ui32Events)
+{
+    struct epoll_event sEvent;
+
+    if (psDev->bLinkFailed || psDev->ui32Events == ui32Events)
+        return;
+
+    sEvent.events   = ui32Events;
+    sEvent.data.u32 = (uint32_t)(psDev - sSciFleet.sDevices);
+    epoll_ctl(sSciFleet.iEpollFd, EPOLL_CTL_MOD, psDev->iFd, &sEvent);
+    psDev->ui32Events = ui32Events;
+}
+
+//=============================================================================
+static void _LinkFailed (tsSCI_FLEET_DEVICE *psDev)
+{
+    epoll_ctl(sSciFleet.iEpollFd, EPOLL_CTL_DEL, psDev->iFd, NULL);
+    psDev->bLinkFailed = true;
+    psDev->ui16TxLen = 0;
+    psDev->ui16TxSent = 0;
+
+    SCIFinishStreamReceive();
+    SCIReleaseProtocol();
+
+    _FailAll(psDev, eSCI_FLEET_STATUS_IO_ERROR);
+}
+
+//=============================================================================
+static bool _Flush (tsSCI_FLEET_DEVICE *psDev)
+{
+    while (psDev->ui16TxSent < psDev->ui16TxLen)
+    {
+        ssize_t iCnt = write(psDev->iFd, &psDev->ui8Tx[psDev->ui16TxSent], psDev->ui16TxLen - psDev->ui16TxSent);
+
+        if (iCnt > 0)
+        {
+            psDev->ui16TxSent += (uint16_t)iCnt;
+            psDev->sStats.ui64BytesOut += (uint64_t)iCnt;
+        }
+        else if (iCnt < 0 && errno == EINTR)
+            continue;
+        else if (iCnt < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            // The rest is written when the link is writable again
+            _Watch(psDev, EPOLLIN | EPOLLOUT);
+            return true;
+        }
+        else
+            return false;
+    }
+
+    psDev->ui16TxLen = 0;
+    psDev->ui16TxSent = 0;
+    _Watch(psDev, EPOLLIN);
+
+    return true;
+}
+
+//=============================================================================
+static bool _StartNext (tsSCI_FLEET_DEVICE *psDev)
+{
+    while (psDev->ui8Cnt > 0)
+    {
+        tsSCI_FLEET_REQUEST *psReq = &psDev->sQueue[psDev->ui8Head];
+        bool bStarted = false;
+
+        psDev->sActive = *psReq;
+        psDev->ui8Head = (psDev->ui8Head + 1) % SCI_FLEET_QUEUE_LENGTH;
+        psDev->ui8Cnt--;
+
+        if (psDev->bFlushInput)
+        {
+            tcflush(psDev->iFd, TCIFLUSH);
+            psDev->bFlushInput = false;
+        }
+
+        switch (psDev->sActive.eOp)
+        {
+            case eSCI_FLEET_OP_GETVAR:      bStarted = SCIRequestGetVar(psDev->sActive.i16Num);                          break;
+            case eSCI_FLEET_OP_SETVAR:      bStarted = SCIRequestSetVar(psDev->sActive.i16Num, psDev->sActive.uVals[0]); break;
+            case eSCI_FLEET_OP_HANDSHAKE:   bStarted = SCIRequestHandshake();                                            break;
+            case eSCI_FLEET_OP_COMMAND:
+                bStarted = SCIRequestCommand(psDev->sActive.i16Num, psDev->sActive.uVals, psDev->sActive.ui16Cnt);
+                break;
+            default:
+                break;
+        }
+
+        if (bStarted)
+        {
+            psDev->ui64DeadlineUs = _NowUs() + (uint64_t)sSciFleet.sConfig.ui32TimeoutMs * 1000u;
+            return true;
+        }
+
+        tsSCI_FLEET_REQUEST sReq = psDev->sActive;
+        psDev->sActive.eOp = eSCI_FLEET_OP_NONE;
+        _Fail(psDev, &sReq, eSCI_FLEET_STATUS_REJECTED);
+    }
+
+    return false;
+}
+
+//=============================================================================
+static void _Pump (tsSCI_FLEET_DEVICE *psDev)
+{
+    do
+    {
+        tePROTOCOL_STATE ePrev;
+
+        // Until the master waits for the link
+        do
+        {
+            ePrev = SCIGetProtocolState();
+            SCIMasterSM();
+        }
+        while (SCIGetProtocolState() != ePrev || ePrev == ePROTOCOL_SENDING || ePrev == ePROTOCOL_EVALUATING);
+
+        if (psDev->ui16TxLen > psDev->ui16TxSent && !_Flush(psDev))
+        {
+            _LinkFailed(psDev);
+            return;
+        }
+
+        // Lost request: The master went idle without reporting a result
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE && psDev->sActive.eOp != eSCI_FLEET_OP_NONE)
+            _Complete(eREQUEST_ACK_STATUS_UNKNOWN, 0, NULL, 0, NULL, 0);
+    }
+    while (SCIGetProtocolState() == ePROTOCOL_IDLE && _StartNext(psDev));
+}
+
+//=============================================================================
+static void _Read (tsSCI_FLEET_DEVICE *psDev)
+{
+    uint8_t ui8Rx[SCI_FLEET_RX_BUDGET];
+    ssize_t iCnt = read(psDev->iFd, ui8Rx, sizeof(ui8Rx));
+
+    if (iCnt > 0)
+    {
+        psDev->sStats.ui64BytesIn += (uint64_t)iCnt;
+
+        // Bytes without a request are late responses
+        if (psDev->sActive.eOp == eSCI_FLEET_OP_NONE)
+            return;
+
+        psDev->ui64DeadlineUs = _NowUs() + (uint64_t)sSciFleet.sConfig.ui32TimeoutMs * 1000u;
+        SCIReceive(ui8Rx, (uint16_t)iCnt);
+        _Pump(psDev);
+    }
+    else if (iCnt == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        _LinkFailed(psDev);
+}
+
+//=============================================================================
+static void _Timeout (tsSCI_FLEET_DEVICE *psDev)
+{
+    tsSCI_FLEET_REQUEST sReq = psDev->sActive;
+
+    // Release the link for the next request
+    psDev->sActive.eOp = eSCI_FLEET_OP_NONE;
+    psDev->bFlushInput = true;
+    psDev->ui16TxLen = 0;
+    psDev->ui16TxSent = 0;
+    SCIFinishStreamReceive();
+    SCIReleaseProtocol();
+
+    _Fail(psDev, &sReq, eSCI_FLEET_STATUS_TIMEOUT);
+    _Pump(psDev);
+}
+
+//=============================================================================
+static bool _Queue (uint16_t ui16Id, teSCI_FLEET_OP eOp, int16_t i16Num, const tuREQUESTVALUE *puVals, uint16_t ui16Cnt, void *pvUser)
+{
+    tsSCI_FLEET_DEVICE *psDev = _Find(ui16Id);
+    tsSCI_FLEET_REQUEST *psReq;
+
+    if (psDev == NULL || ui16Cnt > MAX_NUM_REQUEST_VALUES)
+        return false;
+
+    if (psDev->bLinkFailed || psDev->ui8Cnt >= SCI_FLEET_QUEUE_LENGTH)
+    {
+        psDev->sStats.ui32QueueFull++;
+        return false;
+    }
+
+    psReq = &psDev->sQueue[(psDev->ui8Head + psDev->ui8Cnt) % SCI_FLEET_QUEUE_LENGTH];
+    psReq->eOp          = eOp;
+    psReq->i16Num       = i16Num;
+    psReq->ui16Cnt      = ui16Cnt;
+    psReq->ui64QueuedUs = _NowUs();
+    psReq->pvUser       = pvUser;
+
+    if (ui16Cnt > 0)
+        memcpy(psReq->uVals, puVals, ui16Cnt * sizeof(tuREQUESTVALUE));
+
+    psDev->ui8Cnt++;
+    psDev->sStats.ui32Queued++;
+
+    return true;
+}
+
+//=============================================================================
+bool SCIFleetInit (tsSCI_FLEET_CONFIG sConfig)
+{
+    if (sSciFleet.iEpollFd >= 0)
+        SCIFleetDeinit();
+
+    memset(&sSciFleet, 0, sizeof(sSciFleet));
+    sSciFleet.sConfig = sConfig;
+    sSciFleet.iEpollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    return sSciFleet.iEpollFd >= 0;
+}
+
+//=============================================================================
+void SCIFleetDeinit (void)
+{
+    for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES; i++)
+    {
+        if (sSciFleet.sDevices[i].bUsed)
+            SCIFleetRemoveDevice(sSciFleet.sDevices[i].ui16Id);
+    }
+
+    if (sSciFleet.iEpollFd >= 0)
+        close(sSciFleet.iEpollFd);
+
+    sSciFleet.iEpollFd = -1;
+}
+
+//=============================================================================
+bool SCIFleetAddDevice (uint16_t ui16Id, int iFd, teSCI_VALUE_MODE eValueMode)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tsSCI_FLEET_DEVICE *psDev = NULL;
+    struct epoll_event sEvent;
+    int iFlags = fcntl(iFd, F_GETFL);
+
+    if (sSciFleet.iEpollFd < 0 || ui16Id == SCI_FLEET_ALL || _Find(ui16Id) != NULL || iFlags < 0)
+        return false;
+
+    for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES && psDev == NULL; i++)
+    {
+        if (!sSciFleet.sDevices[i].bUsed)
+            psDev = &sSciFleet.sDevices[i];
+    }
+
+    if (psDev == NULL)
+        return false;
+
+    memset(psDev, 0, sizeof(*psDev));
+
+    if ((psDev->pvCtx = malloc(SCIMasterContextSize())) == NULL)
+        return false;
+
+    sEvent.events   = EPOLLIN;
+    sEvent.data.u32 = (uint32_t)(psDev - sSciFleet.sDevices);
+
+    if (fcntl(iFd, F_SETFL, iFlags | O_NONBLOCK) < 0 || epoll_ctl(sSciFleet.iEpollFd, EPOLL_CTL_ADD, iFd, &sEvent) < 0)
+    {
+        free(psDev->pvCtx);
+        psDev->pvCtx = NULL;
+        return false;
+    }
+
+    psDev->bUsed                = true;
+    psDev->ui16Id               = ui16Id;
+    psDev->iFd                  = iFd;
+    psDev->ui32Events           = EPOLLIN;
+    psDev->sStats.ui16Devices   = 1;
+
+    // Fresh master context: The new device becomes the active one
+    if (sSciFleet.psActive != NULL)
+        SCIMasterSaveContext(sSciFleet.psActive->pvCtx);
+
+    sCbs.BlockingTxExternalCB   = _TxCB;
+    sCbs.GetVarExternalCB       = _GetVarCB;
+    sCbs.SetVarExternalCB       = _SetVarCB;
+    sCbs.CommandExternalCB      = _CommandCB;
+    sCbs.UpstreamExternalCB     = _UpstreamCB;
+    sCbs.HandshakeExternalCB    = _HandshakeCB;
+    SCIMasterInit(sCbs, eValueMode);
+
+#if SCI_METRICS_ENABLE
+    SCIMetricsInit(_MetricsTimeUs);
+#endif
+
+    sSciFleet.psActive = psDev;
+
+    return true;
+}
+
+//=============================================================================
+bool SCIFleetRemoveDevice (uint16_t ui16Id)
+{
+    tsSCI_FLEET_DEVICE *psDev = _Find(ui16Id);
+
+    if (psDev == NULL)
+        return false;
+
+    // Free a transfer in progress
+    _Switch(psDev);
+    SCIFinishStreamReceive();
+    SCIReleaseProtocol();
+
+    if (!psDev->bLinkFailed)
+        epoll_ctl(sSciFleet.iEpollFd, EPOLL_CTL_DEL, psDev->iFd, NULL);
+
+    psDev->bLinkFailed = true;
+    _FailAll(psDev, eSCI_FLEET_STATUS_REMOVED);
+
+    free(psDev->pvCtx);
+    psDev->pvCtx = NULL;
+    psDev->bUsed = false;
+
+    if (sSciFleet.psActive == psDev)
+        sSciFleet.psActive = NULL;
+
+    return true;
+}
+
+//=============================================================================
+bool SCIFleetHandshake (uint16_t ui16Id, void *pvUser)
+{
+    return _Queue(ui16Id, eSCI_FLEET_OP_HANDSHAKE, 0, NULL, 0, pvUser);
+}
+
+//=============================================================================
+bool SCIFleetGetVar (uint16_t ui16Id, int16_t i16Num, void *pvUser)
+{
+    return _Queue(ui16Id, eSCI_FLEET_OP_GETVAR, i16Num, NULL, 0, pvUser);
+}
+
+//=============================================================================
+bool SCIFleetSetVar (uint16_t ui16Id, int16_t i16Num, tuREQUESTVALUE uVal, void *pvUser)
+{
+    return _Queue(ui16Id, eSCI_FLEET_OP_SETVAR, i16Num, &uVal, 1, pvUser);
+}
+
+//=============================================================================
+bool SCIFleetCommand (uint16_t ui16Id, int16_t i16Num, const tuREQUESTVALUE *puVals, uint16_t ui16Cnt, void *pvUser)
+{
+    return _Queue(ui16Id, eSCI_FLEET_OP_COMMAND, i16Num, puVals, ui16Cnt, pvUser);
+}
+
+//=============================================================================
+int SCIFleetProcess (int iTimeoutMs)
+{
+    struct epoll_event sEvents[SCI_FLEET_MAX_DEVICES];
+    uint32_t ui32Ready[SCI_FLEET_MAX_DEVICES] = {0};
+    uint64_t ui64Now = _NowUs();
+    uint64_t ui64Deadline = UINT64_MAX;
+    int iEvents;
+
+    sSciFleet.iResults = 0;
+
+    // Idle devices start their next request, the nearest timeout limits the wait
+    for (uint16_t n = 0; n < SCI_FLEET_MAX_DEVICES; n++)
+    {
+        tsSCI_FLEET_DEVICE *psDev = &sSciFleet.sDevices[(sSciFleet.ui16Next + n) % SCI_FLEET_MAX_DEVICES];
+
+        if (!psDev->bUsed || psDev->bLinkFailed)
+            continue;
+
+        if (psDev->sActive.eOp == eSCI_FLEET_OP_NONE && psDev->ui8Cnt > 0)
+        {
+            _Switch(psDev);
+            _Pump(psDev);
+        }
+
+        if (psDev->sActive.eOp != eSCI_FLEET_OP_NONE && sSciFleet.sConfig.ui32TimeoutMs > 0 && psDev->ui64DeadlineUs < ui64Deadline)
+            ui64Deadline = psDev->ui64DeadlineUs;
+    }
+
+    if (ui64Deadline != UINT64_MAX)
+    {
+        int iDeadlineMs = ui64Deadline > ui64Now ? (int)((ui64Deadline - ui64Now + 999u) / 1000u) : 0;
+
+        if (iTimeoutMs < 0 || iDeadlineMs < iTimeoutMs)
+            iTimeoutMs = iDeadlineMs;
+    }
+
+    iEvents = epoll_wait(sSciFleet.iEpollFd, sEvents, SCI_FLEET_MAX_DEVICES, iTimeoutMs);
+
+    if (iEvents < 0 && errno != EINTR)
+        return -1;
+
+    for (int i = 0; i < iEvents; i++)
+        ui32Ready[sEvents[i].data.u32 % SCI_FLEET_MAX_DEVICES] |= sEvents[i].events;
+
+    // Ready devices in rotating order, one read budget each
+    for (uint16_t n = 0; n < SCI_FLEET_MAX_DEVICES; n++)
+    {
+        uint16_t ui16Idx = (sSciFleet.ui16Next + n) % SCI_FLEET_MAX_DEVICES;
+        tsSCI_FLEET_DEVICE *psDev = &sSciFleet.sDevices[ui16Idx];
+
+        if (ui32Ready[ui16Idx] == 0 || !psDev->bUsed || psDev->bLinkFailed)
+            continue;
+
+        _Switch(psDev);
+
+        if ((ui32Ready[ui16Idx] & EPOLLOUT) && !_Flush(psDev))
+            _LinkFailed(psDev);
+        else if (ui32Ready[ui16Idx] & (EPOLLIN | EPOLLERR | EPOLLHUP))
+            _Read(psDev);
+    }
+
+    sSciFleet.ui16Next = (sSciFleet.ui16Next + 1) % SCI_FLEET_MAX_DEVICES;
+
+    // Requests without response
+    if (sSciFleet.sConfig.ui32TimeoutMs > 0)
+    {
+        ui64Now = _NowUs();
+
+        for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES; i++)
+        {
+            tsSCI_FLEET_DEVICE *psDev = &sSciFleet.sDevices[i];
+
+            if (psDev->bUsed && psDev->sActive.eOp != eSCI_FLEET_OP_NONE && ui64Now >= psDev->ui64DeadlineUs)
+            {
+                _Switch(psDev);
+                _Timeout(psDev);
+            }
+        }
+    }
+
+    return sSciFleet.iResults;
+}
+
+//=============================================================================
+bool SCIFleetIsIdle (void)
+{
+    for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES; i++)
+    {
+        const tsSCI_FLEET_DEVICE *psDev = &sSciFleet.sDevices[i];
+
+        if (psDev->bUsed && (psDev->ui8Cnt > 0 || psDev->sActive.eOp != eSCI_FLEET_OP_NONE))
+            return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+bool SCIFleetGetCapabilities (uint16_t ui16Id, tsSCI_CAPABILITIES *psCapabilities)
+{
+    tsSCI_FLEET_DEVICE *psDev = _Find(ui16Id);
+
+    if (psDev == NULL)
+        return false;
+
+    _Switch(psDev);
+    *psCapabilities = SCIGetCapabilities();
+
+    return true;
+}
+
+//=============================================================================
+bool SCIFleetGetStats (uint16_t ui16Id, tsSCI_FLEET_STATS *psStats)
+{
+    memset(psStats, 0, sizeof(*psStats));
+
+    for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES; i++)
+    {
+        const tsSCI_FLEET_DEVICE *psDev = &sSciFleet.sDevices[i];
+        const tsSCI_FLEET_STATS *psDevStats = &psDev->sStats;
+
+        if (!psDev->bUsed || (ui16Id != SCI_FLEET_ALL && psDev->ui16Id != ui16Id))
+            continue;
+
+        psStats->ui32Queued         += psDevStats->ui32Queued;
+        psStats->ui32QueueFull      += psDevStats->ui32QueueFull;
+        psStats->ui32Done           += psDevStats->ui32Done;
+        psStats->ui32Failed         += psDevStats->ui32Failed;
+        psStats->ui32Timeouts       += psDevStats->ui32Timeouts;
+        psStats->ui32IoErrors       += psDevStats->ui32IoErrors;
+        psStats->ui32Pending        += psDev->ui8Cnt + (psDev->sActive.eOp != eSCI_FLEET_OP_NONE ? 1u : 0u);
+        psStats->ui64BytesOut       += psDevStats->ui64BytesOut;
+        psStats->ui64BytesIn        += psDevStats->ui64BytesIn;
+        psStats->ui64LatencySumUs   += psDevStats->ui64LatencySumUs;
+        psStats->ui16Devices        += 1;
+
+        if (psDevStats->ui32LatencyMaxUs > psStats->ui32LatencyMaxUs)
+            psStats->ui32LatencyMaxUs = psDevStats->ui32LatencyMaxUs;
+    }
+
+    return psStats->ui16Devices > 0;
+}
+
+#if SCI_METRICS_ENABLE
+//=============================================================================
+bool SCIFleetMetrics (uint16_t ui16Id, tsSCI_METRICS *psMetrics, bool bReset)
+{
+    bool bFound = false;
+
+    memset(psMetrics, 0, sizeof(*psMetrics));
+
+    for (uint16_t i = 0; i < SCI_FLEET_MAX_DEVICES; i++)
+    {
+        tsSCI_FLEET_DEVICE *psDev = &sSciFleet.sDevices[i];
+        tsSCI_METRICS sDevMetrics;
+
+        if (!psDev->bUsed || (ui16Id != SCI_FLEET_ALL && psDev->ui16Id != ui16Id))
+            continue;
+
+        // The metrics are part of the master context
+        _Switch(psDev);
+        SCIMetricsSnapshot(&sDevMetrics, bReset);
+        SCIMetricsAccumulate(psMetrics, &sDevMetrics);
+        bFound = true;
+    }
+
+    return bFound;
+}
+#endif
+
+#endif // SCI_FLEET_ENABLE
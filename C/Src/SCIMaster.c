@@ -24,6 +24,8 @@
 #include "SCIDataframe.h"
 #include "SCITransfer.h"
 #include "SCIDataLink.h"
+#include "SCITrace.h"
+#include "SCIMetrics.h"
 #include "Buffer.h"
 #include "Helpers.h"
 
@@ -32,22 +34,109 @@
  *****************************************************************************/
 static tsSCI_MASTER sSciMaster = tsSCI_MASTER_DEFAULTS;
 
+// Initial state (SCIMasterInit starts every context from here)
+static const tsSCI_MASTER sSciMasterDefaults = tsSCI_MASTER_DEFAULTS;
+
+// Capabilities of this master (advertised by the handshake)
+static const tsSCI_CAPABILITIES sOwnCapabilities = 
+{
+    SCI_PROTOCOL_VERSION, 
+    RX_PACKET_LENGTH, 
+    TX_PACKET_LENGTH, 
+    SCI_VALUE_MODE_BIT(eSCI_VALUE_MODE_HEX) | SCI_VALUE_MODE_BIT(eSCI_VALUE_MODE_FLOAT),
+    SCI_FEATURE_UPSTREAM | SCI_FEATURE_DOWNSTREAM | SCI_FEATURE_SETVAR_BATCH | SCI_FEATURE_UPSTREAM_COMPRESSION
+};
+
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
-void SCIMasterInit (tsSCI_MASTER_CALLBACKS sCallbacks)
+static const tsSCI_VALUE_CODEC *_SCIRequestCodec (teREQUEST_TYPE eReqType)
+{
+    // The handshake and the DOWNSTREAM control numbers are always exchanged in HEX format
+    if (eReqType == eREQUEST_TYPE_HANDSHAKE || eReqType == eREQUEST_TYPE_DOWNSTREAM)
+        return &SCIValueCodecHex;
+
+    return sSciMaster.psCodec;
+}
+
+//=============================================================================
+static void _SCISetState (tePROTOCOL_STATE eState)
+{
+    SCI_METRICS_STATE(eState);
+    sSciMaster.eProtocolState = eState;
+}
+
+//=============================================================================
+static void _SCIApplySettings (tsSCI_CAPABILITIES sCapabilities, teSCI_VALUE_MODE eValueMode)
+{
+    sSciMaster.sCapabilities = sCapabilities;
+    sSciMaster.psCodec = SCIGetValueCodec(eValueMode);
+    sSciMaster.sSCITransfer.pDecodeTable = sSciMaster.psCodec->pDecodeTable;
+    sSciMaster.sDatalink.sRxInfo.ui16MaxMsgLen = sCapabilities.ui16RxPacketLength;
+}
+
+//=============================================================================
+static void _SCIHandshakeResponse (teREQUEST_ACKNOWLEDGE eAck, tuRESPONSEVALUE *puVals, uint16_t ui16ValCnt)
 {
+    if (eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA && ui16ValCnt >= SCI_HANDSHAKE_NUM_VALUES)
+    {
+        tsSCI_CAPABILITIES sPeer;
+        tsSCI_CAPABILITIES sResult;
+        teSCI_VALUE_MODE eValueMode;
+
+        // The handshake is always exchanged in HEX format
+        sPeer.ui16ProtocolVersion   = (uint16_t)puVals[0].ui32_hex;
+        sPeer.ui16RxPacketLength    = (uint16_t)puVals[1].ui32_hex;
+        sPeer.ui16TxPacketLength    = (uint16_t)puVals[2].ui32_hex;
+        sPeer.ui16ValueModes        = (uint16_t)puVals[3].ui32_hex;
+        sPeer.ui16Features          = (uint16_t)puVals[4].ui32_hex;
+
+        if (SCINegotiateCapabilities(&sOwnCapabilities, &sPeer, &sResult, &eValueMode))
+            _SCIApplySettings(sResult, eValueMode);
+        else
+            eAck = eREQUEST_ACK_STATUS_ERROR;
+    }
+    // Malformed handshake response
+    else if (eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA || eAck == eREQUEST_ACK_STATUS_SUCCESS)
+        eAck = eREQUEST_ACK_STATUS_ERROR;
+
+    if (sSciMaster.HandshakeExternalCB != NULL)
+        sSciMaster.HandshakeExternalCB(eAck, sSciMaster.sCapabilities);
+}
+
+//=============================================================================
+void SCIMasterInit (tsSCI_MASTER_CALLBACKS sCallbacks, teSCI_VALUE_MODE eValueMode)
+{
+    tsSCI_CAPABILITIES sInitial = sOwnCapabilities;
+
+    sSciMaster = sSciMasterDefaults;
+
+    // Batch frames extend the SETVAR syntax: Only used once a handshake confirmed them
+    sInitial.ui16Features &= ~SCI_FEATURE_SETVAR_BATCH;
+
+    // Same for compressed upstreams (a slave must not send them unasked)
+    sInitial.ui16Features &= ~SCI_FEATURE_UPSTREAM_COMPRESSION;
+
+    // Select the value codec and the full frame lengths (until a handshake takes place)
+    _SCIApplySettings(sInitial, eValueMode);
+
     // Connect the internal callbacks
     sSciMaster.sSCITransfer.sCallbacks.InitiateStreamCB = SCIInitiateStreamReceive;
     sSciMaster.sSCITransfer.sCallbacks.FinishStreamCB = SCIFinishStreamReceive;
     sSciMaster.sSCITransfer.sCallbacks.ReleaseProtocolCB = SCIReleaseProtocol;
     sSciMaster.sSCITransfer.sCallbacks.RequestCB = SCIInitiateRequest;
+    sSciMaster.sSCITransfer.sCallbacks.HandshakeCB = _SCIHandshakeResponse;
 
     // Connect the external callbacks
     sSciMaster.sSCITransfer.sCallbacks.GetVarCB = sCallbacks.GetVarExternalCB;
     sSciMaster.sSCITransfer.sCallbacks.SetVarCB = sCallbacks.SetVarExternalCB;
     sSciMaster.sSCITransfer.sCallbacks.CommandCB = sCallbacks.CommandExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.CommandDataCB = sCallbacks.CommandDataExternalCB;
     sSciMaster.sSCITransfer.sCallbacks.UpstreamCB = sCallbacks.UpstreamExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.UpstreamDataCB = sCallbacks.UpstreamDataExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.DownstreamCB = sCallbacks.DownstreamExternalCB;
+    sSciMaster.sSCITransfer.sCallbacks.DownstreamSourceCB = sCallbacks.DownstreamSourceExternalCB;
+    sSciMaster.HandshakeExternalCB = sCallbacks.HandshakeExternalCB;
     sSciMaster.sDatalink.txBlockingCallback = sCallbacks.BlockingTxExternalCB;
     sSciMaster.sDatalink.txNonBlockingCallback = sCallbacks.NonBlockingTxExternalCB;
     sSciMaster.sDatalink.txGetBusyStateCallback = sCallbacks.GetTxBusyStateExternalCB;
@@ -65,6 +154,8 @@ void SCIMasterSM (void)
     switch (sSciMaster.eProtocolState)
     {
         case ePROTOCOL_IDLE:
+            // Urgent requests queued behind a single-frame request
+            SCITransferStartUrgent(&sSciMaster.sSCITransfer);
             break;
 
         case ePROTOCOL_SENDING:
@@ -81,7 +172,15 @@ void SCIMasterSM (void)
                 // Reset the Rx Buffer
                 // flushBuf(&sSciMaster.sRxFIFO);
 
-                sSciMaster.eProtocolState = ePROTOCOL_RECEIVING;
+                // No response expected -> The transfer continues immediately
+                if (sSciMaster.bNoResponse)
+                {
+                    _SCISetState(ePROTOCOL_IDLE);
+                    SCITransferSent(&sSciMaster.sSCITransfer);
+                    break;
+                }
+
+                _SCISetState(ePROTOCOL_RECEIVING);
 
                 // Enable data receive
                 SCIDatalinkStartRx(&sSciMaster.sDatalink);
@@ -95,7 +194,7 @@ void SCIMasterSM (void)
             {
                 SCIDatalinkAcknowledgeRx(&sSciMaster.sDatalink);
 
-                sSciMaster.eProtocolState = ePROTOCOL_EVALUATING;
+                _SCISetState(ePROTOCOL_EVALUATING);
             }
 
             break;
@@ -104,13 +203,22 @@ void SCIMasterSM (void)
             {
                 tsRESPONSE sRsp = tsRESPONSE_DEFAULTS;
                 uint8_t *pui8Buf;
-                uint8_t ui8DframeLen = readBuf(&sSciMaster.sRxFIFO, &pui8Buf);
+                uint16_t ui16DframeLen = readBuf(&sSciMaster.sRxFIFO, &pui8Buf);
+                const tsSCI_VALUE_CODEC *psCodec = _SCIRequestCodec(sSciMaster.eReqInFlight);
 
                 // Parse the response
                 if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_TRANSFER)
-                    SCIMasterResponseParser(pui8Buf, ui8DframeLen, &sRsp);
+                    eError = SCIMasterResponseParser(pui8Buf, ui16DframeLen, &sRsp, psCodec);
                 else if (sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_STREAM)
-                    SCIMasterStreamParser(pui8Buf, ui8DframeLen, &sRsp);
+                    eError = SCIMasterStreamParser(pui8Buf, ui16DframeLen, &sRsp);
+
+                SCI_TRACE_FRAME(SCI_TRACE_DIR_RX, sSciMaster.eProtocolState, sSciMaster.ui8RecMode, sSciMaster.eReqInFlight, 
+                                eError, pui8Buf, ui16DframeLen);
+
+                // Raw stream chunks carry no acknowledge
+                SCI_METRICS_RESPONSE(sSciMaster.eReqInFlight, ui16DframeLen + 2,
+                                     sSciMaster.ui8RecMode == SCI_RECEIVE_MODE_TRANSFER ? sRsp.eReqAck : eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM,
+                                     eError, sSciMaster.sRxFIFO.b_ovfl);
 
                 // Process the response
                 SCITransferControl(&sSciMaster.sSCITransfer, sRsp);
@@ -125,7 +233,7 @@ void SCIMasterSM (void)
 //=============================================================================
 void SCIReceive (uint8_t *pui8RecBuf, uint16_t ui16ByteCount)
 {
-    uint8_t i = 0;
+    uint16_t i = 0;
 
     while (ui16ByteCount)
     {
@@ -157,7 +265,8 @@ void SCIFinishStreamReceive (void)
 //=============================================================================
 bool SCIInitiateRequest (tsREQUEST sReq)
 {
-    uint8_t ui8Size = 0;
+    uint16_t ui16Size = 0;
+    const tsSCI_VALUE_CODEC *psCodec = _SCIRequestCodec(sReq.eReqType);
 
     // Interface busy -> Don't start transmission
     if (sSciMaster.eProtocolState != ePROTOCOL_IDLE)
@@ -167,18 +276,24 @@ bool SCIInitiateRequest (tsREQUEST sReq)
     flushBuf(&sSciMaster.sTxFIFO);
 
     // Assemble message
-    if (SCIMasterRequestBuilder(sSciMaster.sTxFIFO.pui8_bufPtr, &ui8Size, sReq) == eSCI_ERROR_NONE)
+    if (SCIMasterRequestBuilder(sSciMaster.sTxFIFO.pui8_bufPtr, &ui16Size, sSciMaster.sCapabilities.ui16TxPacketLength, sReq, psCodec) == eSCI_ERROR_NONE)
     {
-        increaseBufIdx(&sSciMaster.sTxFIFO, ui8Size);
+        increaseBufIdx(&sSciMaster.sTxFIFO, ui16Size);
+
+        SCI_TRACE_FRAME(SCI_TRACE_DIR_TX, sSciMaster.eProtocolState, sSciMaster.ui8RecMode, sReq.eReqType, 
+                        eSCI_ERROR_NONE, sSciMaster.sTxFIFO.pui8_bufPtr, ui16Size);
+        SCI_METRICS_REQUEST(sReq.eReqType, ui16Size + 2);
 
         SCIDatalinkTransmit(&sSciMaster.sDatalink, &sSciMaster.sTxFIFO);
 
-        sSciMaster.eProtocolState = ePROTOCOL_SENDING;
+        sSciMaster.bNoResponse = sReq.bNoResponse;
+        sSciMaster.eReqInFlight = sReq.eReqType;
+        _SCISetState(ePROTOCOL_SENDING);
     }
     else
     {
-        // TODO: What to do on error?
-        ;
+        // Request does not fit into the TX frame
+        return false;
     }
 
     return true;
@@ -187,28 +302,207 @@ bool SCIInitiateRequest (tsREQUEST sReq)
 //=============================================================================
 void SCIReleaseProtocol (void)
 {
-    sSciMaster.eProtocolState = ePROTOCOL_IDLE;
+    _SCISetState(ePROTOCOL_IDLE);
 }
 
 //=============================================================================
-void SCIRequestGetVar (int16_t i16VarNum)
+bool SCIRequestGetVar (int16_t i16VarNum)
 {
     // Request generation by the Transfer control module
-    SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, i16VarNum, NULL, 0);
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, i16VarNum, NULL, 0, NULL, NULL, 0);
 }
 
 //=============================================================================
-void SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal)
+bool SCIRequestSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal)
 {
     // Request generation by the Transfer control module
-    SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, i16VarNum, &uVal, 1);
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, i16VarNum, &uVal, 1, NULL, NULL, 0);
+}
+
+//=============================================================================
+bool SCIRequestSetVarBatch (const int16_t *pi16VarNums, const tuREQUESTVALUE *puVals, uint16_t ui16Cnt)
+{
+    tuREQUESTVALUE uValArr[MAX_NUM_REQUEST_VALUES];
+    uint16_t ui16ValCnt = 0;
+
+    if (ui16Cnt == 0 || ui16Cnt > SCI_SETVAR_BATCH_MAX || 
+        (ui16Cnt > 1 && !(sSciMaster.sCapabilities.ui16Features & SCI_FEATURE_SETVAR_BATCH)))
+        return false;
+
+    // "num!val,num,val,...": The further variable numbers are values of the active number format
+    uValArr[ui16ValCnt++] = puVals[0];
+
+    for (uint16_t i = 1; i < ui16Cnt; i++)
+    {
+        uValArr[ui16ValCnt++] = sSciMaster.psCodec->pEncodeTable[eSCI_DTYPE_INT16](&pi16VarNums[i]);
+        uValArr[ui16ValCnt++] = puVals[i];
+    }
+
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, pi16VarNums[0], uValArr, ui16ValCnt, NULL, NULL, 0);
 }
 
 //=============================================================================
-void SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint8_t ui8ArgNum)
+bool SCIRequestUrgentSetVar (int16_t i16VarNum, tuREQUESTVALUE uVal)
+{
+    if (!SCITransferUrgent(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, i16VarNum, uVal))
+        return false;
+
+    // No transfer running: Start it right away (in the order of the queue)
+    if (sSciMaster.eProtocolState == ePROTOCOL_IDLE)
+        SCITransferStartUrgent(&sSciMaster.sSCITransfer);
+
+    return true;
+}
+
+//=============================================================================
+bool SCIRequestUrgentGetVar (int16_t i16VarNum)
+{
+    tuREQUESTVALUE uVal = {.ui32_hex = 0};
+
+    if (!SCITransferUrgent(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, i16VarNum, uVal))
+        return false;
+
+    if (sSciMaster.eProtocolState == ePROTOCOL_IDLE)
+        SCITransferStartUrgent(&sSciMaster.sSCITransfer);
+
+    return true;
+}
+
+//=============================================================================
+bool SCIRequestCommand (int16_t i16CmdNum, tuREQUESTVALUE *puValArr, uint16_t ui16ArgNum)
 {
     // Request generation by the Transfer control module
-    SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_COMMAND, i16CmdNum, puValArr, ui8ArgNum);
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_COMMAND, i16CmdNum, puValArr, ui16ArgNum, NULL, NULL, 0);
+}
+
+//=============================================================================
+bool SCIRequestGetVarTyped (const tsSCI_VARIABLE *psVar, void *pvDst)
+{
+    // A running request keeps its destination
+    if (sSciMaster.eProtocolState != ePROTOCOL_IDLE)
+        return false;
+
+    // The result is decoded into the destination by the Transfer control module
+    sSciMaster.pvTypedResult = pvDst;
+
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_GETVAR, psVar->i16Num, NULL, 0, 
+                            &psVar->eType, &sSciMaster.pvTypedResult, 1);
+}
+
+//=============================================================================
+bool SCIRequestSetVarTyped (const tsSCI_VARIABLE *psVar, const void *pvVal)
+{
+    tuREQUESTVALUE uVal = sSciMaster.psCodec->pEncodeTable[psVar->eType](pvVal);
+
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_SETVAR, psVar->i16Num, &uVal, 1, NULL, NULL, 0);
+}
+
+//=============================================================================
+bool SCIRequestCommandTyped (const tsSCI_FUNCTION *psFcn, const void * const *ppvArgs, void * const *ppvResults)
+{
+    tuREQUESTVALUE uArgs[MAX_NUM_REQUEST_VALUES];
+
+    if (psFcn->ui8ArgCnt > MAX_NUM_REQUEST_VALUES)
+        return false;
+
+    for (uint8_t i = 0; i < psFcn->ui8ArgCnt; i++)
+        uArgs[i] = sSciMaster.psCodec->pEncodeTable[psFcn->peArgTypes[i]](ppvArgs[i]);
+
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_COMMAND, psFcn->i16Num, uArgs, psFcn->ui8ArgCnt, 
+                            psFcn->peRetTypes, ppvResults, psFcn->ui8RetCnt);
+}
+
+//=============================================================================
+bool SCIRequestDownstream (int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Len, uint32_t ui32StartOffset)
+{
+    uint16_t ui16TxLen = sSciMaster.sCapabilities.ui16TxPacketLength;
+
+    // Not supported by the slave (after the handshake) or no room for data within the frames
+    if (!(sSciMaster.sCapabilities.ui16Features & SCI_FEATURE_DOWNSTREAM) || ui16TxLen <= SCI_DOWNSTREAM_HEADER_LENGTH)
+        return false;
+
+    return SCITransferStartDownstream(&sSciMaster.sSCITransfer, i16Num, pui8Data, ui32Len, ui32StartOffset, 
+                                      ui16TxLen - SCI_DOWNSTREAM_HEADER_LENGTH);
+}
+
+//=============================================================================
+bool SCICancel (int16_t i16Num)
+{
+    if (sSciMaster.eProtocolState == ePROTOCOL_IDLE)
+        return false;
+
+    return SCITransferCancel(&sSciMaster.sSCITransfer, i16Num);
+}
+
+//=============================================================================
+bool SCIRequestHandshake (void)
+{
+    tuREQUESTVALUE uCaps[SCI_HANDSHAKE_NUM_VALUES];
+
+    uCaps[0].ui32_hex = sOwnCapabilities.ui16ProtocolVersion;
+    uCaps[1].ui32_hex = sOwnCapabilities.ui16RxPacketLength;
+    uCaps[2].ui32_hex = sOwnCapabilities.ui16TxPacketLength;
+    uCaps[3].ui32_hex = sOwnCapabilities.ui16ValueModes;
+    uCaps[4].ui32_hex = sOwnCapabilities.ui16Features;
+
+    return SCITransferStart(&sSciMaster.sSCITransfer, eREQUEST_TYPE_HANDSHAKE, 0, uCaps, SCI_HANDSHAKE_NUM_VALUES, NULL, NULL, 0);
+}
+
+//=============================================================================
+tsSCI_CAPABILITIES SCIGetCapabilities (void)
+{
+    return sSciMaster.sCapabilities;
+}
+
+//=============================================================================
+bool SCINegotiateCapabilities (const tsSCI_CAPABILITIES *psOwn, const tsSCI_CAPABILITIES *psPeer, 
+                               tsSCI_CAPABILITIES *psResult, teSCI_VALUE_MODE *peValueMode)
+{
+    psResult->ui16ProtocolVersion   = psOwn->ui16ProtocolVersion < psPeer->ui16ProtocolVersion ? psOwn->ui16ProtocolVersion : psPeer->ui16ProtocolVersion;
+    psResult->ui16RxPacketLength    = psOwn->ui16RxPacketLength < psPeer->ui16TxPacketLength ? psOwn->ui16RxPacketLength : psPeer->ui16TxPacketLength;
+    psResult->ui16TxPacketLength    = psOwn->ui16TxPacketLength < psPeer->ui16RxPacketLength ? psOwn->ui16TxPacketLength : psPeer->ui16RxPacketLength;
+    psResult->ui16ValueModes        = psOwn->ui16ValueModes & psPeer->ui16ValueModes;
+    psResult->ui16Features          = psOwn->ui16Features & psPeer->ui16Features;
+
+    // HEX is preferred: Lossless and faster to parse
+    if (psResult->ui16ValueModes & SCI_VALUE_MODE_BIT(eSCI_VALUE_MODE_HEX))
+        *peValueMode = eSCI_VALUE_MODE_HEX;
+    else if (psResult->ui16ValueModes & SCI_VALUE_MODE_BIT(eSCI_VALUE_MODE_FLOAT))
+        *peValueMode = eSCI_VALUE_MODE_FLOAT;
+    else
+        return false;
+
+    return psResult->ui16ProtocolVersion > 0 && psResult->ui16RxPacketLength > 0 && psResult->ui16TxPacketLength > 0;
+}
+
+//=============================================================================
+size_t SCIMasterContextSize (void)
+{
+#if SCI_METRICS_ENABLE
+    return sizeof(sSciMaster) + SCIMetricsContextSize();
+#else
+    return sizeof(sSciMaster);
+#endif
+}
+
+//=============================================================================
+void SCIMasterSaveContext (void *pvCtx)
+{
+    memcpy(pvCtx, &sSciMaster, sizeof(sSciMaster));
+
+#if SCI_METRICS_ENABLE
+    SCIMetricsSaveContext((uint8_t*)pvCtx + sizeof(sSciMaster));
+#endif
+}
+
+//=============================================================================
+void SCIMasterRestoreContext (const void *pvCtx)
+{
+    memcpy(&sSciMaster, pvCtx, sizeof(sSciMaster));
+
+#if SCI_METRICS_ENABLE
+    SCIMetricsRestoreContext((const uint8_t*)pvCtx + sizeof(sSciMaster));
+#endif
 }
 
 //=============================================================================
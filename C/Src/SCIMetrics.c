@@ -0,0 +1,294 @@
+/**************************************************************************//**
+ * \file SCIMetrics.c
+ * \author Roman Holderried
+ *
+ * \brief Protocol metrics of the SCI master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ * 	- 2026-10-18 - Sequence counter with acquire/release ordering
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCIMetrics.h"
+
+#if SCI_METRICS_ENABLE
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+typedef struct
+{
+    tsSCI_METRICS       sLive;              /*!< Counters since SCIMetricsInit (written by the master only).*/
+    tsSCI_METRICS       sBaseline;          /*!< Counters at the last reset (written by the reader only).*/
+    uint32_t            ui32Seq;            /*!< Odd while the master updates sLive (accessed by __atomic builtins only).*/
+    uint32_t            (*GetTimeUsCB)(void);
+    uint32_t            ui32RequestStart;   /*!< Start of the request in flight.*/
+    uint32_t            ui32StateStart;     /*!< Start of the current protocol state.*/
+    int8_t              i8State;            /*!< Current protocol state (-1: not yet known).*/
+}tsSCI_METRICS_CTX;
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_METRICS_CTX sSciMetrics;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static uint32_t _Now (void)
+{
+    return sSciMetrics.GetTimeUsCB != NULL ? sSciMetrics.GetTimeUsCB() : 0;
+}
+
+//=============================================================================
+static void _UpdateBegin (void)
+{
+    uint32_t ui32Seq = __atomic_load_n(&sSciMetrics.ui32Seq, __ATOMIC_RELAXED);
+
+    // The odd sequence is visible before any counter is changed
+    __atomic_store_n(&sSciMetrics.ui32Seq, ui32Seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+//=============================================================================
+static void _UpdateEnd (void)
+{
+    uint32_t ui32Seq = __atomic_load_n(&sSciMetrics.ui32Seq, __ATOMIC_RELAXED);
+
+    // Publishes the changed counters
+    __atomic_store_n(&sSciMetrics.ui32Seq, ui32Seq + 1, __ATOMIC_RELEASE);
+}
+
+//=============================================================================
+static uint8_t _Bucket (uint32_t ui32LatencyUs)
+{
+    uint8_t ui8Msb = 0;
+    uint32_t ui32Bucket;
+
+    if (ui32LatencyUs < SCI_METRICS_SUB_BUCKETS)
+        return (uint8_t)ui32LatencyUs;
+
+    while ((ui32LatencyUs >> ui8Msb) > 1)
+        ui8Msb++;
+
+    // Octave [2^msb, 2^(msb+1)) is split into SCI_METRICS_SUB_BUCKETS buckets of equal width
+    ui32Bucket = SCI_METRICS_SUB_BUCKETS * (ui8Msb - 1) + ((ui32LatencyUs >> (ui8Msb - 2)) & (SCI_METRICS_SUB_BUCKETS - 1));
+
+    return ui32Bucket < SCI_METRICS_NUM_BUCKETS - 1 ? (uint8_t)ui32Bucket : SCI_METRICS_NUM_BUCKETS - 1;
+}
+
+//=============================================================================
+static void _Subtract (tsSCI_METRICS *psMetrics, const tsSCI_METRICS *psBase)
+{
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_TYPES; i++)
+    {
+        tsSCI_REQUEST_METRICS *psType = &psMetrics->sTypes[i];
+        const tsSCI_REQUEST_METRICS *psBaseType = &psBase->sTypes[i];
+
+        psType->ui32Requests        -= psBaseType->ui32Requests;
+        psType->ui32Responses       -= psBaseType->ui32Responses;
+        psType->ui32BytesOut        -= psBaseType->ui32BytesOut;
+        psType->ui32BytesIn         -= psBaseType->ui32BytesIn;
+        psType->ui32Errors          -= psBaseType->ui32Errors;
+        psType->ui32Naks            -= psBaseType->ui32Naks;
+        psType->ui32ParseErrors     -= psBaseType->ui32ParseErrors;
+        psType->ui64LatencySumUs    -= psBaseType->ui64LatencySumUs;
+
+        for (uint8_t j = 0; j < SCI_METRICS_NUM_BUCKETS; j++)
+            psType->ui32Latency[j] -= psBaseType->ui32Latency[j];
+    }
+
+    psMetrics->ui32RxOverflows -= psBase->ui32RxOverflows;
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_STATES; i++)
+        psMetrics->ui64StateUs[i] -= psBase->ui64StateUs[i];
+}
+
+//=============================================================================
+void SCIMetricsInit (uint32_t (*GetTimeUsCB)(void))
+{
+    memset(&sSciMetrics, 0, sizeof(sSciMetrics));
+
+    sSciMetrics.GetTimeUsCB = GetTimeUsCB;
+    sSciMetrics.i8State     = -1;
+}
+
+//=============================================================================
+void SCIMetricsSnapshot (tsSCI_METRICS *psMetrics, bool bReset)
+{
+    uint32_t ui32Seq;
+
+    // Repeat the copy if the master updated the counters meanwhile
+    do
+    {
+        ui32Seq = __atomic_load_n(&sSciMetrics.ui32Seq, __ATOMIC_ACQUIRE);
+        memcpy(psMetrics, &sSciMetrics.sLive, sizeof(*psMetrics));
+        // The copy is complete before the sequence is read again
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((ui32Seq & 1) != 0 || ui32Seq != __atomic_load_n(&sSciMetrics.ui32Seq, __ATOMIC_RELAXED));
+
+    if (bReset)
+    {
+        tsSCI_METRICS sCopy = *psMetrics;
+
+        _Subtract(psMetrics, &sSciMetrics.sBaseline);
+        sSciMetrics.sBaseline = sCopy;
+    }
+    else
+        _Subtract(psMetrics, &sSciMetrics.sBaseline);
+}
+
+//=============================================================================
+void SCIMetricsAccumulate (tsSCI_METRICS *psSum, const tsSCI_METRICS *psMetrics)
+{
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_TYPES; i++)
+    {
+        tsSCI_REQUEST_METRICS *psSumType = &psSum->sTypes[i];
+        const tsSCI_REQUEST_METRICS *psType = &psMetrics->sTypes[i];
+
+        psSumType->ui32Requests     += psType->ui32Requests;
+        psSumType->ui32Responses    += psType->ui32Responses;
+        psSumType->ui32BytesOut     += psType->ui32BytesOut;
+        psSumType->ui32BytesIn      += psType->ui32BytesIn;
+        psSumType->ui32Errors       += psType->ui32Errors;
+        psSumType->ui32Naks         += psType->ui32Naks;
+        psSumType->ui32ParseErrors  += psType->ui32ParseErrors;
+        psSumType->ui64LatencySumUs += psType->ui64LatencySumUs;
+
+        for (uint8_t j = 0; j < SCI_METRICS_NUM_BUCKETS; j++)
+            psSumType->ui32Latency[j] += psType->ui32Latency[j];
+    }
+
+    psSum->ui32RxOverflows += psMetrics->ui32RxOverflows;
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_STATES; i++)
+        psSum->ui64StateUs[i] += psMetrics->ui64StateUs[i];
+}
+
+//=============================================================================
+size_t SCIMetricsContextSize (void)
+{
+    return sizeof(sSciMetrics);
+}
+
+//=============================================================================
+void SCIMetricsSaveContext (void *pvCtx)
+{
+    memcpy(pvCtx, &sSciMetrics, sizeof(sSciMetrics));
+}
+
+//=============================================================================
+void SCIMetricsRestoreContext (const void *pvCtx)
+{
+    memcpy(&sSciMetrics, pvCtx, sizeof(sSciMetrics));
+}
+
+//=============================================================================
+uint32_t SCIMetricsBucketLimit (uint8_t ui8Bucket)
+{
+    uint8_t ui8Octave = ui8Bucket / SCI_METRICS_SUB_BUCKETS + 1;
+
+    if (ui8Bucket < SCI_METRICS_SUB_BUCKETS)
+        return ui8Bucket + 1u;
+
+    return (SCI_METRICS_SUB_BUCKETS + 1u + ui8Bucket % SCI_METRICS_SUB_BUCKETS) << (ui8Octave - 2);
+}
+
+//=============================================================================
+uint32_t SCIMetricsPercentile (const tsSCI_REQUEST_METRICS *psMetrics, uint8_t ui8Percent)
+{
+    uint32_t ui32Total = 0;
+    uint32_t ui32Rank;
+    uint32_t ui32Cnt = 0;
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_BUCKETS; i++)
+        ui32Total += psMetrics->ui32Latency[i];
+
+    if (ui32Total == 0)
+        return 0;
+
+    // Rank of the percentile (rounded up, at least the first sample)
+    ui32Rank = (uint32_t)(((uint64_t)ui32Total * ui8Percent + 99) / 100);
+
+    if (ui32Rank == 0)
+        ui32Rank = 1;
+
+    for (uint8_t i = 0; i < SCI_METRICS_NUM_BUCKETS; i++)
+    {
+        ui32Cnt += psMetrics->ui32Latency[i];
+
+        if (ui32Cnt >= ui32Rank)
+            return i < SCI_METRICS_NUM_BUCKETS - 1 ? SCIMetricsBucketLimit(i) : UINT32_MAX;
+    }
+
+    return UINT32_MAX;
+}
+
+//=============================================================================
+void SCIMetricsRequest (teREQUEST_TYPE eReqType, uint16_t ui16Bytes)
+{
+    tsSCI_REQUEST_METRICS *psType = &sSciMetrics.sLive.sTypes[eReqType];
+
+    sSciMetrics.ui32RequestStart = _Now();
+
+    _UpdateBegin();
+    psType->ui32Requests++;
+    psType->ui32BytesOut += ui16Bytes;
+    _UpdateEnd();
+}
+
+//=============================================================================
+void SCIMetricsResponse (teREQUEST_TYPE eReqType, uint16_t ui16Bytes, teREQUEST_ACKNOWLEDGE eAck, teSCI_ERROR eError, bool bOverflow)
+{
+    tsSCI_REQUEST_METRICS *psType = &sSciMetrics.sLive.sTypes[eReqType];
+    uint32_t ui32Latency = _Now() - sSciMetrics.ui32RequestStart;
+
+    _UpdateBegin();
+
+    psType->ui32Responses++;
+    psType->ui32BytesIn += ui16Bytes;
+    psType->ui64LatencySumUs += ui32Latency;
+    psType->ui32Latency[_Bucket(ui32Latency)]++;
+
+    if (eError != eSCI_ERROR_NONE)
+        psType->ui32ParseErrors++;
+    else if (eAck == eREQUEST_ACK_STATUS_ERROR)
+        psType->ui32Errors++;
+    else if (eAck == eREQUEST_ACK_STATUS_UNKNOWN)
+        psType->ui32Naks++;
+
+    if (bOverflow)
+        sSciMetrics.sLive.ui32RxOverflows++;
+
+    _UpdateEnd();
+}
+
+//=============================================================================
+void SCIMetricsState (int8_t i8State)
+{
+    uint32_t ui32Now;
+
+    if (i8State == sSciMetrics.i8State)
+        return;
+
+    ui32Now = _Now();
+
+    if (sSciMetrics.i8State >= 0 && sSciMetrics.i8State < SCI_METRICS_NUM_STATES)
+    {
+        _UpdateBegin();
+        sSciMetrics.sLive.ui64StateUs[sSciMetrics.i8State] += ui32Now - sSciMetrics.ui32StateStart;
+        _UpdateEnd();
+    }
+
+    sSciMetrics.i8State = i8State;
+    sSciMetrics.ui32StateStart = ui32Now;
+}
+
+#endif // SCI_METRICS_ENABLE
@@ -0,0 +1,423 @@
+/**************************************************************************//**
+ * \file SCIScheduler.c
+ * \author Roman Holderried
+ *
+ * \brief Cyclic GETVAR polling scheduler on top of the SCI master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ * 	- 2026-10-18 - Init rejects a baud rate of 0
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCIScheduler.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_SCHED_PPM   1000000ull
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_SCHEDULER sSciScheduler;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static bool _TimeReached (uint32_t ui32Now, uint32_t ui32Time)
+{
+    return (int32_t)(ui32Now - ui32Time) >= 0;
+}
+
+//=============================================================================
+static bool _HigherPriority (uint8_t ui8A, uint8_t ui8B)
+{
+    tsSCI_SCHED_SUBSCRIPTION *psA = &sSciScheduler.sSubs[ui8A];
+    tsSCI_SCHED_SUBSCRIPTION *psB = &sSciScheduler.sSubs[ui8B];
+
+    if (psA->ui8Priority != psB->ui8Priority)
+        return psA->ui8Priority < psB->ui8Priority;
+    if (psA->ui32Period != psB->ui32Period)
+        return psA->ui32Period < psB->ui32Period;
+
+    return ui8A < ui8B;
+}
+
+//=============================================================================
+static bool _EarlierDeadline (uint8_t ui8A, uint8_t ui8B)
+{
+    tsSCI_SCHED_SUBSCRIPTION *psA = &sSciScheduler.sSubs[ui8A];
+    tsSCI_SCHED_SUBSCRIPTION *psB = &sSciScheduler.sSubs[ui8B];
+    int32_t i32Diff = (int32_t)((psA->ui32Release + psA->ui32Period) - (psB->ui32Release + psB->ui32Period));
+
+    if (i32Diff != 0)
+        return i32Diff < 0;
+
+    return _HigherPriority(ui8A, ui8B);
+}
+
+//=============================================================================
+static uint64_t _UtilizationPpm (void)
+{
+    uint64_t ui64U = 0;
+
+    for (uint8_t i = 0; i < SCI_SCHED_NUM_SUBSCRIPTIONS; i++)
+    {
+        if (sSciScheduler.sSubs[i].bUsed)
+            ui64U += sSciScheduler.sSubs[i].ui32Cost * SCI_SCHED_PPM / sSciScheduler.sSubs[i].ui32Period;
+    }
+
+    return ui64U;
+}
+
+//=============================================================================
+static bool _SchedulableEDF (void)
+{
+    uint32_t ui32CostMax = 0;
+    uint32_t ui32PeriodMin = UINT32_MAX;
+
+    for (uint8_t i = 0; i < SCI_SCHED_NUM_SUBSCRIPTIONS; i++)
+    {
+        tsSCI_SCHED_SUBSCRIPTION *psSub = &sSciScheduler.sSubs[i];
+
+        if (!psSub->bUsed)
+            continue;
+        if (psSub->ui32Cost > ui32CostMax)
+            ui32CostMax = psSub->ui32Cost;
+        if (psSub->ui32Period < ui32PeriodMin)
+            ui32PeriodMin = psSub->ui32Period;
+    }
+
+    // A frame on the link is not preempted: Blocking by one poll
+    return _UtilizationPpm() + ui32CostMax * SCI_SCHED_PPM / ui32PeriodMin <= SCI_SCHED_PPM;
+}
+
+//=============================================================================
+static bool _SchedulableFixed (void)
+{
+    for (uint8_t i = 0; i < SCI_SCHED_NUM_SUBSCRIPTIONS; i++)
+    {
+        tsSCI_SCHED_SUBSCRIPTION *psSub = &sSciScheduler.sSubs[i];
+        uint64_t ui64Block = 0;
+        uint64_t ui64Wait, ui64Next;
+
+        if (!psSub->bUsed)
+            continue;
+
+        // Blocking by a lower priority poll that has just been started
+        for (uint8_t j = 0; j < SCI_SCHED_NUM_SUBSCRIPTIONS; j++)
+        {
+            if (j != i && sSciScheduler.sSubs[j].bUsed && _HigherPriority(i, j) && sSciScheduler.sSubs[j].ui32Cost > ui64Block)
+                ui64Block = sSciScheduler.sSubs[j].ui32Cost;
+        }
+
+        // Non-preemptive response time: Waiting time until the poll starts plus its own cost
+        ui64Next = ui64Block;
+        do
+        {
+            ui64Wait = ui64Next;
+            ui64Next = ui64Block;
+
+            for (uint8_t j = 0; j < SCI_SCHED_NUM_SUBSCRIPTIONS; j++)
+            {
+                if (j != i && sSciScheduler.sSubs[j].bUsed && _HigherPriority(j, i))
+                    ui64Next += (ui64Wait / sSciScheduler.sSubs[j].ui32Period + 1) * sSciScheduler.sSubs[j].ui32Cost;
+            }
+
+            if (ui64Next + psSub->ui32Cost > psSub->ui32Period)
+                return false;
+
+        }while (ui64Next != ui64Wait);
+    }
+
+    return true;
+}
+
+//=============================================================================
+static void _Deliver (const tsSCI_SCHED_SAMPLE *psSample)
+{
+    uint16_t ui16Idx;
+
+    if (sSciScheduler.sConfig.SampleCB != NULL)
+    {
+        sSciScheduler.sConfig.SampleCB(psSample);
+        return;
+    }
+
+    if (sSciScheduler.ui16RingCnt == SCI_SCHED_RING_LENGTH)
+    {
+        // Overwrite the oldest sample
+        sSciScheduler.ui16RingHead = (sSciScheduler.ui16RingHead + 1) % SCI_SCHED_RING_LENGTH;
+        sSciScheduler.ui16RingCnt--;
+        sSciScheduler.ui32RingOverruns++;
+    }
+
+    ui16Idx = (sSciScheduler.ui16RingHead + sSciScheduler.ui16RingCnt) % SCI_SCHED_RING_LENGTH;
+    sSciScheduler.sRing[ui16Idx] = *psSample;
+    sSciScheduler.ui16RingCnt++;
+}
+
+//=============================================================================
+static void _AbortPoll (void)
+{
+    tsSCI_SCHED_SUBSCRIPTION *psSub = &sSciScheduler.sSubs[sSciScheduler.i16InFlight];
+
+    sSciScheduler.i16InFlight = -1;
+
+    // Unsubscribed meanwhile
+    if (!psSub->bUsed)
+        return;
+
+    psSub->sStats.ui32Errors++;
+    psSub->ui32Release += psSub->ui32Period;
+}
+
+//=============================================================================
+bool SCISchedulerInit (tsSCI_SCHED_CONFIG sConfig)
+{
+    memset(&sSciScheduler, 0, sizeof(sSciScheduler));
+
+    sSciScheduler.i16InFlight   = -1;
+
+    // The poll cost is derived from the baud rate
+    if (sConfig.ui32Baudrate == 0)
+        return false;
+
+    sSciScheduler.sConfig       = sConfig;
+
+    return true;
+}
+
+//=============================================================================
+bool SCISchedulerSubscribe (int16_t i16Num, uint32_t ui32PeriodUs, uint8_t ui8Priority, uint8_t *pui8Handle)
+{
+    tsSCI_SCHED_SUBSCRIPTION *psSub = NULL;
+    tsSCI_SCHED_STATS sStats = tsSCI_SCHED_STATS_DEFAULTS;
+    bool bSchedulable;
+    uint8_t i;
+
+    // Not (successfully) initialized
+    if (ui32PeriodUs == 0 || sSciScheduler.sConfig.ui32Baudrate == 0)
+        return false;
+
+    // The slot of a poll in flight is kept until its response
+    for (i = 0; i < SCI_SCHED_NUM_SUBSCRIPTIONS; i++)
+    {
+        if (!sSciScheduler.sSubs[i].bUsed && sSciScheduler.i16InFlight != i)
+        {
+            psSub = &sSciScheduler.sSubs[i];
+            break;
+        }
+    }
+
+    if (psSub == NULL)
+        return false;
+
+    psSub->i16Num       = i16Num;
+    psSub->ui32Period   = ui32PeriodUs;
+    psSub->ui32Cost     = SCISchedulerPollCost();
+    psSub->ui8Priority  = ui8Priority;
+    psSub->ui32Release  = sSciScheduler.sConfig.GetTimeUsCB();
+    psSub->bSampled     = false;
+    psSub->sStats       = sStats;
+    psSub->bUsed        = true;
+
+    // Admission control
+    bSchedulable = _UtilizationPpm() <= SCI_SCHED_MAX_UTILIZATION * (SCI_SCHED_PPM / 100);
+
+    if (bSchedulable)
+        bSchedulable = sSciScheduler.sConfig.ePolicy == eSCI_SCHED_POLICY_EDF ? _SchedulableEDF() : _SchedulableFixed();
+
+    if (!bSchedulable)
+    {
+        psSub->bUsed = false;
+        return false;
+    }
+
+    *pui8Handle = i;
+
+    return true;
+}
+
+//=============================================================================
+void SCISchedulerUnsubscribe (uint8_t ui8Handle)
+{
+    if (ui8Handle < SCI_SCHED_NUM_SUBSCRIPTIONS)
+        sSciScheduler.sSubs[ui8Handle].bUsed = false;
+}
+
+//=============================================================================
+void SCISchedulerProcess (void)
+{
+    uint32_t ui32Now = sSciScheduler.sConfig.GetTimeUsCB();
+    int16_t i16Next = -1;
+
+    // Poll in flight without response: The master has been released meanwhile or the timeout elapsed
+    if (sSciScheduler.i16InFlight >= 0)
+    {
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+            _AbortPoll();
+        else if (sSciScheduler.sConfig.ui32TimeoutUs > 0 &&
+                 _TimeReached(ui32Now, sSciScheduler.ui32InFlightStart + sSciScheduler.sConfig.ui32TimeoutUs))
+        {
+            SCIReleaseProtocol();
+            _AbortPoll();
+        }
+    }
+
+    for (uint8_t i = 0; i < SCI_SCHED_NUM_SUBSCRIPTIONS; i++)
+    {
+        tsSCI_SCHED_SUBSCRIPTION *psSub = &sSciScheduler.sSubs[i];
+
+        if (!psSub->bUsed || sSciScheduler.i16InFlight == i)
+            continue;
+
+        // Jobs that have not been polled until their deadline are dropped
+        while (_TimeReached(ui32Now, psSub->ui32Release + psSub->ui32Period))
+        {
+            psSub->ui32Release += psSub->ui32Period;
+            psSub->sStats.ui32Misses++;
+        }
+
+        if (!_TimeReached(ui32Now, psSub->ui32Release))
+            continue;
+
+        if (i16Next < 0 ||
+            (sSciScheduler.sConfig.ePolicy == eSCI_SCHED_POLICY_EDF ? _EarlierDeadline(i, (uint8_t)i16Next) : _HigherPriority(i, (uint8_t)i16Next)))
+            i16Next = i;
+    }
+
+    // One poll at a time (other requests in progress make the GETVAR fail, it is retried on the next call)
+    if (sSciScheduler.i16InFlight < 0 && i16Next >= 0 && SCIRequestGetVar(sSciScheduler.sSubs[i16Next].i16Num))
+    {
+        sSciScheduler.i16InFlight       = i16Next;
+        sSciScheduler.ui32InFlightStart = ui32Now;
+    }
+}
+
+//=============================================================================
+bool SCISchedulerAbort (void)
+{
+    if (sSciScheduler.i16InFlight < 0)
+        return false;
+
+    _AbortPoll();
+
+    return true;
+}
+
+//=============================================================================
+teTRANSFER_ACK SCISchedulerGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    tsSCI_SCHED_SUBSCRIPTION *psSub;
+    tsSCI_SCHED_SAMPLE sSample;
+    uint32_t ui32Latency;
+
+    if (sSciScheduler.i16InFlight < 0 || sSciScheduler.sSubs[sSciScheduler.i16InFlight].i16Num != i16Num)
+    {
+        if (sSciScheduler.sConfig.GetVarForwardCB != NULL)
+            return sSciScheduler.sConfig.GetVarForwardCB(eAck, i16Num, ui32Data, ui16ErrNum);
+
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    psSub = &sSciScheduler.sSubs[sSciScheduler.i16InFlight];
+
+    sSample.ui8Handle       = (uint8_t)sSciScheduler.i16InFlight;
+    sSample.i16Num          = i16Num;
+    sSample.ui32Data        = ui32Data;
+    sSample.ui32Release     = psSub->ui32Release;
+    sSample.ui32Timestamp   = sSciScheduler.sConfig.GetTimeUsCB();
+    sSample.eAck            = eAck;
+
+    sSciScheduler.i16InFlight = -1;
+
+    // Unsubscribed meanwhile
+    if (!psSub->bUsed)
+        return eTRANSFER_ACK_SUCCESS;
+
+    ui32Latency = sSample.ui32Timestamp - sSample.ui32Release;
+
+    if (ui32Latency > psSub->sStats.ui32MaxLatency)
+        psSub->sStats.ui32MaxLatency = ui32Latency;
+    if (ui32Latency > psSub->ui32Period)
+        psSub->sStats.ui32Misses++;
+
+    if (eAck == eREQUEST_ACK_STATUS_SUCCESS)
+    {
+        if (psSub->bSampled)
+        {
+            uint32_t ui32Interval = sSample.ui32Timestamp - psSub->ui32LastSample;
+            uint32_t ui32Jitter = ui32Interval > psSub->ui32Period ? ui32Interval - psSub->ui32Period : psSub->ui32Period - ui32Interval;
+
+            if (ui32Jitter > psSub->sStats.ui32MaxJitter)
+                psSub->sStats.ui32MaxJitter = ui32Jitter;
+        }
+
+        psSub->ui32LastSample   = sSample.ui32Timestamp;
+        psSub->bSampled         = true;
+        psSub->sStats.ui32Samples++;
+    }
+    else
+        psSub->sStats.ui32Errors++;
+
+    psSub->ui32Release += psSub->ui32Period;
+
+    _Deliver(&sSample);
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+bool SCISchedulerReadSample (tsSCI_SCHED_SAMPLE *psSample)
+{
+    if (sSciScheduler.ui16RingCnt == 0)
+        return false;
+
+    *psSample = sSciScheduler.sRing[sSciScheduler.ui16RingHead];
+    sSciScheduler.ui16RingHead = (sSciScheduler.ui16RingHead + 1) % SCI_SCHED_RING_LENGTH;
+    sSciScheduler.ui16RingCnt--;
+
+    return true;
+}
+
+//=============================================================================
+tsSCI_SCHED_STATS SCISchedulerGetStats (uint8_t ui8Handle)
+{
+    tsSCI_SCHED_STATS sStats = tsSCI_SCHED_STATS_DEFAULTS;
+
+    if (ui8Handle < SCI_SCHED_NUM_SUBSCRIPTIONS)
+        sStats = sSciScheduler.sSubs[ui8Handle].sStats;
+
+    return sStats;
+}
+
+//=============================================================================
+uint32_t SCISchedulerGetRingOverruns (void)
+{
+    return sSciScheduler.ui32RingOverruns;
+}
+
+//=============================================================================
+uint32_t SCISchedulerPollCost (void)
+{
+    if (sSciScheduler.sConfig.ui32Baudrate == 0)
+        return 0;
+
+    return (uint32_t)((uint64_t)SCI_SCHED_GETVAR_FRAME_BYTES * 10u * SCI_SCHED_PPM / sSciScheduler.sConfig.ui32Baudrate) +
+           sSciScheduler.sConfig.ui32TurnaroundUs;
+}
+
+//=============================================================================
+uint16_t SCISchedulerGetUtilization (void)
+{
+    return (uint16_t)(_UtilizationPpm() / 1000u);
+}
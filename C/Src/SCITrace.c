@@ -0,0 +1,239 @@
+/**************************************************************************//**
+ * \file SCITrace.c
+ * \author Roman Holderried
+ *
+ * \brief Binary frame trace of the SCI master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ * 	- 2026-10-18 - Record sequence with acquire/release ordering
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCITrace.h"
+
+#if SCI_TRACE_NUM_RECORDS > 0
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define SCI_TRACE_SEQ_WRITING       UINT32_MAX  // Record is being overwritten
+
+// pcapng block types and options
+#define PCAPNG_BLOCK_SHB            0x0A0D0D0Au
+#define PCAPNG_BLOCK_IDB            0x00000001u
+#define PCAPNG_BLOCK_EPB            0x00000006u
+#define PCAPNG_BYTE_ORDER_MAGIC     0x1A2B3C4Du
+#define PCAPNG_OPT_EPB_FLAGS        2
+#define PCAPNG_EPB_FLAGS_INBOUND    1u
+#define PCAPNG_EPB_FLAGS_OUTBOUND   2u
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+typedef struct
+{
+    tsSCI_TRACE_RECORD  sRecords[SCI_TRACE_NUM_RECORDS];
+    uint32_t            ui32Head;       /*!< Number of records written (sequence number of the next one, accessed by __atomic builtins only).*/
+    uint32_t            (*GetTimeUsCB)(void);
+    uint32_t            ui32LastTime;
+    uint32_t            ui32TimeHigh;   /*!< Wrap-arounds of the time callback.*/
+    bool                bEnabled;
+}tsSCI_TRACE;
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_TRACE sSciTrace;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static void _WriteU32 (void (*WriteCB)(const uint8_t *pui8Data, uint16_t ui16Len), uint32_t ui32Val)
+{
+    // pcapng is written in the byte order of the writer
+    WriteCB((const uint8_t*)&ui32Val, sizeof(ui32Val));
+}
+
+//=============================================================================
+static void _WriteU16Pair (void (*WriteCB)(const uint8_t *pui8Data, uint16_t ui16Len), uint16_t ui16First, uint16_t ui16Second)
+{
+    uint16_t ui16Vals[2] = {ui16First, ui16Second};
+
+    WriteCB((const uint8_t*)ui16Vals, sizeof(ui16Vals));
+}
+
+//=============================================================================
+static void _WriteHeaderBlocks (void (*WriteCB)(const uint8_t *pui8Data, uint16_t ui16Len))
+{
+    // Section header block: Version 1.0, section length unknown
+    _WriteU32(WriteCB, PCAPNG_BLOCK_SHB);
+    _WriteU32(WriteCB, 28);
+    _WriteU32(WriteCB, PCAPNG_BYTE_ORDER_MAGIC);
+    _WriteU16Pair(WriteCB, 1, 0);
+    _WriteU32(WriteCB, UINT32_MAX);
+    _WriteU32(WriteCB, UINT32_MAX);
+    _WriteU32(WriteCB, 28);
+
+    // Interface description block: Link type (plus reserved 16 bit) and snap length, timestamps in us (default)
+    _WriteU32(WriteCB, PCAPNG_BLOCK_IDB);
+    _WriteU32(WriteCB, 20);
+    _WriteU16Pair(WriteCB, SCI_TRACE_LINKTYPE, 0);
+    _WriteU32(WriteCB, SCI_TRACE_SNAP_LENGTH + SCI_TRACE_PSEUDO_HDR_LEN);
+    _WriteU32(WriteCB, 20);
+}
+
+//=============================================================================
+static void _WritePacketBlock (void (*WriteCB)(const uint8_t *pui8Data, uint16_t ui16Len), const tsSCI_TRACE_RECORD *psRecord)
+{
+    static const uint8_t ui8Padding[3] = {0};
+    uint8_t ui8PseudoHdr[SCI_TRACE_PSEUDO_HDR_LEN];
+    uint32_t ui32CapLen = psRecord->ui16CapLen + SCI_TRACE_PSEUDO_HDR_LEN;
+    uint32_t ui32PadLen = (4 - (ui32CapLen & 3)) & 3;
+    // Header (28) + data + flags option (8) + end of options (4) + trailing length (4)
+    uint32_t ui32BlockLen = 28 + ui32CapLen + ui32PadLen + 16;
+
+    ui8PseudoHdr[0] = psRecord->ui8State;
+    ui8PseudoHdr[1] = psRecord->ui8RecMode;
+    ui8PseudoHdr[2] = psRecord->ui8ReqType;
+    ui8PseudoHdr[3] = psRecord->ui8Result;
+
+    _WriteU32(WriteCB, PCAPNG_BLOCK_EPB);
+    _WriteU32(WriteCB, ui32BlockLen);
+    _WriteU32(WriteCB, 0);
+    _WriteU32(WriteCB, (uint32_t)(psRecord->ui64TimeUs >> 32));
+    _WriteU32(WriteCB, (uint32_t)psRecord->ui64TimeUs);
+    _WriteU32(WriteCB, ui32CapLen);
+    _WriteU32(WriteCB, psRecord->ui16Len + SCI_TRACE_PSEUDO_HDR_LEN);
+
+    WriteCB(ui8PseudoHdr, sizeof(ui8PseudoHdr));
+    WriteCB(psRecord->ui8Data, psRecord->ui16CapLen);
+    WriteCB(ui8Padding, (uint16_t)ui32PadLen);
+
+    // epb_flags: Direction
+    _WriteU16Pair(WriteCB, PCAPNG_OPT_EPB_FLAGS, 4);
+    _WriteU32(WriteCB, psRecord->ui8Dir == SCI_TRACE_DIR_RX ? PCAPNG_EPB_FLAGS_INBOUND : PCAPNG_EPB_FLAGS_OUTBOUND);
+    _WriteU32(WriteCB, 0);
+
+    _WriteU32(WriteCB, ui32BlockLen);
+}
+
+//=============================================================================
+void SCITraceInit (uint32_t (*GetTimeUsCB)(void))
+{
+    memset(&sSciTrace, 0, sizeof(sSciTrace));
+
+    sSciTrace.GetTimeUsCB   = GetTimeUsCB;
+    sSciTrace.bEnabled      = true;
+}
+
+//=============================================================================
+void SCITraceEnable (bool bEnable)
+{
+    sSciTrace.bEnabled = bEnable;
+}
+
+//=============================================================================
+void SCITraceFrame (uint8_t ui8Dir, uint8_t ui8State, uint8_t ui8RecMode, uint8_t ui8ReqType, uint8_t ui8Result,
+                    const uint8_t *pui8Frame, uint16_t ui16Len)
+{
+    uint32_t ui32Seq = __atomic_load_n(&sSciTrace.ui32Head, __ATOMIC_RELAXED);
+    tsSCI_TRACE_RECORD *psRecord = &sSciTrace.sRecords[ui32Seq % SCI_TRACE_NUM_RECORDS];
+    uint32_t ui32Time = 0;
+
+    if (!sSciTrace.bEnabled)
+        return;
+
+    if (sSciTrace.GetTimeUsCB != NULL)
+    {
+        ui32Time = sSciTrace.GetTimeUsCB();
+
+        if (ui32Time < sSciTrace.ui32LastTime)
+            sSciTrace.ui32TimeHigh++;
+
+        sSciTrace.ui32LastTime = ui32Time;
+    }
+
+    // Readers copying this record meanwhile discard it (marked before any field is changed)
+    __atomic_store_n(&psRecord->ui32Seq, SCI_TRACE_SEQ_WRITING, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    psRecord->ui64TimeUs    = ((uint64_t)sSciTrace.ui32TimeHigh << 32) | ui32Time;
+    psRecord->ui8Dir        = ui8Dir;
+    psRecord->ui8State      = ui8State;
+    psRecord->ui8RecMode    = ui8RecMode;
+    psRecord->ui8ReqType    = ui8ReqType;
+    psRecord->ui8Result     = ui8Result;
+    psRecord->ui16Len       = ui16Len;
+    psRecord->ui16CapLen    = ui16Len < SCI_TRACE_SNAP_LENGTH ? ui16Len : SCI_TRACE_SNAP_LENGTH;
+    memcpy(psRecord->ui8Data, pui8Frame, psRecord->ui16CapLen);
+
+    // Publishes the record, then the new head
+    __atomic_store_n(&psRecord->ui32Seq, ui32Seq, __ATOMIC_RELEASE);
+    __atomic_store_n(&sSciTrace.ui32Head, ui32Seq + 1, __ATOMIC_RELEASE);
+}
+
+//=============================================================================
+bool SCITraceRead (tsSCI_TRACE_READER *psReader, tsSCI_TRACE_RECORD *psRecord)
+{
+    while (true)
+    {
+        uint32_t ui32Head = __atomic_load_n(&sSciTrace.ui32Head, __ATOMIC_ACQUIRE);
+        const tsSCI_TRACE_RECORD *psSlot;
+
+        // Overtaken by the writer: Continue with the oldest record
+        if (ui32Head - psReader->ui32Next > SCI_TRACE_NUM_RECORDS)
+        {
+            psReader->ui32Lost += ui32Head - psReader->ui32Next - SCI_TRACE_NUM_RECORDS;
+            psReader->ui32Next  = ui32Head - SCI_TRACE_NUM_RECORDS;
+        }
+
+        if (psReader->ui32Next == ui32Head)
+            return false;
+
+        psSlot = &sSciTrace.sRecords[psReader->ui32Next % SCI_TRACE_NUM_RECORDS];
+
+        if (__atomic_load_n(&psSlot->ui32Seq, __ATOMIC_ACQUIRE) == psReader->ui32Next)
+        {
+            memcpy(psRecord, psSlot, sizeof(*psRecord));
+            // The copy is complete before the sequence is read again
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+            // Still the same record after the copy
+            if (__atomic_load_n(&psSlot->ui32Seq, __ATOMIC_RELAXED) == psReader->ui32Next)
+            {
+                psRecord->ui32Seq = psReader->ui32Next++;
+                return true;
+            }
+        }
+
+        psReader->ui32Lost++;
+        psReader->ui32Next++;
+    }
+}
+
+//=============================================================================
+uint32_t SCITraceExport (void (*WriteCB)(const uint8_t *pui8Data, uint16_t ui16Len))
+{
+    tsSCI_TRACE_READER sReader = tsSCI_TRACE_READER_DEFAULTS;
+    tsSCI_TRACE_RECORD sRecord;
+    uint32_t ui32Cnt = 0;
+
+    _WriteHeaderBlocks(WriteCB);
+
+    while (SCITraceRead(&sReader, &sRecord))
+    {
+        _WritePacketBlock(WriteCB, &sRecord);
+        ui32Cnt++;
+    }
+
+    return ui32Cnt;
+}
+
+#endif // SCI_TRACE_NUM_RECORDS > 0
@@ -23,6 +23,7 @@
 #include <stdlib.h>
 
 #include "SCITransfer.h"
+#include "SCIDescriptor.h"
 
 /******************************************************************************
  * Global variable definition
@@ -31,30 +32,398 @@
 /******************************************************************************
  * Function definitions
  *****************************************************************************/
-bool SCITransferStart (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16CmdNum, tuREQUESTVALUE *uVal, uint8_t ui8ArgNum)
+static void _DownstreamFinish (tsSCI_TRANSFER *psSciTransfer, teREQUEST_ACKNOWLEDGE eAck, uint16_t ui16ErrNum)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    free(psInfo->sDownstream.pui8Chunk);
+    psInfo->sDownstream.pui8Chunk = NULL;
+    psInfo->sDownstream.ui16Credit = 0;
+    psInfo->sDownstream.ui16ChunksInFlight = 0;
+
+    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+
+    // The acknowledged byte count is the offset to resume the transfer from
+    if (psSciTransfer->sCallbacks.DownstreamCB != NULL)
+        psSciTransfer->sCallbacks.DownstreamCB(eAck, psInfo->sReq.i16Num, psInfo->sDownstream.ui32AckedOffset, ui16ErrNum);
+}
+
+//=============================================================================
+static void _DownstreamSendChunk (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    tsREQUEST sReq = tsREQUEST_DEFAULTS;
+    tuREQUESTVALUE uHeader[2];
+    uint32_t ui32Remaining = psInfo->sDownstream.ui32Len - psInfo->sDownstream.ui32SendOffset;
+    uint16_t ui16ChunkLen = ui32Remaining < psInfo->sDownstream.ui16MaxChunkLen ? (uint16_t)ui32Remaining : psInfo->sDownstream.ui16MaxChunkLen;
+
+    // Data from the buffer is passed directly, otherwise the application fills the chunk memory
+    if (psInfo->sDownstream.pui8Data != NULL)
+        sReq.pui8Raw = &psInfo->sDownstream.pui8Data[psInfo->sDownstream.ui32SendOffset];
+    else
+    {
+        ui16ChunkLen = psSciTransfer->sCallbacks.DownstreamSourceCB(psInfo->sReq.i16Num, psInfo->sDownstream.ui32SendOffset, 
+                                                                    psInfo->sDownstream.pui8Chunk, ui16ChunkLen);
+        sReq.pui8Raw = psInfo->sDownstream.pui8Chunk;
+
+        // The source could not deliver data
+        if (ui16ChunkLen == 0)
+        {
+            _DownstreamFinish(psSciTransfer, eREQUEST_ACK_STATUS_ERROR, eSCI_ERROR_DOWNSTREAM_SOURCE_FAILED);
+            return;
+        }
+    }
+
+    uHeader[0].ui32_hex = psInfo->sDownstream.ui32SendOffset;
+    uHeader[1].ui32_hex = ui16ChunkLen;
+
+    sReq.eReqType       = eREQUEST_TYPE_DOWNSTREAM;
+    sReq.i16Num         = psInfo->sReq.i16Num;
+    sReq.uValArr        = uHeader;
+    sReq.ui16ValArrLen  = 2;
+    sReq.ui16RawLen     = ui16ChunkLen;
+
+    psInfo->sDownstream.ui32SendOffset += ui16ChunkLen;
+    psInfo->sDownstream.ui16ChunksInFlight++;
+
+    // The slave acknowledges the last chunk of the credit window and the last chunk of the data
+    sReq.bNoResponse = psInfo->sDownstream.ui16ChunksInFlight < psInfo->sDownstream.ui16Credit && 
+                       psInfo->sDownstream.ui32SendOffset < psInfo->sDownstream.ui32Len;
+
+    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+    psSciTransfer->sCallbacks.RequestCB(sReq);
+}
+
+//=============================================================================
+static void _UpstreamDecompress (tsSCI_TRANSFER *psSciTransfer, const uint8_t *pui8Data, uint16_t ui16Len)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    uint8_t ui8Chunk[SCI_UPSTREAM_DECOMPRESS_CHUNK];
+
+    while (ui16Len > 0)
+    {
+        uint32_t ui32Offset = psInfo->sDecompress.ui32RawCnt;
+        uint32_t ui32Produced;
+        uint32_t ui32Consumed;
+
+        // Buffered: Decompressed in place, the buffer holds a padded last word
+        if (psInfo->pui8UpstreamBuffer != NULL)
+        {
+            ui32Consumed = SCIDecompress(&psInfo->sDecompress, pui8Data, ui16Len, &psInfo->pui8UpstreamBuffer[ui32Offset],
+                                         psInfo->sDecompress.ui32RawLen + SCI_COMPRESS_MAX_WORD_LEN - ui32Offset, &ui32Produced);
+        }
+        // Incremental delivery: Chunk-wise through the stack
+        else
+        {
+            ui32Consumed = SCIDecompress(&psInfo->sDecompress, pui8Data, ui16Len, ui8Chunk, sizeof(ui8Chunk), &ui32Produced);
+
+            if (ui32Produced > 0 && psSciTransfer->sCallbacks.UpstreamDataCB != NULL)
+                psSciTransfer->sCallbacks.UpstreamDataCB(psInfo->sReq.i16Num, ui8Chunk, ui32Offset, (uint16_t)ui32Produced);
+        }
+
+        // No progress: Malformed data (reported when the upstream is complete)
+        if (ui32Consumed == 0)
+        {
+            psInfo->sDecompress.bError = true;
+            break;
+        }
+
+        pui8Data += ui32Consumed;
+        ui16Len  -= (uint16_t)ui32Consumed;
+    }
+}
+
+//=============================================================================
+static void _Abort (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    psInfo->bCancel = false;
+
+    if (psInfo->sReq.eReqType == eREQUEST_TYPE_DOWNSTREAM)
+    {
+        _DownstreamFinish(psSciTransfer, eREQUEST_ACK_STATUS_CANCELLED, 0);
+        return;
+    }
+
+    if (psInfo->sReq.eReqType == eREQUEST_TYPE_UPSTREAM)
+        psSciTransfer->sCallbacks.FinishStreamCB();
+
+    free(psInfo->uTransferResults);
+    free(psInfo->pui8UpstreamBuffer);
+    psInfo->uTransferResults    = NULL;
+    psInfo->pui8UpstreamBuffer  = NULL;
+
+    psInfo->ui32ReceivedDataCnt = 0;
+    psInfo->ui32TransferCnt     = 0;
+    psInfo->ui32ExpectedDataCnt = 0;
+    psInfo->bCompressed         = false;
+
+    // The link is free before the caller is notified (it may start the next request)
+    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+
+    if (psSciTransfer->sCallbacks.CommandCB != NULL)
+        psSciTransfer->sCallbacks.CommandCB(eREQUEST_ACK_STATUS_CANCELLED, psInfo->sReq.i16Num, NULL, 0, 0);
+}
+
+//=============================================================================
+static bool _UrgentPop (tsSCI_TRANSFER *psSciTransfer, tsURGENT_REQUEST *psUrgent)
+{
+    if (psSciTransfer->sUrgent.ui8Cnt == 0)
+        return false;
+
+    *psUrgent = psSciTransfer->sUrgent.sQueue[psSciTransfer->sUrgent.ui8Head];
+    psSciTransfer->sUrgent.ui8Head = (psSciTransfer->sUrgent.ui8Head + 1) % SCI_URGENT_QUEUE_LENGTH;
+    psSciTransfer->sUrgent.ui8Cnt--;
+
+    return true;
+}
+
+//=============================================================================
+static tsREQUEST _UrgentRequest (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsREQUEST sReq = tsREQUEST_DEFAULTS;
+
+    sReq.eReqType       = psSciTransfer->sUrgent.sInFlight.eReqType;
+    sReq.i16Num         = psSciTransfer->sUrgent.sInFlight.i16Num;
+    sReq.uValArr        = &psSciTransfer->sUrgent.sInFlight.uVal;
+    sReq.ui16ValArrLen  = sReq.eReqType == eREQUEST_TYPE_SETVAR ? 1 : 0;
+
+    return sReq;
+}
+
+//=============================================================================
+static void _UrgentResult (tsSCI_TRANSFER *psSciTransfer, teREQUEST_ACKNOWLEDGE eAck, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    int16_t i16Num = psSciTransfer->sUrgent.sInFlight.i16Num;
+
+    if (psSciTransfer->sUrgent.sInFlight.eReqType == eREQUEST_TYPE_SETVAR)
+    {
+        if (psSciTransfer->sCallbacks.SetVarCB != NULL)
+            psSciTransfer->sCallbacks.SetVarCB(eAck, i16Num, ui16ErrNum);
+    }
+    else if (psSciTransfer->sCallbacks.GetVarCB != NULL)
+        psSciTransfer->sCallbacks.GetVarCB(eAck, i16Num, ui32Data, ui16ErrNum);
+}
+
+//=============================================================================
+static void _UrgentNext (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+    // Waiting urgent requests go first
+    while (_UrgentPop(psSciTransfer, &psSciTransfer->sUrgent.sInFlight))
+    {
+        psSciTransfer->sCallbacks.ReleaseProtocolCB();
+
+        if (psSciTransfer->sCallbacks.RequestCB(_UrgentRequest(psSciTransfer)))
+        {
+            psSciTransfer->sUrgent.bInFlight = true;
+            return;
+        }
+
+        // Request does not fit into the TX frame
+        _UrgentResult(psSciTransfer, eREQUEST_ACK_STATUS_ERROR, 0, 0);
+    }
+
+    if (psInfo->bCancel)
+    {
+        _Abort(psSciTransfer);
+        return;
+    }
+
+    // Resume the interrupted transfer from its offset
+    if (psSciTransfer->sUrgent.bResumeStream)
+        psSciTransfer->sCallbacks.InitiateStreamCB(psInfo->ui32ExpectedDataCnt - psInfo->ui32ReceivedDataCnt);
+
+    if (psSciTransfer->sUrgent.bResumeDownstream)
+        _DownstreamSendChunk(psSciTransfer);
+    else
+    {
+        psSciTransfer->sCallbacks.ReleaseProtocolCB();
+        psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sUrgent.sResume);
+    }
+}
+
+//=============================================================================
+static bool _Preempt (tsSCI_TRANSFER *psSciTransfer, const tsREQUEST *psResume, bool bStream)
+{
+    // Chunk boundary of a multi-frame transfer: Interleave the waiting urgent requests
+    if (psSciTransfer->sUrgent.ui8Cnt == 0)
+    {
+        if (!psSciTransfer->sTransferInfo.bCancel)
+            return false;
+
+        _Abort(psSciTransfer);
+        return true;
+    }
+
+    // The responses of the urgent requests are regular frames
+    if (bStream)
+        psSciTransfer->sCallbacks.FinishStreamCB();
+
+    psSciTransfer->sUrgent.bResumeStream        = bStream;
+    psSciTransfer->sUrgent.bResumeDownstream    = psResume == NULL;
+
+    if (psResume != NULL)
+        psSciTransfer->sUrgent.sResume = *psResume;
+
+    _UrgentNext(psSciTransfer);
+
+    return true;
+}
+
+//=============================================================================
+bool SCITransferStart (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16CmdNum, tuREQUESTVALUE *uVal, uint16_t ui16ArgNum,
+                       const teSCI_DATATYPE *peResultTypes, void * const *ppvResults, uint16_t ui16ResultCnt)
 {
     tsREQUEST sReq = tsREQUEST_DEFAULTS;
     // Take over the arguments
     sReq.eReqType       = eReqType;
     sReq.i16Num         = i16CmdNum;
     sReq.uValArr        = uVal;
-    sReq.ui8ValArrLen   = ui8ArgNum;
+    sReq.ui16ValArrLen  = ui16ArgNum;
 
     if(!psSciTransfer->sCallbacks.RequestCB(sReq))
         return false;
 
     psSciTransfer->sTransferInfo.sReq = sReq;
+    psSciTransfer->sTransferInfo.bCancel = false;
+
+    // Typed request result destinations
+    psSciTransfer->sTransferInfo.peResultTypes  = peResultTypes;
+    psSciTransfer->sTransferInfo.ppvResults     = ppvResults;
+    psSciTransfer->sTransferInfo.ui16ResultCnt  = peResultTypes != NULL ? ui16ResultCnt : 0;
+
+    return true;
+}
+
+//=============================================================================
+bool SCITransferStartDownstream (tsSCI_TRANSFER *psSciTransfer, int16_t i16Num, const uint8_t *pui8Data, uint32_t ui32Len, 
+                                 uint32_t ui32StartOffset, uint16_t ui16MaxChunkLen)
+{
+    tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+    tuREQUESTVALUE uAnnouncement[2];
+    uint8_t *pui8Chunk = NULL;
+
+    if (ui16MaxChunkLen == 0 || ui32StartOffset > ui32Len)
+        return false;
+
+    // Without a buffer, the data is fetched chunk by chunk from the application
+    if (pui8Data == NULL)
+    {
+        if (psSciTransfer->sCallbacks.DownstreamSourceCB == NULL)
+            return false;
+
+        pui8Chunk = malloc(ui16MaxChunkLen);
+
+        if (pui8Chunk == NULL)
+            return false;
+    }
+
+    uAnnouncement[0].ui32_hex = ui32Len;
+    uAnnouncement[1].ui32_hex = ui32StartOffset;
+
+    if (!SCITransferStart(psSciTransfer, eREQUEST_TYPE_DOWNSTREAM, i16Num, uAnnouncement, 2, NULL, NULL, 0))
+    {
+        free(pui8Chunk);
+        return false;
+    }
+
+    psInfo->sDownstream.pui8Data            = pui8Data;
+    psInfo->sDownstream.pui8Chunk           = pui8Chunk;
+    psInfo->sDownstream.ui32Len             = ui32Len;
+    psInfo->sDownstream.ui32AckedOffset     = ui32StartOffset;
+    psInfo->sDownstream.ui32SendOffset      = ui32StartOffset;
+    psInfo->sDownstream.ui16MaxChunkLen     = ui16MaxChunkLen;
+    psInfo->sDownstream.ui16Credit          = 0;
+    psInfo->sDownstream.ui16ChunksInFlight  = 0;
+
+    return true;
+}
+
+//=============================================================================
+bool SCITransferUrgent (tsSCI_TRANSFER *psSciTransfer, teREQUEST_TYPE eReqType, int16_t i16Num, tuREQUESTVALUE uVal)
+{
+    tsURGENT_REQUEST *psUrgent;
+
+    if ((eReqType != eREQUEST_TYPE_GETVAR && eReqType != eREQUEST_TYPE_SETVAR) || 
+        psSciTransfer->sUrgent.ui8Cnt >= SCI_URGENT_QUEUE_LENGTH)
+        return false;
+
+    psUrgent = &psSciTransfer->sUrgent.sQueue[(psSciTransfer->sUrgent.ui8Head + psSciTransfer->sUrgent.ui8Cnt) % SCI_URGENT_QUEUE_LENGTH];
+    psUrgent->eReqType  = eReqType;
+    psUrgent->i16Num    = i16Num;
+    psUrgent->uVal      = uVal;
+    psSciTransfer->sUrgent.ui8Cnt++;
+
+    return true;
+}
+
+//=============================================================================
+bool SCITransferStartUrgent (tsSCI_TRANSFER *psSciTransfer)
+{
+    tsURGENT_REQUEST sUrgent;
+
+    if (!_UrgentPop(psSciTransfer, &sUrgent))
+        return false;
+
+    psSciTransfer->sUrgent.sInFlight = sUrgent;
+
+    // No transfer to resume: Regular request
+    if (SCITransferStart(psSciTransfer, sUrgent.eReqType, sUrgent.i16Num, &psSciTransfer->sUrgent.sInFlight.uVal, 
+                         sUrgent.eReqType == eREQUEST_TYPE_SETVAR ? 1 : 0, NULL, NULL, 0))
+        return true;
+
+    _UrgentResult(psSciTransfer, eREQUEST_ACK_STATUS_ERROR, 0, 0);
+
+    return false;
+}
+
+//=============================================================================
+bool SCITransferCancel (tsSCI_TRANSFER *psSciTransfer, int16_t i16Num)
+{
+    tsREQUEST *psReq = &psSciTransfer->sTransferInfo.sReq;
+
+    if (psReq->eReqType != eREQUEST_TYPE_COMMAND && psReq->eReqType != eREQUEST_TYPE_UPSTREAM && 
+        psReq->eReqType != eREQUEST_TYPE_DOWNSTREAM)
+        return false;
+
+    if (i16Num != SCI_CANCEL_CURRENT && i16Num != psReq->i16Num)
+        return false;
+
+    psSciTransfer->sTransferInfo.bCancel = true;
+
+    return true;
+}
+
+//=============================================================================
+void SCITransferSent (tsSCI_TRANSFER *psSciTransfer)
+{
+    // Only DOWNSTREAM chunks are sent without a response
+    if (psSciTransfer->sTransferInfo.sReq.eReqType == eREQUEST_TYPE_DOWNSTREAM)
+        _DownstreamSendChunk(psSciTransfer);
 }
 
+//=============================================================================
 bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
 {
     teTRANSFER_ACK eTransferAck = eTRANSFER_ACK_ABORT;
     bool ret = true;
 
+    // Response to an urgent request interleaved with a transfer
+    if (psSciTransfer->sUrgent.bInFlight)
+    {
+        psSciTransfer->sUrgent.bInFlight = false;
+        _UrgentResult(psSciTransfer, sRsp.eReqAck, sRsp.uValArr[0].ui32_hex, sRsp.ui16ErrNum);
+        _UrgentNext(psSciTransfer);
+        return true;
+    }
+
     switch (sRsp.eReqType)
     {
         case eREQUEST_TYPE_SETVAR:
-            if (psSciTransfer->sCallbacks.GetVarCB != NULL)
+            if (psSciTransfer->sCallbacks.SetVarCB != NULL)
             {
                 eTransferAck = psSciTransfer->sCallbacks.SetVarCB(sRsp.eReqAck, sRsp.i16Num, sRsp.ui16ErrNum);
             }
@@ -66,6 +435,12 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
             break;
         
         case eREQUEST_TYPE_GETVAR:
+            // Typed request: Decode the value into the user storage
+            if (psSciTransfer->sTransferInfo.ui16ResultCnt > 0 && sRsp.eReqAck == eREQUEST_ACK_STATUS_SUCCESS)
+            {
+                psSciTransfer->pDecodeTable[psSciTransfer->sTransferInfo.peResultTypes[0]](sRsp.uValArr[0], psSciTransfer->sTransferInfo.ppvResults[0]);
+            }
+
             if (psSciTransfer->sCallbacks.GetVarCB != NULL)
             {
                 eTransferAck = psSciTransfer->sCallbacks.GetVarCB(sRsp.eReqAck, sRsp.i16Num, sRsp.uValArr[0].ui32_hex, sRsp.ui16ErrNum);
@@ -84,26 +459,73 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
             {
                 case eREQUEST_ACK_STATUS_SUCCESS_DATA:
 
-                    // Generate a transfer value buffer and copy data
                     // In first message
                     if (psSciTransfer->sTransferInfo.ui32TransferCnt == 0)
                     {
                         psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = sRsp.ui32DataLength;
 
-                        // Allocate the memory for the COMMAND results
-                        psSciTransfer->sTransferInfo.uTransferResults = malloc(psSciTransfer->sTransferInfo.ui32ExpectedDataCnt * sizeof(tuRESPONSEVALUE));
+                        // Typed request or incremental delivery: No transfer memory needed
+                        if (psSciTransfer->sTransferInfo.peResultTypes == NULL && psSciTransfer->sCallbacks.CommandDataCB == NULL)
+                        {
+                            // Allocate the memory for the COMMAND results
+                            psSciTransfer->sTransferInfo.uTransferResults = malloc(psSciTransfer->sTransferInfo.ui32ExpectedDataCnt * sizeof(tuRESPONSEVALUE));
 
-                        // TODO: Handling of not enough memory ?!?
-                        if(psSciTransfer->sTransferInfo.uTransferResults == NULL)
-                            return false;
+                            // TODO: Handling of not enough memory ?!?
+                            if(psSciTransfer->sTransferInfo.uTransferResults == NULL)
+                                return false;
+                        }
                     }
 
+                    // More values than announced (would overflow the transfer memory)
+                    if (psSciTransfer->sTransferInfo.ui32ReceivedDataCnt + sRsp.ui16ResponseDataLength > 
+                        psSciTransfer->sTransferInfo.ui32ExpectedDataCnt)
+                    {
+                        if (psSciTransfer->sCallbacks.CommandCB != NULL)
+                            psSciTransfer->sCallbacks.CommandCB(eREQUEST_ACK_STATUS_ERROR, sRsp.i16Num, NULL, 0, eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET);
+
+                        free(psSciTransfer->sTransferInfo.uTransferResults);
+                        psSciTransfer->sTransferInfo.uTransferResults = NULL;
+
+                        psSciTransfer->sTransferInfo.ui32ReceivedDataCnt = 0;
+                        psSciTransfer->sTransferInfo.ui32TransferCnt = 0;
+                        psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = 0;
+
+                        psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                        break;
+                    }
+
+                    // Typed request: Decode the values of this frame into the user storage
+                    if (psSciTransfer->sTransferInfo.peResultTypes != NULL)
+                    {
+                        tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+                        for (uint16_t i = 0; i < sRsp.ui16ResponseDataLength; i++)
+                        {
+                            uint32_t ui32Idx = psInfo->ui32ReceivedDataCnt + i;
+
+                            if (ui32Idx >= psInfo->ui16ResultCnt)
+                                break;
+
+                            psSciTransfer->pDecodeTable[psInfo->peResultTypes[ui32Idx]](sRsp.uValArr[i], psInfo->ppvResults[ui32Idx]);
+                        }
+                    }
+
+                    // Pass the values of this frame directly to the application
+                    if (psSciTransfer->sCallbacks.CommandDataCB != NULL)
+                    {
+                        psSciTransfer->sCallbacks.CommandDataCB(sRsp.i16Num, &sRsp.uValArr[0].ui32_hex, 
+                                                                psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, 
+                                                                sRsp.ui16ResponseDataLength);
+                    }
                     // Copy buffer values into the transfer memory
-                    memcpy(&psSciTransfer->sTransferInfo.uTransferResults[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
-                            sRsp.uValArr, 
-                            sRsp.ui8ResponseDataLength * sizeof(tuRESPONSEVALUE));
+                    else if (psSciTransfer->sTransferInfo.peResultTypes == NULL)
+                    {
+                        memcpy(&psSciTransfer->sTransferInfo.uTransferResults[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
+                                sRsp.uValArr, 
+                                sRsp.ui16ResponseDataLength * sizeof(tuRESPONSEVALUE));
+                    }
 
-                    psSciTransfer->sTransferInfo.ui32ReceivedDataCnt += sRsp.ui8ResponseDataLength;
+                    psSciTransfer->sTransferInfo.ui32ReceivedDataCnt += sRsp.ui16ResponseDataLength;
 
                     // Increment number of COMMAND transfers
                     psSciTransfer->sTransferInfo.ui32TransferCnt++;
@@ -112,14 +534,35 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                     if (psSciTransfer->sTransferInfo.ui32ExpectedDataCnt == 
                         psSciTransfer->sTransferInfo.ui32ReceivedDataCnt)
                     {
-                        // Callback invocation
-                        if (psSciTransfer->sCallbacks.CommandCB != NULL)
+                        // Callback invocation (Values have already been delivered on typed requests or incremental delivery,
+                        // only their number is reported)
+                        if (psSciTransfer->sTransferInfo.peResultTypes != NULL || psSciTransfer->sCallbacks.CommandDataCB != NULL)
                         {
-                            eTransferAck = psSciTransfer->sCallbacks.CommandCB(sRsp.eReqAck, sRsp.i16Num, &psSciTransfer->sTransferInfo.uTransferResults[0].ui32_hex, psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, sRsp.ui16ErrNum);
+                            teREQUEST_ACKNOWLEDGE eAck = sRsp.eReqAck;
+                            uint16_t ui16ErrNum = sRsp.ui16ErrNum;
+
+                            // Typed request: The number of results must match the result destinations
+                            if (psSciTransfer->sTransferInfo.peResultTypes != NULL && 
+                                psSciTransfer->sTransferInfo.ui32ReceivedDataCnt != psSciTransfer->sTransferInfo.ui16ResultCnt)
+                            {
+                                eAck = eREQUEST_ACK_STATUS_ERROR;
+                                ui16ErrNum = eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET;
+                            }
+
+                            if (psSciTransfer->sCallbacks.CommandCB != NULL)
+                                eTransferAck = psSciTransfer->sCallbacks.CommandCB(eAck, sRsp.i16Num, NULL, psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, ui16ErrNum);
+                        }
+                        else
+                        {
+                            if (psSciTransfer->sCallbacks.CommandCB != NULL)
+                            {
+                                eTransferAck = psSciTransfer->sCallbacks.CommandCB(sRsp.eReqAck, sRsp.i16Num, &psSciTransfer->sTransferInfo.uTransferResults[0].ui32_hex, psSciTransfer->sTransferInfo.ui32ReceivedDataCnt, sRsp.ui16ErrNum);
+                            }
+
+                            // Free data memory
+                            free(psSciTransfer->sTransferInfo.uTransferResults);
+                            psSciTransfer->sTransferInfo.uTransferResults = NULL;
                         }
-
-                        // Free data memory
-                        free(psSciTransfer->sTransferInfo.uTransferResults);
 
                         // Reset the count variables
                         psSciTransfer->sTransferInfo.ui32ReceivedDataCnt = 0;
@@ -135,10 +578,13 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                     else
                     {
                         // For all consecutive transfers, parameters do not have to be passed.
-                        psSciTransfer->sTransferInfo.sReq.ui8ValArrLen = 0;
+                        psSciTransfer->sTransferInfo.sReq.ui16ValArrLen = 0;
 
-                        psSciTransfer->sCallbacks.ReleaseProtocolCB();
-                        psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+                        if (!_Preempt(psSciTransfer, &psSciTransfer->sTransferInfo.sReq, false))
+                        {
+                            psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                            psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+                        }
                     }
                     break;
 
@@ -146,13 +592,38 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                 case eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM:
                 {
                     tsREQUEST sUpstreamRequest = tsREQUEST_DEFAULTS;
+                    uint32_t ui32BufferLen = sRsp.ui32DataLength;
+
+                    // Compressed upstream: Codec and decompressed length follow the wire length
+                    psSciTransfer->sTransferInfo.bCompressed = sRsp.ui16ResponseDataLength >= 2;
+
+                    if (psSciTransfer->sTransferInfo.bCompressed)
+                    {
+                        if (!SCIDecompressInit(&psSciTransfer->sTransferInfo.sDecompress,
+                                               (teSCI_COMPRESS_CODEC)sRsp.uValArr[0].ui32_hex, sRsp.uValArr[1].ui32_hex))
+                        {
+                            psSciTransfer->sTransferInfo.bCompressed = false;
 
-                    // Allocate memory for the upstream data
-                    psSciTransfer->sTransferInfo.pui8UpstreamBuffer = malloc(sRsp.ui32DataLength);
+                            if (psSciTransfer->sCallbacks.CommandCB != NULL)
+                                psSciTransfer->sCallbacks.CommandCB(eREQUEST_ACK_STATUS_ERROR, sRsp.i16Num, NULL, 0, 0);
 
-                    // TODO: What to do if memory allocation failed?
-                    if (psSciTransfer->sTransferInfo.pui8UpstreamBuffer == NULL)
-                        return false;
+                            psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                            break;
+                        }
+
+                        // The decoder needs space for a complete (padded) last word
+                        ui32BufferLen = sRsp.uValArr[1].ui32_hex + SCI_COMPRESS_MAX_WORD_LEN;
+                    }
+
+                    // Allocate memory for the upstream data (incremental delivery: Not buffered)
+                    if (psSciTransfer->sCallbacks.UpstreamDataCB == NULL)
+                    {
+                        psSciTransfer->sTransferInfo.pui8UpstreamBuffer = malloc(ui32BufferLen);
+
+                        // TODO: What to do if memory allocation failed?
+                        if (psSciTransfer->sTransferInfo.pui8UpstreamBuffer == NULL)
+                            return false;
+                    }
 
                     psSciTransfer->sTransferInfo.ui32ExpectedDataCnt = sRsp.ui32DataLength;
 
@@ -163,12 +634,15 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                     sUpstreamRequest.eReqType = eREQUEST_TYPE_UPSTREAM;
                     sUpstreamRequest.i16Num = psSciTransfer->sTransferInfo.sReq.i16Num;
 
-                    // Initiate the upstream request
-                    psSciTransfer->sCallbacks.ReleaseProtocolCB();
-                    psSciTransfer->sCallbacks.RequestCB(sUpstreamRequest);
-
                     psSciTransfer->sTransferInfo.sReq = sUpstreamRequest;
 
+                    // Initiate the upstream request
+                    if (!_Preempt(psSciTransfer, &sUpstreamRequest, true))
+                    {
+                        psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                        psSciTransfer->sCallbacks.RequestCB(sUpstreamRequest);
+                    }
+
                     break;
                 }
 
@@ -188,17 +662,36 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
         
         case eREQUEST_TYPE_UPSTREAM:
 
+            // Decompress the frame into the upstream memory or the application
+            if (psSciTransfer->sTransferInfo.bCompressed)
+            {
+                _UpstreamDecompress(psSciTransfer, sRsp.pui8Raw, sRsp.ui16ResponseDataLength);
+            }
+            // Pass the data of this frame directly to the application
+            else if (psSciTransfer->sCallbacks.UpstreamDataCB != NULL)
+            {
+                psSciTransfer->sCallbacks.UpstreamDataCB(psSciTransfer->sTransferInfo.sReq.i16Num, sRsp.pui8Raw,
+                                                         psSciTransfer->sTransferInfo.ui32ReceivedDataCnt,
+                                                         sRsp.ui16ResponseDataLength);
+            }
             // Copy transfer data from receive buffer into upstream memory
-            memcpy(&psSciTransfer->sTransferInfo.pui8UpstreamBuffer[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
-                    sRsp.pui8Raw, sRsp.ui8ResponseDataLength);
+            else
+            {
+                memcpy(&psSciTransfer->sTransferInfo.pui8UpstreamBuffer[psSciTransfer->sTransferInfo.ui32ReceivedDataCnt], 
+                        sRsp.pui8Raw, sRsp.ui16ResponseDataLength);
+            }
             
-            psSciTransfer->sTransferInfo.ui32ReceivedDataCnt += sRsp.ui8ResponseDataLength;
+            psSciTransfer->sTransferInfo.ui32ReceivedDataCnt += sRsp.ui16ResponseDataLength;
 
             // There is additional data to transfer
             if (psSciTransfer->sTransferInfo.ui32ReceivedDataCnt < psSciTransfer->sTransferInfo.ui32ExpectedDataCnt)
             {
                 // New request
-                psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+                if (!_Preempt(psSciTransfer, &psSciTransfer->sTransferInfo.sReq, true))
+                {
+                    psSciTransfer->sCallbacks.ReleaseProtocolCB();
+                    psSciTransfer->sCallbacks.RequestCB(psSciTransfer->sTransferInfo.sReq);
+                }
             }
             // All data arrived
             else
@@ -206,13 +699,22 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
                 // Switch back receive mode
                 psSciTransfer->sCallbacks.FinishStreamCB();
 
+                // Truncated or malformed compressed data
+                if (psSciTransfer->sTransferInfo.bCompressed && !SCIDecompressDone(&psSciTransfer->sTransferInfo.sDecompress))
+                {
+                    if (psSciTransfer->sCallbacks.CommandCB != NULL)
+                        psSciTransfer->sCallbacks.CommandCB(eREQUEST_ACK_STATUS_ERROR, psSciTransfer->sTransferInfo.sReq.i16Num, NULL, 0, 0);
+                }
                 // Call the Upstream CB
-                if (psSciTransfer->sCallbacks.UpstreamCB != NULL)
+                else if (psSciTransfer->sCallbacks.UpstreamCB != NULL)
                 {
                     psSciTransfer->sCallbacks.UpstreamCB(psSciTransfer->sTransferInfo.sReq.i16Num, 
                                                         psSciTransfer->sTransferInfo.pui8UpstreamBuffer,
+                                                        psSciTransfer->sTransferInfo.bCompressed ?
+                                                        psSciTransfer->sTransferInfo.sDecompress.ui32RawCnt :
                                                         psSciTransfer->sTransferInfo.ui32ReceivedDataCnt);
                 }
+                psSciTransfer->sTransferInfo.bCompressed = false;
 
                 // Reset the count variables
                 psSciTransfer->sTransferInfo.ui32ReceivedDataCnt = 0;
@@ -221,11 +723,61 @@ bool SCITransferControl (tsSCI_TRANSFER *psSciTransfer, tsRESPONSE sRsp)
 
                 // Free the formerly allocated memory
                 free(psSciTransfer->sTransferInfo.pui8UpstreamBuffer);
+                psSciTransfer->sTransferInfo.pui8UpstreamBuffer = NULL;
 
                 psSciTransfer->sCallbacks.ReleaseProtocolCB();
             }
             break;
         
+        case eREQUEST_TYPE_DOWNSTREAM:
+        {
+            tsTRANSFER_INFO *psInfo = &psSciTransfer->sTransferInfo;
+
+            if (sRsp.eReqAck != eREQUEST_ACK_STATUS_SUCCESS)
+            {
+                _DownstreamFinish(psSciTransfer, sRsp.eReqAck, sRsp.ui16ErrNum);
+                break;
+            }
+
+            // Response to the announcement: The slave grants its credit
+            if (psInfo->sDownstream.ui16Credit == 0)
+            {
+                psInfo->sDownstream.ui16Credit = sRsp.uValArr[0].ui32_hex > 0 ? (uint16_t)sRsp.uValArr[0].ui32_hex : 1;
+            }
+            // Cumulative acknowledge: Continue from the next offset expected by the slave
+            else
+            {
+                uint32_t ui32NextOffset = sRsp.uValArr[0].ui32_hex;
+
+                // The slave can't acknowledge data that has not been sent (or forget acknowledged data)
+                if (ui32NextOffset < psInfo->sDownstream.ui32AckedOffset || ui32NextOffset > psInfo->sDownstream.ui32SendOffset)
+                {
+                    _DownstreamFinish(psSciTransfer, eREQUEST_ACK_STATUS_ERROR, 0);
+                    break;
+                }
+
+                psInfo->sDownstream.ui32AckedOffset = ui32NextOffset;
+                psInfo->sDownstream.ui32SendOffset  = ui32NextOffset;
+            }
+
+            psInfo->sDownstream.ui16ChunksInFlight = 0;
+
+            if (psInfo->sDownstream.ui32AckedOffset >= psInfo->sDownstream.ui32Len)
+                _DownstreamFinish(psSciTransfer, eREQUEST_ACK_STATUS_SUCCESS, 0);
+            else if (!_Preempt(psSciTransfer, NULL, false))
+                _DownstreamSendChunk(psSciTransfer);
+
+            break;
+        }
+
+        case eREQUEST_TYPE_HANDSHAKE:
+            // The settings are applied by the master before the protocol is released
+            if (psSciTransfer->sCallbacks.HandshakeCB != NULL)
+                psSciTransfer->sCallbacks.HandshakeCB(sRsp.eReqAck, sRsp.uValArr, sRsp.ui16ResponseDataLength);
+
+            psSciTransfer->sCallbacks.ReleaseProtocolCB();
+            break;
+        
         default:
             break;
 
@@ -0,0 +1,300 @@
+/**************************************************************************//**
+ * \file SCIWriteBehind.c
+ * \author Roman Holderried
+ *
+ * \brief Write-behind SETVAR buffer on top of the SCI master.
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "SCIWriteBehind.h"
+#include "SCIMaster.h"
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static tsSCI_WRITE_BEHIND sSciWb;
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static bool _Used (const tsSCI_WB_ENTRY *psEntry)
+{
+    return psEntry->bPending || psEntry->bInFlight;
+}
+
+//=============================================================================
+static uint32_t _OldestEpoch (void)
+{
+    uint32_t ui32Oldest = UINT32_MAX;
+
+    for (uint8_t i = 0; i < SCI_WB_NUM_ENTRIES; i++)
+    {
+        if (_Used(&sSciWb.sEntries[i]) && sSciWb.sEntries[i].ui32Epoch < ui32Oldest)
+            ui32Oldest = sSciWb.sEntries[i].ui32Epoch;
+    }
+
+    return ui32Oldest;
+}
+
+//=============================================================================
+static void _ReportBarriers (void)
+{
+    uint32_t ui32Oldest = _OldestEpoch();
+
+    // A barrier is passed if no write of its interval (or before) is left
+    while (sSciWb.ui32Notified < sSciWb.ui32Epoch && sSciWb.ui32Notified < ui32Oldest)
+    {
+        if (sSciWb.sConfig.BarrierCB != NULL)
+            sSciWb.sConfig.BarrierCB(sSciWb.ui32Notified);
+
+        sSciWb.ui32Notified++;
+    }
+}
+
+//=============================================================================
+static void _AbortBatch (void)
+{
+    // Unknown whether the slave applied the values: The newest value of every write is sent again
+    for (uint8_t i = 0; i < sSciWb.ui8BatchCnt; i++)
+    {
+        tsSCI_WB_ENTRY *psEntry = &sSciWb.sEntries[sSciWb.ui8Batch[i]];
+
+        psEntry->bInFlight  = false;
+        psEntry->bPending   = true;
+    }
+
+    sSciWb.ui8BatchCnt = 0;
+    sSciWb.sStats.ui32Aborts++;
+}
+
+//=============================================================================
+void SCIWriteBehindInit (tsSCI_WB_CONFIG sConfig)
+{
+    tsSCI_WB_STATS sStats = tsSCI_WB_STATS_DEFAULTS;
+
+    memset(&sSciWb, 0, sizeof(sSciWb));
+
+    sSciWb.sConfig  = sConfig;
+    sSciWb.sStats   = sStats;
+}
+
+//=============================================================================
+bool SCIWriteBehindWrite (int16_t i16Num, tuREQUESTVALUE uVal)
+{
+    tsSCI_WB_ENTRY *psFree = NULL;
+
+    for (uint8_t i = 0; i < SCI_WB_NUM_ENTRIES; i++)
+    {
+        tsSCI_WB_ENTRY *psEntry = &sSciWb.sEntries[i];
+
+        if (!_Used(psEntry))
+        {
+            if (psFree == NULL)
+                psFree = psEntry;
+            continue;
+        }
+
+        // Last writer wins within the barrier interval
+        if (psEntry->i16Num == i16Num && psEntry->ui32Epoch == sSciWb.ui32Epoch)
+        {
+            // Rewritten while on the link: Queued behind the other pending writes
+            if (psEntry->bPending)
+                sSciWb.sStats.ui32Coalesced++;
+            else
+                psEntry->ui32Order = sSciWb.ui32Order++;
+
+            psEntry->uVal       = uVal;
+            psEntry->bPending   = true;
+            sSciWb.sStats.ui32Writes++;
+
+            return true;
+        }
+    }
+
+    if (psFree == NULL)
+    {
+        sSciWb.sStats.ui32Rejected++;
+        return false;
+    }
+
+    psFree->i16Num      = i16Num;
+    psFree->uVal        = uVal;
+    psFree->ui32Epoch   = sSciWb.ui32Epoch;
+    psFree->ui32Order   = sSciWb.ui32Order++;
+    psFree->bPending    = true;
+    psFree->bInFlight   = false;
+    sSciWb.sStats.ui32Writes++;
+
+    return true;
+}
+
+//=============================================================================
+uint32_t SCIWriteBehindBarrier (void)
+{
+    return sSciWb.ui32Epoch++;
+}
+
+//=============================================================================
+void SCIWriteBehindProcess (void)
+{
+    int16_t i16Nums[SCI_SETVAR_BATCH_MAX];
+    tuREQUESTVALUE uVals[SCI_SETVAR_BATCH_MAX];
+    uint8_t ui8Cnt = 0;
+    uint8_t ui8Max = (SCIGetCapabilities().ui16Features & SCI_FEATURE_SETVAR_BATCH) ? SCI_SETVAR_BATCH_MAX : 1;
+    uint32_t ui32Oldest;
+
+    _ReportBarriers();
+
+    // Frame in flight without response: The master has been released meanwhile or the timeout elapsed
+    if (sSciWb.ui8BatchCnt > 0)
+    {
+        if (SCIGetProtocolState() == ePROTOCOL_IDLE)
+            _AbortBatch();
+        else if (sSciWb.sConfig.ui32Timeout > 0 &&
+                 (sSciWb.sConfig.GetTimeCB() - sSciWb.ui32BatchStart) >= sSciWb.sConfig.ui32Timeout)
+        {
+            SCIReleaseProtocol();
+            _AbortBatch();
+        }
+    }
+
+    if (sSciWb.ui8BatchCnt > 0 || SCIGetProtocolState() != ePROTOCOL_IDLE)
+        return;
+
+    // Pending writes of the oldest barrier interval in the order of their first write 
+    // (Selected entries are marked temporarily to exclude them from the search)
+    ui32Oldest = _OldestEpoch();
+
+    while (ui8Cnt < ui8Max)
+    {
+        int16_t i16Next = -1;
+
+        for (uint8_t i = 0; i < SCI_WB_NUM_ENTRIES; i++)
+        {
+            tsSCI_WB_ENTRY *psEntry = &sSciWb.sEntries[i];
+
+            if (psEntry->bPending && !psEntry->bInFlight && psEntry->ui32Epoch == ui32Oldest &&
+                (i16Next < 0 || psEntry->ui32Order < sSciWb.sEntries[i16Next].ui32Order))
+                i16Next = i;
+        }
+
+        if (i16Next < 0)
+            break;
+
+        sSciWb.ui8Batch[ui8Cnt] = (uint8_t)i16Next;
+        sSciWb.sEntries[i16Next].bInFlight = true;
+        i16Nums[ui8Cnt] = sSciWb.sEntries[i16Next].i16Num;
+        uVals[ui8Cnt]   = sSciWb.sEntries[i16Next].uVal;
+        ui8Cnt++;
+    }
+
+    for (uint8_t i = 0; i < ui8Cnt; i++)
+        sSciWb.sEntries[sSciWb.ui8Batch[i]].bInFlight = false;
+
+    // Frames exceeding the TX length are split
+    while (ui8Cnt > 0 && !SCIRequestSetVarBatch(i16Nums, uVals, ui8Cnt))
+        ui8Cnt /= 2;
+
+    if (ui8Cnt == 0)
+        return;
+
+    for (uint8_t i = 0; i < ui8Cnt; i++)
+    {
+        sSciWb.sEntries[sSciWb.ui8Batch[i]].bPending  = false;
+        sSciWb.sEntries[sSciWb.ui8Batch[i]].bInFlight = true;
+    }
+
+    sSciWb.ui8BatchCnt = ui8Cnt;
+    sSciWb.sStats.ui32Frames++;
+
+    if (sSciWb.sConfig.ui32Timeout > 0)
+        sSciWb.ui32BatchStart = sSciWb.sConfig.GetTimeCB();
+
+    if (ui8Cnt > 1)
+        sSciWb.sStats.ui32Batched += ui8Cnt;
+}
+
+//=============================================================================
+bool SCIWriteBehindAbort (void)
+{
+    if (sSciWb.ui8BatchCnt == 0)
+        return false;
+
+    _AbortBatch();
+
+    return true;
+}
+
+//=============================================================================
+bool SCIWriteBehindIsEmpty (void)
+{
+    return _OldestEpoch() == UINT32_MAX;
+}
+
+//=============================================================================
+teTRANSFER_ACK SCIWriteBehindSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    uint8_t ui8Failed;
+
+    if (sSciWb.ui8BatchCnt == 0)
+    {
+        if (sSciWb.sConfig.SetVarForwardCB != NULL)
+            return sSciWb.sConfig.SetVarForwardCB(eAck, i16Num, ui16ErrNum);
+
+        return eTRANSFER_ACK_SUCCESS;
+    }
+
+    // On errors, the slave has stopped at the reported variable
+    ui8Failed = sSciWb.ui8BatchCnt;
+
+    if (eAck != eREQUEST_ACK_STATUS_SUCCESS)
+    {
+        ui8Failed = 0;
+
+        for (uint8_t i = 0; i < sSciWb.ui8BatchCnt; i++)
+        {
+            if (sSciWb.sEntries[sSciWb.ui8Batch[i]].i16Num == i16Num)
+            {
+                ui8Failed = i;
+                break;
+            }
+        }
+
+        sSciWb.sStats.ui32Errors++;
+
+        if (sSciWb.sConfig.WriteErrorCB != NULL)
+            sSciWb.sConfig.WriteErrorCB(eAck, sSciWb.sEntries[sSciWb.ui8Batch[ui8Failed]].i16Num, ui16ErrNum);
+    }
+
+    for (uint8_t i = 0; i < sSciWb.ui8BatchCnt; i++)
+    {
+        tsSCI_WB_ENTRY *psEntry = &sSciWb.sEntries[sSciWb.ui8Batch[i]];
+
+        psEntry->bInFlight = false;
+
+        // Writes behind the failed one have not been applied (the newest value is sent again)
+        if (i > ui8Failed)
+            psEntry->bPending = true;
+    }
+
+    sSciWb.ui8BatchCnt = 0;
+
+    _ReportBarriers();
+
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+tsSCI_WB_STATS SCIWriteBehindGetStats (void)
+{
+    return sSciWb.sStats;
+}
@@ -1,146 +1,365 @@
+/**************************************************************************//**
+ * \file TestSCIMaster.c
+ * \author Roman Holderried
+ *
+ * \brief Checks of the SCI master against scripted slave responses.
+ *
+ * The requests are sent into a capture buffer, the responses are passed to
+ * SCIReceive as the slave would send them. Every check prints its result,
+ * the exit code is the number of failed checks.
+ *
+ * - SETVAR: The result is reported to the SETVAR callback only, with or
+ *   without a GETVAR callback registered.
+ * - Typed requests: Constant descriptors built by SCI_VARIABLE / SCI_FUNCTION /
+ *   SCI_TYPES / SCI_UPSTREAM_FUNCTION. Every datatype is decoded into its user
+ *   storage (GETVAR and a COMMAND result of two frames) and encoded (SETVAR)
+ *   in both value modes, a COMMAND answering with fewer results than return
+ *   types fails.
+ * - COMMAND: A result with more values than announced fails (in the first or a
+ *   later frame) without overflowing the result memory.
+ *
+ * Build:
+ * gcc -std=c99 -O2 -DRX_PACKET_LENGTH=512 -DTX_PACKET_LENGTH=512 -I C/Inc
+ *     -I C/Inc/config -I C/Test C/Src/SCI*.c C/Src/Buffer.c C/Src/Helpers.c
+ *     C/Test/TestSCIMaster.c -o TestSCIMaster
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - Scripted slave responses, SETVAR result callback check
+ * 	- 2026-10-18 - Typed requests of every datatype in both value modes
+ * 	- 2026-10-18 - COMMAND results with more values than announced
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
+
 #include "SCIMaster.h"
 #include "TestSCIMaster.h"
 
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define TEST_MAX_STEPS      10000   // Master steps until a state is reached
+#define TEST_SETVAR_NUM     3
+#define TEST_NUM_TYPES      eSCI_DTYPE_NUM
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief User storage of any datatype */
+typedef union
+{
+    uint8_t     ui8;
+    int8_t      i8;
+    uint16_t    ui16;
+    int16_t     i16;
+    uint32_t    ui32;
+    int32_t     i32;
+    float       f32;
+}tuTEST_VALUE;
+
+/** \brief Value of a datatype as sent in either value mode */
+typedef struct
+{
+    const tsSCI_VARIABLE    *psVar;
+    const char              *pcHex;
+    const char              *pcFloat;
+    tuTEST_VALUE            uExpected;
+    uint8_t                 ui8Size;
+}tsTEST_TYPED_VALUE;
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static uint8_t ui8TxFrame[TX_PACKET_LENGTH + 2];
+static uint16_t ui16TxLen = 0;
+static uint32_t ui32Failed = 0;
+
+static uint32_t ui32SetVarCnt = 0;
+static uint32_t ui32GetVarCnt = 0;
+static teREQUEST_ACKNOWLEDGE eLastAck = eREQUEST_ACK_STATUS_UNKNOWN;
+static int16_t i16LastNum = -1;
+static uint16_t ui16LastErrNum = 0;
+static uint32_t ui32LastDataCnt = 0;
 
-uint8_t TestSetVarCB(uint8_t ui8Ack, int16_t i16Num, uint16_t ui16ErrNum)
+// Constant descriptors (as an application defines them)
+static const tsSCI_VARIABLE sVarUINT8   = SCI_VARIABLE(1, UINT8);
+static const tsSCI_VARIABLE sVarINT8    = SCI_VARIABLE(2, INT8);
+static const tsSCI_VARIABLE sVarUINT16  = SCI_VARIABLE(3, UINT16);
+static const tsSCI_VARIABLE sVarINT16   = SCI_VARIABLE(4, INT16);
+static const tsSCI_VARIABLE sVarUINT32  = SCI_VARIABLE(5, UINT32);
+static const tsSCI_VARIABLE sVarINT32   = SCI_VARIABLE(6, INT32);
+static const tsSCI_VARIABLE sVarF32     = SCI_VARIABLE(7, F32);
+static const tsSCI_FUNCTION sFcnAll     = SCI_FUNCTION(8, SCI_TYPES(INT16), SCI_TYPES(UINT8, INT8, UINT16, INT16, UINT32, INT32, F32));
+static const tsSCI_FUNCTION sFcnNoArgs  = SCI_FUNCTION(9, SCI_NO_TYPES, SCI_TYPES(UINT8));
+static const tsSCI_FUNCTION sFcnUps     = SCI_UPSTREAM_FUNCTION(10, SCI_TYPES(UINT32, F32));
+
+// Sign extension of INT8 / INT16, full width UINT32 (exact as float), negative F32
+static const tsTEST_TYPED_VALUE sTypedValues[TEST_NUM_TYPES] =
+{
+    {&sVarUINT8,    "FF",       "255",          {.ui8 = 255},           1},
+    {&sVarINT8,     "FF",       "-1",           {.i8 = -1},             1},
+    {&sVarUINT16,   "FFFE",     "65534",        {.ui16 = 65534},        2},
+    {&sVarINT16,    "FFFE",     "-2",           {.i16 = -2},            2},
+    {&sVarUINT32,   "EE6B2800", "4000000000",   {.ui32 = 4000000000u},  4},
+    {&sVarINT32,    "FFFFFFFD", "-3",           {.i32 = -3},            4},
+    {&sVarF32,      "C0200000", "-2.5",         {.f32 = -2.5f},         4},
+};
+
+/******************************************************************************
+ * Function definitions
+ *****************************************************************************/
+static void TestTxCB (uint8_t *pui8Buf, uint16_t ui16Len)
 {
-    printf("SetVar Transfer finished!\n");
-    printf("Acknowledge: %d, Number %d, Error %d\n", ui8Ack, i16Num, ui16ErrNum);
+    // A new frame starts with STX
+    if (ui16Len > 0 && pui8Buf[0] == 0x02)
+        ui16TxLen = 0;
 
-    return 0;
+    if (ui16TxLen + ui16Len <= sizeof(ui8TxFrame))
+    {
+        memcpy(&ui8TxFrame[ui16TxLen], pui8Buf, ui16Len);
+        ui16TxLen += ui16Len;
+    }
 }
 
-uint8_t TestGetVarCB(uint8_t ui8Ack, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+//=============================================================================
+static teTRANSFER_ACK TestSetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
 {
-    printf("GetVar Transfer finished!\n");
-    printf("Acknowledge: %d, Number %d, Error %d\n\n", ui8Ack, i16Num, ui16ErrNum);
-    printf("Result:\n");
-    printf("%\n", ui32Data);
+    ui32SetVarCnt++;
+    eLastAck = eAck;
+    i16LastNum = i16Num;
 
-    return 0;
+    return eTRANSFER_ACK_SUCCESS;
 }
 
-uint8_t TestCommandCB(uint8_t ui8Ack, int16_t i16Num, uint32_t *pui32Data, uint8_t ui8DataCnt, uint16_t ui16ErrNum)
+//=============================================================================
+static teTRANSFER_ACK TestGetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
 {
-    printf("Command Transfer finished!\n");
-    printf("Acknowledge: %d, Number %d, Error %d\n\n", ui8Ack, i16Num, ui16ErrNum);
-    printf("Results:\n");
+    ui32GetVarCnt++;
+    eLastAck = eAck;
+    i16LastNum = i16Num;
+
+    return eTRANSFER_ACK_SUCCESS;
+}
 
-    for (uint8_t i = 0; i < ui8DataCnt;i++)
-        printf("R%d: %x\n",(i+1), *pui32Data++);
+//=============================================================================
+static teTRANSFER_ACK TestCommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    eLastAck = eAck;
+    i16LastNum = i16Num;
+    ui16LastErrNum = ui16ErrNum;
+    ui32LastDataCnt = pui32Data != NULL ? ui32DataCnt : 0;
 
-    return 0;
+    return eTRANSFER_ACK_SUCCESS;
 }
 
-uint8_t TestUpstreamCB(int16_t i16Num, uint8_t *pui8Data, uint32_t ui32DataCnt)
+//=============================================================================
+static void Check (const char *pcName, bool bPassed)
 {
-    printf("Upstream Transfer finished!\n");
-    printf("Number %d\n\n", i16Num);
-    printf("Result:\n");
+    printf("%-48s %s\n", pcName, bPassed ? "ok" : "FAILED");
 
-    for (uint32_t i = 0; i < ui32DataCnt;i++)
-        printf("%x", *pui8Data++);
+    if (!bPassed)
+        ui32Failed++;
+}
+
+//=============================================================================
+static void Init (tsSCI_MASTER_CALLBACKS sCbs, teSCI_VALUE_MODE eValueMode)
+{
+    sCbs.BlockingTxExternalCB = TestTxCB;
+    SCIMasterInit(sCbs, eValueMode);
 
-    return 0;
+    ui32SetVarCnt = ui32GetVarCnt = 0;
+    eLastAck = eREQUEST_ACK_STATUS_UNKNOWN;
+    i16LastNum = -1;
+    ui16LastErrNum = 0;
+    ui32LastDataCnt = 0;
 }
 
-void dummySlave(void)
+//=============================================================================
+/** \brief Answers the request in flight with a response (without STX / ETX) and evaluates it.*/
+static bool Respond (const char *pcRsp)
 {
-    static uint8_t ui8Sched = 0;
-    // uint8_t ui8_msg1[] = {2,'1','?','A','C','K',';','4',3};
-    //uint8_t ui8_msg1[] = {2,'F','F',':','D','A','T',';','2',';','F','F',',','3',3};
-    uint8_t ui8_msg1[] = {2,'F','F',':','U','P','S',';','2','0','0',3};
-    uint8_t ui8UpsMsg[TX_PACKET_LENGTH + 2];
-    
-    if (ui8Sched == 0)
-    {
-        SCIReceive(ui8_msg1, sizeof(ui8_msg1));
-        ui8Sched++;
-    }
-    else
-    {
-        ui8UpsMsg[0] = 2;
+    uint8_t ui8Rsp[RX_PACKET_LENGTH + 2];
+    uint16_t ui16Len = (uint16_t)strlen(pcRsp);
+    uint32_t ui32Steps = 0;
 
-        for (uint8_t i = 0; i < TX_PACKET_LENGTH; i++)
-        {
-            ui8UpsMsg[i + 1] = ui8Sched;
-        }
-        ui8UpsMsg[TX_PACKET_LENGTH + 1] = 3;
+    while (SCIGetProtocolState() != ePROTOCOL_RECEIVING && ++ui32Steps < TEST_MAX_STEPS)
+        SCIMasterSM();
 
-        ui8Sched++;
-        SCIReceive(ui8UpsMsg, sizeof(ui8UpsMsg));
-    }
+    if (SCIGetProtocolState() != ePROTOCOL_RECEIVING || ui16Len > RX_PACKET_LENGTH)
+        return false;
+
+    ui8Rsp[0] = 0x02;
+    memcpy(&ui8Rsp[1], pcRsp, ui16Len);
+    ui8Rsp[ui16Len + 1] = 0x03;
+    SCIReceive(ui8Rsp, ui16Len + 2);
+
+    // Evaluated: Idle or the next request of the transfer on the way
+    while (SCIGetProtocolState() == ePROTOCOL_RECEIVING && ++ui32Steps < TEST_MAX_STEPS)
+        SCIMasterSM();
+
+    if (SCIGetProtocolState() == ePROTOCOL_EVALUATING)
+        SCIMasterSM();
+
+    return SCIGetProtocolState() != ePROTOCOL_RECEIVING && SCIGetProtocolState() != ePROTOCOL_EVALUATING;
 }
 
-void dummyTxCb(uint8_t * pui8_buf, uint8_t ui8_size)
+//=============================================================================
+static void TestSetVarResult (void)
 {
-    char* buf = (char*)malloc(ui8_size + 1);
-    memcpy(buf, pui8_buf, ui8_size);
-    buf[ui8_size]='\0';
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    tuREQUESTVALUE uVal = {.ui32_hex = 0x1234};
+    bool bPassed;
+
+    // SETVAR callback only: The result is reported
+    sCbs.SetVarExternalCB = TestSetVarCB;
+    Init(sCbs, eSCI_VALUE_MODE_HEX);
+
+    bPassed = SCIRequestSetVar(TEST_SETVAR_NUM, uVal) && Respond("3!ACK") && SCIGetProtocolState() == ePROTOCOL_IDLE;
+    Check("SETVAR result without GETVAR callback", bPassed && ui32SetVarCnt == 1 &&
+          eLastAck == eREQUEST_ACK_STATUS_SUCCESS && i16LastNum == TEST_SETVAR_NUM);
 
-    // print("\n");
-    // print("Tx Message:\n");
-    printf(buf);
-    // print("\n\n");
-    // print("Calling Slave...\n");
-    // dummySlave(buf, ui8_size);
+    // GETVAR callback only: Neither called nor a missing SETVAR callback
+    sCbs = (tsSCI_MASTER_CALLBACKS)tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    sCbs.GetVarExternalCB = TestGetVarCB;
+    Init(sCbs, eSCI_VALUE_MODE_HEX);
 
-    free(buf);
+    bPassed = SCIRequestSetVar(TEST_SETVAR_NUM, uVal) && Respond("3!ACK") && SCIGetProtocolState() == ePROTOCOL_IDLE;
+    Check("SETVAR result without SETVAR callback", bPassed && ui32GetVarCnt == 0);
 }
 
+//=============================================================================
+/** \brief Data section of the request frame (after the command identifier, without ETX).*/
+static bool TxDataIs (const char *pcData)
+{
+    uint16_t ui16Len = (uint16_t)strlen(pcData);
+    uint8_t *pui8Id = memchr(ui8TxFrame, '!', ui16TxLen);
 
+    return pui8Id != NULL && &pui8Id[ui16Len + 1] == &ui8TxFrame[ui16TxLen - 1] && memcmp(&pui8Id[1], pcData, ui16Len) == 0;
+}
 
-void main(void)
+//=============================================================================
+static void TestDescriptors (void)
 {
-    tsSCI_MASTER_CALLBACKS sCbs = { .BlockingTxExternalCB = dummyTxCb, 
-                                    .CommandExternalCB = TestCommandCB,
-                                    .GetVarExternalCB = TestGetVarCB,
-                                    .SetVarExternalCB = TestSetVarCB,
-                                    .UpstreamExternalCB = TestUpstreamCB};
+    Check("descriptor SCI_VARIABLE", sVarINT16.i16Num == 4 && sVarINT16.eType == eSCI_DTYPE_INT16);
+    Check("descriptor SCI_FUNCTION", sFcnAll.i16Num == 8 && sFcnAll.ui8ArgCnt == 1 && sFcnAll.peArgTypes[0] == eSCI_DTYPE_INT16 &&
+          sFcnAll.ui8RetCnt == TEST_NUM_TYPES && sFcnAll.peRetTypes[0] == eSCI_DTYPE_UINT8 &&
+          sFcnAll.peRetTypes[TEST_NUM_TYPES - 1] == eSCI_DTYPE_F32 && !sFcnAll.bRequestsUpstream);
+    Check("descriptor SCI_NO_TYPES", sFcnNoArgs.peArgTypes == NULL && sFcnNoArgs.ui8ArgCnt == 0 && sFcnNoArgs.ui8RetCnt == 1);
+    Check("descriptor SCI_UPSTREAM_FUNCTION", sFcnUps.ui8ArgCnt == 2 && sFcnUps.peArgTypes[1] == eSCI_DTYPE_F32 &&
+          sFcnUps.peRetTypes == NULL && sFcnUps.ui8RetCnt == 0 && sFcnUps.bRequestsUpstream);
+}
 
-    tuREQUESTVALUE uVal[3] = {{.ui32_hex = 3}, {.f_float = 2.0}, {.ui32_hex = 255}};
-    // Init Master
-    SCIMasterInit(sCbs);
+//=============================================================================
+static void TestTypedRequests (teSCI_VALUE_MODE eValueMode)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    bool bHex = eValueMode == eSCI_VALUE_MODE_HEX;
+    const char *pcMode = bHex ? "HEX" : "FLOAT";
+    char cName[64];
+    char cRsp[RX_PACKET_LENGTH];
+    tuTEST_VALUE uResults[TEST_NUM_TYPES];
+    void *pvResults[TEST_NUM_TYPES];
+    const void *pvArgs[1];
+    int16_t i16Arg = -7;
+    bool bPassed;
 
-    // Get variable 1
-    //SCIRequestGetVar(1);
-    SCIRequestCommand(255, uVal, 3);
+    sCbs.CommandExternalCB = TestCommandCB;
+    Init(sCbs, eValueMode);
 
-    for (uint16_t i = 0; i<256; i++)
-        SCIMasterSM();
-    
-    dummySlave();
+    for (uint8_t i = 0; i < TEST_NUM_TYPES; i++)
+    {
+        const tsTEST_TYPED_VALUE *psValue = &sTypedValues[i];
+        tuTEST_VALUE uResult;
 
-    for (uint8_t i = 0; i<255; i++)
-        SCIMasterSM();
-    
-    dummySlave();
+        // GETVAR: Decoded into the storage of the datatype only
+        memset(&uResult, 0xA5, sizeof(uResult));
+        snprintf(cRsp, sizeof(cRsp), "%d?ACK;%s", psValue->psVar->i16Num, bHex ? psValue->pcHex : psValue->pcFloat);
+        bPassed = SCIRequestGetVarTyped(psValue->psVar, &uResult) && Respond(cRsp) &&
+                  memcmp(&uResult, &psValue->uExpected, psValue->ui8Size) == 0;
 
-    for (uint8_t i = 0; i<255; i++)
-        SCIMasterSM();
-    
-    dummySlave();
+        if (psValue->ui8Size < sizeof(uResult))
+            bPassed = bPassed && ((uint8_t*)&uResult)[psValue->ui8Size] == 0xA5;
 
-    for (uint8_t i = 0; i<255; i++)
-        SCIMasterSM();
-    
-    dummySlave();
+        snprintf(cName, sizeof(cName), "GETVAR typed %s (%s)", psValue->pcFloat, pcMode);
+        Check(cName, bPassed);
 
-    for (uint8_t i = 0; i<255; i++)
-        SCIMasterSM();
-    
-    dummySlave();
+        // SETVAR: Encoded from the storage of the datatype
+        snprintf(cRsp, sizeof(cRsp), "%d!ACK", psValue->psVar->i16Num);
+        bPassed = SCIRequestSetVarTyped(psValue->psVar, &psValue->uExpected) && Respond(cRsp) &&
+                  TxDataIs(bHex ? psValue->pcHex : psValue->pcFloat);
+        snprintf(cName, sizeof(cName), "SETVAR typed %s (%s)", psValue->pcFloat, pcMode);
+        Check(cName, bPassed);
+    }
 
-    for (uint8_t i = 0; i<255; i++)
-        SCIMasterSM();
-    
-    dummySlave();
+    // COMMAND: Results of every datatype in two frames
+    for (uint8_t i = 0; i < TEST_NUM_TYPES; i++)
+        pvResults[i] = &uResults[i];
 
-    for (uint8_t i = 0; i<255; i++)
-        SCIMasterSM();
-}
\ No newline at end of file
+    memset(uResults, 0, sizeof(uResults));
+    pvArgs[0] = &i16Arg;
+
+    snprintf(cRsp, sizeof(cRsp), "8:DAT;7;%s,%s,%s,%s", bHex ? sTypedValues[0].pcHex : sTypedValues[0].pcFloat,
+             bHex ? sTypedValues[1].pcHex : sTypedValues[1].pcFloat, bHex ? sTypedValues[2].pcHex : sTypedValues[2].pcFloat,
+             bHex ? sTypedValues[3].pcHex : sTypedValues[3].pcFloat);
+    bPassed = SCIRequestCommandTyped(&sFcnAll, pvArgs, pvResults) && Respond(cRsp);
+
+    snprintf(cRsp, sizeof(cRsp), "8:%s,%s,%s", bHex ? sTypedValues[4].pcHex : sTypedValues[4].pcFloat,
+             bHex ? sTypedValues[5].pcHex : sTypedValues[5].pcFloat, bHex ? sTypedValues[6].pcHex : sTypedValues[6].pcFloat);
+    bPassed = bPassed && Respond(cRsp) && SCIGetProtocolState() == ePROTOCOL_IDLE && eLastAck == eREQUEST_ACK_STATUS_SUCCESS_DATA;
+
+    for (uint8_t i = 0; i < TEST_NUM_TYPES; i++)
+        bPassed = bPassed && memcmp(&uResults[i], &sTypedValues[i].uExpected, sTypedValues[i].ui8Size) == 0;
+
+    snprintf(cName, sizeof(cName), "COMMAND typed, all datatypes (%s)", pcMode);
+    Check(cName, bPassed);
+
+    // COMMAND: Fewer results than return types
+    bPassed = SCIRequestCommandTyped(&sFcnAll, pvArgs, pvResults) && Respond("8:DAT;3;1,2,3") &&
+              SCIGetProtocolState() == ePROTOCOL_IDLE;
+    snprintf(cName, sizeof(cName), "COMMAND typed, result count mismatch (%s)", pcMode);
+    Check(cName, bPassed && eLastAck == eREQUEST_ACK_STATUS_ERROR && ui16LastErrNum == eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET);
+}
+
+//=============================================================================
+static void TestCommandOverrun (void)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    bool bPassed;
+
+    sCbs.CommandExternalCB = TestCommandCB;
+    Init(sCbs, eSCI_VALUE_MODE_HEX);
+
+    // More values than announced in the first frame
+    bPassed = SCIRequestCommand(8, NULL, 0) && Respond("8:DAT;2;1,2,3") && SCIGetProtocolState() == ePROTOCOL_IDLE;
+    Check("COMMAND overrun in the first frame", bPassed && eLastAck == eREQUEST_ACK_STATUS_ERROR &&
+          ui16LastErrNum == eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET);
+
+    // More values than announced in a later frame
+    bPassed = SCIRequestCommand(8, NULL, 0) && Respond("8:DAT;3;1,2") && Respond("8:3,4") &&
+              SCIGetProtocolState() == ePROTOCOL_IDLE;
+    Check("COMMAND overrun in a later frame", bPassed && eLastAck == eREQUEST_ACK_STATUS_ERROR &&
+          ui16LastErrNum == eSCI_ERROR_EXPECTED_DATALENGTH_NOT_MET);
+
+    // The next transfer starts over
+    bPassed = SCIRequestCommand(8, NULL, 0) && Respond("8:DAT;2;1,2") && SCIGetProtocolState() == ePROTOCOL_IDLE;
+    Check("COMMAND after an overrun", bPassed && eLastAck == eREQUEST_ACK_STATUS_SUCCESS_DATA && ui32LastDataCnt == 2);
+}
+
+//=============================================================================
+int main (void)
+{
+    TestSetVarResult();
+    TestDescriptors();
+    TestTypedRequests(eSCI_VALUE_MODE_HEX);
+    TestTypedRequests(eSCI_VALUE_MODE_FLOAT);
+    TestCommandOverrun();
+
+    printf("%u checks failed\n", ui32Failed);
+
+    return ui32Failed > 0;
+}
@@ -9,6 +9,6 @@
 /******************************************************************************
  * Function declarations
  *****************************************************************************/
-void main(void);
+int main(void);
 
 #endif // _TESTSCIMASTER_H_
\ No newline at end of file
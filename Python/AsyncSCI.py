@@ -0,0 +1,522 @@
+"""
+asyncio driver for the Serial Communication Interface
+
+Same requests and frame format as SCI, but all methods are coroutines and any number of
+callers may await results concurrently over the one serialized link. A reader registered
+with the event loop parses the received frames continuously and resolves the requests in
+the order they were sent. The next frame of a transfer (COMMAND results, upstream chunks)
+is requested as soon as the previous one arrived instead of after a fixed sleep.
+
+Flow control:
+- pipelineDepth limits the requests on the way (1: every request waits for the previous
+  response). Deeper pipelines need a device that buffers requests while it answers.
+- Multi-frame transfers (command, requestUpstream) run one at a time, single GETVAR /
+  SETVAR requests of other callers may go in between their frames.
+- Upstream chunks are requested up to pipelineDepth ahead.
+
+POSIX ports only (the reader watches the file descriptor of the port).
+
+Usage:
+    sci = await AsyncSCI.open('/dev/ttyUSB0', pipelineDepth = 2)
+    values = await asyncio.gather(*(sci.getvalue(var) for var in variables))
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+- Upstream chunks checked for STX / ETX before they are copied, 18.10.2026
+- Responses matched by their number, 18.10.2026
+- COMMAND results and FLOAT values decoded by the precompiled codecs, 18.10.2026
+"""
+
+import asyncio
+import collections
+import os
+import serial
+import time
+from typing import *
+from SCI import *
+from SCIMetrics import Metrics
+
+
+class _PendingRequest:
+    """
+    Request on the way: Resolved by the reader with the response frame or the number of bytes received into its buffer
+    """
+
+    def __init__(self, cmdID : CommandID, number : Optional[int], into : Optional[memoryview], bytesOut : int, future : asyncio.Future):
+        self.cmdID      : CommandID             = cmdID
+        self.number     : Optional[int]         = number    # Number the response must carry (not checked if None)
+        self.into       : Optional[memoryview]  = into      # Raw frame data of known length (frame up to ETX if None)
+        self.size       : Optional[int]         = None if into is None else len(into) + 2
+        self.bytesOut   : int               = bytesOut
+        self.future     : asyncio.Future    = future
+        self.start      : float             = time.perf_counter()
+        self.sent       : float             = self.start
+
+
+class AsyncSCI(SCI):
+    READ_CHUNK  = 4096
+
+    #==============================================================================
+    def __init__(self, port : str, maxPacketSize : Optional[int] = None, baud : int = 115200, timeout : float = 5, numberFormat : Optional[NumberFormat] = None, pipelineDepth : int = 1):
+        """
+        Opens the port without talking to the device (see AsyncSCI.open). Must be called within the event loop.
+
+        Parameters:
+        -----------
+        - port              : Serial port of the device
+        - maxPacketSize     : Upper limit of the frame payload length (Determined by the handshake if omitted)
+        - baud              : Baudrate
+        - timeout           : Response timeout
+        - numberFormat      : Number format to use (The fastest one supported by both sides if omitted)
+        - pipelineDepth     : Maximum number of requests on the way
+        """
+
+        self.metrics        = Metrics(cmdID.name for cmdID in CommandID if cmdID != CommandID.REJECTED)
+        self.timeout        = timeout
+        self.pipelineDepth  = pipelineDepth
+        self.pending        : Deque[_PendingRequest] = collections.deque()
+        self.rxBuffer       = bytearray()
+        self.window         = asyncio.Semaphore(pipelineDepth)
+        self.transferLock   = asyncio.Lock()
+        self.loop           = asyncio.get_running_loop()
+
+        self.ownCapabilities = Capabilities(self.PROTOCOL_VERSION,
+                                            maxPacketSize or self.MAX_PACKET_SIZE,
+                                            maxPacketSize or self.MAX_PACKET_SIZE,
+                                            [numberFormat] if numberFormat is not None else list(NumberFormat),
+                                            Feature.UPSTREAM | Feature.SETVAR_BATCH)
+
+        # Settings until the handshake took place
+        self.capabilities   = None
+        self.numberFormat   = numberFormat or NumberFormat.HEX
+        self.rxPacketSize   = self.ownCapabilities.rxPacketSize
+        self.txPacketSize   = self.ownCapabilities.txPacketSize
+
+        self.device = serial.Serial(port=port, baudrate=baud, timeout=0)
+        self.loop.add_reader(self.device.fileno(), self._onReadable)
+
+    #==============================================================================
+    @classmethod
+    async def open(cls, port : str, maxPacketSize : Optional[int] = None, baud : int = 115200, timeout : float = 5, numberFormat : Optional[NumberFormat] = None, handshakeTimeout : float = 3, pipelineDepth : int = 1) -> 'AsyncSCI':
+        """
+        Opens the port and negotiates the communication settings with the device (parameters see SCI and __init__).
+        """
+
+        sci = cls(port, maxPacketSize, baud, timeout, numberFormat, pipelineDepth)
+
+        try:
+            sci.capabilities = await sci.handshake(handshakeTimeout)
+        except BaseException:
+            sci.close()
+            raise
+
+        if sci.capabilities is None:
+            if maxPacketSize is None:
+                sci.close()
+                raise Exception('HANDSHAKE - No response from the device and no maxPacketSize given.')
+
+            sci.capabilities = Capabilities(0, maxPacketSize, maxPacketSize, [numberFormat or NumberFormat.HEX], Feature.UPSTREAM)
+
+        sci.numberFormat = sci.capabilities.numberFormats[0]
+        sci.rxPacketSize = sci.capabilities.rxPacketSize
+        sci.txPacketSize = sci.capabilities.txPacketSize
+
+        return sci
+
+    #==============================================================================
+    def close(self):
+        """
+        Stops the reader, fails the requests on the way and closes the port.
+        """
+
+        if self.device.is_open:
+            self.loop.remove_reader(self.device.fileno())
+            self.device.close()
+
+        self._failPending(ConnectionError('Port closed'))
+
+    #==============================================================================
+    async def __aenter__(self) -> 'AsyncSCI':
+        return self
+
+    #==============================================================================
+    async def __aexit__(self, *args):
+        self.close()
+
+    #==============================================================================
+    def _failPending(self, error : Exception):
+        while self.pending:
+            request = self.pending.popleft()
+            self.window.release()
+
+            if not request.future.done():
+                request.future.set_exception(error)
+
+    #==============================================================================
+    def _onReadable(self):
+        """
+        Reader callback of the event loop: Collects the received bytes and resolves the requests.
+        """
+
+        try:
+            data = os.read(self.device.fileno(), self.READ_CHUNK)
+        except BlockingIOError:
+            return
+        except OSError as e:
+            self.loop.remove_reader(self.device.fileno())
+            self._failPending(e)
+            return
+
+        self.rxBuffer += data
+        buf = self.rxBuffer
+
+        while self.pending:
+            request = self.pending[0]
+
+            if request.size is not None:
+                if len(buf) < request.size:
+                    return
+
+                # No raw frame of the requested size (ERR / NAK response, late frame): The request
+                # fails and the frame is scanned up to ETX like a response frame
+                if buf[0] != self.STX or buf[request.size - 1] != self.ETX:
+                    self._failRawFrame(request)
+                    continue
+
+                # Frame data straight into the buffer of the request (STX / ETX skipped)
+                with memoryview(buf) as received, received[1 : request.size - 1] as data:
+                    request.into[:] = data
+
+                frame = request.size
+                del buf[:request.size]
+            else:
+                stx = buf.find(self.STX)
+
+                if stx < 0:
+                    buf.clear()
+                    return
+
+                etx = buf.find(self.ETX, stx)
+
+                if etx < 0:
+                    del buf[:stx]
+                    return
+
+                frame = bytes(buf[stx : etx + 1])
+                del buf[:etx + 1]
+
+                # Foreign or late frames (e.g. the response of a timed out request) are dropped
+                if not self._isResponse(request, frame):
+                    continue
+
+            self.pending.popleft()
+            self.window.release()
+            self.metrics.exchange(request.cmdID.name, request.start, request.sent, time.perf_counter(), request.bytesOut, request.size or len(frame), True)
+
+            if not request.future.done():
+                request.future.set_result(frame)
+
+        # Nothing requested
+        buf.clear()
+
+    #==============================================================================
+    def _isResponse(self, request : _PendingRequest, frame : bytes) -> bool:
+        """
+        Checks the command identifier and the number of a response frame (STX -> ETX) against the request.
+        """
+
+        idPos = frame.find(request.cmdID.value.encode())
+
+        if idPos < 0:
+            return False
+
+        if request.number is None:
+            return True
+
+        try:
+            if self.numberFormat == NumberFormat.HEX:
+                number = int(frame[1 : idPos], 16)
+            else:
+                number = int(float(frame[1 : idPos]) + 0.5)
+        except ValueError:
+            return False
+
+        return number == request.number
+
+    #==============================================================================
+    def _failRawFrame(self, request : _PendingRequest):
+        """
+        Fails the raw frame request at the head of the pipeline and drops the received frame up to ETX.
+        """
+
+        buf = self.rxBuffer
+        stx = buf.find(self.STX)
+        etx = buf.find(self.ETX, max(stx, 0))
+        error = self._upstreamError(bytes(buf[:etx + 1]) if etx >= 0 else bytes(buf))
+
+        # Without ETX, all received bytes are dropped
+        if etx >= 0:
+            del buf[:etx + 1]
+        else:
+            buf.clear()
+
+        self.pending.popleft()
+        self.window.release()
+        self.metrics.exchange(request.cmdID.name, request.start, request.sent, time.perf_counter(), request.bytesOut, 0, False)
+
+        if not request.future.done():
+            request.future.set_exception(error)
+
+    #==============================================================================
+    async def _exchange(self, cmdID : CommandID, packet : bytearray, into : Optional[memoryview] = None, checkSize : bool = True, timeout : Optional[float] = None, number : Optional[int] = None) -> Union[bytes, int]:
+        """
+        Sends a request as soon as the pipeline has room and waits for its response.
+
+        Parameters:
+        -----------
+        - cmdID     : Command identifier of the request
+        - packet    : Request frame content (without STX / ETX)
+        - into      : Buffer for the data of a raw response frame (frame up to ETX if omitted)
+        - checkSize : Check the packet against the TX packet size
+        - timeout   : Response timeout (self.timeout if omitted)
+        - number    : Variable / command number of the response (frames of other numbers are dropped, not checked if omitted)
+
+        Returns:
+        --------
+        - Response frame or number of received frame bytes if read into a buffer (empty / 0 on timeout)
+        """
+
+        if checkSize and len(packet) > self.txPacketSize:
+            raise Exception(f'Size of packet too big: Packet size: {len(packet)}; Max size: {self.txPacketSize}.')
+
+        await self.window.acquire()
+
+        request = _PendingRequest(cmdID, number, into, len(packet) + 2, self.loop.create_future())
+        self.pending.append(request)
+        self.device.write(bytes([self.STX]) + packet + bytes([self.ETX]))
+        request.sent = time.perf_counter()
+
+        try:
+            return await asyncio.wait_for(asyncio.shield(request.future), timeout or self.timeout)
+        except asyncio.TimeoutError:
+            self._abandon(request)
+            self.metrics.exchange(cmdID.name, request.start, request.sent, time.perf_counter(), request.bytesOut, 0, False)
+
+            return b''
+        except asyncio.CancelledError:
+            self._abandon(request)
+            raise
+
+    #==============================================================================
+    def _abandon(self, request : _PendingRequest):
+        """
+        Gives up a request without response: The link is out of sync, later frames are matched by their command identifier and number.
+        """
+
+        if request in self.pending:
+            self.pending.remove(request)
+            self.window.release()
+
+        self.rxBuffer.clear()
+
+    #==============================================================================
+    async def handshake(self, handshakeTimeout : float) -> Optional[Capabilities]:
+        """
+        Exchanges the capabilities with the device, repeated until the device answers (see SCI.handshake).
+        """
+
+        deadline = time.monotonic() + handshakeTimeout
+        attempts = 0
+
+        async with self.transferLock:
+            while time.monotonic() < deadline:
+                if attempts > 0:
+                    self.metrics.retry(CommandID.HANDSHAKE.name)
+
+                attempts += 1
+
+                # Discard anything the device sent during its startup
+                self.device.reset_input_buffer()
+                self.rxBuffer.clear()
+                response = await self._exchange(CommandID.HANDSHAKE, self._handshakePacket(), checkSize = False, timeout = self.HANDSHAKE_RETRY_TIME)
+
+                if self._isHandshakeResponse(response):
+                    return self._handshakeResult(response)
+
+        return None
+
+    #==============================================================================
+    async def command(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> Union[List[Union[float, int]], int]:
+        """
+        Send a command to the SCI device (see SCI.command).
+        """
+
+        async with self.transferLock:
+            return await self._command(function, paramList)
+
+    #==============================================================================
+    async def _command(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> Union[List[Union[float, int]], int]:
+
+        if paramList is not None:
+            if len(paramList) != len(function.argTypeList):
+                raise Exception('Length of parameter list does not match the length of the type specifier list.')
+
+        packet = function.codec.encode(self.numberFormat, CommandID.COMMAND, paramList)
+        ongoing = False
+        data = []
+
+        while True:
+            response = await self._exchange(CommandID.COMMAND, packet, number = function.number)
+
+            if len(response) == 0:
+                raise Exception('COMMAND - Timeout occured')
+
+            if not ongoing and self._decodeAck(function.codec, CommandID.COMMAND, response) is not None:
+                break
+
+            values = self._decodeResult(function, response, ongoing)
+
+            if values is None:
+                rsp = self._decode(bytearray(response), CommandID.COMMAND, ongoing)
+
+                if rsp.acknowledge == 'ACK':
+                    break
+                elif rsp.acknowledge == 'UPS':
+                    return rsp.dataLength
+                elif rsp.acknowledge == 'ERR':
+                    raise Exception(f'COMMAND - Error: {rsp.dataArray[0]}')
+                elif rsp.acknowledge == 'NAK':
+                    raise Exception('COMMAND - Unknown Command')
+
+                values = rsp.dataArray
+
+            # The next result frame is requested right away
+            data.extend(values)
+            ongoing = True
+
+            if len(data) >= len(function.returnTypeList):
+                break
+
+        return self._convertResults(data, function)
+
+    #==============================================================================
+    async def setvalue(self, variable : Variable, value : Union[float, int]):
+        """
+        Sets a variable of the variable struct
+        """
+
+        response = await self._exchange(CommandID.SETVAR, variable.codec.encode(self.numberFormat, CommandID.SETVAR, [value]), number = variable.number)
+
+        if len(response) == 0:
+            raise Exception('SETVALUE - Timeout occured')
+
+        if self._decodeAck(variable.codec, CommandID.SETVAR, response) is not None:
+            return
+
+        rsp = self._decode(bytearray(response), CommandID.SETVAR)
+
+        if rsp.acknowledge == 'ERR':
+            raise Exception(f'SETVALUE - Error: {rsp.dataArray[0]}')
+        elif rsp.acknowledge == 'NAK':
+            raise Exception('SETVALUE - Variable unknown')
+
+    #==============================================================================
+    async def setvalues(self, writes : Sequence[Tuple[Variable, Union[float, int]]]):
+        """
+        Sets several variables within one SETVAR batch frame (see SCI.setvalues).
+        """
+
+        if len(writes) == 1:
+            try:
+                return await self.setvalue(*writes[0])
+            except Exception as e:
+                raise BatchWriteError(writes[0][0].number, str(e))
+
+        if not (self.capabilities.features & Feature.SETVAR_BATCH):
+            raise Exception('SETVALUES - Batch frames are not supported by the device')
+
+        cmd = Command()
+        cmd.number          = writes[0][0].number
+        cmd.commandID       = CommandID.SETVAR
+        cmd.dataArray       = [writes[0][1]]
+        cmd.datatypeArray   = [writes[0][0].type]
+
+        for variable, value in writes[1:]:
+            cmd.dataArray       += [variable.number, value]
+            cmd.datatypeArray   += [Datatype.DTYPE_INT16, variable.type]
+
+        response = await self._exchange(cmd.commandID, self._encode(cmd))
+
+        if len(response) == 0:
+            raise Exception('SETVALUES - Timeout occured')
+        rsp = self._decode(bytearray(response), cmd.commandID)
+
+        if rsp.acknowledge == 'ERR':
+            raise BatchWriteError(rsp.number, f'SETVALUES - Error at variable {rsp.number}: {rsp.dataArray[0]}')
+        elif rsp.acknowledge == 'NAK':
+            raise BatchWriteError(rsp.number, f'SETVALUES - Variable {rsp.number} unknown')
+
+    #==============================================================================
+    async def getvalue(self, variable : Variable) -> Union[float, int]:
+        """
+        Requests a variable value from the variable struct.
+        """
+
+        response = await self._exchange(CommandID.GETVAR, variable.codec.encode(self.numberFormat, CommandID.GETVAR), number = variable.number)
+
+        if len(response) == 0:
+            raise Exception('GETVALUE - Timeout occured')
+
+        value = self._decodeValue(variable, response)
+
+        if value is not None:
+            return value
+
+        rsp = self._decode(bytearray(response), CommandID.GETVAR)
+
+        if rsp.acknowledge == 'ACK':
+            return variable.codec.convert(rsp.dataArray, self.numberFormat)[0]
+        elif rsp.acknowledge == 'ERR':
+            raise Exception(f'GETVALUE - Error: {rsp.dataArray[0]}')
+        elif rsp.acknowledge == 'NAK':
+            raise Exception('GETVALUE - Variable unknown')
+
+    #==============================================================================
+    async def requestUpstream(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None, buffer : Optional[Any] = None) -> Union[bytearray, memoryview]:
+        """
+        Upstream request: The chunks are requested up to pipelineDepth ahead and copied from the
+        receive buffer to their position of the upstream buffer (see SCI.requestUpstream).
+
+        Returns:
+        --------
+        - bytearray holding the upstream data (own buffer) or a memoryview of the upstream data within buffer
+        """
+
+        packet = function.codec.encode(self.numberFormat, CommandID.UPSTREAM)
+        inflight : Deque[asyncio.Task] = collections.deque()
+
+        async with self.transferLock:
+            upstreamSize = await self._command(function, paramList)
+            data = bytearray(upstreamSize) if buffer is None else buffer
+            view = memoryview(data).cast('B')
+            requested = 0
+
+            if view.nbytes < upstreamSize:
+                raise ValueError(f'UPSTREAM REQUEST - Buffer too small: Buffer size: {view.nbytes}; Upstream size: {upstreamSize}.')
+
+            try:
+                while requested < upstreamSize or inflight:
+                    # Requests are sent in the order of the tasks
+                    while requested < upstreamSize and len(inflight) < self.pipelineDepth:
+                        chunk = min(self.rxPacketSize, upstreamSize - requested)
+                        inflight.append(asyncio.ensure_future(self._exchange(CommandID.UPSTREAM, packet, into = view[requested : requested + chunk])))
+                        requested += chunk
+
+                    if not await inflight.popleft():
+                        raise Exception('UPSTREAM REQUEST - Timeout occured')
+            finally:
+                for task in inflight:
+                    task.cancel()
+
+        return data if buffer is None else view[:upstreamSize]
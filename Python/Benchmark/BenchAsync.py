@@ -0,0 +1,143 @@
+"""
+SCI (blocking, fixed sleeps between frames) against AsyncSCI (response driven, pipelined)
+on the simulated slave on a pseudo terminal (C/Benchmark/PtySlave.c).
+
+- Upstream of 64 KiB in small frames (128 bytes)
+- GETVAR requests of several concurrent callers (coroutines / threads)
+
+Beforehand, a scripted device on a second pseudo terminal checks that the late reply to a
+timed out GETVAR does not resolve the GETVAR of another variable (both number formats).
+
+Usage:
+    python3 BenchAsync.py <PtySlave binary> [requests]
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+- Late reply checked in the FLOAT format, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import asyncio
+import subprocess
+import threading
+import time
+from SCI import *
+from AsyncSCI import AsyncSCI
+
+PACKET_LENGTH   = 128
+CALLERS         = 8
+
+fcn1 = Function(1, requestsUpstream = True)
+fcn2 = Function(2, argTypeList=[Datatype.DTYPE_UINT16], returnTypeList=[Datatype.DTYPE_UINT32]*10)
+variables = [Variable(num, Datatype.DTYPE_UINT16) for num in range(1, CALLERS + 1)]
+
+
+#==============================================================================
+def report(name : str, count : int, seconds : float, unit : str = 'req/s'):
+    print(f'  {name:<32} {count / seconds:10.0f} {unit}')
+
+
+#==============================================================================
+async def checkLateReply(numberFormat : NumberFormat):
+    master, slave = os.openpty()
+    os.set_blocking(master, False)
+    sci = AsyncSCI(os.ttyname(slave), maxPacketSize = PACKET_LENGTH, timeout = 0.2, numberFormat = numberFormat)
+    late, value = (b'1?ACK;1234', b'2?ACK;2') if numberFormat == NumberFormat.HEX else (b'1?ACK;4660', b'2?ACK;2')
+
+    try:
+        # No answer: Times out
+        try:
+            await sci.getvalue(variables[0])
+            raise AssertionError('late reply: GETVAR answered without response')
+        except Exception as e:
+            assert 'Timeout' in str(e), e
+
+        # The reply to the timed out request arrives ahead of the one to the next request
+        request = asyncio.ensure_future(sci.getvalue(variables[1]))
+        await asyncio.sleep(0.05)
+        os.write(master, bytes([SCI.STX]) + late + bytes([SCI.ETX]) + bytes([SCI.STX]) + value + bytes([SCI.ETX]))
+        result = await request
+        assert result == 2, f'late reply ({numberFormat.name}): {result} instead of 2'
+    finally:
+        sci.close()
+        os.close(master)
+        os.close(slave)
+
+    print(f'late reply ({numberFormat.name}): dropped')
+
+
+#==============================================================================
+def benchBlocking(port : str, count : int):
+    print('SCI (blocking)')
+    sci = SCI(port, baud = 2000000)
+
+    start = time.perf_counter()
+    upstream = sci.requestUpstream(fcn1)
+    report('upstream', len(upstream) / 1024, time.perf_counter() - start, 'KiB/s')
+
+    def caller(variable : Variable):
+        for _ in range(count // CALLERS):
+            assert sci.getvalue(variable) == variable.number
+
+    threads = [threading.Thread(target = caller, args = (variable,)) for variable in variables]
+    start = time.perf_counter()
+
+    for thread in threads:
+        thread.start()
+
+    for thread in threads:
+        thread.join()
+
+    report(f'getvalue ({CALLERS} threads)', count, time.perf_counter() - start)
+    sci.device.close()
+
+
+#==============================================================================
+async def benchAsync(port : str, count : int, pipelineDepth : int):
+    print(f'AsyncSCI (pipeline depth {pipelineDepth})')
+
+    async with await AsyncSCI.open(port, baud = 2000000, pipelineDepth = pipelineDepth) as sci:
+        start = time.perf_counter()
+        upstream = await sci.requestUpstream(fcn1)
+        report('upstream', len(upstream) / 1024, time.perf_counter() - start, 'KiB/s')
+        assert len(upstream) == 65536 and all(upstream[i] == ((i * 0x9E3779B1) & 0xFFFFFFFF) >> 24 for i in range(0, 65536, 997))
+
+        async def caller(variable : Variable):
+            for _ in range(count // CALLERS):
+                assert await sci.getvalue(variable) == variable.number
+
+        start = time.perf_counter()
+        await asyncio.gather(*(caller(variable) for variable in variables))
+        report(f'getvalue ({CALLERS} coroutines)', count, time.perf_counter() - start)
+
+        # Requests of other callers go in between the frames of a transfer
+        results = await asyncio.gather(sci.command(fcn2, [1]), sci.getvalue(variables[0]), sci.requestUpstream(fcn1), sci.setvalue(variables[1], 7))
+        assert results[0] == list(range(1, 11)) and results[1] == 1 and len(results[2]) == 65536
+        assert await sci.getvalue(variables[1]) == 7
+        await sci.setvalue(variables[1], 2)
+
+
+#==============================================================================
+def main():
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 2000
+
+    for numberFormat in NumberFormat:
+        asyncio.run(checkLateReply(numberFormat))
+
+    slave = subprocess.Popen([sys.argv[1], str(PACKET_LENGTH)], stdout = subprocess.PIPE, text = True)
+    port = slave.stdout.readline().strip()
+
+    try:
+        benchBlocking(port, count)
+
+        for pipelineDepth in (1, 4):
+            asyncio.run(benchAsync(port, count, pipelineDepth))
+    finally:
+        slave.terminate()
+
+
+if __name__ == '__main__':
+    main()
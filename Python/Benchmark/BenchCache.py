@@ -0,0 +1,123 @@
+"""
+SCICache against a stub of the SCI driver (GETVAR round trip of 1 ms, values held by the stub).
+
+- Several threads read a few hot variables every 0.5 ms with a maximum age of 5 ms: Hits,
+  reads merged into a GETVAR in flight and GETVARs on the link are reported, every value is
+  checked.
+- A read overlapping a setvalue of the same variable returns the former value, but must not
+  be served from the cache afterwards.
+
+Usage:
+    python3 BenchCache.py [reads per thread]
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import threading
+import time
+from SCI import *
+from SCICache import SCICache
+
+ROUND_TRIP  = 0.001
+THREADS     = 8
+MAX_AGE     = 0.005
+READ_PERIOD = 0.0005
+
+variables = [Variable(num, Datatype.DTYPE_UINT16) for num in range(4)]
+
+
+class StubSCI:
+    """
+    Device stub: GETVAR returns the value the device held when the request arrived.
+    """
+
+    def __init__(self):
+        self.values     = {variable.number : variable.number for variable in variables}
+        self.getvalues  = 0
+        # Set: GETVARs wait for it after sampling the value (request on the way)
+        self.hold       = threading.Event()
+        self.sampled    = threading.Event()
+        self.hold.set()
+
+    def getvalue(self, variable : Variable):
+        value = self.values[variable.number]
+        self.getvalues += 1
+        self.sampled.set()
+        self.hold.wait()
+        time.sleep(ROUND_TRIP)
+        return value
+
+    def setvalue(self, variable : Variable, value):
+        time.sleep(ROUND_TRIP)
+        self.values[variable.number] = value
+
+
+#==============================================================================
+def benchReads(count : int):
+    sci = StubSCI()
+    cache = SCICache(sci)
+    errors = []
+
+    def reader(index : int):
+        for i in range(count):
+            variable = variables[(index + i) % len(variables)]
+            if cache.getvalue(variable, MAX_AGE) != variable.number:
+                errors.append(variable.number)
+            time.sleep(READ_PERIOD)
+
+    threads = [threading.Thread(target = reader, args = (index,)) for index in range(THREADS)]
+    start = time.perf_counter()
+
+    for thread in threads:
+        thread.start()
+
+    for thread in threads:
+        thread.join()
+
+    seconds = time.perf_counter() - start
+    stats = cache.stats
+
+    print(f'{THREADS} threads x {count} reads in {seconds:.2f} s: {stats.hits} hits, {stats.coalesced} coalesced, '
+          f'{stats.linkReads} link reads (hit rate {stats.hitRate:.2f}, {stats.savedRoundTrips} round trips saved)')
+    assert not errors, f'wrong values of variables {set(errors)}'
+    assert stats.linkReads == sci.getvalues and stats.reads == THREADS * count
+
+
+#==============================================================================
+def checkOverlappingWrite():
+    sci = StubSCI()
+    cache = SCICache(sci)
+    variable = variables[1]
+    result = []
+
+    # The read samples the former value, the write completes before its response arrives
+    sci.hold.clear()
+    sci.sampled.clear()
+    read = threading.Thread(target = lambda : result.append(cache.getvalue(variable, 1.0)))
+    read.start()
+    sci.sampled.wait()
+
+    cache.setvalue(variable, 7)
+    sci.hold.set()
+    read.join()
+
+    assert result == [variable.number], f'overlapping read returned {result}'
+    assert cache.getvalue(variable, 1.0) == 7, 'value of a read overlapping a write served from the cache'
+    print('overlapping write: former value not cached')
+
+
+#==============================================================================
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 500
+
+    checkOverlappingWrite()
+    benchReads(count)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,62 @@
+"""
+Capture file access: Opening a recording and slicing 10 ms out of it (memory-mapped) against
+loading the whole channel. The recording is written with CaptureWriter (3 INT16 channels at
+20 kHz in blocks of 32768 samples, about the drain size of the continuous mode).
+
+Usage:
+    python3 BenchCapture.py <file> [MiB]
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import time
+import numpy as np
+from SCI import *
+from Datalogger import Channel
+from SCICapture import CaptureWriter, CaptureFile
+
+BASE_FREQUENCY  = 20000
+BLOCK_SAMPLES   = 32768
+
+
+#==============================================================================
+def main():
+    path = sys.argv[1]
+    size = (int(sys.argv[2]) if len(sys.argv) > 2 else 256) << 20
+    channels = [Channel(num, Variable(num, Datatype.DTYPE_INT16), 1, BLOCK_SAMPLES, BASE_FREQUENCY) for num in range(1, 4)]
+    block = np.arange(BLOCK_SAMPLES, dtype = '>i2')
+    blocks = size // (3 * block.nbytes)
+
+    with CaptureWriter(path, channels, BASE_FREQUENCY) as writer:
+        for i in range(blocks):
+            for ch in channels:
+                writer.writeBlock(ch.channel, i * BLOCK_SAMPLES, block)
+
+    duration = blocks * BLOCK_SAMPLES / BASE_FREQUENCY
+    print(f'{os.path.getsize(path) >> 20} MiB, {blocks * 3} blocks, {duration / 3600:.2f} h per channel')
+
+    start = time.perf_counter()
+    capture = CaptureFile(path)
+    opened = time.perf_counter()
+    timebase, samples = capture.channels[2].slice(duration / 2, duration / 2 + 0.01)
+    sliced = time.perf_counter()
+    print(f'  open                 {(opened - start) * 1e3:8.2f} ms')
+    print(f'  slice 10 ms          {(sliced - opened) * 1e3:8.2f} ms ({len(samples)} samples)')
+    assert len(samples) == BASE_FREQUENCY // 100 and samples[0] == int(round(timebase[0] * BASE_FREQUENCY)) % BLOCK_SAMPLES
+
+    start = time.perf_counter()
+    full = capture.channels[2].samples()
+    print(f'  load whole channel   {(time.perf_counter() - start) * 1e3:8.2f} ms ({len(full)} samples)')
+
+    del timebase, samples, full
+    capture.close()
+    os.remove(path)
+
+
+if __name__ == '__main__':
+    main()
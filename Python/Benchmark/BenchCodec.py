@@ -0,0 +1,126 @@
+"""
+Encode / decode cost per request: Generic SCI coder (format built per call) against the
+codecs precompiled by Variable and Function. No device needed, the frames are built and
+parsed in memory (HEX number format, the FLOAT format is checked for equal results).
+
+Usage:
+    python3 BenchCodec.py [calls]
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+- COMMAND result frames and the FLOAT format, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import time
+from SCI import *
+from SCIMetrics import Metrics
+
+var1 = Variable(0x12, Datatype.DTYPE_INT32)
+fcn2 = Function(0x2A, argTypeList=[Datatype.DTYPE_UINT16, Datatype.DTYPE_INT32, Datatype.DTYPE_F32, Datatype.DTYPE_INT8],
+                returnTypeList=[Datatype.DTYPE_INT16, Datatype.DTYPE_F32, Datatype.DTYPE_UINT32, Datatype.DTYPE_INT8, Datatype.DTYPE_UINT8]*2)
+args = [0xBEEF, -123456, 1.5, -3]
+results = [0xFFFE, 0x3FC00000, 0xDEADBEEF, 0x80, 0x7F] * 2
+getvarResponse = b'\x0212?ACK;FFFFFF85\x03'
+commandResponse = b'\x022A:DAT;A;' + ','.join(f'{value:X}' for value in results).encode() + b'\x03'
+
+
+#==============================================================================
+def measure(name : str, fcn : Callable, count : int) -> float:
+    start = time.perf_counter()
+
+    for _ in range(count):
+        fcn()
+
+    cost = (time.perf_counter() - start) / count * 1e6
+    print(f'  {name:<32} {cost:8.2f} us/call')
+
+    return cost
+
+
+#==============================================================================
+def generic(sci : SCI, count : int) -> Dict[str, float]:
+    def getvarEncode():
+        cmd = Command()
+        cmd.number      = var1.number
+        cmd.commandID   = CommandID.GETVAR
+        return sci._encode(cmd)
+
+    def getvarDecode():
+        rsp = sci._decode(bytearray(getvarResponse), CommandID.GETVAR)
+        return sci._reinterpretDecodedIntToDtype(rsp.dataArray[0], var1.type)
+
+    def commandEncode():
+        cmd = Command()
+        cmd.number          = fcn2.number
+        cmd.commandID       = CommandID.COMMAND
+        cmd.dataArray       = args
+        cmd.datatypeArray   = fcn2.argTypeList
+        return sci._encode(cmd)
+
+    def commandDecode():
+        return sci._decode(bytearray(commandResponse), CommandID.COMMAND).dataArray
+
+    def resultConversion():
+        return [sci._reinterpretDecodedIntToDtype(dat, type) for dat, type in zip(results, fcn2.returnTypeList)]
+
+    return {
+        'GETVAR encode'     : measure('GETVAR encode', getvarEncode, count),
+        'GETVAR decode'     : measure('GETVAR decode', getvarDecode, count),
+        'COMMAND encode'    : measure('COMMAND encode (4 args)', commandEncode, count),
+        'COMMAND decode'    : measure('COMMAND decode (10 values)', commandDecode, count),
+        'COMMAND results'   : measure('COMMAND results (10 values)', resultConversion, count),
+    }
+
+
+#==============================================================================
+def precompiled(sci : SCI, count : int) -> Dict[str, float]:
+    return {
+        'GETVAR encode'     : measure('GETVAR encode', lambda : var1.codec.encode(sci.numberFormat, CommandID.GETVAR), count),
+        'GETVAR decode'     : measure('GETVAR decode', lambda : sci._decodeValue(var1, getvarResponse), count),
+        'COMMAND encode'    : measure('COMMAND encode (4 args)', lambda : fcn2.codec.encode(sci.numberFormat, CommandID.COMMAND, args), count),
+        'COMMAND decode'    : measure('COMMAND decode (10 values)', lambda : sci._decodeResult(fcn2, commandResponse, False), count),
+        'COMMAND results'   : measure('COMMAND results (10 values)', lambda : sci._convertResults(results, fcn2), count),
+    }
+
+
+#==============================================================================
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+
+    # Coder only: No port, no handshake
+    sci = SCI.__new__(SCI)
+    sci.numberFormat = NumberFormat.HEX
+    sci.metrics = Metrics(cmdID.name for cmdID in CommandID if cmdID != CommandID.REJECTED)
+
+    # Both coders build the same frames and values
+    cmd = Command()
+    cmd.number, cmd.commandID, cmd.dataArray, cmd.datatypeArray = fcn2.number, CommandID.COMMAND, args, fcn2.argTypeList
+    assert sci._encode(cmd) == fcn2.codec.encode(sci.numberFormat, CommandID.COMMAND, args)
+    assert sci._decodeValue(var1, getvarResponse) == -123
+    assert sci._convertResults(results, fcn2) == [sci._reinterpretDecodedIntToDtype(dat, type) for dat, type in zip(results, fcn2.returnTypeList)]
+    assert sci._decodeResult(fcn2, commandResponse, False) == results == sci._decode(bytearray(commandResponse), CommandID.COMMAND).dataArray
+    assert sci._decodeResult(fcn2, b'\x022A:FFFE,7F\x03', True) == [0xFFFE, 0x7F]
+    assert sci._decodeResult(fcn2, b'\x022A:ERR;5\x03', True) is None
+
+    # FLOAT format: Same values from the fast paths
+    sci.numberFormat = NumberFormat.FLOAT
+    assert sci._decodeValue(var1, b'\x0218?ACK;-123\x03') == -123
+    assert sci._convertResults(sci._decodeResult(fcn2, b'\x0242:DAT;10;-2,1.5,3735928559,-128,127\x03', False) * 2, fcn2) == \
+           [-2, 1.5, 0xDEADBEEF, -128, 127] * 2
+    sci.numberFormat = NumberFormat.HEX
+
+    print('Generic coder')
+    old = generic(sci, count)
+    print('Precompiled codecs')
+    new = precompiled(sci, count)
+
+    for name in old:
+        print(f'{name:<16} speedup {old[name] / new[name]:5.1f}x')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,104 @@
+"""
+Datalogger.getData decoding cost: Per sample struct decoding (list per channel) against the
+NumPy views of the upstream buffer. The SCI handle is replaced by a stub answering with a
+prepared upstream of 3 x 2500 INT16 samples, so only the host side decoding is measured.
+
+Usage:
+    python3 BenchDatalogger.py [captures]
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import struct
+import time
+import numpy as np
+from SCI import *
+from Datalogger import Datalogger
+
+REC_LEN         = 2500
+BASE_FREQUENCY  = 20000
+CFG_FILE        = os.path.realpath(os.path.join(os.path.dirname(__file__), '..', 'Tests', 'DataloggerCfg.py'))
+
+
+class StubSCI:
+    """
+    Answers the datalogger requests without device
+    """
+
+    def __init__(self, upstream : bytearray):
+        self.upstream = upstream
+
+    def getvalue(self, variable : Variable) -> int:
+        return BASE_FREQUENCY
+
+    def command(self, function : Function, paramList = None) -> List[int]:
+        return [0] * len(function.returnTypeList)
+
+    def requestUpstream(self, function : Function, paramList = None) -> bytearray:
+        return self.upstream
+
+
+#==============================================================================
+def listDecode(dlog : Datalogger) -> List[List[int]]:
+    """
+    Decoding as done before the NumPy views: Copy and struct decoding per channel, timebase as list
+    """
+
+    data = dlog.sciHdl.requestUpstream(dlog.functions['GetLogData'], [dlog.index])
+    result = []
+    offset = 0
+
+    for ch in dlog.chRegistered:
+        if ch is None:
+            continue
+
+        chDat = data[offset : offset + ch.recLen * ch.variable.type.value[1]].copy()
+        offset += ch.recLen * ch.variable.type.value[1]
+        samples = [dat[0] for dat in struct.iter_unpack(f'>{ch.variable.type.value[0]}', chDat)]
+        timebase = [1/dlog.baseFrequency_Hz * ch.divider * i for i in range(0, len(samples))]
+        result.append((samples, timebase))
+
+    return result
+
+
+#==============================================================================
+def measure(name : str, fcn : Callable, count : int) -> float:
+    start = time.perf_counter()
+
+    for _ in range(count):
+        fcn()
+
+    cost = (time.perf_counter() - start) / count * 1e3
+    print(f'  {name:<28} {cost:8.3f} ms/capture')
+
+    return cost
+
+
+#==============================================================================
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 200
+
+    samples = np.arange(-3 * REC_LEN // 2, 3 * REC_LEN // 2, dtype = '>i2')
+    dlog = Datalogger(StubSCI(bytearray(samples.tobytes())), 0, 15000, CFG_FILE)
+
+    for num in range(1, 4):
+        dlog.register(Variable(num, Datatype.DTYPE_INT16), REC_LEN, num)
+
+    channels = dlog.getData()
+    reference = listDecode(dlog)
+
+    for ch, (refSamples, refTimebase) in zip(channels, reference):
+        assert ch.data == refSamples and np.allclose(ch.timebase, refTimebase)
+
+    old = measure('struct + lists', lambda : listDecode(dlog), count)
+    new = measure('NumPy views', dlog.getData, count)
+    print(f'speedup {old / new:5.0f}x')
+
+
+if __name__ == '__main__':
+    main()
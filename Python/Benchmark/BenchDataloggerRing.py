@@ -0,0 +1,145 @@
+"""
+Continuous datalogger mode against a simulated ring device: The SCI handle is replaced by a
+stub modelling the on-board channel rings (running 32 bit sample counters starting shortly
+before the wrap). startContinuous drains it from the background thread, one drain is forced
+to overrun the rings. The channel stores are checked afterwards (samples, unwrapped indices,
+timebase, the single gap of the overrun), then the host side cost of a drain is measured.
+
+Usage:
+    python3 BenchDataloggerRing.py [drains]
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import time
+import numpy as np
+from SCI import *
+from Datalogger import Datalogger, ChannelStore, DTYPES
+
+REC_LEN         = 4096
+BASE_FREQUENCY  = 20000
+# Base ticks the device runs between two drains (a quarter of the fastest ring)
+DRAIN_TICKS     = REC_LEN // 4
+# Running sample counter of all channels at start: Wraps within the first drains
+INDEX_START     = ChannelStore.INDEX_RANGE - 3 * DRAIN_TICKS
+# Drain running into an overrun, the device runs 1.5 rings of the fastest channel before
+OVERRUN_DRAIN   = 6
+OVERRUN_TICKS   = REC_LEN * 3 // 2
+CHECK_DRAINS    = 20
+SET_OP_MODE_NUM = 15
+CFG_FILE        = os.path.realpath(os.path.join(os.path.dirname(__file__), '..', 'Tests', 'DataloggerCfg.py'))
+
+# Registered channels (variable, divider): The sample values are the low bits of the sample counter
+CHANNELS = [(Variable(1, Datatype.DTYPE_UINT16), 1),
+            (Variable(2, Datatype.DTYPE_INT32), 2),
+            (Variable(3, Datatype.DTYPE_UINT8), 4)]
+
+
+class RingSCI:
+    """
+    Answers the datalogger requests like a device in continuous mode. Every GetLogData request
+    lets the device run DRAIN_TICKS base ticks (OVERRUN_TICKS on the overrun drain) and returns
+    the samples written since the previous request, at most a ring of each channel.
+    """
+
+    def __init__(self, channels : List[Tuple[Variable, int]], recLen : int):
+        self.channels   = channels
+        self.recLen     = recLen
+        self.ticks      = 0
+        self.requests   = 0
+        self.drained    = [INDEX_START] * len(channels)     # Next sample counter to pass per channel
+        self.lost       = [[] for _ in channels]            # (counter of the first lost sample, number of lost samples)
+
+    def getvalue(self, variable : Variable) -> int:
+        return BASE_FREQUENCY
+
+    def command(self, function : Function, paramList = None) -> List[int]:
+        return [0] * len(function.returnTypeList)
+
+    def requestUpstream(self, function : Function, paramList = None) -> bytearray:
+        self.requests += 1
+        self.ticks += OVERRUN_TICKS if self.requests == OVERRUN_DRAIN else DRAIN_TICKS
+
+        data = bytearray()
+
+        for i, (variable, divider) in enumerate(self.channels):
+            written = INDEX_START + self.ticks // divider
+            first = max(self.drained[i], written - self.recLen)
+
+            if first > self.drained[i]:
+                self.lost[i].append((self.drained[i], first - self.drained[i]))
+
+            counters = np.arange(first, written, dtype=np.uint64)
+            samples = (counters & (1 << (8 * variable.type.value[1] - 1)) - 1).astype(DTYPES[variable.type])
+
+            data += Datalogger.CONT_HEADER.pack(first % ChannelStore.INDEX_RANGE, len(counters))
+            data += samples.tobytes()
+            self.drained[i] = written
+
+        return data
+
+
+#==============================================================================
+def check(dlog : Datalogger, stub : RingSCI, stores : Dict[int, ChannelStore]):
+    """
+    Compares the stores with the samples the device wrote (minus the overrun)
+    """
+
+    for i, (ch, (variable, divider)) in enumerate(zip([ch for ch in dlog.chRegistered if ch is not None], stub.channels)):
+        store = stores[ch.channel]
+        indices = np.rint(store.timebase() / store.period_s).astype(np.int64)
+        expected = indices[0] + np.arange(stub.drained[i] - INDEX_START)
+        expected = np.delete(expected, np.concatenate([np.arange(s, s + n) for s, n in stub.lost[i]]) - INDEX_START) if stub.lost[i] else expected
+
+        assert indices[0] == INDEX_START and indices[-1] >= ChannelStore.INDEX_RANGE, f'Channel {ch.channel}: Counter did not wrap'
+        assert np.array_equal(indices, expected), f'Channel {ch.channel}: Sample indices'
+        assert np.array_equal(store.samples(), indices & (1 << (8 * variable.type.value[1] - 1)) - 1), f'Channel {ch.channel}: Samples'
+        assert store.gaps == stub.lost[i], f'Channel {ch.channel}: Gaps {store.gaps} instead of {stub.lost[i]}'
+        assert store.count == len(indices)
+
+        print(f'  channel {ch.channel}: {store.count:6} samples, gaps {store.gaps}')
+
+
+#==============================================================================
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 200
+    stub = RingSCI(CHANNELS, REC_LEN)
+    dlog = Datalogger(stub, 0, REC_LEN * 16, CFG_FILE)
+
+    # The test configuration has no SetOpMode command
+    dlog.functions['SetOpMode'].number = SET_OP_MODE_NUM
+
+    for channel, (variable, divider) in enumerate(CHANNELS, 1):
+        dlog.register(variable, REC_LEN, divider, channel)
+
+    dlog.initializeLogger()
+
+    # Continuous mode drained by the background thread until the overrun and the wrap are through
+    stores = dlog.startContinuous(interval=0.001)
+
+    while stub.requests < CHECK_DRAINS:
+        time.sleep(0.001)
+
+    dlog.stopContinuous()
+
+    assert dlog.drainErrors == 0 and stub.lost[0], 'No overrun forced'
+    print(f'{stub.requests} drains, counters wrapped after {ChannelStore.INDEX_RANGE - INDEX_START} samples')
+    check(dlog, stub, stores)
+
+    # Host side cost of a drain (decoding and storing a quarter ring per channel, the stub included)
+    start = time.perf_counter()
+
+    for _ in range(count):
+        dlog.drain()
+
+    cost = (time.perf_counter() - start) / count * 1e3
+    print(f'  drain {cost:8.3f} ms ({DRAIN_TICKS / BASE_FREQUENCY * 1e3:.1f} ms of data)')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,146 @@
+"""
+Requests per second of SCI (pure Python) and SCINative (C master) against the simulated
+slave on a pseudo terminal (C/Benchmark/PtySlave.c). The slave answers without delay, so
+the host side is measured. Afterwards, upstreams of one thread run concurrently with the
+GETVARs of another, every result must belong to its own request.
+
+Usage:
+    python3 BenchNative.py <PtySlave binary> [requests]
+
+The extension _SCIMaster has to be built into the Python directory (see Python/_SCIMaster.c).
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+- Concurrent upstreams and GETVARs, 18.10.2026
+"""
+
+import sys, os
+sys.path.append(os.path.realpath(os.path.join(os.path.dirname(__file__), '..')))
+
+import subprocess
+import threading
+import time
+from SCI import *
+from SCINative import SCINative
+
+var1 = Variable(1, Datatype.DTYPE_UINT16)
+var2 = Variable(2, Datatype.DTYPE_INT32)
+fcn2 = Function(2, argTypeList=[Datatype.DTYPE_UINT16], returnTypeList=[Datatype.DTYPE_UINT32]*10)
+batch = [(Variable(num, Datatype.DTYPE_UINT32), num * 3) for num in range(1, 6)]
+UPSTREAMS = 100
+
+
+#==============================================================================
+def measure(name : str, fcn : Callable, count : int) -> float:
+    start = time.perf_counter()
+
+    for i in range(count):
+        fcn(i)
+
+    rate = count / (time.perf_counter() - start)
+    print(f'  {name:<28} {rate:10.0f} req/s')
+
+    return rate
+
+
+#==============================================================================
+def bench(sci, count : int) -> Dict[str, float]:
+    return {
+        'getvalue'          : measure('getvalue', lambda i : sci.getvalue(var1), count),
+        'setvalue'          : measure('setvalue', lambda i : sci.setvalue(var2, -i), count),
+        'setvalues (5)'     : measure('setvalues (5 writes)', lambda i : sci.setvalues(batch), count),
+    }
+
+
+#==============================================================================
+def checkConcurrent(sci):
+    """
+    Upstreams of one thread, GETVARs of another in between: No result is taken over by the other thread.
+    """
+
+    errors = []
+    done = threading.Event()
+
+    def upstreams():
+        try:
+            for _ in range(UPSTREAMS):
+                upstream = sci.requestUpstream(Function(1, requestsUpstream = True))
+                if len(upstream) != 65536 or upstream[1] != (0x9E3779B1 >> 24):
+                    errors.append(f'upstream of {len(upstream)} bytes')
+        except Exception as e:
+            errors.append(f'upstream: {e}')
+        finally:
+            done.set()
+
+    thread = threading.Thread(target = upstreams)
+    thread.start()
+    reads = 0
+
+    while not done.is_set():
+        try:
+            if sci.getvalue(Variable(10, Datatype.DTYPE_UINT16)) != 10:
+                errors.append('getvalue')
+        except Exception as e:
+            errors.append(f'getvalue: {e}')
+        reads += 1
+
+    thread.join()
+    print(f'  concurrent: {UPSTREAMS} upstreams, {reads} getvalues, {len(errors)} failed')
+    assert not errors, errors[:5]
+
+
+#==============================================================================
+def main():
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 2000
+    slave = subprocess.Popen([sys.argv[1], '1024'], stdout = subprocess.PIPE, text = True)
+    port = slave.stdout.readline().strip()
+
+    try:
+        print('SCI (Python)')
+        sci = SCI(port, baud = 2000000)
+        python = bench(sci, count)
+        sci.device.close()
+
+        print('SCINative (C master)')
+        sci = SCINative(port, baud = 2000000)
+        native = bench(sci, count)
+
+        # Results of the C master
+        assert sci.getvalue(Variable(10, Datatype.DTYPE_UINT16)) == 10
+        assert sci.getvalue(batch[4][0]) == batch[4][1]
+        sci.setvalue(var2, -5)
+        assert sci.getvalue(var2) == -5
+        assert sci.command(fcn2, [4]) == list(range(1, 11))
+        upstream = sci.requestUpstream(Function(1, requestsUpstream = True))
+        assert len(upstream) == 65536 and upstream[1] == (0x9E3779B1 >> 24)
+
+        # Other threads keep running while the requests wait for the port
+        ticks = 0
+        done = threading.Event()
+
+        def ticker():
+            nonlocal ticks
+            while not done.is_set():
+                ticks += 1
+                time.sleep(0)
+
+        thread = threading.Thread(target = ticker)
+        thread.start()
+        measure('getvalue (busy thread)', lambda i : sci.getvalue(var1), count)
+        done.set()
+        thread.join()
+        print(f'  ticks of the other thread: {ticks}')
+
+        checkConcurrent(sci)
+
+        sci.close()
+
+        for name in python:
+            print(f'{name:<16} speedup {native[name] / python[name]:5.1f}x')
+    finally:
+        slave.terminate()
+
+
+if __name__ == '__main__':
+    main()
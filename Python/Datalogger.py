@@ -4,6 +4,17 @@ Datalogger SCI interface
 History:
 --------
 - Created by Holderried, Roman, 22.08.2022
+- getData decodes into NumPy arrays (views of the upstream buffer), 18.10.2026
+- Continuous mode: On-board ring drained by a background thread into ChannelStores, 18.10.2026
+
+Continuous mode (SetOpMode OP_MODE_CONTINUOUS): The on-board channel buffers (recLen samples
+each) run as rings. GetLogData answers with the samples written since the previous request,
+for every registered channel in ascending order:
+    UINT32 index of the first sample (running sample counter of the channel)
+    UINT16 number of samples
+    samples
+All values big endian. Samples overwritten before they were drained show up as gaps of the
+sample index.
 """
 
 from xmlrpc.client import boolean
@@ -12,22 +23,120 @@ from typing import *
 from Common import Version
 import importlib.util, sys
 import struct
+import threading
+import time
+import numpy as np
+
+# Big endian sample types of the upstream
+DTYPES : Dict[Datatype, np.dtype] = {   Datatype.DTYPE_UINT8    : np.dtype('u1'),
+                                        Datatype.DTYPE_INT8     : np.dtype('i1'),
+                                        Datatype.DTYPE_UINT16   : np.dtype('>u2'),
+                                        Datatype.DTYPE_INT16    : np.dtype('>i2'),
+                                        Datatype.DTYPE_UINT32   : np.dtype('>u4'),
+                                        Datatype.DTYPE_INT32    : np.dtype('>i4'),
+                                        Datatype.DTYPE_F32      : np.dtype('>f4')}
 
 
 class Channel:
 
-    def __init__(self, channel : int, variable : Variable, divider : int, recLen : int):
+    def __init__(self, channel : int, variable : Variable, divider : int, recLen : int, baseFrequency_Hz : int = 0):
         self.channel    : int = channel
         self.variable   : Variable = variable
         self.divider    : int = divider
         self.recLen     : int = recLen
-        self.data       : Union[int, float] = []
+        self.dtype      : np.dtype = DTYPES[variable.type]
+        # Samples of the last capture: View of the upstream buffer
+        self.samples    : np.ndarray = np.empty(0, self.dtype)
+        # Sample times in seconds (computed once at registration)
+        self.timebase   : np.ndarray = np.arange(recLen) * (divider / baseFrequency_Hz) if baseFrequency_Hz > 0 else np.empty(0)
+
+    @property
+    def data(self) -> List[Union[int, float]]:
+        """
+        Samples of the last capture as list (compatibility, use samples)
+        """
+
+        return self.samples.tolist()
+
+
+class ChannelStore:
+    """
+    Unbounded host store of a continuously drained channel. The samples are kept as received
+    chunks (views of the upstream buffers), indices are 64 bit (the 32 bit device counter is unwrapped).
+    """
+
+    INDEX_RANGE = 1 << 32
+
+    def __init__(self, channel : Channel, period_s : float):
+        self.channel        : Channel               = channel
+        self.period_s       : float                 = period_s
+        self.chunks         : List[np.ndarray]      = []
+        self.firstIndices   : List[int]             = []
+        self.nextIndex      : Optional[int]         = None
+        self.count          : int                   = 0
+        self.gaps           : List[Tuple[int, int]] = []    # (index of the first lost sample, number of lost samples)
+        self.lock           : threading.Lock        = threading.Lock()
+
+    def append(self, deviceIndex : int, samples : np.ndarray):
+        """
+        Appends the samples starting at the device sample counter deviceIndex
+        """
+
+        with self.lock:
+            if self.nextIndex is None:
+                firstIndex = deviceIndex
+            else:
+                delta = (deviceIndex - self.nextIndex) % self.INDEX_RANGE
+
+                # Counter behind the expected index: Samples already stored
+                if delta >= self.INDEX_RANGE // 2:
+                    samples = samples[self.INDEX_RANGE - delta:]
+                    delta = 0
+                elif delta > 0:
+                    self.gaps.append((self.nextIndex, delta))
+
+                firstIndex = self.nextIndex + delta
+
+            self.nextIndex = firstIndex + len(samples)
+
+            if len(samples) == 0:
+                return
+
+            self.chunks.append(samples)
+            self.firstIndices.append(firstIndex)
+            self.count += len(samples)
+
+    def samples(self) -> np.ndarray:
+        """
+        All samples received so far (native byte order)
+        """
+
+        with self.lock:
+            chunks = list(self.chunks)
+
+        return np.concatenate(chunks).astype(self.channel.dtype.newbyteorder('=')) if chunks else np.empty(0, self.channel.dtype)
+
+    def timebase(self) -> np.ndarray:
+        """
+        Sample times in seconds since the first sample index of the device (gaps included)
+        """
+
+        with self.lock:
+            ranges = [np.arange(first, first + len(chunk)) for first, chunk in zip(self.firstIndices, self.chunks)]
+
+        return np.concatenate(ranges) * self.period_s if ranges else np.empty(0)
 
 
 class Datalogger:
 
     MAX_NUM_LOGS = 8
 
+    OP_MODE_SINGLE      = 0
+    OP_MODE_CONTINUOUS  = 1
+
+    # First sample index and number of samples in front of every channel (continuous mode)
+    CONT_HEADER = struct.Struct('>LH')
+
     def __init__(self, SCI: SCI, index: int, maxNumBytes : int, cfgFilePath : str):
         """
         Datalogger API initializer
@@ -70,6 +179,13 @@ class Datalogger:
 
         self.chRegistered  : List[Optional[Channel]] = [None] * self.MAX_NUM_LOGS
         self.loggerInit     : boolean = False
+
+        # Continuous mode
+        self.stores         : Dict[int, ChannelStore] = {}
+        self.drainThread    : Optional[threading.Thread] = None
+        self.drainStop      : threading.Event = threading.Event()
+        self.errorCallback  : Optional[Callable[[Exception], None]] = None
+        self.drainErrors    : int = 0
     
     def getVersion(self):
         """
@@ -135,7 +251,7 @@ class Datalogger:
 
         # We get here: Command was successful
         self.numBytesLeft = self.numBytesLeft - recByteLen
-        self.chRegistered[channel - 1] = Channel(channel, variable, divider, recLen)
+        self.chRegistered[channel - 1] = Channel(channel, variable, divider, recLen, self.baseFrequency_Hz)
         self.loggerInit = False
 
     def initializeLogger(self):
@@ -184,7 +300,8 @@ class Datalogger:
 
         Returns:
         --------
-        - List of Channel-Instances containing log information and data.
+        - List of Channel-Instances containing log information and data (samples: typed array
+          viewing the upstream buffer, timebase: sample times in seconds).
         """
 
     
@@ -192,27 +309,130 @@ class Datalogger:
         
         data = self.sciHdl.requestUpstream(self.functions['GetLogData'], [self.index])
 
-        chNums = [ch.channel for ch in self.chRegistered if ch is not None]
-
         offset = 0
 
-        # Decompose channel data
-        for num in chNums:
-            self.chRegistered[num - 1].data = []
-            
-            # Slice to get the channel data bytearray
-            chDat = data[offset : (self.chRegistered[num - 1].recLen * self.chRegistered[num - 1].variable.type.value[1]) + offset].copy()
-            
-            offset += self.chRegistered[num - 1].recLen * self.chRegistered[num - 1].variable.type.value[1]
+        # Decompose channel data: The channels are concatenated in the order of their numbers
+        for ch in self.chRegistered:
+            if ch is None:
+                continue
 
-            # Covert data and save into struct
-            self.chRegistered[num - 1].data = [dat[0] for dat in struct.iter_unpack(f'>{self.chRegistered[num - 1].variable.type.value[0]}', chDat)]
+            ch.samples = np.frombuffer(data, ch.dtype, ch.recLen, offset)
+            offset += ch.recLen * ch.dtype.itemsize
 
-            ret.append(self.chRegistered[num - 1])
+            ret.append(ch)
 
         return ret
 
 
+    def setOpMode(self, mode : int):
+        """
+        Sets the operation mode of the onboard datalogger (OP_MODE_SINGLE / OP_MODE_CONTINUOUS).
+        """
+
+        if (self.functions['SetOpMode'].number <= 0):
+            raise Exception(f'No valid channel number for the callback SetOpMode assigned.')
+
+        self.sciHdl.command(self.functions['SetOpMode'], [self.index, mode])
+
+    def startContinuous(self, interval : Optional[float] = None, errorCallback : Optional[Callable[[Exception], None]] = None) -> Dict[int, ChannelStore]:
+        """
+        Starts the onboard datalogger in continuous mode and drains its rings from a background
+        thread until stopContinuous() is called.
+
+        Parameters:
+        -----------
+        - interval      : Time between two drains (Default: Half the time the fastest channel needs to fill its ring)
+        - errorCallback : Called with the exception of a failed drain (the thread keeps draining)
+
+        Returns:
+        --------
+        - Stores of the registered channels (channel number -> ChannelStore)
+        """
+
+        if not self.loggerInit:
+            raise Exception(f'Onboard logger must be initialized befor starting the logger.')
+
+        if self.drainThread is not None:
+            raise Exception('Continuous mode is already running.')
+
+        channels = [ch for ch in self.chRegistered if ch is not None]
+
+        if interval is None:
+            interval = min(ch.recLen * ch.divider / self.baseFrequency_Hz for ch in channels) / 2
+
+        self.stores = {ch.channel : ChannelStore(ch, ch.divider / self.baseFrequency_Hz) for ch in channels}
+        self.errorCallback = errorCallback
+        self.drainErrors = 0
+
+        self.setOpMode(self.OP_MODE_CONTINUOUS)
+        self.start()
+
+        self.drainStop.clear()
+        self.drainThread = threading.Thread(target=self._drainWorker, args=(interval,), daemon=True)
+        self.drainThread.start()
+
+        return self.stores
+
+    def stopContinuous(self):
+        """
+        Stops the drain thread and the onboard datalogger, the samples written until then are drained.
+        """
+
+        if self.drainThread is None:
+            return
+
+        self.drainStop.set()
+        self.drainThread.join()
+        self.drainThread = None
+
+        if self.functions['StopDatalogger'].number > 0:
+            self.stop()
+
+        self.drain()
+        self.setOpMode(self.OP_MODE_SINGLE)
+
+    def drain(self) -> int:
+        """
+        Pulls the samples written since the last drain into the channel stores (continuous mode).
+
+        Returns:
+        --------
+        - Number of new samples
+        """
+
+        data = self.sciHdl.requestUpstream(self.functions['GetLogData'], [self.index])
+        offset = 0
+        received = 0
+
+        for ch in self.chRegistered:
+            if ch is None:
+                continue
+
+            firstIndex, count = self.CONT_HEADER.unpack_from(data, offset)
+            offset += self.CONT_HEADER.size
+
+            self.stores[ch.channel].append(firstIndex, np.frombuffer(data, ch.dtype, count, offset))
+            offset += count * ch.dtype.itemsize
+            received += count
+
+        return received
+
+    def _drainWorker(self, interval : float):
+        deadline = time.monotonic()
+
+        while not self.drainStop.is_set():
+            try:
+                self.drain()
+            except Exception as e:
+                self.drainErrors += 1
+
+                if self.errorCallback is not None:
+                    self.errorCallback(e)
+
+            # Fixed rate: The drain time does not add up
+            deadline = max(deadline + interval, time.monotonic())
+            self.drainStop.wait(deadline - time.monotonic())
+
     def reset(self):
         """
         Resets the onboard datalogger.
@@ -5,19 +5,39 @@ History:
 --------
 - Created by Tim Loh, 27.01.2022
 - Updated by Holderried Roman for SCI functionality, 29.03.2022
+- Capability handshake replaces the fixed settling time, 18.10.2026
+- SETVAR batch frames (setvalues), 18.10.2026
+- Protocol metrics (SCIMetrics), 18.10.2026
+- Handshake and result conversion helpers shared with AsyncSCI, 18.10.2026
+- Requests encoded / decoded by the precompiled codecs of Variable and Function, 18.10.2026
+- Upstream chunks received in place (requestUpstream into a given buffer), 18.10.2026
+- Feature bit of compressed upstreams, 18.10.2026
+- Upstream chunks checked for STX / ETX (ERR / NAK responses, late frames), 18.10.2026
+- COMMAND results and FLOAT values decoded by the precompiled codecs, 18.10.2026
 """
 
+import os
+import re
+import select
 import serial
 import struct
 import time
-from enum import Enum
+from enum import Enum, IntFlag
 import threading
 from typing import *
+from SCIMetrics import Metrics
 
 class NumberFormat(Enum):
     HEX = 1
     FLOAT = 2
 
+class Feature(IntFlag):
+    NONE        = 0x0000
+    UPSTREAM    = 0x0001
+    DOWNSTREAM  = 0x0002
+    SETVAR_BATCH= 0x0004
+    UPSTREAM_COMPRESSION = 0x0008   # C master only: Not announced by this master, upstreams stay raw
+
 class CommandID(Enum):
     REJECTED    = '#'
     GETVAR      = '?'
@@ -25,6 +45,7 @@ class CommandID(Enum):
     COMMAND     = ':'
     UPSTREAM    = '>'
     DOWNSTREAM  = '<'
+    HANDSHAKE   = '%'
 
 class Datatype(Enum):
     DTYPE_UINT8    = ('B',1)
@@ -51,12 +72,157 @@ class Command:
         self.dataArray      : Iterable[float, int]  = []
         self.datatypeArray  : Iterable[Datatype]    = []
 
+class Capabilities:
+    """
+    Capabilities of a communication partner (exchanged by the handshake). 
+    The negotiated settings hold the largest frame lengths and the features / number formats that both sides support.
+    """
+
+    def __init__(self, protocolVersion : int = 0, rxPacketSize : int = 0, txPacketSize : int = 0, numberFormats : Iterable[NumberFormat] = [], features : Feature = Feature.NONE):
+        self.protocolVersion    : int                   = protocolVersion
+        self.rxPacketSize       : int                   = rxPacketSize
+        self.txPacketSize       : int                   = txPacketSize
+        self.numberFormats      : List[NumberFormat]    = list(numberFormats)
+        self.features           : Feature               = features
+
+class BatchWriteError(Exception):
+    """
+    Failed SETVAR batch: The device has applied the writes in front of the failed variable.
+    """
+
+    def __init__(self, number : int, message : str):
+        super().__init__(message)
+        self.number : int = number
+
+class ValueCodec:
+    """
+    Precompiled conversion of a fixed datatype list: One struct call per frame instead of one per value.
+    """
+
+    RAW_FORMATS = {1 : 'B', 2 : 'H', 4 : 'L'}
+
+    def __init__(self, types : Iterable[Datatype]):
+        types = list(types)
+        self.count          : int           = len(types)
+        self.valueStruct    : struct.Struct = struct.Struct('>' + ''.join(type.value[0] for type in types))
+        # Raw words as transmitted in HEX format (the decoded numbers are truncated to these by masks)
+        self.rawStruct      : struct.Struct = struct.Struct('>' + ''.join(self.RAW_FORMATS[type.value[1]] for type in types))
+        self.masks          : List[int]     = [(1 << (8 * type.value[1])) - 1 for type in types]
+        self.isFloat        : List[bool]    = [type == Datatype.DTYPE_F32 for type in types]
+        self.hexSlices      : List[slice]   = []
+
+        offset = 0
+        for type in types:
+            self.hexSlices.append(slice(offset, offset + 2 * type.value[1]))
+            offset += 2 * type.value[1]
+
+    def encodeHex(self, values : Sequence[Union[float, int]]) -> str:
+        text = self.valueStruct.pack(*values).hex().upper()
+        return ','.join(text[hexSlice].lstrip('0') for hexSlice in self.hexSlices)
+
+    def encodeFloat(self, values : Sequence[Union[float, int]]) -> str:
+        return ','.join(str(float(value)).rstrip('0') if isinstance(value, float) else str(int(value)) for value in values)
+
+    def reinterpret(self, decoded : Sequence[int]) -> List[Union[float, int]]:
+        """
+        Reinterprets the decoded HEX numbers (exactly count) as the datatypes
+        """
+
+        return list(self.valueStruct.unpack(self.rawStruct.pack(*[value & mask for value, mask in zip(decoded, self.masks)])))
+
+    def convertFloat(self, decoded : Sequence[float]) -> List[Union[float, int]]:
+        return [value if isFloat else int(value) for value, isFloat in zip(decoded, self.isFloat)]
+
+    def convert(self, decoded : Sequence[Union[float, int]], numberFormat : NumberFormat) -> List[Union[float, int]]:
+        return self.reinterpret(decoded) if numberFormat == NumberFormat.HEX else self.convertFloat(decoded)
+
+    @staticmethod
+    def parse(data : bytes, numberFormat : NumberFormat) -> List[Union[float, int]]:
+        """
+        Numbers of a comma separated data section (not yet converted into the datatypes)
+        """
+
+        if not data:
+            return []
+
+        # int() / float() of str items is faster than of bytes items
+        items = data.decode().split(',')
+
+        if numberFormat == NumberFormat.HEX:
+            return [int(item, 16) for item in items]
+
+        return [float(item) for item in items]
+
+class RequestCodec(ValueCodec):
+    """
+    Precompiled requests of a Variable / Function: Frame headers of all number formats and the value conversion.
+    Only the data dependent part is left for the single request.
+    """
+
+    # Designators of responses that are no further frame of COMMAND results
+    DESIGNATORS = (b'ACK', b'DAT', b'UPS', b'ERR', b'NAK')
+
+    def __init__(self, number : int, types : Iterable[Datatype], commandIDs : Iterable[CommandID]):
+        super().__init__(types)
+        self.headers    : Dict[Tuple[NumberFormat, CommandID], bytes] = {}
+        self.ackPrefixes: Dict[Tuple[NumberFormat, CommandID], bytes] = {}
+        self.rspPrefixes: Dict[Tuple[NumberFormat, CommandID], bytes] = {}
+
+        for numberFormat in NumberFormat:
+            num = struct.pack('>L', number).hex().upper().lstrip('0') if numberFormat == NumberFormat.HEX else str(int(number))
+
+            for cmdID in commandIDs:
+                self.headers[(numberFormat, cmdID)]     = f'{num}{cmdID.value}'.encode()
+                self.ackPrefixes[(numberFormat, cmdID)] = bytes([SCI.STX]) + f'{num}{cmdID.value}ACK'.encode()
+                self.rspPrefixes[(numberFormat, cmdID)] = bytes([SCI.STX]) + f'{num}{cmdID.value}'.encode()
+
+    def encode(self, numberFormat : NumberFormat, cmdID : CommandID, values : Optional[Sequence[Union[float, int]]] = None) -> bytearray:
+        packet = bytearray(self.headers[(numberFormat, cmdID)])
+
+        if values:
+            packet += (self.encodeHex(values) if numberFormat == NumberFormat.HEX else self.encodeFloat(values)).encode()
+
+        return packet
+
+    def ackData(self, response : bytes, numberFormat : NumberFormat, cmdID : CommandID) -> Optional[bytes]:
+        """
+        Data section of a plain ACK response to this request (None for any other response)
+        """
+
+        prefix = self.ackPrefixes[(numberFormat, cmdID)]
+
+        if response.startswith(prefix) and response[-1] == SCI.ETX:
+            return response[len(prefix) + 1 : -1]
+
+        return None
+
+    def resultData(self, response : bytes, numberFormat : NumberFormat, ongoing : bool) -> Optional[bytes]:
+        """
+        Values of a COMMAND result frame: First frame "DAT;length;values" or a further frame (ongoing).
+        None for any other response.
+        """
+
+        prefix = self.rspPrefixes[(numberFormat, CommandID.COMMAND)]
+
+        if not response.startswith(prefix) or response[-1] != SCI.ETX:
+            return None
+
+        data = response[len(prefix) : -1]
+
+        if ongoing:
+            return None if data[:3] in self.DESIGNATORS else data
+
+        end = data.find(b';', 4)
+
+        return data[end + 1:] if data.startswith(b'DAT;') and end >= 0 else None
+
 class Variable:
 
     def __init__(self, number : int, type : Datatype, description : Optional[str] = None):
         self.description    : Optional[str] = description
         self.number         : int           = number
         self.type           : Datatype      = type
+        self.codec          : RequestCodec  = RequestCodec(number, [type], (CommandID.GETVAR, CommandID.SETVAR))
 
 class Function:
 
@@ -70,25 +236,278 @@ class Function:
         self.argTypeList        : Iterable[Datatype]    = argTypeList
         self.returnTypeList     : Iterable[Datatype]    = returnTypeList
         self.requestsUpstream   : bool                  = requestsUpstream
+        # Compiled once: Changes of the type lists require a new Function object
+        self.codec              : RequestCodec          = RequestCodec(number, argTypeList, (CommandID.COMMAND, CommandID.UPSTREAM))
+        self.resultCodec        : ValueCodec            = ValueCodec(returnTypeList)
 
 class SCI:
     STX = 2
     ETX = 3
 
+    # ERR / NAK frame received instead of an upstream chunk
+    UPSTREAM_REJECT = re.compile(rb'\x02[^\x02\x03]*>(ERR|NAK);?([^\x02\x03]*)\x03')
+
+    PROTOCOL_VERSION        = 1
+    MAX_PACKET_SIZE         = 0xFFFF
+    # Bit positions of the number formats within the handshake (HEX preferred: lossless and faster to parse)
+    NUMBER_FORMAT_BITS      = {NumberFormat.HEX : 0x1, NumberFormat.FLOAT : 0x2}
+    HANDSHAKE_RETRY_TIME    = 0.1
+
     #==============================================================================
-    def __init__(self, port : str, maxPacketSize : int, baud : int = 115200, timeout : float = 5, numberFormat : NumberFormat = NumberFormat.HEX):
+    def __init__(self, port : str, maxPacketSize : Optional[int] = None, baud : int = 115200, timeout : float = 5, numberFormat : Optional[NumberFormat] = None, handshakeTimeout : float = 3):
+        """
+        Opens the port and negotiates the communication settings with the device.
+
+        Parameters:
+        -----------
+        - port              : Serial port of the device
+        - maxPacketSize     : Upper limit of the frame payload length (Determined by the handshake if omitted)
+        - baud              : Baudrate
+        - timeout           : Response timeout
+        - numberFormat      : Number format to use (The fastest one supported by both sides if omitted)
+        - handshakeTimeout  : Time to wait for the handshake response. Devices without handshake support
+                              fall back to maxPacketSize and numberFormat (HEX if omitted).
+        """
 
         self.ressourceLock = threading.Lock()
+        self.metrics = Metrics(cmdID.name for cmdID in CommandID if cmdID != CommandID.REJECTED)
 
         self.device = serial.Serial(port=port, baudrate=baud, timeout=timeout)
-        # serial module needs settling time...
-        time.sleep(1)
 
-        self.numberFormat = numberFormat
-        self.maxPacketSize = maxPacketSize
+        self.ownCapabilities = Capabilities(self.PROTOCOL_VERSION, 
+                                            maxPacketSize or self.MAX_PACKET_SIZE, 
+                                            maxPacketSize or self.MAX_PACKET_SIZE, 
+                                            [numberFormat] if numberFormat is not None else list(NumberFormat), 
+                                            Feature.UPSTREAM | Feature.SETVAR_BATCH)
+
+        # Connection setup ends as soon as the device answers the handshake
+        self.capabilities = self.handshake(handshakeTimeout)
+
+        if self.capabilities is None:
+            if maxPacketSize is None:
+                raise Exception('HANDSHAKE - No response from the device and no maxPacketSize given.')
+
+            self.capabilities = Capabilities(0, maxPacketSize, maxPacketSize, [numberFormat or NumberFormat.HEX], Feature.UPSTREAM)
+
+        self.numberFormat = self.capabilities.numberFormats[0]
+        self.rxPacketSize = self.capabilities.rxPacketSize
+        self.txPacketSize = self.capabilities.txPacketSize
+
+    #==============================================================================
+    def handshake(self, handshakeTimeout : float) -> Optional[Capabilities]:
+        """
+        Exchanges the capabilities with the device (always in HEX format) and negotiates the settings.
+        The request is repeated until the device answers, so that the startup time of the device is
+        covered without a fixed delay.
+
+        Parameters:
+        -----------
+        - handshakeTimeout  : Maximum time to wait for the handshake response
+
+        Returns:
+        --------
+        - Negotiated capabilities or None if the device does not support the handshake
+        """
+
+        deadline = time.monotonic() + handshakeTimeout
+        response = b''
+        attempts = 0
+
+        with self.ressourceLock:
+            responseTimeout = self.device.timeout
+            self.device.timeout = self.HANDSHAKE_RETRY_TIME
+
+            try:
+                while len(response) == 0 and time.monotonic() < deadline:
+                    if attempts > 0:
+                        self.metrics.retry(CommandID.HANDSHAKE.name)
+
+                    attempts += 1
+
+                    # Discard anything the device sent during its startup
+                    self.device.reset_input_buffer()
+                    response = self._exchange(CommandID.HANDSHAKE, self._handshakePacket(), checkSize = False)
+
+                    # Partial or foreign frames (e.g. while the device is still starting up) are dropped
+                    if not self._isHandshakeResponse(response):
+                        response = b''
+            finally:
+                self.device.timeout = responseTimeout
+
+        if len(response) == 0:
+            return None
+
+        return self._handshakeResult(response)
+
+    #==============================================================================
+    def _handshakePacket(self) -> bytearray:
+        """
+        Handshake request frame content with the own capabilities (HEX format)
+        """
+
+        own = self.ownCapabilities
+        ownFormats = sum(self.NUMBER_FORMAT_BITS[fmt] for fmt in own.numberFormats)
+
+        return bytearray(f'0{CommandID.HANDSHAKE.value}{own.protocolVersion:X},{own.rxPacketSize:X},{own.txPacketSize:X},{ownFormats:X},{int(own.features):X}', 'ASCII')
+
+    #==============================================================================
+    def _isHandshakeResponse(self, response : bytes) -> bool:
+        return self.STX in response and response.endswith(b'\x03') and \
+               CommandID.HANDSHAKE.value.encode() in response[response.rindex(self.STX):]
+
+    #==============================================================================
+    def _handshakeResult(self, response : bytes) -> Optional[Capabilities]:
+        """
+        Negotiates the settings from the handshake response
+
+        Returns:
+        --------
+        - Negotiated capabilities or None if the device does not support the handshake
+        """
+
+        own = self.ownCapabilities
+
+        # Frame content: 0%DAT;5;version,rxPacketSize,txPacketSize,numberFormats,features
+        msgDat = response[response.rindex(self.STX) + 1 : -1].decode().split(CommandID.HANDSHAKE.value)[-1].split(';')
+
+        if msgDat[0] != 'DAT' or len(msgDat) < 3:
+            return None
+
+        version, rxPacketSize, txPacketSize, formats, features = [int(item, 16) for item in msgDat[2].split(',')][:5]
+        commonFormats = [fmt for fmt in own.numberFormats if formats & self.NUMBER_FORMAT_BITS[fmt]]
+
+        if len(commonFormats) == 0:
+            raise Exception('HANDSHAKE - The device does not support any requested number format.')
+
+        # Same negotiation rules as on the device side
+        return Capabilities(min(own.protocolVersion, version), 
+                            min(own.rxPacketSize, txPacketSize), 
+                            min(own.txPacketSize, rxPacketSize), 
+                            sorted(commonFormats, key = lambda fmt : self.NUMBER_FORMAT_BITS[fmt]), 
+                            own.features & features)
 
     #==============================================================================
     def _decode(self, msg : bytearray, cmdID : CommandID, ongoing : bool = False) -> Response:
+        """
+        Message decoder (counted by the metrics)
+
+        Parameters:
+        -----------
+        - msg   : Received data line (STX -> ETX)
+        - cmdID : Expected command identifier
+        
+        Returns:
+        --------
+        - Response details
+        """
+
+        start = time.perf_counter()
+
+        try:
+            rsp = self._decodeFrame(msg, cmdID, ongoing)
+        except Exception:
+            self.metrics.evaluated(cmdID.name, time.perf_counter() - start, parseError = True)
+            raise
+
+        self.metrics.evaluated(cmdID.name, time.perf_counter() - start, rsp.acknowledge)
+
+        return rsp
+
+    #==============================================================================
+    def _upstreamError(self, response : bytes) -> Exception:
+        """
+        Error of an UPSTREAM response that is no raw data frame of the requested size
+
+        Parameters:
+        -----------
+        - response  : Received bytes (searched for an ERR / NAK frame)
+
+        Returns:
+        --------
+        - Exception to raise
+        """
+
+        match = self.UPSTREAM_REJECT.search(response)
+
+        if match is None:
+            return Exception('UPSTREAM REQUEST - STX / ETX error')
+        elif match.group(1) == b'NAK':
+            return Exception('UPSTREAM REQUEST - Upstream unknown')
+
+        errNum = match.group(2).decode()
+
+        try:
+            errNum = int(errNum, 16) if self.numberFormat == NumberFormat.HEX else int(float(errNum) + 0.5)
+        except ValueError:
+            pass
+
+        return Exception(f'UPSTREAM REQUEST - Error: {errNum}')
+
+    #==============================================================================
+    def _decodeAck(self, codec : RequestCodec, cmdID : CommandID, response : bytes) -> Optional[bytes]:
+        """
+        Fast path of the decoder for plain ACK responses (counted by the metrics)
+
+        Returns:
+        --------
+        - Data section of the response, None if the response needs the full decoder
+        """
+
+        start = time.perf_counter()
+        data = codec.ackData(response, self.numberFormat, cmdID)
+
+        if data is not None:
+            self.metrics.evaluated(cmdID.name, time.perf_counter() - start, 'ACK')
+
+        return data
+
+    #==============================================================================
+    def _decodeValue(self, variable : Variable, response : bytes) -> Optional[Union[float, int]]:
+        """
+        Fast path of the GETVAR decoder
+
+        Returns:
+        --------
+        - Variable value, None if the response needs the full decoder
+        """
+
+        data = self._decodeAck(variable.codec, CommandID.GETVAR, response)
+
+        if not data:
+            return None
+
+        if self.numberFormat == NumberFormat.HEX:
+            return variable.codec.reinterpret([int(data, 16)])[0]
+
+        return variable.codec.convertFloat([float(data)])[0]
+
+    #==============================================================================
+    def _decodeResult(self, function : Function, response : bytes, ongoing : bool) -> Optional[List[Union[float, int]]]:
+        """
+        Fast path of the COMMAND decoder for result frames (counted by the metrics)
+
+        Returns:
+        --------
+        - Result numbers of the frame (not yet converted), None if the response needs the full decoder
+        """
+
+        start = time.perf_counter()
+        data = function.codec.resultData(response, self.numberFormat, ongoing)
+
+        if data is None:
+            return None
+
+        try:
+            values = ValueCodec.parse(data, self.numberFormat)
+        except ValueError:
+            return None
+
+        self.metrics.evaluated(CommandID.COMMAND.name, time.perf_counter() - start, None if ongoing else 'DAT')
+
+        return values
+
+    #==============================================================================
+    def _decodeFrame(self, msg : bytearray, cmdID : CommandID, ongoing : bool = False) -> Response:
         """
         Message decoder
 
@@ -220,13 +639,118 @@ class SCI:
         return bytearray(packet,'ASCII')
 
     #==============================================================================
-    def _send(self, packet : bytearray):
+    def _exchange(self, cmdID : CommandID, packet : bytearray, size : Optional[int] = None, checkSize : bool = True) -> bytes:
+        """
+        Sends a request and reads the response (counted by the metrics).
+
+        Parameters:
+        -----------
+        - cmdID     : Command identifier of the request
+        - packet    : Request frame content (without STX / ETX)
+        - size      : Number of bytes to read (up to ETX if omitted)
+        - checkSize : Check the packet against the TX packet size
+
+        Returns:
+        --------
+        - Received bytes (incomplete on timeout)
+        """
+
+        start = time.perf_counter()
+        self._send(packet, checkSize)
+        sent = time.perf_counter()
+
+        if size is None:
+            response = self.device.read_until(b'\x03')
+            complete = response.endswith(b'\x03')
+        else:
+            response = self.device.read(size = size)
+            complete = len(response) == size
+
+        self.metrics.exchange(cmdID.name, start, sent, time.perf_counter(), len(packet), len(response), complete)
+
+        return response
+
+    #==============================================================================
+    def _exchangeInto(self, cmdID : CommandID, packet : bytearray, buffers : List[memoryview]) -> int:
+        """
+        Sends a request and reads the response into the buffers (counted by the metrics).
+
+        Parameters:
+        -----------
+        - cmdID     : Command identifier of the request
+        - packet    : Request frame content (without STX / ETX)
+        - buffers   : Buffers filled in order with the response bytes
+
+        Returns:
+        --------
+        - Number of received bytes (less than the buffers hold on timeout)
+        """
+
+        start = time.perf_counter()
+        self._send(packet)
+        sent = time.perf_counter()
+
+        size = sum(len(buf) for buf in buffers)
+        received = self._readInto(buffers)
+
+        self.metrics.exchange(cmdID.name, start, sent, time.perf_counter(), len(packet), received, received == size)
+
+        return received
+
+    #==============================================================================
+    def _readInto(self, buffers : List[memoryview]) -> int:
+        """
+        Fills the buffers in order until all are full or the port timeout elapsed.
+        POSIX ports are read by scattered reads of the file descriptor (no intermediate copy).
+        """
+
+        timeout = self.device.timeout
+        deadline = None if timeout is None else time.monotonic() + timeout
+        fd = getattr(self.device, 'fd', None)
+        pending = [buf for buf in buffers if len(buf) > 0]
+        received = 0
+
+        while pending:
+            remaining = None if deadline is None else deadline - time.monotonic()
+
+            if remaining is not None and remaining <= 0:
+                break
+
+            if fd is not None and hasattr(os, 'readv'):
+                if not select.select([fd], [], [], remaining)[0]:
+                    break
+
+                try:
+                    count = os.readv(fd, pending)
+                except BlockingIOError:
+                    continue
+            else:
+                count = self.device.readinto(pending[0])
+
+            # End of file or nothing received within the port timeout
+            if count == 0:
+                break
+
+            received += count
+
+            while count > 0:
+                if count >= len(pending[0]):
+                    count -= len(pending[0])
+                    pending.pop(0)
+                else:
+                    pending[0] = pending[0][count:]
+                    count = 0
+
+        return received
+
+    #==============================================================================
+    def _send(self, packet : bytearray, checkSize : bool = True):
         """
         Sends data to the packed as bytearray to the SCI device.
         """
         
-        if len(packet) > self.maxPacketSize:
-            raise Exception(f'Size of packet too big: Packet size: {len(packet)}; Max size: {len(self.maxPacketSize)}.')
+        if checkSize and len(packet) > self.txPacketSize:
+            raise Exception(f'Size of packet too big: Packet size: {len(packet)}; Max size: {self.txPacketSize}.')
         
         packet.insert(0, self.STX)
         packet.append(self.ETX)
@@ -258,13 +782,6 @@ class SCI:
             if len(paramList) != len(function.argTypeList):
                 raise Exception('Length of parameter list does not match the length of the type specifier list.')
 
-        # Construct command
-        cmd = Command()
-        cmd.number      = function.number
-        cmd.commandID   = CommandID.COMMAND
-        cmd.dataArray   = paramList
-        cmd.datatypeArray  = function.argTypeList
-
         sendOnce = True
         ongoing = False
         data = []
@@ -273,36 +790,52 @@ class SCI:
         # Query is allowed just once at a time!
         with self.ressourceLock:
             
+            packet = function.codec.encode(self.numberFormat, CommandID.COMMAND, paramList)
+
             while (len(data) < len(function.returnTypeList) or sendOnce):
-                packet = self._encode(cmd)
                 self.device.flush()
-                self._send(packet)
-                response = self.device.read_until(b'\x03')
+                response = self._exchange(CommandID.COMMAND, bytearray(packet))
                 if len(response) == 0:
                     raise Exception('COMMAND - Timeout occured')
-                rsp = self._decode(bytearray(response), cmd.commandID, ongoing)
 
                 # This command does not need further processing
-                if rsp.acknowledge == 'ACK':
+                if not ongoing and self._decodeAck(function.codec, CommandID.COMMAND, response) is not None:
                     break
-                elif rsp.acknowledge == 'UPS':
-                    return rsp.dataLength
-                elif rsp.acknowledge == 'ERR':
-                    raise Exception(f'COMMAND - Error: {rsp.dataArray[0]}')
-                elif rsp.acknowledge == 'NAK':
-                    raise Exception('COMMAND - Unknown Command')
-                # elif rsp.acknowledge == 'DAT':
-                #     expectedDatalen = rsp.dataLength
-                
-                # Here we also land if the response designator is None
-                data.extend(rsp.dataArray.copy())
+
+                values = self._decodeResult(function, response, ongoing)
+
+                if values is None:
+                    rsp = self._decode(bytearray(response), CommandID.COMMAND, ongoing)
+
+                    if rsp.acknowledge == 'ACK':
+                        break
+                    elif rsp.acknowledge == 'UPS':
+                        return rsp.dataLength
+                    elif rsp.acknowledge == 'ERR':
+                        raise Exception(f'COMMAND - Error: {rsp.dataArray[0]}')
+                    elif rsp.acknowledge == 'NAK':
+                        raise Exception('COMMAND - Unknown Command')
+
+                    # Here we also land if the response designator is None
+                    values = rsp.dataArray
+
+                data.extend(values)
                 ongoing = True
                 sendOnce = False
                 # Sleep time necessary for reliable data transmission
                 time.sleep(0.01)
         
-        # Type conversion
-        if len(data) > 0:
+        return self._convertResults(data, function)
+
+    #==============================================================================
+    def _convertResults(self, data : List[Union[float, int]], function : Function) -> List[Union[float, int]]:
+        """
+        Converts the received COMMAND result values into the return types of the function
+        """
+
+        if len(data) == function.resultCodec.count:
+            data = function.resultCodec.convert(data, self.numberFormat)
+        elif len(data) > 0:
             if self.numberFormat.name == 'HEX':
                 data = [self._reinterpretDecodedIntToDtype(dat, type) for dat, type in zip(data, function.returnTypeList)]
             else:
@@ -321,24 +854,21 @@ class SCI:
         - value     : Value to set
         """
 
-        # Construct command
-        cmd = Command()
-        cmd.number      = variable.number
-        cmd.commandID   = CommandID.SETVAR
-        cmd.dataArray   = [value]
-        cmd.datatypeArray  = [variable.type]
+        packet = variable.codec.encode(self.numberFormat, CommandID.SETVAR, [value])
         response        = None
         
         # Query is allowed just once at a time!
         with self.ressourceLock:
-            packet = self._encode(cmd)
             self.device.flush()
-            self._send(packet)
-            response = self.device.read_until(b'\x03')
+            response = self._exchange(CommandID.SETVAR, packet)
 
         if len(response) == 0:
             raise Exception('SETVALUE - Timeout occured')
-        rsp = self._decode(bytearray(response), cmd.commandID)
+
+        if self._decodeAck(variable.codec, CommandID.SETVAR, response) is not None:
+            return
+
+        rsp = self._decode(bytearray(response), CommandID.SETVAR)
 
         if rsp.acknowledge == 'ACK':
             return
@@ -347,6 +877,60 @@ class SCI:
         elif rsp.acknowledge == 'NAK':
             raise Exception('SETVALUE - Variable unknown')
 
+    #==============================================================================
+    def setvalues(self, writes : Sequence[Tuple[Variable, Union[float, int]]]):
+        """
+        Sets several variables within one SETVAR batch frame ("num!val,num,val,...").
+        The device applies the writes in order and stops at the first failing one.
+        Batches of more than one write require Feature.SETVAR_BATCH (handshake).
+
+        Parameters:
+        -----------
+        - writes    : Variables and the values to set
+
+        Raises:
+        -------
+        - BatchWriteError with the number of the failed variable
+        """
+
+        if len(writes) == 1:
+            try:
+                return self.setvalue(*writes[0])
+            except Exception as e:
+                raise BatchWriteError(writes[0][0].number, str(e))
+
+        if not (self.capabilities.features & Feature.SETVAR_BATCH):
+            raise Exception('SETVALUES - Batch frames are not supported by the device')
+
+        # Construct command: The further variable numbers are values
+        cmd = Command()
+        cmd.number          = writes[0][0].number
+        cmd.commandID       = CommandID.SETVAR
+        cmd.dataArray       = [writes[0][1]]
+        cmd.datatypeArray   = [writes[0][0].type]
+        response            = None
+
+        for variable, value in writes[1:]:
+            cmd.dataArray       += [variable.number, value]
+            cmd.datatypeArray   += [Datatype.DTYPE_INT16, variable.type]
+
+        # Query is allowed just once at a time!
+        with self.ressourceLock:
+            packet = self._encode(cmd)
+            self.device.flush()
+            response = self._exchange(cmd.commandID, packet)
+
+        if len(response) == 0:
+            raise Exception('SETVALUES - Timeout occured')
+        rsp = self._decode(bytearray(response), cmd.commandID)
+
+        if rsp.acknowledge == 'ACK':
+            return
+        elif rsp.acknowledge == 'ERR':
+            raise BatchWriteError(rsp.number, f'SETVALUES - Error at variable {rsp.number}: {rsp.dataArray[0]}')
+        elif rsp.acknowledge == 'NAK':
+            raise BatchWriteError(rsp.number, f'SETVALUES - Variable {rsp.number} unknown')
+
 
     def getvalue(self, variable : Variable) -> Union[float,int]:
         """
@@ -361,90 +945,106 @@ class SCI:
         - Variable value of the requested struct variable
         """
         
-        # Construct command
-        cmd = Command()
-        cmd.number      = variable.number
-        cmd.commandID   = CommandID.GETVAR
+        packet = variable.codec.encode(self.numberFormat, CommandID.GETVAR)
         response        = None
         
         # Query is allowed just once at a time!
         with self.ressourceLock:
-            packet = self._encode(cmd)
             self.device.flush()
-            self._send(packet)
-            response = self.device.read_until(b'\x03')
+            response = self._exchange(CommandID.GETVAR, packet)
 
         if len(response) == 0:
             raise Exception('GETVALUE - Timeout occured')
 
-        rsp = self._decode(bytearray(response), cmd.commandID)
+        value = self._decodeValue(variable, response)
+
+        if value is not None:
+            return value
+
+        rsp = self._decode(bytearray(response), CommandID.GETVAR)
 
         if rsp.acknowledge == 'ACK':
-            return self._reinterpretDecodedIntToDtype(rsp.dataArray[0], variable.type)
+            return variable.codec.convert(rsp.dataArray, self.numberFormat)[0]
         elif rsp.acknowledge == 'ERR':
             raise Exception(f'GETVALUE - Error: {rsp.dataArray[0]}')
         elif rsp.acknowledge == 'NAK':
             raise Exception('GETVALUE - Variable unknown')
 
 
-    def requestUpstream(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> bytearray:
+    def requestUpstream(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None, buffer : Optional[Any] = None) -> Union[bytearray, memoryview]:
         """
-        Upstream request function. 
-        TODO: To be tested!!!
+        Upstream request function. The chunks are received in place: STX / ETX of every frame are
+        read into a scratch buffer, the data directly into its position of the upstream buffer.
+        A chunk without STX / ETX at its bounds (ERR / NAK response, late frame of an earlier
+        request) fails the request, the contents of the buffer are undefined then.
 
         Parameters:
         -----------
         - function  : Function object of the external callback to request.
         - paramList : Parameter to be passed to the external function
+        - buffer    : Writable contiguous buffer to receive into (e.g. bytearray, numpy array, mmap). 
+                      Allocated with the upstream size if omitted.
 
         Returns:
         --------
-        - bytearray holding the upstream data    
+        - bytearray holding the upstream data (own buffer) or a memoryview of the upstream data within buffer
         """
 
         # Request upstream
         upstreamSize = self.command(function, paramList=paramList)
 
-        cmd = Command()
-        cmd.number      = function.number
-        cmd.commandID   = CommandID.UPSTREAM
+        packet = function.codec.encode(self.numberFormat, CommandID.UPSTREAM)
 
-        data = bytearray([])
+        data = bytearray(upstreamSize) if buffer is None else buffer
+        view = memoryview(data).cast('B')
 
-        with self.ressourceLock:
+        if view.nbytes < upstreamSize:
+            raise ValueError(f'UPSTREAM REQUEST - Buffer too small: Buffer size: {view.nbytes}; Upstream size: {upstreamSize}.')
 
-            while (len(data) < upstreamSize):
-                remainingData = (upstreamSize - len(data))
+        framing = memoryview(bytearray(2))
+        offset = 0
 
-                if (remainingData >= self.maxPacketSize):
-                    rspDatLen = self.maxPacketSize
-                else:
-                    rspDatLen =  remainingData
+        with self.ressourceLock:
 
-                rspDatLen += 2 # Take care for STX and ETX
+            while (offset < upstreamSize):
+                rspDatLen = min(self.rxPacketSize, upstreamSize - offset)
                 
-                # Send the request
-                packet = self._encode(cmd)
-                self.device.flush()
-                self._send(packet)
+                chunk = view[offset : offset + rspDatLen]
 
-                # TODO: This has to be replaced by a function reading number of bytes if the upstream has been switched to binary format
-                # response = self.device.read_until(b'\x03')
-                response = self.device.read(size = rspDatLen)
-
-                if len(response) < rspDatLen:
-                    raise Exception('UPSTREAM REQUEST - Timeout occured')
+                # Send the request (bytes left from an earlier request would be taken for the chunk)
+                self.device.reset_input_buffer()
+                self.device.flush()
+                received = self._exchangeInto(CommandID.UPSTREAM, bytearray(packet), [framing[:1], chunk, framing[1:]])
 
-                 # Remove STX and ETX
-                response = bytearray(response[1 : -1])
+                if received < rspDatLen + 2 or framing[0] != self.STX or framing[1] != self.ETX:
+                    self._upstreamChunkFailed(framing, chunk, received)
 
-                # rsp = self._decode(bytearray(response), cmd.commandID)
-                
-                data.extend(response.copy())
+                offset += rspDatLen
                 # Sleep time necessary for reliable data transmission
                 time.sleep(0.01)
 
-        return data
+        return data if buffer is None else view[:upstreamSize]
+
+    #==============================================================================
+    def _upstreamChunkFailed(self, framing : memoryview, chunk : memoryview, received : int):
+        """
+        Raises the error of an upstream chunk that is incomplete or framed wrong.
+        """
+
+        if received < len(chunk) + 2:
+            # An ERR / NAK frame is shorter than the chunk, otherwise the device did not answer
+            response = bytes(framing[:1]) + bytes(chunk[:max(received - 1, 0)])
+
+            if self.UPSTREAM_REJECT.search(response) is None:
+                raise Exception('UPSTREAM REQUEST - Timeout occured')
+        else:
+            response = bytes(framing[:1]) + bytes(chunk) + bytes(framing[1:])
+
+            # The frame is read up to its end
+            if framing[1] != self.ETX:
+                response += self.device.read_until(b'\x03')
+
+        raise self._upstreamError(response)
     
 
 
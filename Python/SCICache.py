@@ -0,0 +1,154 @@
+"""
+Variable cache on top of the SCI driver
+
+Serves getvalue() calls from the last value of the variable if it is younger than the
+maximum age given by the caller. Concurrent reads of the same variable (from different
+threads) are merged into one request. setvalue() invalidates the cached value, a read
+overlapping an invalidation returns its value without caching it.
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+- Reads overlapping an invalidation not cached, 18.10.2026
+"""
+
+import threading
+import time
+from typing import *
+from SCI import SCI, Variable
+
+
+class CacheStats:
+    def __init__(self):
+        self.reads          : int = 0
+        self.hits           : int = 0
+        self.coalesced      : int = 0
+        self.linkReads      : int = 0
+        self.invalidations  : int = 0
+
+    @property
+    def hitRate(self) -> float:
+        return self.hits / self.reads if self.reads > 0 else 0.0
+
+    @property
+    def savedRoundTrips(self) -> int:
+        return self.hits + self.coalesced
+
+
+class _Entry:
+    def __init__(self):
+        self.value      : Optional[Union[float, int]]   = None
+        self.timestamp  : Optional[float]               = None
+        self.inFlight   : Optional[threading.Event]     = None
+        self.error      : Optional[Exception]           = None
+        self.generation : int                           = 0     # Number of invalidations
+
+
+class SCICache:
+
+    #==============================================================================
+    def __init__(self, sci : SCI, clock : Callable[[], float] = time.monotonic):
+        """
+        Parameters:
+        -----------
+        - sci   : Handle to the SCI driver
+        - clock : Time base of the timestamps and maximum ages (seconds)
+        """
+        self.sciHdl     : SCI               = sci
+        self.clock      : Callable          = clock
+        self.stats      : CacheStats        = CacheStats()
+        self.entries    : Dict[int, _Entry] = {}
+        self.lock       : threading.Lock    = threading.Lock()
+
+    #==============================================================================
+    def getvalue(self, variable : Variable, maxAge : float) -> Union[float, int]:
+        """
+        Reads a variable through the cache.
+
+        Parameters:
+        -----------
+        - variable  : Object of the variable to read
+        - maxAge    : Maximum age of a cached value to be served (seconds)
+
+        Returns:
+        --------
+        - Variable value
+        """
+
+        with self.lock:
+            self.stats.reads += 1
+            entry = self.entries.setdefault(variable.number, _Entry())
+
+            if entry.timestamp is not None and (self.clock() - entry.timestamp) <= maxAge:
+                self.stats.hits += 1
+                return entry.value
+
+            # Merge into the request in flight
+            inFlight = entry.inFlight
+            owner = inFlight is None
+
+            if owner:
+                inFlight = entry.inFlight = threading.Event()
+                generation = entry.generation
+                self.stats.linkReads += 1
+            else:
+                self.stats.coalesced += 1
+
+        if not owner:
+            inFlight.wait()
+
+            if entry.error is not None:
+                raise entry.error
+            return entry.value
+
+        try:
+            value = self.sciHdl.getvalue(variable)
+            error = None
+        except Exception as e:
+            value = None
+            error = e
+
+        with self.lock:
+            # Handed to the merged reads, but not served later if invalidated during the read (may precede a write)
+            if error is None:
+                entry.value     = value
+                if entry.generation == generation:
+                    entry.timestamp = self.clock()
+            entry.error     = error
+            entry.inFlight  = None
+            inFlight.set()
+
+        if error is not None:
+            raise error
+        return value
+
+    #==============================================================================
+    def setvalue(self, variable : Variable, value : Union[float, int]):
+        """
+        Sets a variable and invalidates its cached value.
+        """
+
+        self.invalidate(variable)
+        self.sciHdl.setvalue(variable, value)
+        # Reads that started during the write may have cached the former value
+        self.invalidate(variable, count = False)
+
+    #==============================================================================
+    def invalidate(self, variable : Optional[Variable] = None, count : bool = True):
+        """
+        Invalidates the cached value of a variable (or of all variables).
+        """
+
+        with self.lock:
+            entries = self.entries.values() if variable is None else [self.entries.get(variable.number)]
+
+            for entry in entries:
+                if entry is None:
+                    continue
+
+                entry.generation += 1
+
+                if entry.timestamp is not None:
+                    entry.timestamp = None
+                    if count:
+                        self.stats.invalidations += 1
@@ -0,0 +1,287 @@
+"""
+Datalogger capture files (format see C/Inc/SCICapture.h)
+
+CaptureFile memory-maps a capture: Opening reads the header, the channel table and the chunk
+index only (files without index are indexed by walking the block headers). The samples are
+NumPy views of the mapping, so only the sliced time ranges are paged in.
+CaptureWriter writes the channels of Datalogger.getData or the stores of the continuous mode
+in the same format as the C writer.
+
+Usage:
+    with CaptureFile('run.scicap') as capture:
+        timebase, samples = capture.channels[1].slice(10.0, 10.5)
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import mmap
+import struct
+import time
+import numpy as np
+from typing import *
+from SCI import Datatype
+from Datalogger import Channel, ChannelStore, DTYPES
+
+VERSION         = 1
+FILE_MAGIC      = b'SCICAPT\x1a'
+FOOTER_MAGIC    = b'SCICAPIX'
+BLOCK_MAGIC     = 0x4B4C4253
+FLAG_BIG_ENDIAN = 0x00000001
+ALIGN           = 8
+
+HEADER  = struct.Struct('<8sHHLLLQ')    # Magic, version, channels, base frequency, flags, reserved, start time (us)
+CHANNEL = struct.Struct('<BBHLLL')      # Channel, datatype, variable number, divider, record length, reserved
+BLOCK   = struct.Struct('<LB3xQLL')     # Magic, channel, first sample index, samples, data length
+INDEX   = struct.Struct('<QQLB3x')      # Block offset, first sample index, samples, channel
+FOOTER  = struct.Struct('<QLL8s')       # Index offset, entries, reserved, magic
+
+# Datatype codes of the file (teSCI_DATATYPE)
+DATATYPES : List[Datatype] = [Datatype.DTYPE_UINT8, Datatype.DTYPE_INT8, Datatype.DTYPE_UINT16, Datatype.DTYPE_INT16,
+                              Datatype.DTYPE_UINT32, Datatype.DTYPE_INT32, Datatype.DTYPE_F32]
+
+
+class CaptureChannel:
+    """
+    Channel of a capture file: Metadata and the blocks of its samples
+    """
+
+    def __init__(self, mapping : mmap.mmap, channel : int, datatype : Datatype, varNum : int, divider : int, recLen : int, baseFrequency_Hz : int):
+        self.mapping    : mmap.mmap = mapping
+        self.channel    : int       = channel
+        self.datatype   : Datatype  = datatype
+        self.dtype      : np.dtype  = DTYPES[datatype]
+        self.varNum     : int       = varNum
+        self.divider    : int       = divider
+        self.recLen     : int       = recLen
+        self.period_s   : float     = divider / baseFrequency_Hz if baseFrequency_Hz > 0 else 0.0
+
+        # Blocks in file order (sample data offsets)
+        self.offsets        : np.ndarray = np.empty(0, np.int64)
+        self.firstIndices   : np.ndarray = np.empty(0, np.int64)
+        self.counts         : np.ndarray = np.empty(0, np.int64)
+
+    def __len__(self) -> int:
+        return int(self.counts.sum())
+
+    def _block(self, pos : int, start : int = 0, end : Optional[int] = None) -> np.ndarray:
+        count = int(self.counts[pos]) if end is None else end
+        return np.frombuffer(self.mapping, self.dtype, count - start, int(self.offsets[pos]) + start * self.dtype.itemsize)
+
+    def samples(self) -> np.ndarray:
+        """
+        All samples (a view of the file if stored in one block)
+        """
+
+        return self.indexSlice(0, None)[1]
+
+    def slice(self, start_s : float, end_s : Optional[float] = None) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Samples of the time range [start_s, end_s) (a view of the file if within one block).
+
+        Returns:
+        --------
+        - Sample times in seconds and samples
+        """
+
+        if self.period_s <= 0:
+            raise ValueError('CAPTURE - No timebase (base frequency unknown)')
+
+        # Rounded first: Times computed from sample indices must map back to the same index
+        return self.indexSlice(int(np.ceil(round(start_s / self.period_s, 6))), None if end_s is None else int(np.ceil(round(end_s / self.period_s, 6))))
+
+    def indexSlice(self, startIndex : int, endIndex : Optional[int] = None) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Samples of the sample index range [startIndex, endIndex)
+
+        Returns:
+        --------
+        - Sample times in seconds and samples
+        """
+
+        ends = self.firstIndices + self.counts
+        parts = []
+        times = []
+
+        for pos in np.nonzero((ends > startIndex) & ((self.firstIndices < endIndex) if endIndex is not None else True))[0]:
+            first = int(self.firstIndices[pos])
+            start = max(startIndex - first, 0)
+            end = int(self.counts[pos]) if endIndex is None else min(endIndex - first, int(self.counts[pos]))
+
+            parts.append(self._block(pos, start, end))
+            times.append(np.arange(first + start, first + end))
+
+        if len(parts) == 0:
+            return np.empty(0), np.empty(0, self.dtype)
+
+        if len(parts) == 1:
+            return times[0] * self.period_s, parts[0]
+
+        return np.concatenate(times) * self.period_s, np.concatenate(parts)
+
+
+class CaptureFile:
+
+    #==============================================================================
+    def __init__(self, path : str):
+        """
+        Maps a capture file and reads its index.
+        """
+
+        self.file = open(path, 'rb')
+        self.mapping = mmap.mmap(self.file.fileno(), 0, access = mmap.ACCESS_READ)
+
+        magic, self.version, numChannels, self.baseFrequency_Hz, self.flags, _, self.startTimeUs = HEADER.unpack_from(self.mapping, 0)
+
+        if magic != FILE_MAGIC:
+            raise ValueError('CAPTURE - No capture file')
+
+        if self.version != VERSION:
+            raise ValueError(f'CAPTURE - Unsupported version {self.version}')
+
+        self.channels : Dict[int, CaptureChannel] = {}
+        offset = HEADER.size
+
+        for _ in range(numChannels):
+            channel, dtype, varNum, divider, recLen, _ = CHANNEL.unpack_from(self.mapping, offset)
+            self.channels[channel] = CaptureChannel(self.mapping, channel, DATATYPES[dtype], varNum, divider, recLen, self.baseFrequency_Hz)
+            offset += CHANNEL.size
+
+        blocks = self._readIndex() if self._hasIndex() else self._scanBlocks(offset)
+
+        for ch in self.channels.values():
+            own = [(offset, first, count) for channel, offset, first, count in blocks if channel == ch.channel]
+            ch.offsets, ch.firstIndices, ch.counts = (np.array(column, np.int64) for column in zip(*own)) if own else (np.empty(0, np.int64),) * 3
+
+    #==============================================================================
+    def close(self):
+        # Views of the mapping must be released first
+        self.mapping.close()
+        self.file.close()
+
+    #==============================================================================
+    def __enter__(self) -> 'CaptureFile':
+        return self
+
+    #==============================================================================
+    def __exit__(self, *args):
+        self.close()
+
+    #==============================================================================
+    def _hasIndex(self) -> bool:
+        return len(self.mapping) >= HEADER.size + FOOTER.size and self.mapping[-len(FOOTER_MAGIC):] == FOOTER_MAGIC
+
+    #==============================================================================
+    def _readIndex(self) -> List[Tuple[int, int, int, int]]:
+        """
+        Blocks of the chunk index (channel, sample data offset, first sample index, samples)
+        """
+
+        indexOffset, entries, _, _ = FOOTER.unpack_from(self.mapping, len(self.mapping) - FOOTER.size)
+
+        return [(channel, offset + BLOCK.size, first, count) for offset, first, count, channel in INDEX.iter_unpack(self.mapping[indexOffset : indexOffset + entries * INDEX.size])]
+
+    #==============================================================================
+    def _scanBlocks(self, offset : int) -> List[Tuple[int, int, int, int]]:
+        """
+        Walks the block headers (file without index): Stops at the first incomplete block
+        """
+
+        blocks = []
+
+        while offset + BLOCK.size <= len(self.mapping):
+            magic, channel, first, count, dataLen = BLOCK.unpack_from(self.mapping, offset)
+
+            if magic != BLOCK_MAGIC or offset + BLOCK.size + dataLen > len(self.mapping):
+                break
+
+            blocks.append((channel, offset + BLOCK.size, first, count))
+            offset += BLOCK.size + (dataLen + ALIGN - 1) // ALIGN * ALIGN
+
+        return blocks
+
+
+class CaptureWriter:
+
+    #==============================================================================
+    def __init__(self, path : str, channels : Iterable[Channel], baseFrequency_Hz : int, startTimeUs : Optional[int] = None):
+        """
+        Starts a capture file.
+
+        Parameters:
+        -----------
+        - path              : File to write
+        - channels          : Registered datalogger channels
+        - baseFrequency_Hz  : Base frequency of the datalogger
+        - startTimeUs       : Start of the recording (Unix time in us, now if omitted)
+        """
+
+        self.channels   : Dict[int, Channel] = {ch.channel : ch for ch in channels}
+        self.nextIndex  : Dict[int, int] = {ch : 0 for ch in self.channels}
+        self.index      : List[bytes] = []
+        self.file       = open(path, 'wb')
+
+        self.file.write(HEADER.pack(FILE_MAGIC, VERSION, len(self.channels), baseFrequency_Hz, FLAG_BIG_ENDIAN, 0,
+                                    int(time.time() * 1e6) if startTimeUs is None else startTimeUs))
+
+        for ch in self.channels.values():
+            self.file.write(CHANNEL.pack(ch.channel, DATATYPES.index(ch.variable.type), ch.variable.number, ch.divider, ch.recLen, 0))
+
+    #==============================================================================
+    def writeBlock(self, channel : int, firstIndex : int, samples : np.ndarray):
+        """
+        Writes a block of samples of one channel.
+        """
+
+        data = np.ascontiguousarray(samples, self.channels[channel].dtype)
+
+        if len(data) == 0:
+            return
+
+        self.index.append(INDEX.pack(self.file.tell(), firstIndex, len(data), channel))
+        self.file.write(BLOCK.pack(BLOCK_MAGIC, channel, firstIndex, len(data), data.nbytes))
+        self.file.write(data)
+        self.file.write(bytes(-data.nbytes % ALIGN))
+        self.nextIndex[channel] = max(self.nextIndex[channel], firstIndex + len(data))
+
+    #==============================================================================
+    def writeChannels(self, channels : Iterable[Channel]):
+        """
+        Writes a single capture (Datalogger.getData): Successive captures continue the sample indices.
+        """
+
+        for ch in channels:
+            self.writeBlock(ch.channel, self.nextIndex[ch.channel], ch.samples)
+
+    #==============================================================================
+    def writeStores(self, stores : Dict[int, ChannelStore]):
+        """
+        Writes the chunks of the continuous mode stores.
+        """
+
+        for channel, store in stores.items():
+            with store.lock:
+                chunks = list(zip(store.firstIndices, store.chunks))
+
+            for firstIndex, samples in chunks:
+                self.writeBlock(channel, firstIndex, samples)
+
+    #==============================================================================
+    def close(self):
+        """
+        Writes the chunk index and the footer.
+        """
+
+        indexOffset = self.file.tell()
+        self.file.write(b''.join(self.index))
+        self.file.write(FOOTER.pack(indexOffset, len(self.index), 0, FOOTER_MAGIC))
+        self.file.close()
+
+    #==============================================================================
+    def __enter__(self) -> 'CaptureWriter':
+        return self
+
+    #==============================================================================
+    def __exit__(self, *args):
+        self.close()
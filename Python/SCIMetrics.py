@@ -0,0 +1,203 @@
+"""
+Protocol metrics of the SCI driver (counterpart of C/Inc/SCIMetrics.h)
+
+Per command ID: Requests, responses, bytes out / in (including STX / ETX), ERR and NAK
+responses, parse errors, timeouts, retries and a latency histogram (request written ->
+response read). The histogram uses the buckets of the C master: Every power of two
+[2^n, 2^(n+1)) us is split into four buckets of equal width, so percentiles are known
+within 25 %. Further, the time spent sending, waiting for / receiving, evaluating the
+responses and idle between the requests is accumulated.
+
+All memory is allocated up front. snapshot() copies the counters and optionally resets
+them within one step, so no request is lost or counted twice between two snapshots.
+
+Usage:
+    sci = SCI('/dev/ttyUSB0')
+    ...
+    print(formatMetrics(sci.metrics.snapshot(reset = True)))
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import copy
+import threading
+import time
+from typing import *
+
+NUM_BUCKETS     = 80    # Same as SCI_METRICS_NUM_BUCKETS (up to ~1.8 s)
+SUB_BUCKETS     = 4     # Buckets per power of two
+STATES          = ('IDLE', 'SENDING', 'EVALUATING', 'RECEIVING')
+
+
+#==============================================================================
+def bucket(latencyUs : int) -> int:
+
+    if latencyUs < SUB_BUCKETS:
+        return max(latencyUs, 0)
+
+    msb = latencyUs.bit_length() - 1
+
+    return min(SUB_BUCKETS * (msb - 1) + ((latencyUs >> (msb - 2)) & (SUB_BUCKETS - 1)), NUM_BUCKETS - 1)
+
+
+#==============================================================================
+def bucketLimit(index : int) -> int:
+    """
+    Latencies of the bucket are below this limit (us)
+    """
+
+    if index < SUB_BUCKETS:
+        return index + 1
+
+    return (SUB_BUCKETS + 1 + index % SUB_BUCKETS) << (index // SUB_BUCKETS - 1)
+
+
+class RequestMetrics:
+    def __init__(self):
+        self.requests       : int = 0
+        self.responses      : int = 0
+        self.bytesOut       : int = 0
+        self.bytesIn        : int = 0
+        self.errors         : int = 0   # ERR responses
+        self.naks           : int = 0   # NAK responses
+        self.parseErrors    : int = 0
+        self.timeouts       : int = 0
+        self.retries        : int = 0
+        self.latencySumUs   : int = 0
+        self.latency        : List[int] = [0] * NUM_BUCKETS
+
+    #==============================================================================
+    def percentile(self, percent : float) -> Optional[int]:
+        """
+        Returns the upper limit (us) of the histogram bucket holding the percentile
+        (None without responses, inf if beyond the last bucket).
+        """
+
+        total = sum(self.latency)
+
+        if total == 0:
+            return None
+
+        rank = max(1, -(-total * percent // 100))
+        count = 0
+
+        for index, cnt in enumerate(self.latency):
+            count += cnt
+
+            if count >= rank:
+                return bucketLimit(index) if index < NUM_BUCKETS - 1 else float('inf')
+
+    #==============================================================================
+    def mean(self) -> Optional[float]:
+        return self.latencySumUs / self.responses if self.responses > 0 else None
+
+
+class Metrics:
+
+    #==============================================================================
+    def __init__(self, commandIDs : Iterable[str]):
+        """
+        Parameters:
+        -----------
+        - commandIDs    : Names of the request types
+        """
+
+        self.lock       = threading.Lock()
+        self.types      : Dict[str, RequestMetrics] = {name : RequestMetrics() for name in commandIDs}
+        self.stateTime  : Dict[str, float] = {state : 0.0 for state in STATES}
+        self.lastEnd    : Optional[float] = None
+
+    #==============================================================================
+    def exchange(self, name : str, start : float, sent : float, end : float, bytesOut : int, bytesIn : int, complete : bool):
+        """
+        Records a request and its response (perf_counter timestamps: write start, write end, read end).
+        """
+
+        with self.lock:
+            rm = self.types[name]
+            rm.requests += 1
+            rm.bytesOut += bytesOut
+            rm.bytesIn  += bytesIn
+
+            if complete:
+                latencyUs = int((end - start) * 1e6)
+                rm.responses    += 1
+                rm.latencySumUs += latencyUs
+                rm.latency[bucket(latencyUs)] += 1
+            else:
+                rm.timeouts += 1
+
+            if self.lastEnd is not None:
+                self.stateTime['IDLE'] += max(start - self.lastEnd, 0.0)
+
+            self.stateTime['SENDING']   += sent - start
+            self.stateTime['RECEIVING'] += end - sent
+            self.lastEnd = end
+
+    #==============================================================================
+    def evaluated(self, name : str, duration : float, acknowledge : Optional[str] = None, parseError : bool = False):
+        """
+        Records the evaluation of a response (acknowledge designator or parse error).
+        """
+
+        with self.lock:
+            rm = self.types[name]
+
+            if parseError:
+                rm.parseErrors += 1
+            elif acknowledge == 'ERR':
+                rm.errors += 1
+            elif acknowledge == 'NAK':
+                rm.naks += 1
+
+            self.stateTime['EVALUATING'] += duration
+            self.lastEnd = time.perf_counter()
+
+    #==============================================================================
+    def retry(self, name : str):
+        with self.lock:
+            self.types[name].retries += 1
+
+    #==============================================================================
+    def snapshot(self, reset : bool = False) -> 'Metrics':
+        """
+        Returns a copy of the metrics, the counters start from zero again if reset is set.
+        """
+
+        with self.lock:
+            snap = Metrics(())
+            snap.types      = copy.deepcopy(self.types)
+            snap.stateTime  = dict(self.stateTime)
+            snap.lastEnd    = self.lastEnd
+
+            if reset:
+                self.types      = {name : RequestMetrics() for name in self.types}
+                self.stateTime  = {state : 0.0 for state in STATES}
+
+        return snap
+
+
+#==============================================================================
+def formatMetrics(metrics : Metrics) -> str:
+    """
+    Table of the counters and p50 / p99 latencies per request type plus the state times.
+    """
+
+    lines = [f'{"type":<10} | requests | responses | bytes out | bytes in | ERR | NAK | parse | timeout | retry | p50 [us] | p99 [us]']
+
+    for name, rm in metrics.types.items():
+        if rm.requests == 0:
+            continue
+
+        p50, p99 = rm.percentile(50), rm.percentile(99)
+        lines.append(f'{name:<10} | {rm.requests:8} | {rm.responses:9} | {rm.bytesOut:9} | {rm.bytesIn:8} | {rm.errors:3} | {rm.naks:3} | '
+                     f'{rm.parseErrors:5} | {rm.timeouts:7} | {rm.retries:5} | {p50 if p50 is not None else "-":>8} | {p99 if p99 is not None else "-":>8}')
+
+    total = sum(metrics.stateTime.values())
+
+    for state, seconds in metrics.stateTime.items():
+        lines.append(f'{state:<10} {seconds * 1000:10.1f} ms ({seconds * 100 / total if total > 0 else 0:5.1f} %)')
+
+    return '\n'.join(lines)
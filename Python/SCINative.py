@@ -0,0 +1,195 @@
+"""
+SCI driver running the C SCI master (CPython extension _SCIMaster, see Python/_SCIMaster.c)
+
+Same interface as SCI (command, getvalue, setvalue, setvalues, requestUpstream), but the
+frames are built and parsed by the C master and the serial port is read and written from C.
+The GIL is released while a request is on the way, so other threads keep running.
+
+Differences to SCI:
+- One instance per process (the C master is a singleton), POSIX ports only
+- Frame lengths are limited by the build of the extension (RX / TX_PACKET_LENGTH)
+- The number format is negotiated by the master (HEX preferred), numberFormat only applies
+  to devices without handshake support
+- command() of a function requesting an upstream fetches the upstream right away and
+  returns its length, requestUpstream() returns the data
+- No metrics (build the extension with -DSCI_METRICS_ENABLE=1 for the C metrics)
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import serial
+import time
+from typing import *
+
+import _SCIMaster
+from SCI import NumberFormat, Feature, Capabilities, BatchWriteError, Variable, Function, Datatype
+
+VALUE_MODES = {NumberFormat.HEX : 0, NumberFormat.FLOAT : 1}
+
+
+class SCINative:
+    HANDSHAKE_RETRY_TIME    = 0.1
+
+    #==============================================================================
+    def __init__(self, port : str, maxPacketSize : Optional[int] = None, baud : int = 115200, timeout : float = 5, numberFormat : Optional[NumberFormat] = None, handshakeTimeout : float = 3):
+        """
+        Opens the port and negotiates the communication settings with the device.
+
+        Parameters:
+        -----------
+        - port              : Serial port of the device
+        - maxPacketSize     : Frame payload length of devices without handshake support
+        - baud              : Baudrate
+        - timeout           : Response timeout (no byte received)
+        - numberFormat      : Number format of devices without handshake support (HEX if omitted)
+        - handshakeTimeout  : Time to wait for the handshake response
+        """
+
+        self.device = serial.Serial(port=port, baudrate=baud, timeout=timeout)
+        _SCIMaster.open(self.device.fileno(), VALUE_MODES[numberFormat or NumberFormat.HEX], float(timeout))
+
+        self.capabilities = self.handshake(handshakeTimeout)
+
+        if self.capabilities is None:
+            if maxPacketSize is None:
+                raise Exception('HANDSHAKE - No response from the device and no maxPacketSize given.')
+
+            self.capabilities = Capabilities(0, min(maxPacketSize, _SCIMaster.RX_PACKET_LENGTH), min(maxPacketSize, _SCIMaster.TX_PACKET_LENGTH),
+                                             [numberFormat or NumberFormat.HEX], Feature.UPSTREAM)
+
+        self.numberFormat = self.capabilities.numberFormats[0]
+        self.rxPacketSize = self.capabilities.rxPacketSize
+        self.txPacketSize = self.capabilities.txPacketSize
+
+    #==============================================================================
+    def close(self):
+        _SCIMaster.close()
+        self.device.close()
+
+    #==============================================================================
+    def handshake(self, handshakeTimeout : float) -> Optional[Capabilities]:
+        """
+        Exchanges the capabilities with the device, repeated until the device answers.
+
+        Returns:
+        --------
+        - Negotiated capabilities or None if the device does not support the handshake
+        """
+
+        deadline = time.monotonic() + handshakeTimeout
+
+        while time.monotonic() < deadline:
+            # Discard anything the device sent during its startup
+            self.device.reset_input_buffer()
+
+            try:
+                version, rxPacketSize, txPacketSize, valueModes, features, valueMode = _SCIMaster.handshake(self.HANDSHAKE_RETRY_TIME)
+            except TimeoutError:
+                continue
+            except _SCIMaster.RequestError:
+                raise Exception('HANDSHAKE - The device does not support any requested number format.')
+
+            numberFormat = NumberFormat.HEX if valueMode == VALUE_MODES[NumberFormat.HEX] else NumberFormat.FLOAT
+
+            return Capabilities(version, rxPacketSize, txPacketSize, [numberFormat], Feature(features))
+
+        return None
+
+    #==============================================================================
+    @staticmethod
+    def _error(prefix : str, error : _SCIMaster.RequestError, unknown : str) -> Exception:
+        acknowledge, number, errorNumber = error.args
+
+        return Exception(f'{prefix} - {unknown}' if acknowledge == _SCIMaster.ACK_UNKNOWN else f'{prefix} - Error: {errorNumber}')
+
+    #==============================================================================
+    def command(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> Union[List[Union[float, int]], int]:
+        """
+        Send a command to the SCI device.
+
+        Returns:
+        --------
+        - List of return values from the external function or length of the upstream.
+        """
+
+        try:
+            result = _SCIMaster.command(function.number, [dtype.value[0] for dtype in function.argTypeList], paramList or [],
+                                        [dtype.value[0] for dtype in function.returnTypeList], function.requestsUpstream)
+        except TimeoutError:
+            raise Exception('COMMAND - Timeout occured')
+        except _SCIMaster.RequestError as e:
+            raise self._error('COMMAND', e, 'Unknown Command')
+
+        return len(result) if isinstance(result, bytearray) else result
+
+    #==============================================================================
+    def setvalue(self, variable : Variable, value : Union[float, int]):
+        """
+        Sets a variable of the variable struct
+        """
+
+        try:
+            _SCIMaster.setvar(variable.number, variable.type.value[0], value)
+        except TimeoutError:
+            raise Exception('SETVALUE - Timeout occured')
+        except _SCIMaster.RequestError as e:
+            raise self._error('SETVALUE', e, 'Variable unknown')
+
+    #==============================================================================
+    def setvalues(self, writes : Sequence[Tuple[Variable, Union[float, int]]]):
+        """
+        Sets several variables within one SETVAR batch frame (see SCI.setvalues).
+
+        Raises:
+        -------
+        - BatchWriteError with the number of the failed variable
+        """
+
+        if len(writes) > 1 and not (self.capabilities.features & Feature.SETVAR_BATCH):
+            raise Exception('SETVALUES - Batch frames are not supported by the device')
+
+        try:
+            _SCIMaster.setvars([variable.number for variable, _ in writes], [variable.type.value[0] for variable, _ in writes],
+                               [value for _, value in writes])
+        except TimeoutError:
+            raise Exception('SETVALUES - Timeout occured')
+        except _SCIMaster.RequestError as e:
+            number = e.args[1]
+            raise BatchWriteError(number, str(self._error(f'SETVALUES - Variable {number}', e, 'unknown')))
+
+    #==============================================================================
+    def getvalue(self, variable : Variable) -> Union[float, int]:
+        """
+        Requests a variable value from the variable struct.
+        """
+
+        try:
+            return _SCIMaster.getvar(variable.number, variable.type.value[0])
+        except TimeoutError:
+            raise Exception('GETVALUE - Timeout occured')
+        except _SCIMaster.RequestError as e:
+            raise self._error('GETVALUE', e, 'Variable unknown')
+
+    #==============================================================================
+    def requestUpstream(self, function : Function, paramList : Optional[Iterable[Union[float, int]]] = None) -> bytearray:
+        """
+        Requests the upstream of a function.
+
+        Returns:
+        --------
+        - bytearray holding the upstream data
+        """
+
+        try:
+            result = _SCIMaster.command(function.number, [dtype.value[0] for dtype in function.argTypeList], paramList or [], [], True)
+        except TimeoutError:
+            raise Exception('UPSTREAM REQUEST - Timeout occured')
+        except _SCIMaster.RequestError as e:
+            raise self._error('UPSTREAM REQUEST', e, 'Unknown Command')
+
+        if not isinstance(result, bytearray):
+            raise Exception('UPSTREAM REQUEST - The function did not answer with an upstream')
+
+        return result
@@ -0,0 +1,260 @@
+"""
+Cyclic polling scheduler on top of the SCI driver
+
+Variables are subscribed with a period and a priority and polled by a worker thread.
+Every period a poll job is released, its deadline is the next release. The next job is
+selected by the earliest deadline (EDF, priority as tie breaker) or by the fixed
+priority (0 = highest, period as tie breaker; rate monotonic if assigned by period).
+Releases are derived from the subscription start, so the polling does not drift.
+
+The link time of a poll is estimated from the worst case GETVAR frame bytes at the
+baud rate of the port plus the device turnaround. Subscriptions that would make the
+set unschedulable are rejected (same tests as the C scheduler, see SCIScheduler.h).
+Jobs that are not polled before their deadline are dropped and counted as misses.
+
+Samples are passed to the callback of the subscription or, if none is given, stored
+in a ring buffer (readSamples()).
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import collections
+import threading
+import time
+from enum import Enum
+from typing import *
+from SCI import SCI, Variable
+
+
+class Policy(Enum):
+    EDF     = 0
+    FIXED   = 1
+
+
+class Sample(NamedTuple):
+    variable    : Variable
+    value       : Optional[Union[float, int]]   # None if the poll failed
+    release     : float
+    timestamp   : float
+
+
+class SubscriptionStats:
+    def __init__(self):
+        self.samples    : int   = 0
+        self.errors     : int   = 0
+        self.misses     : int   = 0
+        self.maxLatency : float = 0.0   # Release to response (s)
+        self.maxJitter  : float = 0.0   # Deviation of the sample interval from the period (s)
+
+
+class Subscription:
+    def __init__(self, variable : Variable, period : float, priority : int, cost : float, callback : Optional[Callable[[Sample], None]], release : float):
+        self.variable   = variable
+        self.period     = period
+        self.priority   = priority
+        self.cost       = cost
+        self.callback   = callback
+        self.release    = release
+        self.lastSample : Optional[float] = None
+        self.stats      = SubscriptionStats()
+
+    @property
+    def deadline(self) -> float:
+        return self.release + self.period
+
+
+class SCIScheduler:
+
+    GETVAR_FRAME_BYTES  = 32    # Worst case GETVAR request plus response (incl. STX/ETX)
+    MAX_UTILIZATION     = 0.9   # Link share of the subscriptions, the rest is left to other requests
+
+    #==============================================================================
+    def __init__(self, sci : SCI, policy : Policy = Policy.EDF, turnaround : float = 0.001, ringLength : int = 1024):
+        """
+        Parameters:
+        -----------
+        - sci           : Handle to the SCI driver
+        - policy        : Scheduling policy
+        - turnaround    : Device turnaround per poll (s)
+        - ringLength    : Number of samples kept in the ring buffer
+        """
+        self.sciHdl         : SCI                   = sci
+        self.policy         : Policy                = policy
+        self.pollCost       : float                 = self.GETVAR_FRAME_BYTES * 10 / sci.device.baudrate + turnaround
+        self.subscriptions  : List[Subscription]    = []
+        self.ring           : Deque[Sample]         = collections.deque(maxlen=ringLength)
+        self.ringOverruns   : int                   = 0
+        self.lock           : threading.Condition   = threading.Condition()
+        self.thread         : Optional[threading.Thread] = None
+        self.running        : bool                  = False
+
+    #==============================================================================
+    def subscribe(self, variable : Variable, period : float, priority : int = 0, callback : Optional[Callable[[Sample], None]] = None) -> Subscription:
+        """
+        Subscribes a variable for cyclic polling (the first job is released immediately).
+
+        Parameters:
+        -----------
+        - variable  : Object of the variable to poll
+        - period    : Polling period (s)
+        - priority  : Fixed priority (0 = highest), tie breaker for EDF
+        - callback  : Sample delivery (None: ring buffer)
+
+        Returns:
+        --------
+        - Subscription handle (holds the statistics)
+        """
+
+        sub = Subscription(variable, period, priority, self.pollCost, callback, time.monotonic())
+
+        with self.lock:
+            candidates = self.subscriptions + [sub]
+
+            if not self._schedulable(candidates):
+                raise ValueError(f'Subscription of variable {variable.number} at {period} s is not schedulable')
+
+            self.subscriptions = candidates
+            self.lock.notify()
+
+        return sub
+
+    #==============================================================================
+    def unsubscribe(self, sub : Subscription):
+        with self.lock:
+            self.subscriptions = [s for s in self.subscriptions if s is not sub]
+
+    #==============================================================================
+    def start(self):
+        self.running = True
+        self.thread = threading.Thread(target=self._worker, daemon=True)
+        self.thread.start()
+
+    #==============================================================================
+    def stop(self):
+        with self.lock:
+            self.running = False
+            self.lock.notify()
+
+        if self.thread is not None:
+            self.thread.join()
+
+    #==============================================================================
+    def readSamples(self) -> List[Sample]:
+        """
+        Takes all samples out of the ring buffer.
+        """
+
+        with self.lock:
+            samples = list(self.ring)
+            self.ring.clear()
+
+        return samples
+
+    #==============================================================================
+    @property
+    def utilization(self) -> float:
+        return sum(s.cost / s.period for s in self.subscriptions)
+
+    #==============================================================================
+    def _higherPriority(self, a : Subscription, b : Subscription) -> bool:
+        return (a.priority, a.period) < (b.priority, b.period)
+
+    #==============================================================================
+    def _schedulable(self, subs : List[Subscription]) -> bool:
+
+        utilization = sum(s.cost / s.period for s in subs)
+
+        if utilization > self.MAX_UTILIZATION:
+            return False
+
+        # A frame on the link is not preempted: Blocking by one poll
+        if self.policy == Policy.EDF:
+            return utilization + max(s.cost for s in subs) / min(s.period for s in subs) <= 1
+
+        # Non-preemptive response time analysis
+        for sub in subs:
+            higher  = [s for s in subs if s is not sub and self._higherPriority(s, sub)]
+            block   = max([s.cost for s in subs if s is not sub and s not in higher], default=0)
+            wait    = None
+            nextWait = block
+
+            while nextWait != wait:
+                wait = nextWait
+                nextWait = block + sum((int(wait / s.period) + 1) * s.cost for s in higher)
+
+                if nextWait + sub.cost > sub.period:
+                    return False
+
+        return True
+
+    #==============================================================================
+    def _worker(self):
+
+        while True:
+            with self.lock:
+                if not self.running:
+                    return
+
+                now = time.monotonic()
+                ready = []
+
+                for sub in self.subscriptions:
+                    # Jobs that have not been polled until their deadline are dropped
+                    while now >= sub.deadline:
+                        sub.release += sub.period
+                        sub.stats.misses += 1
+
+                    if now >= sub.release:
+                        ready.append(sub)
+
+                if len(ready) == 0:
+                    nextRelease = min((s.release for s in self.subscriptions), default=now + 1)
+                    self.lock.wait(max(nextRelease - now, 0))
+                    continue
+
+                if self.policy == Policy.EDF:
+                    sub = min(ready, key=lambda s: (s.deadline, s.priority, s.period))
+                else:
+                    sub = min(ready, key=lambda s: (s.priority, s.period, s.deadline))
+
+            try:
+                value = self.sciHdl.getvalue(sub.variable)
+            except Exception:
+                value = None
+
+            self._complete(sub, value, time.monotonic())
+
+    #==============================================================================
+    def _complete(self, sub : Subscription, value : Optional[Union[float, int]], timestamp : float):
+
+        sample  = Sample(sub.variable, value, sub.release, timestamp)
+        latency = timestamp - sub.release
+        stats   = sub.stats
+
+        stats.maxLatency = max(stats.maxLatency, latency)
+
+        if latency > sub.period:
+            stats.misses += 1
+
+        if value is not None:
+            if sub.lastSample is not None:
+                stats.maxJitter = max(stats.maxJitter, abs(timestamp - sub.lastSample - sub.period))
+
+            sub.lastSample = timestamp
+            stats.samples += 1
+        else:
+            stats.errors += 1
+
+        sub.release += sub.period
+
+        if sub.callback is not None:
+            sub.callback(sample)
+            return
+
+        with self.lock:
+            if len(self.ring) == self.ring.maxlen:
+                self.ringOverruns += 1
+
+            self.ring.append(sample)
@@ -0,0 +1,173 @@
+"""
+Decoder of the SCI master frame trace (C/Inc/SCITrace.h)
+
+Reads the pcapng files written by SCITraceExport: One enhanced packet block per frame,
+the direction in the flags option, a 4 byte pseudo header (protocol state, receive mode,
+request type, parse result) in front of the frame. Files of both byte orders are read.
+
+Usage: python SCITrace.py <trace.pcapng>
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import struct
+import sys
+from enum import IntEnum
+from typing import *
+
+
+class Direction(IntEnum):
+    TX  = 0
+    RX  = 1
+
+
+class ProtocolState(IntEnum):
+    IDLE        = 0
+    SENDING     = 1
+    EVALUATING  = 2
+    RECEIVING   = 3
+
+
+class RequestType(IntEnum):
+    NONE        = 0
+    GETVAR      = 1
+    SETVAR      = 2
+    COMMAND     = 3
+    UPSTREAM    = 4
+    DOWNSTREAM  = 5
+    HANDSHAKE   = 6
+
+
+class TraceRecord(NamedTuple):
+    timestamp   : int           # us
+    direction   : Direction
+    state       : int           # Protocol state (ProtocolState if known)
+    streamMode  : bool          # Received in stream mode (raw upstream data)
+    requestType : int           # Request on the link (RequestType if known)
+    result      : int           # Build / parse result (teSCI_ERROR, 0: no error)
+    length      : int           # Frame length on the wire (without STX / ETX)
+    data        : bytes         # Captured frame bytes
+
+
+BLOCK_SHB       = 0x0A0D0D0A
+BLOCK_IDB       = 0x00000001
+BLOCK_EPB       = 0x00000006
+BYTE_ORDER_MAGIC = 0x1A2B3C4D
+OPT_EPB_FLAGS   = 2
+LINKTYPE_SCI    = 147
+PSEUDO_HDR_LEN  = 4
+
+
+#==============================================================================
+def _options(data : bytes, order : str) -> Dict[int, bytes]:
+
+    options = {}
+    pos = 0
+
+    while pos + 4 <= len(data):
+        code, length = struct.unpack_from(order + 'HH', data, pos)
+        pos += 4
+
+        if code == 0:
+            break
+
+        options[code] = data[pos:pos + length]
+        pos += (length + 3) & ~3
+
+    return options
+
+
+#==============================================================================
+def readTrace(path : str) -> Iterator[TraceRecord]:
+    """
+    Reads the frames of a trace file.
+
+    Parameters:
+    -----------
+    - path  : pcapng file written by SCITraceExport
+
+    Returns:
+    --------
+    - Trace records in recording order
+    """
+
+    with open(path, 'rb') as file:
+        content = file.read()
+
+    order   = '<'
+    pos     = 0
+
+    while pos + 12 <= len(content):
+        blockType, = struct.unpack_from('<I', content, pos)
+
+        # The section header defines the byte order of the section
+        if blockType == BLOCK_SHB:
+            magic, = struct.unpack_from('<I', content, pos + 8)
+            order = '<' if magic == BYTE_ORDER_MAGIC else '>'
+
+        blockType, blockLen = struct.unpack_from(order + 'II', content, pos)
+
+        if blockLen < 12 or pos + blockLen > len(content):
+            raise ValueError(f'Truncated block at offset {pos}')
+
+        body = content[pos + 8:pos + blockLen - 4]
+
+        if blockType == BLOCK_IDB:
+            linkType, = struct.unpack_from(order + 'H', body, 0)
+
+            if linkType != LINKTYPE_SCI:
+                raise ValueError(f'Link type {linkType} is no SCI trace')
+
+        elif blockType == BLOCK_EPB:
+            _, tsHigh, tsLow, capLen, origLen = struct.unpack_from(order + 'IIIII', body, 0)
+            packet  = body[20:20 + capLen]
+            options = _options(body[20 + ((capLen + 3) & ~3):], order)
+            flags   = struct.unpack(order + 'I', options[OPT_EPB_FLAGS])[0] if OPT_EPB_FLAGS in options else 0
+
+            yield TraceRecord(timestamp     = (tsHigh << 32) | tsLow,
+                              direction     = Direction.RX if flags & 3 == 1 else Direction.TX,
+                              state         = packet[0],
+                              streamMode    = packet[1] != 0,
+                              requestType   = packet[2],
+                              result        = packet[3],
+                              length        = origLen - PSEUDO_HDR_LEN,
+                              data          = packet[PSEUDO_HDR_LEN:])
+
+        pos += blockLen
+
+
+#==============================================================================
+def formatRecord(record : TraceRecord, start : int = 0) -> str:
+
+    try:
+        reqType = RequestType(record.requestType).name
+    except ValueError:
+        reqType = str(record.requestType)
+
+    if record.streamMode:
+        data = record.data.hex()
+    else:
+        data = record.data.decode('ascii', errors='backslashreplace')
+
+    truncated = '...' if len(record.data) < record.length else ''
+    result = '' if record.result == 0 else f' ERR {record.result}'
+
+    return f'{(record.timestamp - start) / 1000:12.3f} ms {record.direction.name} {reqType:<10} {record.length:5} {data}{truncated}{result}'
+
+
+#==============================================================================
+if __name__ == '__main__':
+
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(1)
+
+    start = None
+
+    for record in readTrace(sys.argv[1]):
+        if start is None:
+            start = record.timestamp
+
+        print(formatRecord(record, start))
@@ -0,0 +1,157 @@
+"""
+Write-behind SETVAR buffer on top of the SCI driver
+
+write() returns immediately, a worker thread sends the pending writes. Until a write is
+sent, a newer write to the same variable replaces its value (last writer wins). Pending
+writes to different variables are packed into SETVAR batch frames (SCI.setvalues) if the
+device supports them. barrier() separates the writes: Writes after it are neither merged
+into nor sent before the writes in front of it. flush() waits until all writes so far are
+finished.
+
+History:
+--------
+- Created by Holderried, Roman, 18.10.2026
+"""
+
+import collections
+import threading
+from typing import *
+from SCI import SCI, Variable, Feature, BatchWriteError
+
+
+class WriteBehindStats:
+    def __init__(self):
+        self.writes     : int = 0
+        self.coalesced  : int = 0   # Writes replaced by a newer value before being sent
+        self.frames     : int = 0
+        self.batched    : int = 0   # Writes sent within batch frames (more than one write)
+        self.errors     : int = 0
+
+
+class SCIWriteBehind:
+
+    #==============================================================================
+    def __init__(self, sci : SCI, maxBatch : int = 5, errorCallback : Optional[Callable[[Variable, Exception], None]] = None):
+        """
+        Parameters:
+        -----------
+        - sci           : Handle to the SCI driver
+        - maxBatch      : Maximum number of writes per batch frame (must fit into the TX packet size)
+        - errorCallback : Called with the variable of a failed write
+        """
+        self.sciHdl         : SCI               = sci
+        self.maxBatch       : int               = maxBatch if sci.capabilities.features & Feature.SETVAR_BATCH else 1
+        self.errorCallback  = errorCallback
+        self.stats          : WriteBehindStats  = WriteBehindStats()
+
+        # One ordered dict (number -> (variable, value)) per barrier interval plus its completion event
+        self.intervals      : Deque[Tuple[collections.OrderedDict, threading.Event]] = collections.deque()
+        self.lock           : threading.Condition = threading.Condition()
+        self.running        : bool = True
+
+        self._newInterval()
+
+        self.thread = threading.Thread(target=self._worker, daemon=True)
+        self.thread.start()
+
+    #==============================================================================
+    def write(self, variable : Variable, value : Union[float, int]):
+        with self.lock:
+            pending, _ = self.intervals[-1]
+
+            # Last writer wins, a rewritten variable is queued behind the other writes
+            if variable.number in pending:
+                del pending[variable.number]
+                self.stats.coalesced += 1
+
+            pending[variable.number] = (variable, value)
+            self.stats.writes += 1
+            self.lock.notify()
+
+    #==============================================================================
+    def barrier(self) -> threading.Event:
+        """
+        Inserts a barrier.
+
+        Returns:
+        --------
+        - Event that is set once all writes before the barrier are finished
+        """
+
+        with self.lock:
+            _, done = self.intervals[-1]
+            self._newInterval()
+            self.lock.notify()
+
+        return done
+
+    #==============================================================================
+    def flush(self, timeout : Optional[float] = None) -> bool:
+        """
+        Waits until all writes so far are finished.
+
+        Returns:
+        --------
+        - False on timeout
+        """
+
+        return self.barrier().wait(timeout)
+
+    #==============================================================================
+    def stop(self):
+        with self.lock:
+            self.running = False
+            self.lock.notify()
+
+        self.thread.join()
+
+    #==============================================================================
+    def _newInterval(self):
+        self.intervals.append((collections.OrderedDict(), threading.Event()))
+
+    #==============================================================================
+    def _worker(self):
+
+        while True:
+            with self.lock:
+                # Oldest interval first, finished intervals complete their barrier
+                while len(self.intervals) > 1 and len(self.intervals[0][0]) == 0 and not self.intervals[0][1].is_set():
+                    self.intervals.popleft()[1].set()
+
+                pending, _ = self.intervals[0]
+
+                if len(pending) == 0:
+                    if not self.running:
+                        return
+                    self.lock.wait()
+                    continue
+
+                writes = [pending.popitem(last=False)[1] for _ in range(min(self.maxBatch, len(pending)))]
+
+            try:
+                self.sciHdl.setvalues(writes)
+                failed = len(writes)
+            except BatchWriteError as e:
+                failed = next((i for i, (variable, _) in enumerate(writes) if variable.number == e.number), 0)
+                self._error(writes[failed][0], e)
+            except Exception as e:
+                failed = 0
+                self._error(writes[0][0], e)
+
+            with self.lock:
+                self.stats.frames += 1
+                if len(writes) > 1:
+                    self.stats.batched += len(writes)
+
+                # Writes behind the failed one have not been applied (unless rewritten meanwhile)
+                for variable, value in reversed(writes[failed + 1:]):
+                    if variable.number not in pending:
+                        pending[variable.number] = (variable, value)
+                        pending.move_to_end(variable.number, last=False)
+
+    #==============================================================================
+    def _error(self, variable : Variable, error : Exception):
+        self.stats.errors += 1
+
+        if self.errorCallback is not None:
+            self.errorCallback(variable, error)
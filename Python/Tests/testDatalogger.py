@@ -16,7 +16,7 @@ hallPos = Variable(5, Datatype.DTYPE_INT32, 'Hall decoder position')
 sixStepVector = Variable(6, Datatype.DTYPE_UINT8, 'Vector determined by six step module')
 sixStepOut = Variable(7, Datatype.DTYPE_UINT16, 'Output value of the six step module')
 
-sciHdl = SCI('COM27', 128)
+sciHdl = SCI('COM27')
 dlogHdl = Datalogger(sciHdl, 0, 15000, os.path.join(os.path.realpath(os.path.join(os.path.dirname(__file__))), 'DataloggerCfg.py'))
 
 dlogHdl.reset()
@@ -34,9 +34,5 @@ sleep(2)
 
 data = dlogHdl.getData()
 
-timebaseCh1 = [1/dlogHdl.baseFrequency_Hz * data[0].divider * i for i in range(0,len(data[0].data))]
-timebaseCh2 = [1/dlogHdl.baseFrequency_Hz * data[1].divider * i for i in range(0,len(data[1].data))]
-timebaseCh3 = [1/dlogHdl.baseFrequency_Hz * data[2].divider * i for i in range(0,len(data[2].data))]
-
-plt.plot(timebaseCh1, data[0].data, timebaseCh2, data[1].data, timebaseCh3, data[2].data)
+plt.plot(data[0].timebase, data[0].samples, data[1].timebase, data[1].samples, data[2].timebase, data[2].samples)
 plt.show()
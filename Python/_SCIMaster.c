@@ -0,0 +1,875 @@
+/**************************************************************************//**
+ * \file _SCIMaster.c
+ * \author Roman Holderried
+ *
+ * \brief CPython extension module running the C SCI master (C/Src).
+ *
+ * Low level binding used by SCINative.py: Request building, response parsing,
+ * value conversion and the transfer control (multi-frame COMMAND results,
+ * upstreams) are done by the C master. The module writes and reads the
+ * serial port itself through the file descriptor of an opened pyserial port
+ * (POSIX only). The GIL is released for the whole request, including the
+ * waits for the response. Requests of several threads are serialized by a
+ * module lock.
+ *
+ * The C master is a singleton, so there is one open port per process. Frame
+ * lengths are limited by the build (RX_PACKET_LENGTH / TX_PACKET_LENGTH) and
+ * negotiated by the handshake. The master has no response timeout: A request
+ * is aborted (SCIReleaseProtocol) if no byte arrives within the timeout, the
+ * input received so far is discarded before the next request.
+ *
+ * Datatypes are passed as the struct format characters of SCI.Datatype
+ * ('B', 'b', 'H', 'h', 'L', 'l', 'f').
+ *
+ * Build (from the repository root):
+ * gcc -std=c99 -O2 -shared -fPIC -DRX_PACKET_LENGTH=4096 -DTX_PACKET_LENGTH=4096
+ *     $(python3-config --includes) -I C/Inc -I C/Inc/config C/Src/SCI*.c
+ *     C/Src/Buffer.c C/Src/Helpers.c Python/_SCIMaster.c
+ *     -o Python/_SCIMaster$(python3-config --extension-suffix)
+ *
+ * <b> History </b>
+ * 	- 2026-10-18 - File creation
+ * 	- 2026-10-18 - Request results taken over while the module lock is held
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SCIMaster.h"
+#include "SCIDataframe.h"
+
+/******************************************************************************
+ * Defines
+ *****************************************************************************/
+#define NATIVE_RX_CHUNK     4096    // Bytes read from the port at once
+
+/******************************************************************************
+ * Type definitions
+ *****************************************************************************/
+/** \brief Storage of a typed value */
+typedef union
+{
+    uint8_t     ui8;
+    int8_t      i8;
+    uint16_t    ui16;
+    int16_t     i16;
+    uint32_t    ui32;
+    int32_t     i32;
+    float       f32;
+}tuNATIVE_VALUE;
+
+typedef enum
+{
+    eNATIVE_RESULT_DONE         = 0,
+    eNATIVE_RESULT_TIMEOUT      = 1,
+    eNATIVE_RESULT_IO_ERROR     = 2,
+    eNATIVE_RESULT_ABORTED      = 3,    /*!< The master released the protocol without result.*/
+    eNATIVE_RESULT_CLOSED       = 4     /*!< Port not open (no request sent).*/
+}teNATIVE_RESULT;
+
+/** \brief Result of a request, copied from the module state while the lock is held */
+typedef struct
+{
+    teNATIVE_RESULT         eResult;
+    int                     iErrno;             /*!< errno of an I/O error.*/
+    teREQUEST_ACKNOWLEDGE   eAck;
+    int16_t                 i16Num;
+    uint16_t                ui16ErrNum;
+    uint8_t                 *pui8Upstream;      /*!< Copy of the upstream data (owned by the caller).*/
+    uint32_t                ui32UpstreamLen;
+}tsNATIVE_RESPONSE;
+
+/******************************************************************************
+ * Global variable definition
+ *****************************************************************************/
+static struct
+{
+    int                     iFd;
+    bool                    bOpen;
+    double                  dTimeout;           /*!< Response timeout (s, no byte received).*/
+    bool                    bFlushInput;        /*!< Discard late responses of a timed out request.*/
+    PyThread_type_lock      pLock;              /*!< Held for every access to the port and the master.*/
+    teSCI_VALUE_MODE        eValueMode;         /*!< Active value mode (initial or negotiated).*/
+
+    uint8_t                 ui8TxFrame[TX_PACKET_LENGTH + 2];   /*!< Frame passed byte by byte by the master.*/
+    uint16_t                ui16TxLen;
+
+    bool                    bDone;
+    teREQUEST_ACKNOWLEDGE   eAck;
+    int16_t                 i16Num;
+    uint16_t                ui16ErrNum;
+    uint8_t                 *pui8Upstream;      /*!< Copy of the upstream data.*/
+    uint32_t                ui32UpstreamLen;
+}sNative;
+
+static PyObject *pRequestError = NULL;
+
+/******************************************************************************
+ * Master callbacks (called without the GIL)
+ *****************************************************************************/
+static void _Finish (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    sNative.eAck        = eAck;
+    sNative.i16Num      = i16Num;
+    sNative.ui16ErrNum  = ui16ErrNum;
+    sNative.bDone       = true;
+}
+
+//=============================================================================
+static void _TxCB (uint8_t *pui8Buf, uint16_t ui16Len)
+{
+    if (sNative.ui16TxLen + ui16Len > sizeof(sNative.ui8TxFrame))
+        return;
+
+    memcpy(&sNative.ui8TxFrame[sNative.ui16TxLen], pui8Buf, ui16Len);
+    sNative.ui16TxLen += ui16Len;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _GetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t ui32Data, uint16_t ui16ErrNum)
+{
+    _Finish(eAck, i16Num, ui16ErrNum);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _SetVarCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint16_t ui16ErrNum)
+{
+    _Finish(eAck, i16Num, ui16ErrNum);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _CommandCB (teREQUEST_ACKNOWLEDGE eAck, int16_t i16Num, uint32_t *pui32Data, uint32_t ui32DataCnt, uint16_t ui16ErrNum)
+{
+    _Finish(eAck, i16Num, ui16ErrNum);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static teTRANSFER_ACK _UpstreamCB (int16_t i16Num, uint8_t *pui8Data, uint32_t ui32ByteCnt)
+{
+    // The buffer of the master is freed on return
+    sNative.pui8Upstream = malloc(ui32ByteCnt > 0 ? ui32ByteCnt : 1);
+
+    if (sNative.pui8Upstream != NULL)
+    {
+        memcpy(sNative.pui8Upstream, pui8Data, ui32ByteCnt);
+        sNative.ui32UpstreamLen = ui32ByteCnt;
+    }
+
+    _Finish(sNative.pui8Upstream != NULL ? eREQUEST_ACK_STATUS_SUCCESS_UPSTREAM : eREQUEST_ACK_STATUS_ERROR, i16Num, 0);
+    return eTRANSFER_ACK_SUCCESS;
+}
+
+//=============================================================================
+static void _HandshakeCB (teREQUEST_ACKNOWLEDGE eAck, tsSCI_CAPABILITIES sCapabilities)
+{
+    // Same selection as the master: HEX if both sides support it
+    if (eAck == eREQUEST_ACK_STATUS_SUCCESS_DATA)
+        sNative.eValueMode = (sCapabilities.ui16ValueModes & SCI_VALUE_MODE_BIT(eSCI_VALUE_MODE_HEX)) ? eSCI_VALUE_MODE_HEX : eSCI_VALUE_MODE_FLOAT;
+
+    _Finish(eAck, 0, 0);
+}
+
+/******************************************************************************
+ * Port I/O (called without the GIL)
+ *****************************************************************************/
+static double _Now (void)
+{
+    struct timespec sTs;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTs);
+
+    return (double)sTs.tv_sec + (double)sTs.tv_nsec * 1e-9;
+}
+
+//=============================================================================
+static bool _Wait (short iEvents, double dDeadline)
+{
+    struct pollfd sPoll = {sNative.iFd, iEvents, 0};
+    int iRemainingMs = (int)((dDeadline - _Now()) * 1000.0) + 1;
+    int iRet;
+
+    if (iRemainingMs <= 0)
+        return false;
+
+    iRet = poll(&sPoll, 1, iRemainingMs);
+
+    return iRet > 0 || (iRet < 0 && errno == EINTR);
+}
+
+//=============================================================================
+static teNATIVE_RESULT _Write (double dDeadline)
+{
+    uint16_t ui16Sent = 0;
+
+    while (ui16Sent < sNative.ui16TxLen)
+    {
+        ssize_t iCnt = write(sNative.iFd, &sNative.ui8TxFrame[ui16Sent], sNative.ui16TxLen - ui16Sent);
+
+        if (iCnt > 0)
+            ui16Sent += (uint16_t)iCnt;
+        else if (iCnt < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            return eNATIVE_RESULT_IO_ERROR;
+        else if (!_Wait(POLLOUT, dDeadline))
+            return eNATIVE_RESULT_TIMEOUT;
+    }
+
+    sNative.ui16TxLen = 0;
+
+    return eNATIVE_RESULT_DONE;
+}
+
+//=============================================================================
+static teNATIVE_RESULT _Run (double dTimeout)
+{
+    uint8_t ui8Rx[NATIVE_RX_CHUNK];
+    double dDeadline = _Now() + dTimeout;
+    teNATIVE_RESULT eResult = eNATIVE_RESULT_DONE;
+
+    while (!sNative.bDone && eResult == eNATIVE_RESULT_DONE)
+    {
+        tePROTOCOL_STATE eState;
+
+        SCIMasterSM();
+        eState = SCIGetProtocolState();
+
+        // The master passes the frame byte by byte, it is written at once
+        if (eState == ePROTOCOL_SENDING)
+            continue;
+
+        if (sNative.ui16TxLen > 0)
+        {
+            eResult = _Write(dDeadline);
+            dDeadline = _Now() + dTimeout;
+        }
+        else if (eState == ePROTOCOL_RECEIVING)
+        {
+            ssize_t iCnt = read(sNative.iFd, ui8Rx, sizeof(ui8Rx));
+
+            if (iCnt > 0)
+            {
+                SCIReceive(ui8Rx, (uint16_t)iCnt);
+                dDeadline = _Now() + dTimeout;
+            }
+            else if (iCnt < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                eResult = eNATIVE_RESULT_IO_ERROR;
+            else if (!_Wait(POLLIN, dDeadline))
+                eResult = eNATIVE_RESULT_TIMEOUT;
+        }
+        else if (eState == ePROTOCOL_IDLE && !sNative.bDone)
+            eResult = eNATIVE_RESULT_ABORTED;
+    }
+
+    // No response: Release the link for the next request
+    if (!sNative.bDone)
+    {
+        int iErrno = errno;
+
+        sNative.bFlushInput = true;
+        sNative.ui16TxLen = 0;
+        SCIFinishStreamReceive();
+        SCIReleaseProtocol();
+
+        // Reported by the caller
+        errno = iErrno;
+    }
+
+    return eResult;
+}
+
+/******************************************************************************
+ * Value conversion
+ *****************************************************************************/
+static int _Dtype (int iFormat)
+{
+    switch (iFormat)
+    {
+        case 'B': return eSCI_DTYPE_UINT8;
+        case 'b': return eSCI_DTYPE_INT8;
+        case 'H': return eSCI_DTYPE_UINT16;
+        case 'h': return eSCI_DTYPE_INT16;
+        case 'L': return eSCI_DTYPE_UINT32;
+        case 'l': return eSCI_DTYPE_INT32;
+        case 'f': return eSCI_DTYPE_F32;
+        default:
+            PyErr_Format(PyExc_ValueError, "Unknown datatype '%c'", iFormat);
+            return -1;
+    }
+}
+
+//=============================================================================
+static bool _DtypeList (PyObject *pTypes, teSCI_DATATYPE *peTypes, Py_ssize_t iMax, uint8_t *pui8Cnt)
+{
+    PyObject *pSeq = PySequence_Fast(pTypes, "Datatypes must be a sequence");
+    Py_ssize_t iCnt;
+
+    if (pSeq == NULL)
+        return false;
+
+    iCnt = PySequence_Fast_GET_SIZE(pSeq);
+
+    if (iCnt > iMax)
+    {
+        Py_DECREF(pSeq);
+        PyErr_SetString(PyExc_ValueError, "Too many values for one request");
+        return false;
+    }
+
+    for (Py_ssize_t i = 0; i < iCnt; i++)
+    {
+        PyObject *pItem = PySequence_Fast_GET_ITEM(pSeq, i);
+        int iType = PyUnicode_Check(pItem) && PyUnicode_GET_LENGTH(pItem) == 1 ? _Dtype(PyUnicode_READ_CHAR(pItem, 0)) : _Dtype(0);
+
+        if (iType < 0)
+        {
+            Py_DECREF(pSeq);
+            return false;
+        }
+
+        peTypes[i] = (teSCI_DATATYPE)iType;
+    }
+
+    Py_DECREF(pSeq);
+    *pui8Cnt = (uint8_t)iCnt;
+
+    return true;
+}
+
+//=============================================================================
+static bool _FromPython (PyObject *pVal, teSCI_DATATYPE eType, tuNATIVE_VALUE *puVal)
+{
+    static const long long i64Min[] = {0, INT8_MIN, 0, INT16_MIN, 0, INT32_MIN};
+    static const long long i64Max[] = {UINT8_MAX, INT8_MAX, UINT16_MAX, INT16_MAX, UINT32_MAX, INT32_MAX};
+    long long i64Val;
+
+    if (eType == eSCI_DTYPE_F32)
+    {
+        double dVal = PyFloat_AsDouble(pVal);
+
+        puVal->f32 = (float)dVal;
+        return !(dVal == -1.0 && PyErr_Occurred());
+    }
+
+    i64Val = PyLong_AsLongLong(pVal);
+
+    if (i64Val == -1 && PyErr_Occurred())
+        return false;
+
+    if (i64Val < i64Min[eType] || i64Val > i64Max[eType])
+    {
+        PyErr_SetString(PyExc_OverflowError, "Value out of range of the datatype");
+        return false;
+    }
+
+    switch (eType)
+    {
+        case eSCI_DTYPE_UINT8:  puVal->ui8  = (uint8_t)i64Val;  break;
+        case eSCI_DTYPE_INT8:   puVal->i8   = (int8_t)i64Val;   break;
+        case eSCI_DTYPE_UINT16: puVal->ui16 = (uint16_t)i64Val; break;
+        case eSCI_DTYPE_INT16:  puVal->i16  = (int16_t)i64Val;  break;
+        case eSCI_DTYPE_UINT32: puVal->ui32 = (uint32_t)i64Val; break;
+        default:                puVal->i32  = (int32_t)i64Val;  break;
+    }
+
+    return true;
+}
+
+//=============================================================================
+static PyObject *_ToPython (const tuNATIVE_VALUE *puVal, teSCI_DATATYPE eType)
+{
+    switch (eType)
+    {
+        case eSCI_DTYPE_UINT8:  return PyLong_FromLong(puVal->ui8);
+        case eSCI_DTYPE_INT8:   return PyLong_FromLong(puVal->i8);
+        case eSCI_DTYPE_UINT16: return PyLong_FromLong(puVal->ui16);
+        case eSCI_DTYPE_INT16:  return PyLong_FromLong(puVal->i16);
+        case eSCI_DTYPE_UINT32: return PyLong_FromUnsignedLong(puVal->ui32);
+        case eSCI_DTYPE_INT32:  return PyLong_FromLong(puVal->i32);
+        default:                return PyFloat_FromDouble(puVal->f32);
+    }
+}
+
+//=============================================================================
+static bool _ValueList (PyObject *pVals, const teSCI_DATATYPE *peTypes, uint8_t ui8Cnt, tuNATIVE_VALUE *puVals)
+{
+    PyObject *pSeq = PySequence_Fast(pVals, "Values must be a sequence");
+    bool bOk = true;
+
+    if (pSeq == NULL)
+        return false;
+
+    if (PySequence_Fast_GET_SIZE(pSeq) != ui8Cnt)
+    {
+        PyErr_SetString(PyExc_ValueError, "Length of parameter list does not match the length of the type specifier list.");
+        bOk = false;
+    }
+
+    for (uint8_t i = 0; bOk && i < ui8Cnt; i++)
+        bOk = _FromPython(PySequence_Fast_GET_ITEM(pSeq, i), peTypes[i], &puVals[i]);
+
+    Py_DECREF(pSeq);
+
+    return bOk;
+}
+
+/******************************************************************************
+ * Request execution
+ *****************************************************************************/
+/** \brief Request starter, called with the module lock held (without the GIL).*/
+typedef bool (*NATIVE_START_FCN)(const void *pvArgs);
+
+//=============================================================================
+static void _Lock (void)
+{
+    // Another thread may run a request meanwhile
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(sNative.pLock, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+}
+
+//=============================================================================
+/** \brief Runs a request (dTimeout: Response timeout, 0: Timeout of the port).
+ *
+ * The result is taken over into psRsp before the lock is released (the next
+ * request of another thread overwrites the module state). An upstream copy in
+ * psRsp is owned by the caller if true is returned.
+ */
+static bool _Execute (NATIVE_START_FCN Start, const void *pvArgs, double dTimeout, tsNATIVE_RESPONSE *psRsp)
+{
+    memset(psRsp, 0, sizeof(*psRsp));
+    psRsp->eResult = eNATIVE_RESULT_CLOSED;
+
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(sNative.pLock, WAIT_LOCK);
+
+    // Port state and timeout are taken over with the lock (changed by other threads only while it is free)
+    if (sNative.bOpen)
+    {
+        if (dTimeout <= 0)
+            dTimeout = sNative.dTimeout;
+
+        sNative.bDone           = false;
+        sNative.ui16TxLen       = 0;
+        sNative.pui8Upstream    = NULL;
+        sNative.ui32UpstreamLen = 0;
+
+        if (sNative.bFlushInput)
+        {
+            tcflush(sNative.iFd, TCIFLUSH);
+            sNative.bFlushInput = false;
+        }
+
+        psRsp->eResult          = Start(pvArgs) ? _Run(dTimeout) : eNATIVE_RESULT_ABORTED;
+        psRsp->iErrno           = errno;
+        psRsp->eAck             = sNative.eAck;
+        psRsp->i16Num           = sNative.i16Num;
+        psRsp->ui16ErrNum       = sNative.ui16ErrNum;
+        psRsp->pui8Upstream     = sNative.pui8Upstream;
+        psRsp->ui32UpstreamLen  = sNative.ui32UpstreamLen;
+        sNative.pui8Upstream    = NULL;
+    }
+
+    PyThread_release_lock(sNative.pLock);
+    Py_END_ALLOW_THREADS
+
+    // Only a successful request hands over its upstream
+    if (psRsp->eResult != eNATIVE_RESULT_DONE || psRsp->eAck == eREQUEST_ACK_STATUS_ERROR ||
+        psRsp->eAck == eREQUEST_ACK_STATUS_UNKNOWN || psRsp->eAck == eREQUEST_ACK_STATUS_CANCELLED)
+    {
+        free(psRsp->pui8Upstream);
+        psRsp->pui8Upstream = NULL;
+    }
+
+    switch (psRsp->eResult)
+    {
+        case eNATIVE_RESULT_DONE:
+            break;
+        case eNATIVE_RESULT_CLOSED:
+            PyErr_SetString(PyExc_RuntimeError, "Port not open");
+            return false;
+        case eNATIVE_RESULT_TIMEOUT:
+            PyErr_SetString(PyExc_TimeoutError, "Timeout occured");
+            return false;
+        case eNATIVE_RESULT_IO_ERROR:
+            errno = psRsp->iErrno;
+            PyErr_SetFromErrno(PyExc_OSError);
+            return false;
+        default:
+            PyErr_SetString(PyExc_RuntimeError, "Request could not be completed");
+            return false;
+    }
+
+    // Failed requests: RequestError(acknowledge, number, error number)
+    if (psRsp->eAck == eREQUEST_ACK_STATUS_ERROR || psRsp->eAck == eREQUEST_ACK_STATUS_UNKNOWN ||
+        psRsp->eAck == eREQUEST_ACK_STATUS_CANCELLED)
+    {
+        PyObject *pArgs = Py_BuildValue("(iiI)", (int)psRsp->eAck, (int)psRsp->i16Num, (unsigned int)psRsp->ui16ErrNum);
+
+        if (pArgs != NULL)
+        {
+            PyErr_SetObject(pRequestError, pArgs);
+            Py_DECREF(pArgs);
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================
+typedef struct
+{
+    tsSCI_VARIABLE  sVar;
+    tuNATIVE_VALUE  uVal;
+}tsNATIVE_VAR_ARGS;
+
+static bool _StartGetVar (const void *pvArgs)
+{
+    tsNATIVE_VAR_ARGS *psArgs = (tsNATIVE_VAR_ARGS*)pvArgs;
+
+    return SCIRequestGetVarTyped(&psArgs->sVar, &psArgs->uVal);
+}
+
+static bool _StartSetVar (const void *pvArgs)
+{
+    const tsNATIVE_VAR_ARGS *psArgs = (const tsNATIVE_VAR_ARGS*)pvArgs;
+
+    return SCIRequestSetVarTyped(&psArgs->sVar, &psArgs->uVal);
+}
+
+//=============================================================================
+typedef struct
+{
+    int16_t         i16Nums[SCI_SETVAR_BATCH_MAX];
+    teSCI_DATATYPE  eTypes[SCI_SETVAR_BATCH_MAX];
+    tuNATIVE_VALUE  uVals[SCI_SETVAR_BATCH_MAX];
+    uint8_t         ui8Cnt;
+}tsNATIVE_BATCH_ARGS;
+
+static bool _StartSetVarBatch (const void *pvArgs)
+{
+    const tsNATIVE_BATCH_ARGS *psArgs = (const tsNATIVE_BATCH_ARGS*)pvArgs;
+    const tsSCI_VALUE_CODEC *psCodec = SCIGetValueCodec(sNative.eValueMode);
+    tuREQUESTVALUE uVals[SCI_SETVAR_BATCH_MAX];
+
+    // Encoded in the value mode of the link (a handshake may have changed it)
+    for (uint8_t i = 0; i < psArgs->ui8Cnt; i++)
+        uVals[i] = psCodec->pEncodeTable[psArgs->eTypes[i]](&psArgs->uVals[i]);
+
+    return SCIRequestSetVarBatch(psArgs->i16Nums, uVals, psArgs->ui8Cnt);
+}
+
+//=============================================================================
+typedef struct
+{
+    tsSCI_FUNCTION  sFcn;
+    teSCI_DATATYPE  eArgTypes[MAX_NUM_REQUEST_VALUES];
+    teSCI_DATATYPE  eRetTypes[UINT8_MAX];
+    tuNATIVE_VALUE  uArgs[MAX_NUM_REQUEST_VALUES];
+    tuNATIVE_VALUE  uRets[UINT8_MAX];
+    const void      *pvArgs[MAX_NUM_REQUEST_VALUES];
+    void            *pvRets[UINT8_MAX];
+}tsNATIVE_COMMAND_ARGS;
+
+static bool _StartCommand (const void *pvArgs)
+{
+    const tsNATIVE_COMMAND_ARGS *psArgs = (const tsNATIVE_COMMAND_ARGS*)pvArgs;
+
+    return SCIRequestCommandTyped(&psArgs->sFcn, psArgs->pvArgs, psArgs->pvRets);
+}
+
+//=============================================================================
+static bool _StartHandshake (const void *pvArgs)
+{
+    return SCIRequestHandshake();
+}
+
+/******************************************************************************
+ * Module functions
+ *****************************************************************************/
+static PyObject *Native_open (PyObject *pSelf, PyObject *pArgs)
+{
+    tsSCI_MASTER_CALLBACKS sCbs = tsSCI_MASTER_CALLBACKS_DEFAULTS;
+    int iFd;
+    int iValueMode;
+    double dTimeout;
+
+    if (!PyArg_ParseTuple(pArgs, "iid", &iFd, &iValueMode, &dTimeout))
+        return NULL;
+
+    _Lock();
+
+    if (sNative.bOpen)
+    {
+        PyThread_release_lock(sNative.pLock);
+        PyErr_SetString(PyExc_RuntimeError, "Only one port per process is supported");
+        return NULL;
+    }
+
+    sCbs.BlockingTxExternalCB   = _TxCB;
+    sCbs.GetVarExternalCB       = _GetVarCB;
+    sCbs.SetVarExternalCB       = _SetVarCB;
+    sCbs.CommandExternalCB      = _CommandCB;
+    sCbs.UpstreamExternalCB     = _UpstreamCB;
+    sCbs.HandshakeExternalCB    = _HandshakeCB;
+
+    sNative.eValueMode = iValueMode == eSCI_VALUE_MODE_FLOAT ? eSCI_VALUE_MODE_FLOAT : eSCI_VALUE_MODE_HEX;
+    SCIMasterInit(sCbs, sNative.eValueMode);
+
+    sNative.iFd         = iFd;
+    sNative.dTimeout    = dTimeout;
+    sNative.bOpen       = true;
+
+    PyThread_release_lock(sNative.pLock);
+
+    Py_RETURN_NONE;
+}
+
+//=============================================================================
+static PyObject *Native_close (PyObject *pSelf, PyObject *pArgs)
+{
+    // Not while a request is running
+    _Lock();
+    sNative.bOpen = false;
+    PyThread_release_lock(sNative.pLock);
+
+    Py_RETURN_NONE;
+}
+
+//=============================================================================
+static PyObject *Native_capabilities (PyObject *pSelf, PyObject *pArgs)
+{
+    tsSCI_CAPABILITIES sCaps;
+    teSCI_VALUE_MODE eValueMode;
+
+    // Updated by a running handshake
+    _Lock();
+    sCaps       = SCIGetCapabilities();
+    eValueMode  = sNative.eValueMode;
+    PyThread_release_lock(sNative.pLock);
+
+    return Py_BuildValue("(IIIIIi)", sCaps.ui16ProtocolVersion, sCaps.ui16RxPacketLength, sCaps.ui16TxPacketLength,
+                         sCaps.ui16ValueModes, sCaps.ui16Features, (int)eValueMode);
+}
+
+//=============================================================================
+static PyObject *Native_handshake (PyObject *pSelf, PyObject *pArgs)
+{
+    tsNATIVE_RESPONSE sRsp;
+    double dTimeout = 0;
+
+    if (!PyArg_ParseTuple(pArgs, "|d", &dTimeout))
+        return NULL;
+
+    // Short timeout for the repeated handshake of a starting device
+    if (!_Execute(_StartHandshake, NULL, dTimeout, &sRsp))
+        return NULL;
+
+    return Native_capabilities(pSelf, NULL);
+}
+
+//=============================================================================
+static PyObject *Native_getvar (PyObject *pSelf, PyObject *pArgs)
+{
+    tsNATIVE_VAR_ARGS sArgs;
+    tsNATIVE_RESPONSE sRsp;
+    int iNum;
+    int iFormat;
+    int iType;
+
+    if (!PyArg_ParseTuple(pArgs, "iC", &iNum, &iFormat) || (iType = _Dtype(iFormat)) < 0)
+        return NULL;
+
+    sArgs.sVar.i16Num = (int16_t)iNum;
+    sArgs.sVar.eType = (teSCI_DATATYPE)iType;
+    sArgs.uVal.ui32 = 0;
+
+    if (!_Execute(_StartGetVar, &sArgs, 0, &sRsp))
+        return NULL;
+
+    return _ToPython(&sArgs.uVal, sArgs.sVar.eType);
+}
+
+//=============================================================================
+static PyObject *Native_setvar (PyObject *pSelf, PyObject *pArgs)
+{
+    tsNATIVE_VAR_ARGS sArgs;
+    tsNATIVE_RESPONSE sRsp;
+    PyObject *pVal;
+    int iNum;
+    int iFormat;
+    int iType;
+
+    if (!PyArg_ParseTuple(pArgs, "iCO", &iNum, &iFormat, &pVal) || (iType = _Dtype(iFormat)) < 0)
+        return NULL;
+
+    sArgs.sVar.i16Num = (int16_t)iNum;
+    sArgs.sVar.eType = (teSCI_DATATYPE)iType;
+
+    if (!_FromPython(pVal, sArgs.sVar.eType, &sArgs.uVal) || !_Execute(_StartSetVar, &sArgs, 0, &sRsp))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+//=============================================================================
+static PyObject *Native_setvars (PyObject *pSelf, PyObject *pArgs)
+{
+    tsNATIVE_BATCH_ARGS sArgs;
+    tsNATIVE_RESPONSE sRsp;
+    PyObject *pNums, *pTypes, *pVals, *pSeq;
+    uint8_t ui8TypeCnt;
+
+    if (!PyArg_ParseTuple(pArgs, "OOO", &pNums, &pTypes, &pVals) ||
+        !_DtypeList(pTypes, sArgs.eTypes, SCI_SETVAR_BATCH_MAX, &ui8TypeCnt) || !_ValueList(pVals, sArgs.eTypes, ui8TypeCnt, sArgs.uVals))
+        return NULL;
+
+    if ((pSeq = PySequence_Fast(pNums, "Numbers must be a sequence")) == NULL)
+        return NULL;
+
+    if (PySequence_Fast_GET_SIZE(pSeq) != ui8TypeCnt)
+    {
+        Py_DECREF(pSeq);
+        PyErr_SetString(PyExc_ValueError, "Number of variables and values differ");
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < ui8TypeCnt; i++)
+        sArgs.i16Nums[i] = (int16_t)PyLong_AsLong(PySequence_Fast_GET_ITEM(pSeq, i));
+
+    Py_DECREF(pSeq);
+    sArgs.ui8Cnt = ui8TypeCnt;
+
+    if (PyErr_Occurred() || !_Execute(_StartSetVarBatch, &sArgs, 0, &sRsp))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+//=============================================================================
+static PyObject *Native_command (PyObject *pSelf, PyObject *pArgs)
+{
+    tsNATIVE_COMMAND_ARGS *psArgs;
+    tsNATIVE_RESPONSE sRsp;
+    PyObject *pArgTypes, *pVals, *pRetTypes, *pResult = NULL;
+    int iNum;
+    int iUpstream = 0;
+
+    if (!PyArg_ParseTuple(pArgs, "iOOO|p", &iNum, &pArgTypes, &pVals, &pRetTypes, &iUpstream))
+        return NULL;
+
+    // Result storage is too large for the stack of a thread
+    if ((psArgs = PyMem_Calloc(1, sizeof(tsNATIVE_COMMAND_ARGS))) == NULL)
+        return PyErr_NoMemory();
+
+    psArgs->sFcn.i16Num = (int16_t)iNum;
+    psArgs->sFcn.peArgTypes = psArgs->eArgTypes;
+    psArgs->sFcn.peRetTypes = psArgs->eRetTypes;
+    psArgs->sFcn.bRequestsUpstream = iUpstream != 0;
+
+    if (_DtypeList(pArgTypes, psArgs->eArgTypes, MAX_NUM_REQUEST_VALUES, &psArgs->sFcn.ui8ArgCnt) &&
+        _DtypeList(pRetTypes, psArgs->eRetTypes, UINT8_MAX, &psArgs->sFcn.ui8RetCnt) &&
+        _ValueList(pVals, psArgs->eArgTypes, psArgs->sFcn.ui8ArgCnt, psArgs->uArgs))
+    {
+        for (uint8_t i = 0; i < psArgs->sFcn.ui8ArgCnt; i++)
+            psArgs->pvArgs[i] = &psArgs->uArgs[i];
+
+        for (uint8_t i = 0; i < psArgs->sFcn.ui8RetCnt; i++)
+            psArgs->pvRets[i] = &psArgs->uRets[i];
+
+        if (_Execute(_StartCommand, psArgs, 0, &sRsp))
+        {
+            // The master fetches the upstream of the command right away
+            if (sRsp.pui8Upstream != NULL)
+            {
+                pResult = PyByteArray_FromStringAndSize((const char*)sRsp.pui8Upstream, sRsp.ui32UpstreamLen);
+                free(sRsp.pui8Upstream);
+            }
+            else if ((pResult = PyList_New(psArgs->sFcn.ui8RetCnt)) != NULL)
+            {
+                for (uint8_t i = 0; i < psArgs->sFcn.ui8RetCnt; i++)
+                {
+                    PyObject *pItem = _ToPython(&psArgs->uRets[i], psArgs->eRetTypes[i]);
+
+                    if (pItem == NULL)
+                    {
+                        Py_CLEAR(pResult);
+                        break;
+                    }
+
+                    PyList_SET_ITEM(pResult, i, pItem);
+                }
+            }
+        }
+    }
+
+    PyMem_Free(psArgs);
+
+    return pResult;
+}
+
+/******************************************************************************
+ * Module definition
+ *****************************************************************************/
+static PyMethodDef sNativeMethods[] =
+{
+    {"open",            Native_open,            METH_VARARGS, "open(fd, valueMode, timeout): Initializes the master on an opened port."},
+    {"close",           Native_close,           METH_NOARGS,  "close(): Detaches the master from the port."},
+    {"handshake",       Native_handshake,       METH_VARARGS, "handshake([timeout]) -> (version, rx, tx, valueModes, features, valueMode)"},
+    {"capabilities",    Native_capabilities,    METH_NOARGS,  "capabilities() -> (version, rx, tx, valueModes, features, valueMode)"},
+    {"getvar",          Native_getvar,          METH_VARARGS, "getvar(num, dtype) -> value"},
+    {"setvar",          Native_setvar,          METH_VARARGS, "setvar(num, dtype, value)"},
+    {"setvars",         Native_setvars,         METH_VARARGS, "setvars(nums, dtypes, values): SETVAR batch frame."},
+    {"command",         Native_command,         METH_VARARGS, "command(num, argTypes, args, retTypes[, upstream]) -> results or upstream bytearray"},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef sNativeModule =
+{
+    PyModuleDef_HEAD_INIT, "_SCIMaster", "C SCI master binding (see SCINative.py).", -1, sNativeMethods
+};
+
+//=============================================================================
+PyMODINIT_FUNC PyInit__SCIMaster (void)
+{
+    PyObject *pModule = PyModule_Create(&sNativeModule);
+
+    if (pModule == NULL)
+        return NULL;
+
+    sNative.pLock = PyThread_allocate_lock();
+    pRequestError = PyErr_NewException("_SCIMaster.RequestError", NULL, NULL);
+
+    // The module keeps its own reference of the exception
+    Py_XINCREF(pRequestError);
+
+    if (sNative.pLock == NULL || pRequestError == NULL || PyModule_AddObject(pModule, "RequestError", pRequestError) < 0 ||
+        PyModule_AddIntConstant(pModule, "RX_PACKET_LENGTH", RX_PACKET_LENGTH) < 0 ||
+        PyModule_AddIntConstant(pModule, "TX_PACKET_LENGTH", TX_PACKET_LENGTH) < 0 ||
+        PyModule_AddIntConstant(pModule, "SETVAR_BATCH_MAX", SCI_SETVAR_BATCH_MAX) < 0 ||
+        PyModule_AddIntConstant(pModule, "ACK_ERROR", eREQUEST_ACK_STATUS_ERROR) < 0 ||
+        PyModule_AddIntConstant(pModule, "ACK_UNKNOWN", eREQUEST_ACK_STATUS_UNKNOWN) < 0)
+    {
+        Py_XDECREF(pRequestError);
+        Py_DECREF(pModule);
+        return NULL;
+    }
+
+    return pModule;
+}